@@ -0,0 +1,158 @@
+#include "bindingRemapDialog.h"
+#include "documentWindow.h"
+#include "shaderIntermediateCache.h"
+#include <QtWidgets/QVBoxLayout>
+#include <QtWidgets/QHBoxLayout>
+#include <QtWidgets/QFormLayout>
+#include <QtWidgets/QLabel>
+#include <QtWidgets/QDialogButtonBox>
+#include <QtWidgets/QApplication>
+#include <QtWidgets/QFileDialog>
+#include <QtWidgets/QMessageBox>
+#include <QDir>
+
+// 构造函数，初始化绑定重映射对话框，默认只勾选当前文档。
+BindingRemapDialog::BindingRemapDialog(const QList<DocumentWindow *> &documents, int currentIndex, const QString &layoutFile, QWidget *parent)
+    : QDialog(parent), documents(documents)
+{
+    setWindowTitle(tr("Remap Descriptor Bindings"));
+    resize(900, 650);
+
+    QVBoxLayout *mainLayout = new QVBoxLayout(this);
+
+    mainLayout->addWidget(new QLabel(tr("Pipeline stages:"), this));
+    stageList = new QListWidget(this);
+    for (int i = 0; i < documents.size(); ++i) {
+        QListWidgetItem *item = new QListWidgetItem(documents[i]->getDocumentWindowTitle(), stageList);
+        item->setFlags(item->flags() | Qt::ItemIsUserCheckable);
+        item->setCheckState(i == currentIndex ? Qt::Checked : Qt::Unchecked);
+    }
+    stageList->setMaximumHeight(120);
+    mainLayout->addWidget(stageList);
+
+    QFormLayout *formLayout = new QFormLayout();
+    QHBoxLayout *fileLayout = new QHBoxLayout();
+    layoutFileEdit = new QLineEdit(layoutFile, this);
+    layoutFileEdit->setPlaceholderText(tr("Optional, JSON"));
+    QPushButton *browseButton = new QPushButton(tr("Browse..."), this);
+    fileLayout->addWidget(layoutFileEdit, 1);
+    fileLayout->addWidget(browseButton);
+    formLayout->addRow(tr("Layout file"), fileLayout);
+    compactBindingsCheck = new QCheckBox(tr("Compact bindings"), this);
+    compactBindingsCheck->setChecked(true);
+    compactSetsCheck = new QCheckBox(tr("Compact descriptor sets"), this);
+    QHBoxLayout *optionLayout = new QHBoxLayout();
+    optionLayout->addWidget(compactBindingsCheck);
+    optionLayout->addWidget(compactSetsCheck);
+    optionLayout->addStretch();
+    formLayout->addRow(tr("Options"), optionLayout);
+    mainLayout->addLayout(formLayout);
+
+    reportEdit = new QTextEdit(this);
+    reportEdit->setReadOnly(true);
+    reportEdit->setLineWrapMode(QTextEdit::NoWrap);
+    reportEdit->setStyleSheet("QTextEdit { font-family: 'Consolas', monospace; }");
+    mainLayout->addWidget(reportEdit, 1);
+
+    QDialogButtonBox *buttonBox = new QDialogButtonBox(QDialogButtonBox::Close, Qt::Horizontal, this);
+    QPushButton *runButton = buttonBox->addButton(tr("Run"), QDialogButtonBox::ActionRole);
+    saveLayoutButton = buttonBox->addButton(tr("Save Layout..."), QDialogButtonBox::ActionRole);
+    saveButton = buttonBox->addButton(tr("Save Remapped SPIR-V..."), QDialogButtonBox::ActionRole);
+    saveLayoutButton->setEnabled(false);
+    saveButton->setEnabled(false);
+    mainLayout->addWidget(buttonBox);
+
+    connect(browseButton, &QPushButton::clicked, this, &BindingRemapDialog::browseLayoutFile);
+    connect(runButton, &QPushButton::clicked, this, &BindingRemapDialog::runRemap);
+    connect(saveLayoutButton, &QPushButton::clicked, this, &BindingRemapDialog::saveLayout);
+    connect(saveButton, &QPushButton::clicked, this, &BindingRemapDialog::saveRemapped);
+    connect(buttonBox, &QDialogButtonBox::rejected, this, &QDialog::reject);
+}
+
+void BindingRemapDialog::browseLayoutFile()
+{
+    QString filePath = QFileDialog::getOpenFileName(this, tr("Open Layout File"), layoutFileEdit->text(), tr("Layout Files (*.json);;All Files (*)"));
+    if (!filePath.isEmpty()) {
+        layoutFileEdit->setText(filePath);
+    }
+}
+
+void BindingRemapDialog::runRemap()
+{
+    saveLayoutButton->setEnabled(false);
+    saveButton->setEnabled(false);
+
+    QVector<SpirvLayoutBinding> fixedLayout;
+    QString error;
+    QString layoutFilePath = layoutFileEdit->text().trimmed();
+    if (!layoutFilePath.isEmpty() && !SpirvBindingRemapper::loadLayout(layoutFilePath, fixedLayout, error)) {
+        reportEdit->setPlainText(tr("Remap failed:\n") + error);
+        return;
+    }
+
+    stages.clear();
+    QApplication::setOverrideCursor(Qt::WaitCursor);
+    bool success = true;
+    for (int i = 0; i < stageList->count() && success; ++i) {
+        if (stageList->item(i)->checkState() != Qt::Checked) {
+            continue;
+        }
+        SpirvRemapStage stage;
+        stage.name = documents[i]->getDocumentWindowTitle();
+        success = documents[i]->compileSpirv(stage.binary, error);
+        if (!success) {
+            error = tr("%1: %2").arg(stage.name).arg(error.isEmpty() ? tr("Compilation failed.") : error);
+        }
+        stages.append(stage);
+    }
+
+    QStringList warnings;
+    if (success && stages.isEmpty()) {
+        success = false;
+        error = tr("Check at least one stage.");
+    }
+    if (success) {
+        SpirvRemapOptions options;
+        options.compactBindings = compactBindingsCheck->isChecked();
+        options.compactSets = compactSetsCheck->isChecked();
+        success = SpirvBindingRemapper::remap(stages, fixedLayout, options, layout, warnings, error);
+    }
+    QApplication::restoreOverrideCursor();
+
+    if (!success) {
+        reportEdit->setPlainText(tr("Remap failed:\n") + error);
+        return;
+    }
+
+    reportEdit->setPlainText(SpirvBindingRemapper::reportText(stages, layout, warnings));
+    saveLayoutButton->setEnabled(true);
+    saveButton->setEnabled(true);
+}
+
+void BindingRemapDialog::saveLayout()
+{
+    QString filePath = QFileDialog::getSaveFileName(this, tr("Save Layout"), layoutFileEdit->text(), tr("Layout Files (*.json)"));
+    if (filePath.isEmpty()) {
+        return;
+    }
+    if (!SpirvBindingRemapper::saveLayout(filePath, layout)) {
+        QMessageBox::warning(this, windowTitle(), tr("Failed to write %1").arg(filePath));
+    }
+}
+
+void BindingRemapDialog::saveRemapped()
+{
+    QString directory = QFileDialog::getExistingDirectory(this, tr("Save Remapped SPIR-V"));
+    if (directory.isEmpty()) {
+        return;
+    }
+
+    QDir dir(directory);
+    for (const SpirvRemapStage &stage : stages) {
+        QString filePath = dir.filePath(QString("%1_%2.spv").arg(stage.name).arg(stage.stage.toLower()));
+        if (!ShaderIntermediateCache::writeBlob(filePath, stage.remappedBinary)) {
+            QMessageBox::warning(this, windowTitle(), tr("Failed to write %1").arg(filePath));
+            return;
+        }
+    }
+}
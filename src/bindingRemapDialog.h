@@ -0,0 +1,45 @@
+#ifndef BINDINGREMAPDIALOG_H
+#define BINDINGREMAPDIALOG_H
+
+#include <QtWidgets/QDialog>
+#include <QtWidgets/QListWidget>
+#include <QtWidgets/QLineEdit>
+#include <QtWidgets/QCheckBox>
+#include <QtWidgets/QTextEdit>
+#include <QtWidgets/QPushButton>
+#include "spirvBindingRemapper.h"
+
+class DocumentWindow;
+
+// BindingRemapDialog 选择一条管线的各阶段文档，按布局描述文件重映射描述符绑定并压缩，
+// 输出合并后的管线布局表，可保存为布局文件及重映射后的 SPIR-V。
+class BindingRemapDialog : public QDialog
+{
+    Q_OBJECT
+
+public:
+    BindingRemapDialog(const QList<DocumentWindow *> &documents, int currentIndex, const QString &layoutFile, QWidget *parent = nullptr);
+
+    QString layoutFile() const { return layoutFileEdit->text(); }
+
+private slots:
+    void browseLayoutFile();
+    void runRemap();
+    void saveLayout();
+    void saveRemapped();
+
+private:
+    QList<DocumentWindow *> documents;
+    QVector<SpirvRemapStage> stages;
+    QVector<SpirvLayoutBinding> layout;
+
+    QListWidget *stageList;
+    QLineEdit *layoutFileEdit;
+    QCheckBox *compactBindingsCheck;
+    QCheckBox *compactSetsCheck;
+    QTextEdit *reportEdit;
+    QPushButton *saveLayoutButton;
+    QPushButton *saveButton;
+};
+
+#endif // BINDINGREMAPDIALOG_H
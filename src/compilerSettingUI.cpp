@@ -4,6 +4,7 @@
 // 构造函数，初始化编译器设置 UI。
 CompilerSettingUI::CompilerSettingUI(QWidget *parent)
     : QWidget(parent)
+    , isUpdatingCompilerSettings(false)
 {
     setupUI();
     setupConnections();
@@ -52,6 +53,17 @@ void CompilerSettingUI::setupUI()
     outputTypeLayout->addWidget(outputTypeCombo);
     compilerLayout->addLayout(outputTypeLayout);
 
+    // SPIR-V 优化级别（仅 GLSLANG/GLSLANGKGVER）
+    spirvOptimizeWidget = new QWidget(this);
+    QHBoxLayout *spirvOptimizeLayout = new QHBoxLayout(spirvOptimizeWidget);
+    spirvOptimizeLayout->setContentsMargins(0, 0, 0, 0);
+    spirvOptimizeLayout->addWidget(new QLabel(tr("SPIR-V Optimize:")));
+    spirvOptimizeCombo = new QComboBox(spirvOptimizeWidget);
+    spirvOptimizeCombo->addItems(QStringList() << "-O" << "-Os" << "None");
+    spirvOptimizeLayout->addWidget(spirvOptimizeCombo);
+    spirvOptimizeWidget->setVisible(false);
+    compilerLayout->addWidget(spirvOptimizeWidget);
+
     // 在构建按钮之前添加额外编译选项控件
     QHBoxLayout *extraOptionsLayout = new QHBoxLayout();
     extraOptionsCheckBox = new QCheckBox(tr("Additional Options:"), this);
@@ -62,11 +74,43 @@ void CompilerSettingUI::setupUI()
     extraOptionsLayout->addWidget(extraOptionsCheckBox);
     extraOptionsLayout->addWidget(extraOptionsEdit, 1); // 让输入框占据更多空间
     compilerLayout->addLayout(extraOptionsLayout);
+
+    // glslkgver 预处理输出 #line 指令，错误信息及调试信息指向原始文件
+    lineDirectivesCheckBox = new QCheckBox(tr("Emit #line Directives"), this);
+    lineDirectivesCheckBox->setCheckState(Qt::Unchecked);
+    lineDirectivesCheckBox->setVisible(false);
+    compilerLayout->addWidget(lineDirectivesCheckBox);
+
+    // 编译时附加调试信息，按 OpLine/DebugLine 或 DXIL !dbg 统计每行代价
+    lineCostCheckBox = new QCheckBox(tr("Source Line Cost (debug info)"), this);
+    lineCostCheckBox->setCheckState(Qt::Unchecked);
+    lineCostCheckBox->setToolTip(tr("Compile with debug info and show per-line instruction cost in the editor gutter"));
+    lineCostCheckBox->setVisible(false);
+    compilerLayout->addWidget(lineCostCheckBox);
+
+    // glslkgver 预编译库，列出的cginc单独编译为 SPIR-V 库模块后链接
+    linkedLibrariesWidget = new QWidget(this);
+    QHBoxLayout *linkedLibrariesLayout = new QHBoxLayout(linkedLibrariesWidget);
+    linkedLibrariesLayout->setContentsMargins(0, 0, 0, 0);
+    linkedLibrariesCheckBox = new QCheckBox(tr("Link Libraries:"), linkedLibrariesWidget);
+    linkedLibrariesCheckBox->setCheckState(Qt::Unchecked);
+    linkedLibrariesEdit = new QLineEdit(linkedLibrariesWidget);
+    linkedLibrariesEdit->setPlaceholderText(tr("e.g. BRDF.cginc, shadow.cginc"));
+    linkedLibrariesEdit->setEnabled(false);
+    linkedLibrariesLayout->addWidget(linkedLibrariesCheckBox);
+    linkedLibrariesLayout->addWidget(linkedLibrariesEdit, 1);
+    linkedLibrariesWidget->setVisible(false);
+    compilerLayout->addWidget(linkedLibrariesWidget);
     
     // 构建按钮
     buildButton = new QPushButton(tr("Build"), this);
     compilerLayout->addWidget(buildButton);
 
+    // 并行构建 glslkgver 文件中的所有阶段代码块
+    buildAllStagesButton = new QPushButton(tr("Build All Stages"), this);
+    buildAllStagesButton->setVisible(false);
+    compilerLayout->addWidget(buildAllStagesButton);
+
     mainLayout->addWidget(compilerGroup);
 }
 
@@ -79,9 +123,20 @@ void CompilerSettingUI::setupConnections()
             this, &CompilerSettingUI::compilerChanged);
     connect(buildButton, &QPushButton::clicked, 
             this, &CompilerSettingUI::buildClicked);
+    connect(buildAllStagesButton, &QPushButton::clicked,
+            this, &CompilerSettingUI::buildAllStagesClicked);
+
+    // 输出类型或 SPIR-V 优化级别变化只影响下游步骤，切换编译器时重新填充选项不发送信号
+    connect(outputTypeCombo, &QComboBox::currentTextChanged, this, [this]() {
+        if (!isUpdatingCompilerSettings) emit downstreamSettingsChanged();
+    });
+    connect(spirvOptimizeCombo, &QComboBox::currentTextChanged, this, [this]() {
+        if (!isUpdatingCompilerSettings) emit downstreamSettingsChanged();
+    });
     
     // 连接额外选项复选框信号
     connect(extraOptionsCheckBox, &QCheckBox::toggled, extraOptionsEdit, &QLineEdit::setEnabled);
+    connect(linkedLibrariesCheckBox, &QCheckBox::toggled, linkedLibrariesEdit, &QLineEdit::setEnabled);
 }
 
 // 获取当前设置
@@ -141,6 +196,8 @@ void CompilerSettingUI::updateCompilerSettings(const QString &compiler)
 {
     QString currentShaderType = shaderTypeCombo->currentText();
 
+    isUpdatingCompilerSettings = true;
+
     shaderTypeCombo->clear();
     shaderModelCombo->clear();
     outputTypeCombo->clear();
@@ -161,6 +218,14 @@ void CompilerSettingUI::updateCompilerSettings(const QString &compiler)
         shaderModelCombo->addItems(capability.supportedShaderModels);
         outputTypeCombo->addItems(capability.supportedOutputTypes);
     }
+
+    lineDirectivesCheckBox->setVisible(compiler == "GLSLANGKGVER");
+    lineCostCheckBox->setVisible(compiler == "DXC" || compiler == "GLSLANG" || compiler == "GLSLANGKGVER");
+    buildAllStagesButton->setVisible(compiler == "GLSLANGKGVER");
+    linkedLibrariesWidget->setVisible(compiler == "GLSLANGKGVER");
+    spirvOptimizeWidget->setVisible(compiler == "GLSLANG" || compiler == "GLSLANGKGVER");
+
+    isUpdatingCompilerSettings = false;
 }
 
 // 响应语言变化
@@ -214,3 +279,70 @@ void CompilerSettingUI::setExtraOptions(const QString &options)
 {
     extraOptionsEdit->setText(options);
 }
+
+bool CompilerSettingUI::isLineDirectivesEnabled() const
+{
+    return lineDirectivesCheckBox->isChecked();
+}
+
+void CompilerSettingUI::setLineDirectivesEnabled(bool enabled)
+{
+    lineDirectivesCheckBox->setChecked(enabled);
+}
+
+bool CompilerSettingUI::isLineCostEnabled() const
+{
+    return lineCostCheckBox->isChecked();
+}
+
+void CompilerSettingUI::setLineCostEnabled(bool enabled)
+{
+    lineCostCheckBox->setChecked(enabled);
+}
+
+bool CompilerSettingUI::isLinkedLibrariesEnabled() const
+{
+    return linkedLibrariesCheckBox->isChecked();
+}
+
+QStringList CompilerSettingUI::getLinkedLibraries() const
+{
+    QStringList libraries;
+    for (const QString &library : linkedLibrariesEdit->text().split(',', QString::SkipEmptyParts)) {
+        if (!library.trimmed().isEmpty()) {
+            libraries << library.trimmed();
+        }
+    }
+    return libraries;
+}
+
+void CompilerSettingUI::setLinkedLibrariesEnabled(bool enabled)
+{
+    linkedLibrariesCheckBox->setChecked(enabled);
+    linkedLibrariesEdit->setEnabled(enabled);
+}
+
+void CompilerSettingUI::setLinkedLibraries(const QStringList &libraries)
+{
+    linkedLibrariesEdit->setText(libraries.join(", "));
+}
+
+QString CompilerSettingUI::getSpirvOptimizeOptions() const
+{
+    QString level = spirvOptimizeCombo->currentText();
+    return level == "None" ? QString() : level;
+}
+
+QString CompilerSettingUI::getSpirvOptimizeLevel() const
+{
+    return spirvOptimizeCombo->currentText();
+}
+
+void CompilerSettingUI::setSpirvOptimizeLevel(const QString &level)
+{
+    // 自定义 pass 列表不在预设项中，追加后再选中
+    if (spirvOptimizeCombo->findText(level) < 0) {
+        spirvOptimizeCombo->addItem(level);
+    }
+    spirvOptimizeCombo->setCurrentText(level);
+}
@@ -30,6 +30,12 @@ public:
     QString getOutputType() const;
     bool isExtraOptionsEnabled() const; // 获取额外选项是否启用
     QString getExtraOptions() const; // 获取额外编译选项
+    bool isLineDirectivesEnabled() const; // 获取是否输出 #line 指令
+    bool isLineCostEnabled() const; // 获取是否生成调试信息并统计每行代价
+    bool isLinkedLibrariesEnabled() const; // 获取是否链接预编译库
+    QStringList getLinkedLibraries() const; // 获取预编译库列表
+    QString getSpirvOptimizeOptions() const; // 获取 spirv-opt 参数，不优化时为空
+    QString getSpirvOptimizeLevel() const; // 获取 SPIR-V 优化级别选项
     
     // 设置当前配置
     void setCurrentCompiler(const QString &compiler);
@@ -39,6 +45,11 @@ public:
     void setOutputType(const QString &type);
     void setExtraOptionsEnabled(bool enabled); // 设置额外选项是否启用
     void setExtraOptions(const QString &options); // 设置额外编译选项
+    void setLineDirectivesEnabled(bool enabled); // 设置是否输出 #line 指令
+    void setLineCostEnabled(bool enabled); // 设置是否生成调试信息并统计每行代价
+    void setLinkedLibrariesEnabled(bool enabled); // 设置是否链接预编译库
+    void setLinkedLibraries(const QStringList &libraries); // 设置预编译库列表
+    void setSpirvOptimizeLevel(const QString &level); // 设置 SPIR-V 优化级别选项
 
 public slots:
     // 响应语言变化
@@ -49,7 +60,9 @@ public slots:
 
 signals:
     void buildClicked(); // 构建按钮点击信号
+    void buildAllStagesClicked(); // 构建所有阶段按钮点击信号
     void compilerChanged(const QString &compiler); // 编译器变化信号
+    void downstreamSettingsChanged(); // 输出类型或 SPIR-V 优化级别变化信号
 
 private:
     // UI 组件
@@ -58,9 +71,19 @@ private:
     QLineEdit *entryPointEdit; // 入口点输入框
     QComboBox *shaderModelCombo; // 着色器模型选择下拉框
     QComboBox *outputTypeCombo; // 输出类型选择下拉框
+    QWidget *spirvOptimizeWidget; // SPIR-V 优化级别容器（仅 GLSLANG/GLSLANGKGVER）
+    QComboBox *spirvOptimizeCombo; // SPIR-V 优化级别下拉框
     QCheckBox *extraOptionsCheckBox; // 额外编译选项复选框
     QLineEdit *extraOptionsEdit; // 额外编译选项输入框
+    QCheckBox *lineDirectivesCheckBox; // 输出 #line 指令复选框（仅 GLSLANGKGVER）
+    QCheckBox *lineCostCheckBox; // 每行代价热度复选框（FXC 除外）
+    QWidget *linkedLibrariesWidget; // 预编译库设置容器（仅 GLSLANGKGVER）
+    QCheckBox *linkedLibrariesCheckBox; // 链接预编译库复选框
+    QLineEdit *linkedLibrariesEdit; // 预编译库列表输入框，逗号分隔
     QPushButton *buildButton; // 构建按钮
+    QPushButton *buildAllStagesButton; // 构建所有阶段按钮（仅 GLSLANGKGVER）
+
+    bool isUpdatingCompilerSettings; // 正在切换编译器并重新填充选项
 
     // 设置 UI 组件
     void setupUI();
@@ -0,0 +1,497 @@
+#include "constantBufferLayout.h"
+#include "shaderReflection.h"
+#include <QRegularExpression>
+#include <algorithm>
+
+namespace {
+
+// 标量/向量/矩阵的形状：vectorCount 个含 components 个分量的向量（矩阵按存储主序展开）
+struct Shape
+{
+    bool valid = false;
+    bool matrix = false;
+    uint32_t scalarBytes = 4;
+    uint32_t components = 1;
+    uint32_t vectorCount = 1;
+};
+
+// 成员在某种规则下的大小及对齐
+struct Layout
+{
+    uint32_t size = 0;
+    uint32_t align = 4;
+    uint32_t dataBytes = 0;
+    bool aggregate = false; // 数组、结构体、矩阵，HLSL 中从新的寄存器开始
+};
+
+uint32_t roundUp(uint32_t value, uint32_t alignment)
+{
+    return alignment > 1 ? (value + alignment - 1) / alignment * alignment : value;
+}
+
+// 标量字节数，cbuffer 中 min16 类型按 32 位存储，未知类型返回 0
+uint32_t scalarBytesOf(const QString &name)
+{
+    if (name == "double" || name == "int64_t" || name == "uint64_t" || name == "int64" || name == "uint64") {
+        return 8;
+    }
+    if (name == "half" || name == "float16_t" || name == "int16_t" || name == "uint16_t") {
+        return 2;
+    }
+    if (name == "float" || name == "int" || name == "uint" || name == "bool" || name == "dword" || name.startsWith("min16")) {
+        return 4;
+    }
+    return 0;
+}
+
+// 从反射的类型名称解析形状，支持 GLSL（vec3、dmat4x3）及 HLSL（float3、half4x4）命名
+Shape parseShape(QString typeName, bool rowMajor)
+{
+    typeName.remove(QRegularExpression("^(row_major|column_major|const)\\s+"));
+
+    Shape shape;
+    QRegularExpressionMatch match = QRegularExpression("^(d|i|u|b|f16|i16|u16|i64|u64)?vec([2-4])$").match(typeName);
+    if (match.hasMatch()) {
+        QString prefix = match.captured(1);
+        shape.valid = true;
+        shape.scalarBytes = (prefix == "d" || prefix == "i64" || prefix == "u64") ? 8 : (prefix.endsWith("16") ? 2 : 4);
+        shape.components = match.captured(2).toUInt();
+        return shape;
+    }
+
+    // GLSL matCxR 为 C 列 R 行
+    match = QRegularExpression("^(d|f16)?mat([2-4])(?:x([2-4]))?$").match(typeName);
+    if (match.hasMatch()) {
+        uint32_t columns = match.captured(2).toUInt();
+        uint32_t rows = match.captured(3).isEmpty() ? columns : match.captured(3).toUInt();
+        shape.valid = true;
+        shape.matrix = true;
+        shape.scalarBytes = match.captured(1) == "d" ? 8 : (match.captured(1) == "f16" ? 2 : 4);
+        shape.vectorCount = rowMajor ? rows : columns;
+        shape.components = rowMajor ? columns : rows;
+        return shape;
+    }
+
+    // HLSL floatRxC 为 R 行 C 列
+    match = QRegularExpression("^([a-z0-9_]*[a-z_])([1-4])x([1-4])$").match(typeName);
+    if (match.hasMatch() && scalarBytesOf(match.captured(1)) > 0) {
+        uint32_t rows = match.captured(2).toUInt();
+        uint32_t columns = match.captured(3).toUInt();
+        shape.valid = true;
+        shape.matrix = true;
+        shape.scalarBytes = scalarBytesOf(match.captured(1));
+        shape.vectorCount = rowMajor ? rows : columns;
+        shape.components = rowMajor ? columns : rows;
+        return shape;
+    }
+
+    match = QRegularExpression("^([a-z0-9_]*[a-z_])([1-4])$").match(typeName);
+    if (match.hasMatch() && scalarBytesOf(match.captured(1)) > 0) {
+        shape.valid = true;
+        shape.scalarBytes = scalarBytesOf(match.captured(1));
+        shape.components = match.captured(2).toUInt();
+        return shape;
+    }
+
+    shape.scalarBytes = scalarBytesOf(typeName);
+    shape.valid = shape.scalarBytes > 0;
+    return shape;
+}
+
+uint32_t vectorAlignment(uint32_t components, uint32_t scalarBytes)
+{
+    return components == 1 ? scalarBytes : (components == 2 ? 2 * scalarBytes : 4 * scalarBytes);
+}
+
+bool isRelaxed(BufferLayoutRules rules)
+{
+    return rules == BufferLayoutRules::Std140Relaxed || rules == BufferLayoutRules::HlslCBuffer;
+}
+
+// 成员的放置偏移：按对齐取整，relaxed/HLSL 中向量不能跨越 16 字节边界
+uint32_t place(uint32_t offset, const Layout &layout, BufferLayoutRules rules)
+{
+    uint32_t placed = roundUp(offset, layout.align);
+    if (isRelaxed(rules) && !layout.aggregate && layout.size > 0 && layout.size <= 16 && placed / 16 != (placed + layout.size - 1) / 16) {
+        placed = roundUp(placed, 16);
+    }
+    return placed;
+}
+
+Layout layoutOf(const ShaderReflectionMember &member, BufferLayoutRules rules);
+
+// 结构体内的成员保持原有顺序
+Layout structLayout(const QVector<ShaderReflectionMember> &members, BufferLayoutRules rules)
+{
+    Layout layout;
+    layout.aggregate = true;
+    uint32_t offset = 0;
+    uint32_t maxAlign = 1;
+    for (const ShaderReflectionMember &member : members) {
+        Layout memberLayout = layoutOf(member, rules);
+        offset = place(offset, memberLayout, rules) + memberLayout.size;
+        maxAlign = qMax(maxAlign, memberLayout.align);
+        layout.dataBytes += memberLayout.dataBytes;
+    }
+
+    switch (rules) {
+    case BufferLayoutRules::Std140:
+    case BufferLayoutRules::Std140Relaxed:
+        layout.align = roundUp(maxAlign, 16);
+        layout.size = roundUp(offset, layout.align);
+        break;
+    case BufferLayoutRules::Std430:
+        layout.align = maxAlign;
+        layout.size = roundUp(offset, layout.align);
+        break;
+    case BufferLayoutRules::HlslCBuffer:
+        layout.align = 16;
+        layout.size = offset;
+        break;
+    }
+    return layout;
+}
+
+Layout layoutOf(const ShaderReflectionMember &member, BufferLayoutRules rules)
+{
+    Layout element;
+    Shape shape = member.members.isEmpty() ? parseShape(member.typeName, member.rowMajor) : Shape();
+    if (!member.members.isEmpty()) {
+        element = structLayout(member.members, rules);
+    } else if (!shape.valid) {
+        // 无法解析的类型按反射的大小处理
+        uint32_t count = 1;
+        for (uint32_t dim : member.arrayDims) {
+            count *= qMax(dim, 1u);
+        }
+        element.size = member.arrayDims.isEmpty() ? member.size : (member.arrayStride ? member.arrayStride : member.size / count);
+        element.align = 16;
+        element.dataBytes = element.size;
+        element.aggregate = true;
+    } else if (shape.matrix) {
+        uint32_t vectorBytes = shape.components * shape.scalarBytes;
+        uint32_t stride = rules == BufferLayoutRules::Std430 ? vectorAlignment(shape.components, shape.scalarBytes) : roundUp(vectorBytes, 16);
+        element.aggregate = true;
+        element.align = rules == BufferLayoutRules::Std430 ? stride : 16;
+        element.size = rules == BufferLayoutRules::HlslCBuffer ? (shape.vectorCount - 1) * stride + vectorBytes : shape.vectorCount * stride;
+        element.dataBytes = shape.vectorCount * vectorBytes;
+    } else {
+        element.size = shape.components * shape.scalarBytes;
+        element.align = isRelaxed(rules) ? shape.scalarBytes : vectorAlignment(shape.components, shape.scalarBytes);
+        element.dataBytes = element.size;
+    }
+
+    if (member.arrayDims.isEmpty()) {
+        return element;
+    }
+
+    // 运行时数组按一个元素计
+    uint32_t count = 1;
+    for (uint32_t dim : member.arrayDims) {
+        count *= qMax(dim, 1u);
+    }
+
+    Layout layout;
+    layout.aggregate = true;
+    layout.dataBytes = element.dataBytes * count;
+    switch (rules) {
+    case BufferLayoutRules::Std140:
+    case BufferLayoutRules::Std140Relaxed: {
+        layout.align = qMax(element.align, 16u);
+        layout.size = roundUp(element.size, layout.align) * count;
+        break;
+    }
+    case BufferLayoutRules::Std430:
+        layout.align = element.align;
+        layout.size = roundUp(element.size, element.align) * count;
+        break;
+    case BufferLayoutRules::HlslCBuffer:
+        // 最后一个元素不补齐到 16 字节
+        layout.align = 16;
+        layout.size = roundUp(element.size, 16) * (count - 1) + element.size;
+        break;
+    }
+    return layout;
+}
+
+uint32_t blockSize(uint32_t end, uint32_t maxAlign, BufferLayoutRules rules)
+{
+    return rules == BufferLayoutRules::Std430 ? roundUp(end, maxAlign) : roundUp(end, 16);
+}
+
+// 按给定顺序排列后块的大小
+uint32_t orderedSize(const QVector<Layout> &layouts, const QVector<int> &order, BufferLayoutRules rules)
+{
+    uint32_t offset = 0;
+    uint32_t maxAlign = 1;
+    for (int index : order) {
+        offset = place(offset, layouts[index], rules) + layouts[index].size;
+        maxAlign = qMax(maxAlign, layouts[index].align);
+    }
+    return blockSize(offset, maxAlign, rules);
+}
+
+// 贪心排列：每次选择在当前偏移处引入填充最少的成员，相同时对齐大、尺寸大的优先；
+// 与按对齐降序排列的结果比较，取较小者
+QVector<int> suggestOrder(const QVector<Layout> &layouts, const QVector<int> &candidates, BufferLayoutRules rules)
+{
+    auto larger = [&](int a, int b) {
+        if (layouts[a].align != layouts[b].align) {
+            return layouts[a].align > layouts[b].align;
+        }
+        return layouts[a].size > layouts[b].size;
+    };
+
+    QVector<int> greedy;
+    QVector<int> remaining = candidates;
+    uint32_t offset = 0;
+    while (!remaining.isEmpty()) {
+        int best = 0;
+        uint32_t bestPadding = UINT32_MAX;
+        for (int i = 0; i < remaining.size(); ++i) {
+            uint32_t padding = place(offset, layouts[remaining[i]], rules) - offset;
+            if (padding < bestPadding || (padding == bestPadding && larger(remaining[i], remaining[best]))) {
+                best = i;
+                bestPadding = padding;
+            }
+        }
+        offset = place(offset, layouts[remaining[best]], rules) + layouts[remaining[best]].size;
+        greedy.append(remaining.takeAt(best));
+    }
+
+    QVector<int> sorted = candidates;
+    std::stable_sort(sorted.begin(), sorted.end(), larger);
+    return orderedSize(layouts, sorted, rules) < orderedSize(layouts, greedy, rules) ? sorted : greedy;
+}
+
+QString memberText(const ShaderReflectionMember &member)
+{
+    QString text = member.typeName;
+    for (uint32_t dim : member.arrayDims) {
+        text += dim ? QString("[%1]").arg(dim) : QString("[]");
+    }
+    return text;
+}
+
+// 合并后的块：各阶段同名同绑定的块取第一个的布局，成员读取标记按阶段取并集
+struct MergedBlock
+{
+    QString name;
+    QString kind;
+    uint32_t set = 0;
+    uint32_t binding = 0;
+    uint32_t size = 0;
+    bool dxil = false;
+    QStringList stages;
+    QVector<ShaderReflectionMember> members;
+};
+
+void mergeBlock(QVector<MergedBlock> &blocks, const MergedBlock &block, const QString &stage)
+{
+    for (MergedBlock &existing : blocks) {
+        if (existing.name == block.name && existing.kind == block.kind && existing.set == block.set && existing.binding == block.binding
+            && existing.members.size() == block.members.size()) {
+            for (int i = 0; i < existing.members.size(); ++i) {
+                existing.members[i].accessed = existing.members[i].accessed || block.members[i].accessed;
+            }
+            if (!stage.isEmpty() && !existing.stages.contains(stage)) {
+                existing.stages << stage;
+            }
+            return;
+        }
+    }
+    blocks.append(block);
+    if (!stage.isEmpty()) {
+        blocks.last().stages << stage;
+    }
+}
+
+BufferLayoutReport analyzeBlock(const MergedBlock &block)
+{
+    BufferLayoutReport report;
+    report.name = block.name;
+    report.kind = block.kind;
+    report.set = block.set;
+    report.binding = block.binding;
+    report.stages = block.stages;
+
+    // 选择与反射偏移一致的规则
+    QVector<BufferLayoutRules> candidates;
+    if (block.dxil) {
+        candidates = { BufferLayoutRules::HlslCBuffer };
+    } else if (block.kind == "Push Constant") {
+        candidates = { BufferLayoutRules::Std430, BufferLayoutRules::Std140Relaxed, BufferLayoutRules::Std140, BufferLayoutRules::HlslCBuffer };
+    } else {
+        candidates = { BufferLayoutRules::Std140, BufferLayoutRules::Std140Relaxed, BufferLayoutRules::HlslCBuffer, BufferLayoutRules::Std430 };
+    }
+    report.rules = candidates.first();
+    for (BufferLayoutRules rules : candidates) {
+        uint32_t offset = 0;
+        bool matched = true;
+        for (const ShaderReflectionMember &member : block.members) {
+            Layout layout = layoutOf(member, rules);
+            offset = place(offset, layout, rules);
+            if (offset != member.absoluteOffset) {
+                matched = false;
+                break;
+            }
+            offset += layout.size;
+        }
+        if (matched) {
+            report.rules = rules;
+            report.rulesMatched = true;
+            break;
+        }
+    }
+
+    QVector<Layout> layouts;
+    QVector<int> allMembers;
+    QVector<int> usedMembers;
+    uint32_t end = 0;
+    for (int i = 0; i < block.members.size(); ++i) {
+        const ShaderReflectionMember &member = block.members[i];
+        Layout layout = layoutOf(member, report.rules);
+        layouts.append(layout);
+        allMembers.append(i);
+        if (member.accessed) {
+            usedMembers.append(i);
+        } else {
+            ++report.unusedMembers;
+            report.unusedBytes += layout.dataBytes;
+        }
+        report.dataBytes += layout.dataBytes;
+        end = qMax(end, member.absoluteOffset + layout.size);
+    }
+    report.size = qMax(block.size, end);
+    report.paddingBytes = report.size > report.dataBytes ? report.size - report.dataBytes : 0;
+
+    for (int i = 0; i < block.members.size(); ++i) {
+        const ShaderReflectionMember &member = block.members[i];
+        BufferLayoutMember item;
+        item.name = member.name;
+        item.typeName = memberText(member);
+        item.offset = member.absoluteOffset;
+        item.dataBytes = layouts[i].dataBytes;
+        uint32_t next = i + 1 < block.members.size() ? block.members[i + 1].absoluteOffset : report.size;
+        item.paddingBytes = next > item.offset + item.dataBytes ? next - item.offset - item.dataBytes : 0;
+        item.accessed = member.accessed;
+        report.members.append(item);
+    }
+
+    QVector<int> order = suggestOrder(layouts, allMembers, report.rules);
+    report.suggestedSize = orderedSize(layouts, order, report.rules);
+    for (int index : order) {
+        report.suggestedOrder << QString("%1 %2").arg(memberText(block.members[index])).arg(block.members[index].name);
+    }
+
+    if (report.unusedMembers > 0) {
+        order = suggestOrder(layouts, usedMembers, report.rules);
+        report.suggestedUsedSize = orderedSize(layouts, order, report.rules);
+        for (int index : order) {
+            report.suggestedUsedOrder << QString("%1 %2").arg(memberText(block.members[index])).arg(block.members[index].name);
+        }
+    }
+    return report;
+}
+
+} // namespace
+
+QString ConstantBufferLayout::rulesName(BufferLayoutRules rules)
+{
+    switch (rules) {
+    case BufferLayoutRules::Std140: return "std140";
+    case BufferLayoutRules::Std140Relaxed: return "std140 (relaxed)";
+    case BufferLayoutRules::Std430: return "std430";
+    case BufferLayoutRules::HlslCBuffer: return "HLSL cbuffer packing";
+    }
+    return QString();
+}
+
+QVector<BufferLayoutReport> ConstantBufferLayout::analyze(const QVector<ShaderReflection> &reflections)
+{
+    QVector<MergedBlock> blocks;
+    for (const ShaderReflection &reflection : reflections) {
+        QString stage = reflection.entryPoints.isEmpty() ? QString() : reflection.entryPoints.first().stage;
+        bool dxil = reflection.binaryType == "DXIL";
+
+        for (const ShaderReflectionBinding &binding : reflection.descriptorBindings) {
+            if ((binding.descriptorType != "Uniform Buffer" && binding.descriptorType != "CBV") || binding.members.isEmpty()) {
+                continue;
+            }
+            MergedBlock block;
+            block.name = binding.name.isEmpty() ? binding.typeName : binding.name;
+            block.kind = binding.descriptorType;
+            block.set = binding.set;
+            block.binding = binding.binding;
+            block.size = binding.blockSize;
+            block.dxil = dxil;
+            block.members = binding.members;
+            if (!binding.accessed) {
+                for (ShaderReflectionMember &member : block.members) {
+                    member.accessed = false;
+                }
+            }
+            mergeBlock(blocks, block, stage);
+        }
+
+        for (const ShaderReflectionPushConstant &pushConstant : reflection.pushConstants) {
+            MergedBlock block;
+            block.name = pushConstant.name.isEmpty() ? pushConstant.typeName : pushConstant.name;
+            block.kind = "Push Constant";
+            block.size = pushConstant.size;
+            block.members = pushConstant.members;
+            mergeBlock(blocks, block, stage);
+        }
+    }
+
+    QVector<BufferLayoutReport> reports;
+    for (const MergedBlock &block : blocks) {
+        reports.append(analyzeBlock(block));
+    }
+    return reports;
+}
+
+QString ConstantBufferLayout::reportText(const QVector<BufferLayoutReport> &reports)
+{
+    if (reports.isEmpty()) {
+        return "No constant buffers, uniform blocks or push constants.\n";
+    }
+
+    QString text;
+    for (const BufferLayoutReport &report : reports) {
+        QString binding = report.kind == "Push Constant" ? report.kind : QString("%1, set %2, binding %3").arg(report.kind).arg(report.set).arg(report.binding);
+        text += QString("== %1 (%2%3) ==\n").arg(report.name).arg(binding)
+            .arg(report.stages.isEmpty() ? QString() : "; " + report.stages.join(", "));
+        text += QString("Layout rules: %1%2\n").arg(rulesName(report.rules))
+            .arg(report.rulesMatched ? QString(", matches reflected offsets") : QString(", offsets differ from the reflected layout"));
+        text += QString("Size %1 bytes: %2 data, %3 padding (%4%)").arg(report.size).arg(report.dataBytes).arg(report.paddingBytes)
+            .arg(report.size ? report.paddingBytes * 100.0 / report.size : 0.0, 0, 'f', 1);
+        if (report.unusedMembers > 0) {
+            text += QString(", %1 bytes in %2 unused members").arg(report.unusedBytes).arg(report.unusedMembers);
+        }
+        text += "\n\n";
+
+        text += QString("  %1 %2 %3  Member\n").arg("Offset", 6).arg("Bytes", 6).arg("Pad", 5);
+        for (const BufferLayoutMember &member : report.members) {
+            text += QString("  %1 %2 %3  %4 %5%6\n").arg(member.offset, 6).arg(member.dataBytes, 6).arg(member.paddingBytes, 5)
+                .arg(member.typeName).arg(member.name).arg(member.accessed ? QString() : QString("  (unused)"));
+        }
+
+        if (report.suggestedSize < report.size) {
+            text += QString("\nSuggested order: %1 bytes (saves %2)\n").arg(report.suggestedSize).arg(report.size - report.suggestedSize);
+            for (const QString &member : report.suggestedOrder) {
+                text += "  " + member + "\n";
+            }
+        } else {
+            text += "\nNo smaller order found.\n";
+        }
+        if (report.unusedMembers > 0 && report.suggestedUsedSize < report.size) {
+            text += QString("Without unused members: %1 bytes (saves %2)\n").arg(report.suggestedUsedSize).arg(report.size - report.suggestedUsedSize);
+            for (const QString &member : report.suggestedUsedOrder) {
+                text += "  " + member + "\n";
+            }
+        }
+        text += "\n";
+    }
+    return text;
+}
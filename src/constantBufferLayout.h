@@ -0,0 +1,65 @@
+#ifndef CONSTANTBUFFERLAYOUT_H
+#define CONSTANTBUFFERLAYOUT_H
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <cstdint>
+
+class ShaderReflection;
+
+// 缓冲区块的布局规则
+enum class BufferLayoutRules
+{
+    Std140, // GLSL uniform block
+    Std140Relaxed, // Vulkan relaxed block layout（DXC 默认的 cbuffer 布局）
+    Std430, // push constant / storage buffer
+    HlslCBuffer // HLSL cbuffer 16 字节寄存器打包（DXIL 及 -fvk-use-dx-layout）
+};
+
+// 块的顶层成员
+struct BufferLayoutMember
+{
+    QString name;
+    QString typeName; // 含数组维度，如 vec4[8]
+    uint32_t offset = 0;
+    uint32_t dataBytes = 0; // 不含填充的数据字节数
+    uint32_t paddingBytes = 0; // 到下一个成员（或块末尾）之前的填充，含数组元素间的填充
+    bool accessed = true; // 是否被任一阶段读取
+};
+
+// 单个 cbuffer / uniform block / push constant 块的布局分析
+struct BufferLayoutReport
+{
+    QString name;
+    QString kind; // Uniform Buffer、CBV、Push Constant
+    uint32_t set = 0;
+    uint32_t binding = 0;
+    QStringList stages;
+    BufferLayoutRules rules = BufferLayoutRules::Std140;
+    bool rulesMatched = false; // 规则计算出的偏移与反射结果一致
+    uint32_t size = 0;
+    uint32_t dataBytes = 0;
+    uint32_t paddingBytes = 0;
+    uint32_t unusedBytes = 0; // 未读取成员的数据字节数
+    int unusedMembers = 0;
+    QVector<BufferLayoutMember> members;
+    QStringList suggestedOrder; // 按建议顺序的成员名称
+    uint32_t suggestedSize = 0;
+    QStringList suggestedUsedOrder; // 去掉未读取成员后的建议顺序
+    uint32_t suggestedUsedSize = 0;
+};
+
+// ConstantBufferLayout 按反射得到的成员偏移分析常量缓冲区的填充浪费及未读取的成员，
+// 并在目标布局规则下给出使块最小的成员顺序。编译所有阶段时按名称及绑定合并各阶段的块。
+class ConstantBufferLayout
+{
+public:
+    static QString rulesName(BufferLayoutRules rules);
+
+    static QVector<BufferLayoutReport> analyze(const QVector<ShaderReflection> &reflections);
+
+    static QString reportText(const QVector<BufferLayoutReport> &reports);
+};
+
+#endif // CONSTANTBUFFERLAYOUT_H
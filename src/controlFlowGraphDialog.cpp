@@ -0,0 +1,270 @@
+#include "controlFlowGraphDialog.h"
+#include <QtWidgets/QVBoxLayout>
+#include <QtWidgets/QHBoxLayout>
+#include <QtWidgets/QSplitter>
+#include <QtWidgets/QPushButton>
+#include <QtWidgets/QDialogButtonBox>
+#include <QtWidgets/QGraphicsRectItem>
+#include <QtWidgets/QGraphicsSimpleTextItem>
+#include <QTextBlock>
+#include <QPainterPath>
+
+namespace {
+
+const double kNodeWidth = 190;
+const double kNodeHeight = 70;
+const double kGapX = 40;
+const double kGapY = 50;
+
+// 边终点处的箭头
+QPolygonF arrowHead(const QPointF &tip, const QPointF &from)
+{
+    QLineF line(tip, from);
+    line.setLength(10);
+    QLineF left = line;
+    left.setAngle(line.angle() + 25);
+    QLineF right = line;
+    right.setAngle(line.angle() - 25);
+    return QPolygonF() << tip << left.p2() << right.p2();
+}
+
+// 代价热度从白色过渡到橙红色
+QColor heatColor(double heat)
+{
+    heat = qBound(0.0, heat, 1.0);
+    return QColor(255, static_cast<int>(255 - 135 * heat), static_cast<int>(255 - 175 * heat));
+}
+
+QString countsText(const ShaderCostCounts &counts)
+{
+    return QString("ALU %1, transcendental %2, sample %3, fetch %4, load %5, store %6, barrier %7, control flow %8")
+        .arg(counts.alu).arg(counts.transcendental).arg(counts.textureSample).arg(counts.textureFetch)
+        .arg(counts.memoryLoad).arg(counts.memoryStore).arg(counts.barrier).arg(counts.controlFlow);
+}
+
+} // namespace
+
+// 构造函数，初始化控制流图对话框。
+ControlFlowGraphDialog::ControlFlowGraphDialog(const QVector<ControlFlowFunction> &functions, QWidget *parent)
+    : QDialog(parent), functions(functions), currentFunction(-1)
+{
+    setWindowTitle(tr("Control Flow Graph"));
+    resize(1200, 800);
+
+    QVBoxLayout *mainLayout = new QVBoxLayout(this);
+
+    QHBoxLayout *topLayout = new QHBoxLayout();
+    topLayout->addWidget(new QLabel(tr("Function"), this));
+    functionCombo = new QComboBox(this);
+    for (const ControlFlowFunction &function : functions) {
+        functionCombo->addItem(function.stage.isEmpty() ? function.name : QString("%1 (%2)").arg(function.name).arg(function.stage));
+    }
+    topLayout->addWidget(functionCombo);
+    summaryLabel = new QLabel(this);
+    topLayout->addWidget(summaryLabel, 1);
+    QPushButton *zoomInButton = new QPushButton(tr("Zoom In"), this);
+    QPushButton *zoomOutButton = new QPushButton(tr("Zoom Out"), this);
+    QPushButton *fitButton = new QPushButton(tr("Fit"), this);
+    topLayout->addWidget(zoomInButton);
+    topLayout->addWidget(zoomOutButton);
+    topLayout->addWidget(fitButton);
+    mainLayout->addLayout(topLayout);
+
+    QSplitter *splitter = new QSplitter(Qt::Horizontal, this);
+    scene = new QGraphicsScene(this);
+    view = new QGraphicsView(scene, splitter);
+    view->setRenderHint(QPainter::Antialiasing);
+    view->setDragMode(QGraphicsView::ScrollHandDrag);
+    splitter->addWidget(view);
+
+    QWidget *detailWidget = new QWidget(splitter);
+    QVBoxLayout *detailLayout = new QVBoxLayout(detailWidget);
+    detailLayout->setContentsMargins(0, 0, 0, 0);
+    blockLabel = new QLabel(tr("Click a block to locate it in the disassembly and the source."), detailWidget);
+    blockLabel->setWordWrap(true);
+    detailLayout->addWidget(blockLabel);
+    disassemblyEdit = new QPlainTextEdit(detailWidget);
+    disassemblyEdit->setReadOnly(true);
+    disassemblyEdit->setLineWrapMode(QPlainTextEdit::NoWrap);
+    disassemblyEdit->setStyleSheet("QPlainTextEdit { font-family: 'Consolas', monospace; }");
+    detailLayout->addWidget(disassemblyEdit);
+    splitter->addWidget(detailWidget);
+    splitter->setStretchFactor(0, 3);
+    splitter->setStretchFactor(1, 2);
+    mainLayout->addWidget(splitter, 1);
+
+    mainLayout->addWidget(new QLabel(tr("Fill: static cost x estimated frequency.  Blue border: loop body.  "
+                                        "Dashed border: divergent branch.  Red: hottest path.  Dashed blue edge: back edge."), this));
+
+    QDialogButtonBox *buttonBox = new QDialogButtonBox(QDialogButtonBox::Close, this);
+    mainLayout->addWidget(buttonBox);
+
+    connect(buttonBox, &QDialogButtonBox::rejected, this, &QDialog::reject);
+    connect(functionCombo, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &ControlFlowGraphDialog::showFunction);
+    connect(scene, &QGraphicsScene::selectionChanged, this, &ControlFlowGraphDialog::onSelectionChanged);
+    connect(zoomInButton, &QPushButton::clicked, this, [this]() { view->scale(1.25, 1.25); });
+    connect(zoomOutButton, &QPushButton::clicked, this, [this]() { view->scale(0.8, 0.8); });
+    connect(fitButton, &QPushButton::clicked, this, &ControlFlowGraphDialog::fitGraph);
+
+    showFunction(functions.isEmpty() ? -1 : 0);
+}
+
+// 按前向边的最长路径分层排列基本块，回边画在块的右侧
+void ControlFlowGraphDialog::showFunction(int index)
+{
+    scene->clear();
+    disassemblyEdit->clear();
+    blockTextLines.clear();
+    currentFunction = index;
+    if (index < 0 || index >= functions.size()) {
+        summaryLabel->setText(tr("No SPIR-V function to show."));
+        return;
+    }
+
+    const ControlFlowFunction &function = functions[index];
+    const int blockCount = function.blocks.size();
+
+    QVector<int> rank(blockCount, 0);
+    for (const ControlFlowEdge &edge : function.edges) {
+        if (!edge.backEdge) {
+            rank[edge.to] = qMax(rank[edge.to], rank[edge.from] + 1);
+        }
+    }
+    QVector<QVector<int>> layers;
+    for (int b = 0; b < blockCount; ++b) {
+        if (rank[b] >= layers.size()) {
+            layers.resize(rank[b] + 1);
+        }
+        layers[rank[b]].append(b);
+    }
+    QVector<QPointF> positions(blockCount);
+    for (int layer = 0; layer < layers.size(); ++layer) {
+        for (int i = 0; i < layers[layer].size(); ++i) {
+            double x = (i - (layers[layer].size() - 1) / 2.0) * (kNodeWidth + kGapX);
+            positions[layers[layer][i]] = QPointF(x, layer * (kNodeHeight + kGapY));
+        }
+    }
+
+    double maxHeat = 0;
+    for (const ControlFlowBlock &block : function.blocks) {
+        maxHeat = qMax(maxHeat, block.cost * block.frequency);
+    }
+
+    // 边
+    int backEdgeCount = 0;
+    for (const ControlFlowEdge &edge : function.edges) {
+        QPen pen(edge.hot ? QColor(200, 0, 0) : (edge.backEdge ? QColor(Qt::blue) : QColor(Qt::darkGray)), edge.hot ? 3 : 1.5);
+        if (edge.backEdge) {
+            pen.setStyle(Qt::DashLine);
+        }
+        QPointF start;
+        QPointF end;
+        QPointF control;
+        QPainterPath path;
+        if (edge.backEdge) {
+            double offset = 30 + 12 * (backEdgeCount++ % 4);
+            start = positions[edge.from] + QPointF(kNodeWidth, kNodeHeight / 2);
+            end = positions[edge.to] + QPointF(kNodeWidth, kNodeHeight / 2);
+            control = end + QPointF(offset, 0);
+            path.moveTo(start);
+            path.cubicTo(start + QPointF(offset, 0), control, end);
+        } else {
+            start = positions[edge.from] + QPointF(kNodeWidth / 2, kNodeHeight);
+            end = positions[edge.to] + QPointF(kNodeWidth / 2, 0);
+            control = start;
+            path.moveTo(start);
+            path.lineTo(end);
+        }
+        scene->addPath(path, pen)->setZValue(edge.hot ? 1 : 0);
+        QPen arrowPen(pen.color(), 1);
+        scene->addPolygon(arrowHead(end, control), arrowPen, QBrush(pen.color()))->setZValue(edge.hot ? 1 : 0);
+    }
+
+    // 块
+    QString disassembly;
+    int textLine = 0;
+    for (int b = 0; b < blockCount; ++b) {
+        const ControlFlowBlock &block = function.blocks[b];
+
+        QPen pen(block.hot ? QColor(200, 0, 0) : (block.loopDepth > 0 ? QColor(Qt::blue) : QColor(Qt::darkGray)), block.hot ? 3 : 1.5);
+        if (block.divergentBranch) {
+            pen.setStyle(Qt::DashLine);
+        }
+        QGraphicsRectItem *node = scene->addRect(0, 0, kNodeWidth, kNodeHeight, pen, QBrush(heatColor(maxHeat > 0 ? block.cost * block.frequency / maxHeat : 0)));
+        node->setPos(positions[b]);
+        node->setZValue(2);
+        node->setData(0, b);
+        node->setFlag(QGraphicsItem::ItemIsSelectable);
+        node->setToolTip(countsText(block.counts));
+
+        QStringList lines;
+        lines << block.label + (block.loopHeader ? tr("  [loop]") : QString()) + (block.divergentBranch ? tr("  [divergent]") : QString());
+        lines << tr("%1 instr, cost %2").arg(block.instructionCount).arg(block.cost, 0, 'f', 1);
+        lines << tr("freq %1").arg(block.frequency, 0, 'g', 3) + (block.loopWeight != 1.0 ? tr(", x%1 per loop").arg(block.loopWeight) : QString());
+        if (block.sourceLine > 0) {
+            lines << tr("line %1").arg(block.sourceLine);
+        }
+        QGraphicsSimpleTextItem *text = new QGraphicsSimpleTextItem(lines.join("\n"), node);
+        text->setPos(6, 4);
+
+        blockTextLines.append(textLine);
+        disassembly += QString("; %1  cost %2, freq %3%4\n").arg(block.label).arg(block.cost, 0, 'f', 1).arg(block.frequency, 0, 'g', 3)
+            .arg(block.sourceLine > 0 ? QString(", line %1").arg(block.sourceLine) : QString());
+        for (const QString &instruction : block.disassembly) {
+            disassembly += "    " + instruction + "\n";
+        }
+        disassembly += "\n";
+        textLine += block.disassembly.size() + 2;
+    }
+    disassemblyEdit->setPlainText(disassembly);
+
+    int hotBlocks = 0;
+    for (const ControlFlowBlock &block : function.blocks) {
+        hotBlocks += block.hot ? 1 : 0;
+    }
+    summaryLabel->setText(tr("%1 blocks, %2 loops, %3 divergent branches, hottest path cost %4 over %5 blocks")
+                              .arg(blockCount).arg(function.loopCount).arg(function.divergentBranchCount)
+                              .arg(function.hotPathCost, 0, 'f', 1).arg(hotBlocks));
+    fitGraph();
+}
+
+void ControlFlowGraphDialog::fitGraph()
+{
+    QRectF bounds = scene->itemsBoundingRect().adjusted(-20, -20, 20, 20);
+    scene->setSceneRect(bounds);
+
+    // 块较多时不缩得过小，保持文字可读
+    view->resetTransform();
+    double scale = qMin(view->viewport()->width() / bounds.width(), view->viewport()->height() / bounds.height());
+    scale = qBound(0.4, scale, 1.0);
+    view->scale(scale, scale);
+    view->centerOn(bounds.center().x(), bounds.top());
+}
+
+// 在反汇编中选中点击的块，并请求跳转到源代码行
+void ControlFlowGraphDialog::onSelectionChanged()
+{
+    QList<QGraphicsItem *> items = scene->selectedItems();
+    if (items.isEmpty() || currentFunction < 0) {
+        return;
+    }
+    int b = items.first()->data(0).toInt();
+    if (b < 0 || b >= blockTextLines.size()) {
+        return;
+    }
+    const ControlFlowBlock &block = functions[currentFunction].blocks[b];
+
+    QTextDocument *document = disassemblyEdit->document();
+    QTextCursor cursor(document->findBlockByNumber(blockTextLines[b]));
+    QTextBlock last = document->findBlockByNumber(blockTextLines[b] + block.disassembly.size());
+    cursor.setPosition(last.position() + last.length() - 1, QTextCursor::KeepAnchor);
+    disassemblyEdit->setTextCursor(cursor);
+    disassemblyEdit->centerCursor();
+
+    blockLabel->setText(tr("%1: %2 instructions, cost %3, loop depth %4, %5")
+                            .arg(block.label).arg(block.instructionCount).arg(block.cost, 0, 'f', 1).arg(block.loopDepth)
+                            .arg(block.sourceLine > 0 ? tr("line %1").arg(block.sourceLine) : tr("no debug line")));
+    if (block.sourceLine > 0) {
+        emit sourceLineRequested(block.sourceLine);
+    }
+}
@@ -0,0 +1,43 @@
+#ifndef CONTROLFLOWGRAPHDIALOG_H
+#define CONTROLFLOWGRAPHDIALOG_H
+
+#include <QtWidgets/QDialog>
+#include <QtWidgets/QComboBox>
+#include <QtWidgets/QLabel>
+#include <QtWidgets/QGraphicsScene>
+#include <QtWidgets/QGraphicsView>
+#include <QtWidgets/QPlainTextEdit>
+#include "spirvControlFlowGraph.h"
+
+// ControlFlowGraphDialog 显示各函数的控制流图：块按静态代价着色，标出循环、条件不一致的分支及最热路径，
+// 点击块时在反汇编中定位该块，有调试信息时请求跳转到源代码行。
+class ControlFlowGraphDialog : public QDialog
+{
+    Q_OBJECT
+
+public:
+    ControlFlowGraphDialog(const QVector<ControlFlowFunction> &functions, QWidget *parent = nullptr);
+
+signals:
+    // 点击的块映射到的主源文件行号（从 1 开始）
+    void sourceLineRequested(int line);
+
+private slots:
+    void showFunction(int index);
+    void onSelectionChanged();
+    void fitGraph();
+
+private:
+    QVector<ControlFlowFunction> functions;
+    int currentFunction;
+    QVector<int> blockTextLines; // 当前函数各块在反汇编中的起始行
+
+    QComboBox *functionCombo;
+    QLabel *summaryLabel;
+    QGraphicsScene *scene;
+    QGraphicsView *view;
+    QLabel *blockLabel;
+    QPlainTextEdit *disassemblyEdit;
+};
+
+#endif // CONTROLFLOWGRAPHDIALOG_H
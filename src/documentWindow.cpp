@@ -13,8 +13,20 @@
 #include "dxcCompiler.h"
 #include "glslangCompiler.h"
 #include "glslangkgverCompiler.h"
+#include "spirvModule.h"
+#include "shaderAutotuneDialog.h"
+#include "spirvPassPipelineDialog.h"
+#include "shaderModelCompareDialog.h"
+#include "shaderFrontendCompareDialog.h"
+#include "specConstantVariantDialog.h"
+#include "spirvRegisterPressure.h"
+#include "spirvHalfPrecision.h"
+#include "constantBufferLayout.h"
+#include "controlFlowGraphDialog.h"
 #include <QDialogButtonBox>
 #include <QDateTime>
+#include <QElapsedTimer>
+#include <QRegularExpression>
 
 DocumentWindow::DocumentWindow(QWidget *parent, const QString &documentTitle)
     : QMainWindow(parent)
@@ -22,6 +34,8 @@ DocumentWindow::DocumentWindow(QWidget *parent, const QString &documentTitle)
     , lastHLSLCompiler("DXC")
     , lastGLSLCompiler("GLSLANG")
     , lastOpenDir(QDir::currentPath())
+    , glslkgverCodePrebuilder(QStringList())
+    , lastBuildAllStages(false)
     , isSaveSettings(true)
     , isIncludeGroupVisible(true)
     , isMacroGroupVisible(true)
@@ -38,6 +52,8 @@ DocumentWindow::DocumentWindow(QWidget *parent, const QString &documentTitle, co
     , lastHLSLCompiler("DXC")
     , lastGLSLCompiler("GLSLANG")
     , lastOpenDir(QDir::currentPath())
+    , glslkgverCodePrebuilder(QStringList())
+    , lastBuildAllStages(false)
     , isSaveSettings(true)
     , isIncludeGroupVisible(true)
     , isMacroGroupVisible(true)
@@ -229,10 +245,64 @@ void DocumentWindow::setupUI()
     QGroupBox *outputGroup = new QGroupBox(tr("Output"), this);
     QVBoxLayout *outputLayout = new QVBoxLayout(outputGroup);
     
-    // 编译输出
+    // 编译输出及分析面板
+    outputTabs = new QTabWidget(this);
     outputEdit = new QTextEdit(this);
     outputEdit->setReadOnly(true);
-    outputLayout->addWidget(outputEdit);
+    outputTabs->addTab(outputEdit, tr("Output"));
+
+    // 反射数据面板
+    reflectionPanel = new ShaderReflectionPanel(this);
+    outputTabs->addTab(reflectionPanel, tr("Reflection"));
+
+    // 静态代价面板
+    costPanel = new ShaderCostPanel(this);
+    outputTabs->addTab(costPanel, tr("Cost"));
+
+    // 基线对比面板
+    baselineEdit = new QTextEdit(this);
+    baselineEdit->setReadOnly(true);
+    baselineEdit->setLineWrapMode(QTextEdit::NoWrap);
+    baselineEdit->setStyleSheet("QTextEdit { font-family: 'Consolas', monospace; }");
+    baselineEdit->setPlaceholderText(tr("Pin a compile result as baseline (BUILD > Pin Baseline) to compare later builds against it."));
+    outputTabs->addTab(baselineEdit, tr("Baseline"));
+
+    // 计算着色器占用率面板
+    occupancyEdit = new QTextEdit(this);
+    occupancyEdit->setReadOnly(true);
+    occupancyEdit->setLineWrapMode(QTextEdit::NoWrap);
+    occupancyEdit->setStyleSheet("QTextEdit { font-family: 'Consolas', monospace; }");
+    occupancyEdit->setPlaceholderText(tr("Compile a compute, mesh or task shader to estimate its occupancy (BUILD > GPU Profiles to edit the GPUs)."));
+    outputTabs->addTab(occupancyEdit, tr("Occupancy"));
+
+    pressureEdit = new QTextEdit(this);
+    pressureEdit->setReadOnly(true);
+    pressureEdit->setLineWrapMode(QTextEdit::NoWrap);
+    pressureEdit->setStyleSheet("QTextEdit { font-family: 'Consolas', monospace; }");
+    pressureEdit->setPlaceholderText(tr("Compile to SPIR-V to estimate register pressure (emit line directives or debug info to locate source lines)."));
+    outputTabs->addTab(pressureEdit, tr("Pressure"));
+
+    halfPrecisionEdit = new QTextEdit(this);
+    halfPrecisionEdit->setReadOnly(true);
+    halfPrecisionEdit->setLineWrapMode(QTextEdit::NoWrap);
+    halfPrecisionEdit->setStyleSheet("QTextEdit { font-family: 'Consolas', monospace; }");
+    halfPrecisionEdit->setPlaceholderText(tr("Compile to SPIR-V to find arithmetic that could run at 16-bit precision."));
+    outputTabs->addTab(halfPrecisionEdit, tr("FP16"));
+
+    bufferLayoutEdit = new QTextEdit(this);
+    bufferLayoutEdit->setReadOnly(true);
+    bufferLayoutEdit->setLineWrapMode(QTextEdit::NoWrap);
+    bufferLayoutEdit->setStyleSheet("QTextEdit { font-family: 'Consolas', monospace; }");
+    bufferLayoutEdit->setPlaceholderText(tr("Compile to analyze constant buffer padding and unused members."));
+    outputTabs->addTab(bufferLayoutEdit, tr("Layout"));
+
+    textureAccessEdit = new QTextEdit(this);
+    textureAccessEdit->setReadOnly(true);
+    textureAccessEdit->setLineWrapMode(QTextEdit::NoWrap);
+    textureAccessEdit->setStyleSheet("QTextEdit { font-family: 'Consolas', monospace; }");
+    textureAccessEdit->setPlaceholderText(tr("Compile to list texture and storage buffer accesses, dependent reads and divergent sampling."));
+    outputTabs->addTab(textureAccessEdit, tr("Textures"));
+    outputLayout->addWidget(outputTabs);
     
     // 日志面板
     QHBoxLayout *logPanelLayout = new QHBoxLayout();
@@ -270,6 +340,11 @@ void DocumentWindow::setupConnections()
     connect(compilerSettingUI, &CompilerSettingUI::compilerChanged, 
             this, &DocumentWindow::updateCurrentCompilerSettings);
 
+    // 分析面板切换到前台时才分析最近一次编译结果
+    connect(outputTabs, &QTabWidget::currentChanged, this, [this]() {
+        updateCurrentAnalysisView();
+    });
+
     // 文件浏览按钮连接
     connect(encodingCombo, &QComboBox::currentTextChanged, [this]() {
             QString encoding = encodingCombo->currentText();
@@ -326,6 +401,8 @@ void DocumentWindow::setupConnections()
 
     // 连接编译按钮信号
     connect(compilerSettingUI, &CompilerSettingUI::buildClicked, this, &DocumentWindow::compile);
+    connect(compilerSettingUI, &CompilerSettingUI::buildAllStagesClicked, this, &DocumentWindow::compileAllStages);
+    connect(compilerSettingUI, &CompilerSettingUI::downstreamSettingsChanged, this, &DocumentWindow::onDownstreamSettingsChanged);
 }
 
 void DocumentWindow::compile()
@@ -335,6 +412,7 @@ void DocumentWindow::compile()
     QString shaderModel = compilerSettingUI->getShaderModel();
     QString entryPoint = compilerSettingUI->getEntryPoint();
     QString outputType = compilerSettingUI->getOutputType();
+    recordBuildSettings(compiler, false);
 
     // 获取额外编译选项
     QString additionOptions = "";
@@ -342,6 +420,11 @@ void DocumentWindow::compile()
         additionOptions = compilerSettingUI->getExtraOptions();
     }
 
+    // 统计每行代价需要调试信息
+    if (compilerSettingUI->isLineCostEnabled()) {
+        additionOptions = (additionOptions + " " + lineCostDebugOptions(compiler, outputType)).trimmed();
+    }
+
     // 获取包含路径和宏定义
     QStringList includePaths;
     for (int i = 0; i < includePathList->count(); ++i) {
@@ -355,6 +438,17 @@ void DocumentWindow::compile()
 
     outputEdit->clear();
     logEdit->clear();
+    lastReflections.clear();
+    reflectionPanel->clear();
+    lastCostReports.clear();
+    costPanel->clear();
+    inputEdit->clearLineCosts();
+    lastBinaries.clear();
+    lastBinaryTypes.clear();
+    lastDisassemblies.clear();
+
+    QElapsedTimer compileTimer;
+    compileTimer.start();
 
     // 根据选择的编译器创建相应的实例
     if (compiler == "FXC") {
@@ -407,6 +501,14 @@ void DocumentWindow::compile()
             outputEdit->append(tr("Compilation warning:\n") + warning);
         });
 
+        connect(dxcCompilerInstance, &dxcCompiler::reflectionGenerated, this, [this](const ShaderReflection &reflection) {
+            lastReflections.append(reflection);
+            reflectionPanel->addReflection(reflection);
+        });
+
+        connect(dxcCompilerInstance, &dxcCompiler::binaryGenerated, this, &DocumentWindow::onBinaryGenerated);
+
+        dxcCompilerInstance->setIntermediateCache(&intermediateCache);
         dxcCompilerInstance->compile(inputEdit->toPlainText(), languageCombo->currentText(), shaderModel, entryPoint, shaderType, outputType, includePaths, macros, additionOptions);
         dxcCompilerInstance->deleteLater();
     } else if (compiler == "GLSLANG") {
@@ -433,6 +535,15 @@ void DocumentWindow::compile()
             outputEdit->append(tr("Compilation warning:\n") + warning);
         });
 
+        connect(glslangCompilerInstance, &glslangCompiler::reflectionGenerated, this, [this](const ShaderReflection &reflection) {
+            lastReflections.append(reflection);
+            reflectionPanel->addReflection(reflection);
+        });
+
+        connect(glslangCompilerInstance, &glslangCompiler::binaryGenerated, this, &DocumentWindow::onBinaryGenerated);
+
+        glslangCompilerInstance->setIntermediateCache(&intermediateCache);
+        glslangCompilerInstance->setSpirvOptimizeOptions(compilerSettingUI->getSpirvOptimizeOptions());
         glslangCompilerInstance->compile(inputEdit->toPlainText(), languageCombo->currentText(), shaderModel, entryPoint, shaderType, outputType, includePaths, macros, additionOptions);
         glslangCompilerInstance->deleteLater();
     } else if (compiler == "GLSLANGKGVER") {
@@ -459,9 +570,697 @@ void DocumentWindow::compile()
             outputEdit->append(tr("Compilation warning:\n") + warning);
         });
 
+        connect(glslangkgverCompilerInstance, &glslangkgverCompiler::reflectionGenerated, this, [this](const ShaderReflection &reflection) {
+            lastReflections.append(reflection);
+            reflectionPanel->addReflection(reflection);
+        });
+
+        connect(glslangkgverCompilerInstance, &glslangkgverCompiler::binaryGenerated, this, &DocumentWindow::onBinaryGenerated);
+
+        glslangkgverCompilerInstance->setEmitLineDirectives(compilerSettingUI->isLineDirectivesEnabled());
+        glslangkgverCompilerInstance->setCodePrebuilder(&glslkgverCodePrebuilder);
+        glslangkgverCompilerInstance->setLinkedLibraries(compilerSettingUI->isLinkedLibrariesEnabled() ? compilerSettingUI->getLinkedLibraries() : QStringList());
+        glslangkgverCompilerInstance->setIntermediateCache(&intermediateCache);
+        glslangkgverCompilerInstance->setSpirvOptimizeOptions(compilerSettingUI->getSpirvOptimizeOptions());
         glslangkgverCompilerInstance->compile(inputEdit->toPlainText(), shaderModel, entryPoint, shaderType, outputType, includePaths, macros, additionOptions);
         glslangkgverCompilerInstance->deleteLater();
     }
+
+    updateBuildSnapshot(compiler, outputType, compileTimer.nsecsElapsed() / 1e9);
+    invalidateAnalysisViews();
+}
+
+// 同时编译 glslkgver 文件中的所有阶段代码块
+void DocumentWindow::compileAllStages()
+{
+    if (compilerSettingUI->getCurrentCompiler() != "GLSLANGKGVER") {
+        QMessageBox::information(this, tr("Compile All Stages"), tr("Compile All Stages is only available for the GLSLANGKGVER compiler."));
+        return;
+    }
+
+    QString shaderModel = compilerSettingUI->getShaderModel();
+    QString outputType = compilerSettingUI->getOutputType();
+    recordBuildSettings("GLSLANGKGVER", true);
+
+    // 获取额外编译选项
+    QString additionOptions = "";
+    if (compilerSettingUI->isExtraOptionsEnabled()) {
+        additionOptions = compilerSettingUI->getExtraOptions();
+    }
+
+    if (compilerSettingUI->isLineCostEnabled()) {
+        additionOptions = (additionOptions + " " + lineCostDebugOptions("GLSLANGKGVER", outputType)).trimmed();
+    }
+
+    // 获取包含路径和宏定义
+    QStringList includePaths;
+    for (int i = 0; i < includePathList->count(); ++i) {
+        includePaths << includePathList->item(i)->text();
+    }
+
+    QStringList macros;
+    for (int i = 0; i < macroList->count(); ++i) {
+        macros << macroList->item(i)->text();
+    }
+
+    outputEdit->clear();
+    logEdit->clear();
+    lastReflections.clear();
+    reflectionPanel->clear();
+    lastCostReports.clear();
+    costPanel->clear();
+    inputEdit->clearLineCosts();
+    lastBinaries.clear();
+    lastBinaryTypes.clear();
+    lastDisassemblies.clear();
+
+    QElapsedTimer compileTimer;
+    compileTimer.start();
+
+    glslangkgverCompiler *glslangkgverCompilerInstance = new glslangkgverCompiler(this);
+
+    connect(glslangkgverCompilerInstance, &glslangkgverCompiler::compilationFinished, this, [this](const QString &output) {
+        outputEdit->setTextColor(Qt::green);
+        outputEdit->append(output);
+        QString currentTime = QDateTime::currentDateTime().toString("yyyyMMdd-HH-mm-ss");
+        logEdit->setTextColor(Qt::green);
+        logEdit->append(currentTime + ": Compilation succeeded");
+    });
+
+    connect(glslangkgverCompilerInstance, &glslangkgverCompiler::compilationError, this, [this](const QString &error) {
+        outputEdit->setTextColor(Qt::red);
+        outputEdit->append(tr("Compilation error:\n") + error);
+        QString currentTime = QDateTime::currentDateTime().toString("yyyyMMdd-HH-mm-ss");
+        logEdit->setTextColor(Qt::red);
+        logEdit->append(currentTime + ": Compilation failed");
+    });
+
+    connect(glslangkgverCompilerInstance, &glslangkgverCompiler::compilationWarning, this, [this](const QString &warning) {
+        outputEdit->setTextColor(Qt::yellow);
+        outputEdit->append(tr("Compilation warning:\n") + warning);
+    });
+
+    connect(glslangkgverCompilerInstance, &glslangkgverCompiler::reflectionGenerated, this, [this](const ShaderReflection &reflection) {
+        lastReflections.append(reflection);
+        reflectionPanel->addReflection(reflection);
+    });
+
+    connect(glslangkgverCompilerInstance, &glslangkgverCompiler::binaryGenerated, this, &DocumentWindow::onBinaryGenerated);
+
+    glslangkgverCompilerInstance->setEmitLineDirectives(compilerSettingUI->isLineDirectivesEnabled());
+    glslangkgverCompilerInstance->setCodePrebuilder(&glslkgverCodePrebuilder);
+    glslangkgverCompilerInstance->setLinkedLibraries(compilerSettingUI->isLinkedLibrariesEnabled() ? compilerSettingUI->getLinkedLibraries() : QStringList());
+    glslangkgverCompilerInstance->setIntermediateCache(&intermediateCache);
+    glslangkgverCompilerInstance->setSpirvOptimizeOptions(compilerSettingUI->getSpirvOptimizeOptions());
+    glslangkgverCompilerInstance->compileAllStages(inputEdit->toPlainText(), shaderModel, outputType, includePaths, macros, additionOptions);
+    glslangkgverCompilerInstance->deleteLater();
+
+    updateBuildSnapshot("GLSLANGKGVER", outputType, compileTimer.nsecsElapsed() / 1e9);
+    invalidateAnalysisViews();
+}
+
+// 对编译产物进行静态代价分析，SPIR-V 直接索引二进制，DXIL 解析 -dumpbin 反汇编文本
+void DocumentWindow::onBinaryGenerated(const QByteArray &binary, const QString &binaryType, const QString &disassembly)
+{
+    // glslkgver 展开后的行号与编辑器不一致，只有输出 #line 指令时才能映射回编辑器中的行
+    bool isGlslKgver = compilerSettingUI->getCurrentCompiler() == "GLSLANGKGVER";
+    bool mapLineCosts = compilerSettingUI->isLineCostEnabled() && (!isGlslKgver || compilerSettingUI->isLineDirectivesEnabled());
+
+    ShaderCostReport report;
+    if (binaryType == "SPIR-V") {
+        SpirvModule module;
+        if (!module.parse(binary)) {
+            return;
+        }
+        report = ShaderCostAnalyzer::analyzeSpirv(module, isGlslKgver ? QString("textEditor") : QString());
+    } else if (binaryType == "DXIL") {
+        report = ShaderCostAnalyzer::analyzeDxilDisassembly(disassembly);
+    }
+
+    // 其余分析在对应面板可见时进行，见 updateCurrentAnalysisView
+    lastBinaries.append(binary);
+    lastBinaryTypes.append(binaryType);
+    lastDisassemblies.append(disassembly);
+    if (report.isEmpty()) {
+        return;
+    }
+    lastCostReports.append(report);
+    costPanel->addReport(report);
+
+    // 编译所有阶段时合并各阶段的行代价
+    if (mapLineCosts) {
+        QMap<int, ShaderLineCost> lineCosts;
+        for (const ShaderCostReport &costReport : lastCostReports) {
+            for (auto it = costReport.lineCosts.constBegin(); it != costReport.lineCosts.constEnd(); ++it) {
+                lineCosts[it.key()].staticCounts.add(it.value().staticCounts);
+                lineCosts[it.key()].weightedCounts.add(it.value().weightedCounts);
+            }
+        }
+        inputEdit->setLineCosts(lineCosts);
+    }
+}
+
+// 记录本次编译的快照，已固定基线时更新对比结果
+void DocumentWindow::updateBuildSnapshot(const QString &compiler, const QString &outputType, double compileSeconds)
+{
+    lastSnapshot = ShaderBuildSnapshot::capture(compiler, outputType, outputEdit->toPlainText(), lastBinaries, lastCostReports, compileSeconds);
+    updateBaselineView();
+}
+
+// 将最近一次编译结果固定为基线，之后每次编译都与其比较
+void DocumentWindow::pinBaseline()
+{
+    if (!lastSnapshot.isValid()) {
+        QMessageBox::information(this, tr("Pin Baseline"), tr("No compile result, compile the shader first."));
+        return;
+    }
+
+    baselineSnapshot = lastSnapshot;
+    updateBaselineView();
+    outputTabs->setCurrentWidget(baselineEdit);
+}
+
+void DocumentWindow::clearBaseline()
+{
+    baselineSnapshot = ShaderBuildSnapshot();
+    updateBaselineView();
+}
+
+// 用一组优化配方并行编译当前着色器，按静态代价排序，保存选中的配方到文档设置
+void DocumentWindow::autotune()
+{
+    QString compiler = compilerSettingUI->getCurrentCompiler();
+    if (compiler != "DXC" && compiler != "GLSLANG" && compiler != "GLSLANGKGVER") {
+        QMessageBox::information(this, tr("Autotune"), tr("Autotune is only available for the DXC, GLSLANG and GLSLANGKGVER compilers."));
+        return;
+    }
+
+    ShaderAutotuneRequest request = currentCompileRequest();
+    ShaderAutotuneDialog dialog(request, autotuneRecipes, this);
+    bool accepted = dialog.exec() == QDialog::Accepted;
+    autotuneRecipes = dialog.recipesText();
+    if (!accepted) {
+        return;
+    }
+
+    // 配方选项替换用户原有选项中的同类选项
+    ShaderAutotuneRecipe recipe = dialog.selectedRecipe();
+    QString options = ShaderAutotuner::combinedOptions(request.baseOptions, recipe.compilerOptions);
+    compilerSettingUI->setExtraOptionsEnabled(!options.isEmpty());
+    compilerSettingUI->setExtraOptions(options);
+    if (compiler != "DXC") {
+        compilerSettingUI->setSpirvOptimizeLevel(recipe.spirvOptimizeOptions.isEmpty() ? QString("None") : recipe.spirvOptimizeOptions);
+    }
+
+    QString currentTime = QDateTime::currentDateTime().toString("yyyyMMdd-HH-mm-ss");
+    logEdit->setTextColor(Qt::green);
+    logEdit->append(currentTime + ": Autotune saved recipe \"" + recipe.name + "\"");
+}
+
+// 以当前文档的编译设置生成编译请求，供自动调优及对比编译使用
+ShaderAutotuneRequest DocumentWindow::currentCompileRequest()
+{
+    ShaderAutotuneRequest request;
+    request.compiler = compilerSettingUI->getCurrentCompiler();
+    request.shaderCode = inputEdit->toPlainText();
+    request.languageType = languageCombo->currentText();
+    request.shaderModel = compilerSettingUI->getShaderModel();
+    request.entryPoint = compilerSettingUI->getEntryPoint();
+    request.shaderType = compilerSettingUI->getShaderType();
+    request.outputType = compilerSettingUI->getOutputType();
+    for (int i = 0; i < includePathList->count(); ++i) {
+        request.includePaths << includePathList->item(i)->text();
+    }
+    for (int i = 0; i < macroList->count(); ++i) {
+        request.macros << macroList->item(i)->text();
+    }
+    if (compilerSettingUI->isExtraOptionsEnabled()) {
+        request.baseOptions = compilerSettingUI->getExtraOptions();
+    }
+    request.emitLineDirectives = compilerSettingUI->isLineDirectivesEnabled();
+    request.linkedLibraries = compilerSettingUI->isLinkedLibrariesEnabled() ? compilerSettingUI->getLinkedLibraries() : QStringList();
+    request.intermediateCache = &intermediateCache;
+    return request;
+}
+
+// 以多个 Shader Model 并行编译当前 HLSL，比较指令数、大小、耗时及所需硬件特性
+void DocumentWindow::compareShaderModels()
+{
+    if (compilerSettingUI->getCurrentCompiler() != "DXC") {
+        QMessageBox::information(this, tr("Compare Shader Models"), tr("Compare Shader Models is only available for the DXC compiler."));
+        return;
+    }
+
+    ShaderAutotuneRequest request = currentCompileRequest();
+    QStringList shaderModels = CompilerConfig::instance().getCapability("DXC").supportedShaderModels;
+    ShaderModelCompareDialog dialog(request, shaderModels, compareShaderModelList, this);
+    dialog.exec();
+    compareShaderModelList = dialog.selectedModels();
+}
+
+// 将当前 HLSL 同时交给 DXC 和 glslang 编译为 SPIR-V 并对比，也可批量对比一个目录
+void DocumentWindow::compareFrontends()
+{
+    if (!languageCombo->currentText().startsWith("HLSL")) {
+        QMessageBox::information(this, tr("Compare DXC / GLSLANG"), tr("Compare DXC / GLSLANG is only available for HLSL."));
+        return;
+    }
+
+    ShaderAutotuneRequest request = currentCompileRequest();
+    ShaderAutotuneRequest dxcRequest = ShaderFrontendCompare::frontendRequest(request, "DXC");
+    ShaderAutotuneRequest glslangRequest = ShaderFrontendCompare::frontendRequest(request, "GLSLANG");
+    QString glslangOptimizeOptions = request.compiler == "GLSLANG" ? compilerSettingUI->getSpirvOptimizeOptions() : QString("-O");
+    QString sourceName = getFilePath().isEmpty() ? documentWindowTitle : QFileInfo(getFilePath()).fileName();
+
+    ShaderFrontendCompareDialog dialog(dxcRequest, glslangRequest, glslangOptimizeOptions, sourceName, lastOpenDir, this);
+    dialog.exec();
+    lastOpenDir = dialog.lastDirectory();
+}
+
+// 编辑自定义 spirv-opt pass 序列，在未优化的 SPIR-V 上逐个执行，确认后作为当前编译器的优化设置
+void DocumentWindow::editPassPipeline()
+{
+    QString compiler = compilerSettingUI->getCurrentCompiler();
+    QString outputType = compilerSettingUI->getOutputType();
+    bool isDxcSpirv = compiler == "DXC" && (outputType == "SPIR-V" || outputType == "GLSL");
+    if (!isDxcSpirv && compiler != "GLSLANG" && compiler != "GLSLANGKGVER") {
+        QMessageBox::information(this, tr("Pass Pipeline"), tr("The pass pipeline is only available for SPIR-V output (DXC, GLSLANG and GLSLANGKGVER)."));
+        return;
+    }
+
+    QByteArray module;
+    QString error;
+    if (!compileUnoptimizedSpirv(module, error)) {
+        QString currentTime = QDateTime::currentDateTime().toString("yyyyMMdd-HH-mm-ss");
+        logEdit->setTextColor(Qt::red);
+        logEdit->append(currentTime + ": Pass pipeline: " + (error.isEmpty() ? QString("compilation failed") : error));
+        return;
+    }
+
+    SpirvPassPipelineDialog dialog(module, spirvPassPipeline, this);
+    bool accepted = dialog.exec() == QDialog::Accepted;
+    spirvPassPipeline = dialog.pipeline();
+    if (!accepted) {
+        return;
+    }
+
+    if (compiler == "DXC") {
+        // DXC 通过 -Oconfig= 指定 pass 序列，替换已有的设置
+        QString options = compilerSettingUI->isExtraOptionsEnabled() ? compilerSettingUI->getExtraOptions() : QString();
+        options.remove(QRegularExpression("(^|\\s)-Oconfig=\\S*"));
+        options = (options + " " + SpirvPassPipeline::toDxcOptimizeConfig(spirvPassPipeline)).trimmed();
+        compilerSettingUI->setExtraOptionsEnabled(!options.isEmpty());
+        compilerSettingUI->setExtraOptions(options);
+    } else {
+        compilerSettingUI->setSpirvOptimizeLevel(spirvPassPipeline.isEmpty() ? QString("None") : SpirvPassPipeline::toSpirvOptOptions(spirvPassPipeline));
+    }
+}
+
+// 前端只编译一次，对 SPIR-V 中的特化常量逐个取值特化，作为宏排列组合的低成本替代
+void DocumentWindow::specConstantVariants()
+{
+    QString compiler = compilerSettingUI->getCurrentCompiler();
+    QString outputType = compilerSettingUI->getOutputType();
+    bool isDxcSpirv = compiler == "DXC" && (outputType == "SPIR-V" || outputType == "GLSL");
+    if (!isDxcSpirv && compiler != "GLSLANG" && compiler != "GLSLANGKGVER") {
+        QMessageBox::information(this, tr("Spec Constant Variants"), tr("Spec constant variants are only available for SPIR-V output (DXC, GLSLANG and GLSLANGKGVER)."));
+        return;
+    }
+
+    QByteArray binary;
+    QString error;
+    QElapsedTimer timer;
+    timer.start();
+    bool compiled = compileUnoptimizedSpirv(binary, error);
+    double frontEndSeconds = timer.nsecsElapsed() / 1e9;
+
+    SpirvModule module;
+    if (!compiled || !module.parse(binary)) {
+        QString currentTime = QDateTime::currentDateTime().toString("yyyyMMdd-HH-mm-ss");
+        logEdit->setTextColor(Qt::red);
+        logEdit->append(currentTime + ": Spec constant variants: " + (error.isEmpty() ? QString("compilation failed") : error));
+        return;
+    }
+
+    QVector<MacroAxisAnalysis> macroAnalysis = SpecConstantVariants::analyzeMacros(inputEdit->toPlainText(), currentCompileRequest().macros);
+    SpecConstantVariantDialog dialog(binary, SpecConstantVariants::axes(module), frontEndSeconds, macroAnalysis, specConstantValues, this);
+    dialog.exec();
+    specConstantValues = dialog.axisValues();
+}
+
+// 以最近一次编译的 SPIR-V 建立各函数的控制流图，没有 SPIR-V 产物时以当前设置重新编译
+void DocumentWindow::showControlFlowGraph()
+{
+    // glslkgver 展开后的行号只有输出 #line 指令时才能映射回编辑器中的行
+    bool isGlslKgver = compilerSettingUI->getCurrentCompiler() == "GLSLANGKGVER";
+    QString sourceFile = isGlslKgver ? QString("textEditor") : QString();
+
+    QVector<ControlFlowFunction> functions;
+    for (const QByteArray &binary : lastBinaries) {
+        SpirvModule module;
+        if (module.parse(binary)) {
+            functions += SpirvControlFlowGraph::build(module, sourceFile);
+        }
+    }
+    if (functions.isEmpty()) {
+        QByteArray binary;
+        QString error;
+        SpirvModule module;
+        if (!compileSpirv(binary, error) || !module.parse(binary)) {
+            QMessageBox::information(this, tr("Control Flow Graph"), error.isEmpty() ? tr("The control flow graph needs SPIR-V output.") : error);
+            return;
+        }
+        functions = SpirvControlFlowGraph::build(module, sourceFile);
+    }
+
+    // 非模态显示，点击块时编辑器跟随跳转到源代码行
+    ControlFlowGraphDialog *dialog = new ControlFlowGraphDialog(functions, this);
+    dialog->setAttribute(Qt::WA_DeleteOnClose);
+    connect(dialog, &ControlFlowGraphDialog::sourceLineRequested, this, [this](int line) {
+        QTextCursor cursor(inputEdit->document()->findBlockByNumber(line - 1));
+        inputEdit->setTextCursor(cursor);
+        inputEdit->centerCursor();
+    });
+    dialog->show();
+}
+
+// 以当前设置编译出最终的 SPIR-V，DXC 只接受 SPIR-V/GLSL 输出
+bool DocumentWindow::compileSpirv(QByteArray &binary, QString &error)
+{
+    ShaderAutotuneRequest request = currentCompileRequest();
+    bool isDxcSpirv = request.compiler == "DXC" && (request.outputType == "SPIR-V" || request.outputType == "GLSL");
+    if (!isDxcSpirv && request.compiler != "GLSLANG" && request.compiler != "GLSLANGKGVER") {
+        error = tr("The current compiler settings do not produce SPIR-V.");
+        return false;
+    }
+
+    ShaderAutotuneRecipe recipe;
+    recipe.name = "Current";
+    recipe.spirvOptimizeOptions = compilerSettingUI->getSpirvOptimizeOptions();
+    ShaderAutotuneResult result = ShaderAutotuner::compile(request, recipe, "_binding_remap");
+    binary = result.binary;
+    error = result.error;
+    return result.success;
+}
+
+// 以当前设置编译并取得反射数据，DXC 的 DXIL 输出使用 DXIL 反射，其余为 SPIRV-Reflect
+bool DocumentWindow::compileReflection(ShaderReflection &reflection, QString &error)
+{
+    ShaderAutotuneRequest request = currentCompileRequest();
+    if (request.compiler != "DXC" && request.compiler != "GLSLANG" && request.compiler != "GLSLANGKGVER") {
+        error = tr("%1 does not provide reflection.").arg(request.compiler);
+        return false;
+    }
+
+    ShaderAutotuneRecipe recipe;
+    recipe.name = "Current";
+    recipe.spirvOptimizeOptions = compilerSettingUI->getSpirvOptimizeOptions();
+    ShaderAutotuneResult result = ShaderAutotuner::compile(request, recipe, "_pipeline_layout");
+    if (!result.hasReflection) {
+        error = result.error.isEmpty() ? tr("No reflection was generated.") : result.error;
+        return false;
+    }
+    reflection = result.reflection;
+    return true;
+}
+
+// 以当前设置编译出未经 spirv-opt 优化的 SPIR-V，DXC 使用 -O0（仍执行合法化）
+bool DocumentWindow::compileUnoptimizedSpirv(QByteArray &binary, QString &error)
+{
+    QString compiler = compilerSettingUI->getCurrentCompiler();
+
+    QString additionOptions;
+    if (compilerSettingUI->isExtraOptionsEnabled()) {
+        additionOptions = compilerSettingUI->getExtraOptions();
+    }
+
+    QStringList includePaths;
+    for (int i = 0; i < includePathList->count(); ++i) {
+        includePaths << includePathList->item(i)->text();
+    }
+
+    QStringList macros;
+    for (int i = 0; i < macroList->count(); ++i) {
+        macros << macroList->item(i)->text();
+    }
+
+    auto onBinary = [&](const QByteArray &data, const QString &binaryType, const QString &) {
+        if (binaryType == "SPIR-V") {
+            binary = data;
+        }
+    };
+    auto onError = [&](const QString &message) {
+        error = message;
+    };
+
+    if (compiler == "DXC") {
+        additionOptions.remove(QRegularExpression("(^|\\s)-(O[0-3]|Oconfig=\\S*)(?=\\s|$)"));
+        dxcCompiler compilerInstance;
+        connect(&compilerInstance, &dxcCompiler::binaryGenerated, this, onBinary);
+        connect(&compilerInstance, &dxcCompiler::compilationError, this, onError);
+        compilerInstance.setTempFileTag("_pass_pipeline");
+        compilerInstance.setIntermediateCache(&intermediateCache);
+        compilerInstance.compile(inputEdit->toPlainText(), languageCombo->currentText(), compilerSettingUI->getShaderModel(), compilerSettingUI->getEntryPoint(),
+                                 compilerSettingUI->getShaderType(), "SPIR-V", includePaths, macros, (additionOptions + " -O0").trimmed());
+    } else if (compiler == "GLSLANG") {
+        glslangCompiler compilerInstance;
+        connect(&compilerInstance, &glslangCompiler::binaryGenerated, this, onBinary);
+        connect(&compilerInstance, &glslangCompiler::compilationError, this, onError);
+        compilerInstance.setTempFileTag("_pass_pipeline");
+        compilerInstance.setIntermediateCache(&intermediateCache);
+        compilerInstance.setSpirvOptimizeOptions(QString());
+        compilerInstance.compile(inputEdit->toPlainText(), languageCombo->currentText(), compilerSettingUI->getShaderModel(), compilerSettingUI->getEntryPoint(),
+                                 compilerSettingUI->getShaderType(), "SPIR-V", includePaths, macros, additionOptions);
+    } else if (compiler == "GLSLANGKGVER") {
+        glslangkgverCompiler compilerInstance;
+        connect(&compilerInstance, &glslangkgverCompiler::binaryGenerated, this, onBinary);
+        connect(&compilerInstance, &glslangkgverCompiler::compilationError, this, onError);
+        compilerInstance.setTempFileTag("_pass_pipeline");
+        compilerInstance.setEmitLineDirectives(compilerSettingUI->isLineDirectivesEnabled());
+        compilerInstance.setCodePrebuilder(&glslkgverCodePrebuilder);
+        compilerInstance.setLinkedLibraries(compilerSettingUI->isLinkedLibrariesEnabled() ? compilerSettingUI->getLinkedLibraries() : QStringList());
+        compilerInstance.setIntermediateCache(&intermediateCache);
+        compilerInstance.setSpirvOptimizeOptions(QString());
+        compilerInstance.compile(inputEdit->toPlainText(), compilerSettingUI->getShaderModel(), compilerSettingUI->getEntryPoint(),
+                                 compilerSettingUI->getShaderType(), "SPIR-V", includePaths, macros, additionOptions);
+    }
+
+    return !binary.isEmpty();
+}
+
+void DocumentWindow::updateBaselineView()
+{
+    baselineEdit->clear();
+    if (!baselineSnapshot.isValid() || !lastSnapshot.isValid()) {
+        return;
+    }
+
+    QString text = ShaderBuildDiff::compareMetrics(baselineSnapshot, lastSnapshot);
+    text += "\n";
+    text += ShaderBuildDiff::structuralDiff(baselineSnapshot.disassembly, lastSnapshot.disassembly);
+    baselineEdit->setPlainText(text);
+}
+
+// 编译后所有分析面板过期，只立即更新当前可见的面板
+void DocumentWindow::invalidateAnalysisViews()
+{
+    staleAnalysisViews = { occupancyEdit, pressureEdit, halfPrecisionEdit, bufferLayoutEdit, textureAccessEdit };
+    updateCurrentAnalysisView();
+}
+
+void DocumentWindow::updateCurrentAnalysisView()
+{
+    QWidget *view = outputTabs->currentWidget();
+    if (!staleAnalysisViews.remove(view)) {
+        return;
+    }
+
+    if (view == occupancyEdit) {
+        updateOccupancyView();
+    } else if (view == pressureEdit) {
+        updatePressureView();
+    } else if (view == halfPrecisionEdit) {
+        updateHalfPrecisionView();
+    } else if (view == bufferLayoutEdit) {
+        updateBufferLayoutView();
+    } else if (view == textureAccessEdit) {
+        updateTextureAccessView();
+    }
+}
+
+// 估算计算类阶段在各 GPU 配置下的占用率，反汇编中没有工作组大小时使用反射数据
+void DocumentWindow::updateOccupancyView()
+{
+    QVector<ComputeShaderResources> stages;
+    for (int i = 0; i < lastBinaries.size(); ++i) {
+        SpirvModule module;
+        if (lastBinaryTypes[i] == "SPIR-V" && module.parse(lastBinaries[i])) {
+            stages.append(ShaderOccupancy::analyzeSpirv(module));
+        } else if (lastBinaryTypes[i] == "DXIL") {
+            stages.append(ShaderOccupancy::analyzeDxilDisassembly(lastDisassemblies[i]));
+        }
+    }
+    for (int i = 0; i < stages.size(); ++i) {
+        if (stages[i].threadCount() == 0 && stages.size() == lastReflections.size() && !lastReflections[i].entryPoints.isEmpty()) {
+            for (int c = 0; c < 3; ++c) {
+                stages[i].localSize[c] = lastReflections[i].entryPoints.first().localSize[c];
+            }
+        }
+    }
+
+    QVector<GpuProfile> profiles = ShaderOccupancy::profilesFromText(gpuProfiles);
+    if (profiles.isEmpty()) {
+        profiles = ShaderOccupancy::defaultProfiles();
+    }
+    occupancyEdit->setPlainText(ShaderOccupancy::reportText(stages, profiles));
+}
+
+// 编辑占用率估算使用的 GPU 配置
+void DocumentWindow::editGpuProfiles()
+{
+    QVector<GpuProfile> profiles = ShaderOccupancy::profilesFromText(gpuProfiles);
+    bool ok = false;
+    QString text = QInputDialog::getMultiLineText(this, tr("GPU Profiles"), tr("One GPU per line, clear all lines to restore the built-in profiles:"),
+        ShaderOccupancy::profilesToText(profiles.isEmpty() ? ShaderOccupancy::defaultProfiles() : profiles), &ok);
+    if (!ok) {
+        return;
+    }
+
+    gpuProfiles = ShaderOccupancy::profilesFromText(text).isEmpty() ? QString() : text;
+    staleAnalysisViews.insert(occupancyEdit);
+    outputTabs->setCurrentWidget(occupancyEdit);
+    updateCurrentAnalysisView();
+}
+
+// 各阶段的寄存器压力估算
+void DocumentWindow::updatePressureView()
+{
+    QString text;
+    for (int i = 0; i < lastBinaries.size(); ++i) {
+        SpirvModule module;
+        if (lastBinaryTypes[i] == "SPIR-V" && module.parse(lastBinaries[i])) {
+            text += SpirvRegisterPressure::reportText(SpirvRegisterPressure::analyze(module));
+        } else if (lastBinaryTypes[i] == "DXIL") {
+            text += tr("Register pressure estimation needs SPIR-V output.\n");
+        }
+    }
+    pressureEdit->setPlainText(text);
+}
+
+// 各阶段可降为 16 位精度的运算
+void DocumentWindow::updateHalfPrecisionView()
+{
+    QString text;
+    for (int i = 0; i < lastBinaries.size(); ++i) {
+        SpirvModule module;
+        if (lastBinaryTypes[i] == "SPIR-V" && module.parse(lastBinaries[i])) {
+            text += SpirvHalfPrecision::reportText(SpirvHalfPrecision::analyze(module)) + "\n";
+        } else if (lastBinaryTypes[i] == "DXIL") {
+            text += tr("Half-precision analysis needs SPIR-V output.\n");
+        }
+    }
+    halfPrecisionEdit->setPlainText(text);
+}
+
+// 常量缓冲区的填充及未读取成员，各阶段的块合并统计
+void DocumentWindow::updateBufferLayoutView()
+{
+    bufferLayoutEdit->setPlainText(ConstantBufferLayout::reportText(ConstantBufferLayout::analyze(lastReflections)));
+}
+
+// 纹理及存储缓冲区访问，反射数据与各阶段一一对应时用其补全资源名称
+void DocumentWindow::updateTextureAccessView()
+{
+    QVector<TextureAccessReport> reports;
+    for (int i = 0; i < lastBinaries.size(); ++i) {
+        SpirvModule module;
+        if (lastBinaryTypes[i] == "SPIR-V" && module.parse(lastBinaries[i])) {
+            reports.append(TextureAccessAnalyzer::analyzeSpirv(module));
+        } else if (lastBinaryTypes[i] == "DXIL") {
+            reports.append(TextureAccessAnalyzer::analyzeDxilDisassembly(lastDisassemblies[i]));
+        }
+    }
+    if (reports.size() == lastReflections.size()) {
+        for (int i = 0; i < reports.size(); ++i) {
+            TextureAccessAnalyzer::applyReflection(reports[i], lastReflections[i]);
+        }
+    }
+    textureAccessEdit->setPlainText(TextureAccessAnalyzer::reportText(reports));
+}
+
+// 统计每行代价时附加的调试信息选项
+QString DocumentWindow::lineCostDebugOptions(const QString &compiler, const QString &outputType) const
+{
+    if (compiler == "DXC") {
+        // DXIL 调试信息嵌入容器，-dumpbin 才能输出 !dbg 元数据
+        return outputType == "DXIL" ? QString("-Zi -Qembed_debug") : QString("-Zi -fspv-debug=line");
+    }
+    if (compiler == "GLSLANG" || compiler == "GLSLANGKGVER") {
+        return QString("-g");
+    }
+    return QString();
+}
+
+// 导出最近一次编译的反射数据，.json 为 JSON 格式，其余为二进制格式；多个阶段时按阶段名称分别保存
+void DocumentWindow::exportReflection()
+{
+    if (lastReflections.isEmpty()) {
+        QMessageBox::information(this, tr("Export Reflection"), tr("No reflection data, compile the shader to SPIR-V or DXIL first."));
+        return;
+    }
+
+    QString filePath = QFileDialog::getSaveFileName(this, tr("Export Reflection"), lastOpenDir,
+        tr("Reflection JSON (*.json);;Reflection Binary (*.refl)"));
+    if (filePath.isEmpty()) {
+        return;
+    }
+
+    QFileInfo fileInfo(filePath);
+    lastOpenDir = fileInfo.absolutePath();
+
+    QStringList failedFiles;
+    for (const ShaderReflection &reflection : lastReflections) {
+        QString stageFilePath = filePath;
+        if (lastReflections.size() > 1) {
+            QString stage = reflection.entryPoints.isEmpty() ? QString("Unknown") : reflection.entryPoints.first().stage;
+            stageFilePath = fileInfo.dir().filePath(QString("%1_%2.%3").arg(fileInfo.completeBaseName()).arg(stage).arg(fileInfo.suffix()));
+        }
+
+        if (!reflection.saveToFile(stageFilePath)) {
+            failedFiles << stageFilePath;
+        }
+    }
+
+    if (!failedFiles.isEmpty()) {
+        QMessageBox::warning(this, tr("Export Reflection"), tr("Failed to write:\n") + failedFiles.join("\n"));
+    }
+}
+
+// 记录本次构建的编译器、构建方式及下游设置，供下游设置变化时判断是否需要重新构建
+void DocumentWindow::recordBuildSettings(const QString &compiler, bool allStages)
+{
+    lastBuildCompiler = compiler;
+    lastBuildAllStages = allStages;
+    lastBuildOutputType = compilerSettingUI->getOutputType();
+    lastBuildSpirvOptimizeOptions = compilerSettingUI->getSpirvOptimizeOptions();
+}
+
+// 输出类型或 SPIR-V 优化级别变化时，已用当前编译器构建过的文档复用前端结果，按上次的构建方式重新生成输出
+void DocumentWindow::onDownstreamSettingsChanged()
+{
+    if (intermediateCache.isEmpty() || lastBuildCompiler != compilerSettingUI->getCurrentCompiler()) {
+        return;
+    }
+    if (lastBuildOutputType == compilerSettingUI->getOutputType()
+        && lastBuildSpirvOptimizeOptions == compilerSettingUI->getSpirvOptimizeOptions()) {
+        return;
+    }
+
+    if (lastBuildAllStages) {
+        compileAllStages();
+    } else {
+        compile();
+    }
 }
 
 void DocumentWindow::addIncludePath()
@@ -644,6 +1443,17 @@ void DocumentWindow::loadSettings(QString settingsPath)
     QString extraOptions = settings.value("extraOptions", "").toString();
     compilerSettingUI->setExtraOptionsEnabled(extraOptionsEnabled);
     compilerSettingUI->setExtraOptions(extraOptions);
+
+    compilerSettingUI->setLineDirectivesEnabled(settings.value("lineDirectivesEnabled", false).toBool());
+    compilerSettingUI->setLineCostEnabled(settings.value("lineCostEnabled", false).toBool());
+    compilerSettingUI->setLinkedLibrariesEnabled(settings.value("linkedLibrariesEnabled", false).toBool());
+    compilerSettingUI->setLinkedLibraries(settings.value("linkedLibraries").toStringList());
+    compilerSettingUI->setSpirvOptimizeLevel(settings.value("spirvOptimizeLevel", "-O").toString());
+    autotuneRecipes = settings.value("autotuneRecipes").toString();
+    spirvPassPipeline = settings.value("spirvPassPipeline").toStringList();
+    compareShaderModelList = settings.value("compareShaderModels", QStringList() << "6_0" << "6_6" << "6_7").toStringList();
+    specConstantValues = settings.value("specConstantValues").toStringList();
+    gpuProfiles = settings.value("gpuProfiles").toString();
     
     lastOpenDir = settings.value("lastOpenDir", QDir::currentPath()).toString();
     
@@ -698,6 +1508,16 @@ void DocumentWindow::saveSettings(QString settingsPath)
     // 保存额外编译选项设置
     settings.setValue("extraOptionsEnabled", compilerSettingUI->isExtraOptionsEnabled());
     settings.setValue("extraOptions", compilerSettingUI->getExtraOptions());
+    settings.setValue("lineDirectivesEnabled", compilerSettingUI->isLineDirectivesEnabled());
+    settings.setValue("lineCostEnabled", compilerSettingUI->isLineCostEnabled());
+    settings.setValue("linkedLibrariesEnabled", compilerSettingUI->isLinkedLibrariesEnabled());
+    settings.setValue("linkedLibraries", compilerSettingUI->getLinkedLibraries());
+    settings.setValue("spirvOptimizeLevel", compilerSettingUI->getSpirvOptimizeLevel());
+    settings.setValue("autotuneRecipes", autotuneRecipes);
+    settings.setValue("spirvPassPipeline", spirvPassPipeline);
+    settings.setValue("compareShaderModels", compareShaderModelList);
+    settings.setValue("specConstantValues", specConstantValues);
+    settings.setValue("gpuProfiles", gpuProfiles);
     
     // 保存编码
     settings.setValue("encoding", encodingCombo->currentText());
@@ -9,8 +9,20 @@
 #include <QListWidget>
 #include <QPushButton>
 #include <QTextEdit>
+#include <QTabWidget>
+#include <QSet>
 #include "shaderCodeTextEdit.h"
 #include "compilerSettingUI.h"
+#include "glslkgverCodePrebuilder.h"
+#include "shaderIntermediateCache.h"
+#include "shaderReflection.h"
+#include "shaderReflectionPanel.h"
+#include "shaderCostAnalyzer.h"
+#include "shaderCostPanel.h"
+#include "shaderBuildDiff.h"
+#include "shaderAutotuner.h"
+#include "shaderOccupancy.h"
+#include "textureAccessAnalyzer.h"
 
 class DocumentWindow : public QMainWindow
 {
@@ -25,6 +37,19 @@ public:
 
 public slots:
     void compile();
+    void compileAllStages();
+    void onDownstreamSettingsChanged();
+    void exportReflection();
+    void onBinaryGenerated(const QByteArray &binary, const QString &binaryType, const QString &disassembly);
+    void pinBaseline();
+    void clearBaseline();
+    void autotune();
+    void editPassPipeline();
+    void compareShaderModels();
+    void compareFrontends();
+    void specConstantVariants();
+    void showControlFlowGraph();
+    void editGpuProfiles();
     void addIncludePath();
     void removeIncludePath();
     void addMacro();
@@ -45,6 +70,15 @@ public slots:
     QString getLanguage();
     QString getDocumentWindowTitle() { return documentWindowTitle; }
 
+    // 以当前设置编译出未经 spirv-opt 优化的 SPIR-V，供 pass 序列及跨阶段裁剪使用
+    bool compileUnoptimizedSpirv(QByteArray &binary, QString &error);
+
+    // 以当前设置（含优化）编译出最终的 SPIR-V，供绑定重映射使用
+    bool compileSpirv(QByteArray &binary, QString &error);
+
+    // 以当前设置编译并返回反射数据，供管线布局生成使用
+    bool compileReflection(ShaderReflection &reflection, QString &error);
+
 public:
     void loadSettings(QString settingsPath);
     void saveSettings(QString settingsPath);
@@ -53,6 +87,18 @@ private:
     void setupUI();
     void setupConnections();
     QString settingsFilePath() const;
+    QString lineCostDebugOptions(const QString &compiler, const QString &outputType) const;
+    void updateBuildSnapshot(const QString &compiler, const QString &outputType, double compileSeconds);
+    void recordBuildSettings(const QString &compiler, bool allStages);
+    void updateBaselineView();
+    void invalidateAnalysisViews();
+    void updateCurrentAnalysisView();
+    void updateOccupancyView();
+    void updatePressureView();
+    void updateHalfPrecisionView();
+    void updateBufferLayoutView();
+    void updateTextureAccessView();
+    ShaderAutotuneRequest currentCompileRequest();
 
 private:
     QString documentWindowTitle;
@@ -76,8 +122,17 @@ private:
     QPushButton *removeMacroButton;
 
     // 编译输出界面
+    QTabWidget *outputTabs;
     QTextEdit *outputEdit;
     QTextEdit *logEdit;
+    ShaderReflectionPanel *reflectionPanel;
+    ShaderCostPanel *costPanel;
+    QTextEdit *baselineEdit;
+    QTextEdit *occupancyEdit;
+    QTextEdit *pressureEdit;
+    QTextEdit *halfPrecisionEdit;
+    QTextEdit *bufferLayoutEdit;
+    QTextEdit *textureAccessEdit;
 
     // 编译器设置
     CompilerSettingUI *compilerSettingUI;
@@ -87,6 +142,51 @@ private:
     QString lastGLSLCompiler;
     QString lastOpenDir;
 
+    // glslkgver 增量预处理器，跨次编译保留代码块展开结果
+    GlslKgverCodePrebuilder glslkgverCodePrebuilder;
+
+    // 前端编译结果缓存，只有输出类型等下游设置变化时不重新编译源码
+    ShaderIntermediateCache intermediateCache;
+
+    // 最近一次构建使用的编译器、是否编译所有阶段及下游设置
+    QString lastBuildCompiler;
+    bool lastBuildAllStages;
+    QString lastBuildOutputType;
+    QString lastBuildSpirvOptimizeOptions;
+
+    // 最近一次编译生成的反射数据，编译所有阶段时每个阶段一项
+    QVector<ShaderReflection> lastReflections;
+
+    // 最近一次编译的静态代价报告，编译所有阶段时每个阶段一项
+    QVector<ShaderCostReport> lastCostReports;
+
+    // 最近一次编译的二进制产物，及对应的类型（SPIR-V、DXIL）和反汇编，编译所有阶段时每个阶段一项
+    QVector<QByteArray> lastBinaries;
+    QVector<QString> lastBinaryTypes;
+    QVector<QString> lastDisassemblies;
+
+    // 尚未按最近一次编译结果更新的分析面板
+    QSet<QWidget *> staleAnalysisViews;
+
+    // 最近一次编译的快照及固定的基线，基线只在当前文档内有效
+    ShaderBuildSnapshot lastSnapshot;
+    ShaderBuildSnapshot baselineSnapshot;
+
+    // 自动调优配方文本，为空时使用当前编译器的默认配方
+    QString autotuneRecipes;
+
+    // 自定义 spirv-opt pass 序列
+    QStringList spirvPassPipeline;
+
+    // Shader Model 对比时勾选的版本
+    QStringList compareShaderModelList;
+
+    // 占用率估算使用的 GPU 配置文本，为空时使用内置配置
+    QString gpuProfiles;
+
+    // 特化常量变体的取值，每项 "SpecId=值1,值2"
+    QStringList specConstantValues;
+
     bool isSaveSettings;
 };
 
@@ -5,10 +5,13 @@
 #include <QTextStream>
 #include <QDir>
 #include "spirvUtils.h"
+#include "dxilUtils.h"
+#include "shaderIntermediateCache.h"
+#include "shaderReflection.h"
 #include <windows.h>
 
 // 构造函数，初始化 dxcCompiler。
-dxcCompiler::dxcCompiler(QObject *parent) : QObject(parent) {}
+dxcCompiler::dxcCompiler(QObject *parent) : QObject(parent), intermediateCache(nullptr) {}
 
 // 编译方法，执行编译操作。
 void dxcCompiler::compile(const QString &shaderCode, 
@@ -22,7 +25,7 @@ void dxcCompiler::compile(const QString &shaderCode,
                           const QString &additionOptions) 
 {
     // 使用临时文件来存储 Shader 代码
-    QString tempFilePath = QDir::temp().filePath("temp_shader.hlsl");
+    QString tempFilePath = QDir::temp().filePath(QString("temp_shader%1.hlsl").arg(tempFileTag));
     QFile tempFile(tempFilePath);
     if (!tempFile.open(QIODevice::WriteOnly | QIODevice::Text)) {
         emit compilationError("Failed to create temporary shader file.");
@@ -34,13 +37,13 @@ void dxcCompiler::compile(const QString &shaderCode,
 
     QString outputFilePath;
     if (outputType == "DXIL") {
-        outputFilePath = QDir::temp().filePath("output_shader.dxil");
+        outputFilePath = QDir::temp().filePath(QString("output_shader%1.dxil").arg(tempFileTag));
     }
     else if (outputType == "Preprocess-HLSL") {
-        outputFilePath = QDir::temp().filePath("output_shader.hlsl");
+        outputFilePath = QDir::temp().filePath(QString("output_shader%1.hlsl").arg(tempFileTag));
     }
     else {
-        outputFilePath = QDir::temp().filePath("output_shader.spv");
+        outputFilePath = QDir::temp().filePath(QString("output_shader%1.spv").arg(tempFileTag));
     }
 
     bool bHLSL2021 = false;
@@ -51,25 +54,52 @@ void dxcCompiler::compile(const QString &shaderCode,
     QFile::remove(outputFilePath);
     QString command = buildCommand(tempFilePath, shaderModel, entryPoint, shaderType, outputType, includePaths, macros, outputFilePath, bHLSL2021, additionOptions);
 
-    LARGE_INTEGER Frequecy;
-    QueryPerformanceFrequency(&Frequecy);
+    // 前端编译结果只取决于源码及编译参数，与反汇编方式无关
+    QByteArray frontEndKey;
+    bool reuseFrontEnd = false;
+    QString output;
+    QString error;
+    double ToSec = 0.0;
 
-    double s_SecondsPerCPUCyscle = 1.0f / (double)Frequecy.QuadPart;
+    if (intermediateCache && outputType != "Preprocess-HLSL") {
+        bool isSpirv = outputType == "SPIR-V" || outputType == "GLSL";
+        frontEndKey = ShaderIntermediateCache::makeKey(QStringList()
+            << "DXC" << shaderCode << languageType << shaderModel << entryPoint << shaderType
+            << (isSpirv ? "spirv" : "dxil") << includePaths.join(";") << macros.join(";") << additionOptions
+            << ShaderIntermediateCache::includedFilesStamp(shaderCode, QDir::temp().absolutePath(), includePaths));
 
-    LARGE_INTEGER BeginCircle;
-    QueryPerformanceCounter(&BeginCircle);
+        QByteArray frontEndBlob;
+        if (intermediateCache->findFrontEnd(frontEndKey, frontEndBlob, error)) {
+            reuseFrontEnd = ShaderIntermediateCache::writeBlob(outputFilePath, frontEndBlob);
+        }
+    }
+
+    if (!reuseFrontEnd) {
+        LARGE_INTEGER Frequecy;
+        QueryPerformanceFrequency(&Frequecy);
+
+        double s_SecondsPerCPUCyscle = 1.0f / (double)Frequecy.QuadPart;
 
-    QProcess process;
-    process.start(command);
-    process.waitForFinished();
+        LARGE_INTEGER BeginCircle;
+        QueryPerformanceCounter(&BeginCircle);
 
-    LARGE_INTEGER EndCircle;
-    QueryPerformanceCounter(&EndCircle);
+        QProcess process;
+        process.start(command);
+        process.waitForFinished();
+
+        LARGE_INTEGER EndCircle;
+        QueryPerformanceCounter(&EndCircle);
 
-    auto ToSec = s_SecondsPerCPUCyscle* (double)((int64_t)EndCircle.QuadPart - (int64_t)BeginCircle.QuadPart);
+        ToSec = s_SecondsPerCPUCyscle* (double)((int64_t)EndCircle.QuadPart - (int64_t)BeginCircle.QuadPart);
 
-    QString output = process.readAllStandardOutput();
-    QString error = process.readAllStandardError();
+        output = process.readAllStandardOutput();
+        error = process.readAllStandardError();
+
+        QByteArray frontEndBlob;
+        if (!frontEndKey.isEmpty() && ShaderIntermediateCache::readBlob(outputFilePath, frontEndBlob)) {
+            intermediateCache->storeFrontEnd(frontEndKey, frontEndBlob, error);
+        }
+    }
 
     if (!QFile::exists(outputFilePath)) {
         emit compilationError(error.isEmpty() ? "Compilation failed with no output." : error);
@@ -112,14 +142,41 @@ void dxcCompiler::compile(const QString &shaderCode,
         if (output.isEmpty()) {
             emit compilationError(errorDisasm.isEmpty() ? "Compilation failed with no output." : errorDisasm);
         } else {
-            if (outputType == "SPIR-V") {
+            if (outputType == "SPIR-V" || outputType == "GLSL") {
+                QString outputReflectionInfo;
+                ShaderReflection reflection;
+                if (DumpSpirVReflectionInfo(outputFilePath, outputReflectionInfo, &reflection)) {
+                    if (outputType == "SPIR-V") {
+                        output = output + "\n" + outputReflectionInfo;
+                    }
+                    emit reflectionGenerated(reflection);
+                }
+
+                QByteArray spirvBinary;
+                if (ShaderIntermediateCache::readBlob(outputFilePath, spirvBinary)) {
+                    emit binaryGenerated(spirvBinary, "SPIR-V", QString());
+                }
+            } else if (outputType == "DXIL") {
+                // 代价分析基于 -dumpbin 输出的 LLVM IR 文本
+                QByteArray dxilBinary;
+                if (ShaderIntermediateCache::readBlob(outputFilePath, dxilBinary)) {
+                    emit binaryGenerated(dxilBinary, "DXIL", output);
+                }
+
                 QString outputReflectionInfo;
-                if (DumpSpirVReflectionInfo(outputFilePath, outputReflectionInfo)) {
+                ShaderReflection reflection;
+                if (DumpDxilReflectionInfo(outputFilePath, outputReflectionInfo, &reflection)) {
+                    // DXIL 反射数据中没有入口函数名称
+                    if (!reflection.entryPoints.isEmpty()) {
+                        reflection.entryPoints[0].name = entryPoint;
+                    }
                     output = output + "\n" + outputReflectionInfo;
+                    emit reflectionGenerated(reflection);
                 }
             }
 
-            emit compilationFinished(output + "\n" + QString("cost time: %1s").arg(ToSec));
+            QString costTime = reuseFrontEnd ? QString("cost time: 0s (reused front-end result)") : QString("cost time: %1s").arg(ToSec);
+            emit compilationFinished(output + "\n" + costTime);
 
             // 如果 error 非空，将其输出为警告信息
             if (!error.isEmpty()) {
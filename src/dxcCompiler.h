@@ -4,6 +4,10 @@
 #include <QString>
 #include <QObject>
 #include <QStringList>
+#include <QByteArray>
+#include "shaderReflection.h"
+
+class ShaderIntermediateCache;
 
 // dxcCompiler 类用于管理 DXC 编译器的编译过程。
 class dxcCompiler : public QObject {
@@ -20,6 +24,12 @@ public:
                  const QStringList &includePaths, const QStringList &macros,
                  const QString &additionOptions);
 
+    // 设置文档的中间结果缓存，输入未变化时复用上次的 DXIL/SPIR-V 只重新执行反汇编等下游步骤
+    void setIntermediateCache(ShaderIntermediateCache *cache) { intermediateCache = cache; }
+
+    // 设置临时文件名后缀，多个实例并行编译时用于区分临时文件
+    void setTempFileTag(const QString &tag) { tempFileTag = tag; }
+
 signals:
     // 编译完成信号，携带输出结果。
     void compilationFinished(const QString &output);
@@ -30,6 +40,12 @@ signals:
     // 编译警告信号，携带警告信息。
     void compilationWarning(const QString &warning);
 
+    // 反射数据生成信号，携带 SPIR-V 或 DXIL 结构化反射数据。
+    void reflectionGenerated(const ShaderReflection &reflection);
+
+    // 编译产物信号，携带二进制内容、类型（SPIR-V/DXIL）及 DXIL 反汇编文本，用于代价分析。
+    void binaryGenerated(const QByteArray &binary, const QString &binaryType, const QString &disassembly);
+
 private:
     // 构建编译命令的方法。
     QString buildCommand(const QString &tempFilePath,  // 修改为接受临时文件路径
@@ -42,6 +58,9 @@ private:
                          const QString &outputFilePath,
                          bool isHLSL2021,
                          const QString &additionOptions);
+
+    ShaderIntermediateCache *intermediateCache; // 由文档持有的中间结果缓存
+    QString tempFileTag; // 临时文件名后缀
 };
 
 #endif // DXCCOMPILER_H
@@ -0,0 +1,433 @@
+#include <QStringList>
+#include <QFile>
+#include <windows.h>
+#include <wrl/client.h>
+#include "dxcapi.h"
+#include "d3d12shader.h"
+#include "dxilUtils.h"
+#include "shaderReflection.h"
+
+using Microsoft::WRL::ComPtr;
+
+static QString scalarTypeName(D3D_SHADER_VARIABLE_TYPE type)
+{
+    switch (type)
+    {
+        case D3D_SVT_BOOL: return "bool";
+        case D3D_SVT_INT: return "int";
+        case D3D_SVT_UINT: return "uint";
+        case D3D_SVT_FLOAT: return "float";
+        case D3D_SVT_DOUBLE: return "double";
+        case D3D_SVT_FLOAT16: return "half";
+        case D3D_SVT_INT16: return "int16_t";
+        case D3D_SVT_UINT16: return "uint16_t";
+        case D3D_SVT_INT64: return "int64_t";
+        case D3D_SVT_UINT64: return "uint64_t";
+        case D3D_SVT_MIN16FLOAT: return "min16float";
+        case D3D_SVT_MIN16INT: return "min16int";
+        case D3D_SVT_MIN16UINT: return "min16uint";
+        default: return "unknown";
+    }
+}
+
+// 根据 D3D12 类型描述生成 HLSL 类型名称，如 float4、float4x4、结构体名
+static QString typeNameOf(const D3D12_SHADER_TYPE_DESC &typeDesc)
+{
+    if (typeDesc.Name) {
+        return QString(typeDesc.Name);
+    }
+
+    QString scalarName = scalarTypeName(typeDesc.Type);
+    switch (typeDesc.Class)
+    {
+        case D3D_SVC_VECTOR: return scalarName + QString::number(typeDesc.Columns);
+        case D3D_SVC_MATRIX_ROWS:
+        case D3D_SVC_MATRIX_COLUMNS: return QString("%1%2x%3").arg(scalarName).arg(typeDesc.Rows).arg(typeDesc.Columns);
+        case D3D_SVC_STRUCT: return "struct";
+        default: return scalarName;
+    }
+}
+
+// 资源类型名称，使用 D3D12 描述符堆的分类
+static QString resourceClassName(D3D_SHADER_INPUT_TYPE type)
+{
+    switch (type)
+    {
+        case D3D_SIT_CBUFFER: return "CBV";
+        case D3D_SIT_SAMPLER: return "Sampler";
+        case D3D_SIT_TBUFFER:
+        case D3D_SIT_TEXTURE:
+        case D3D_SIT_STRUCTURED:
+        case D3D_SIT_BYTEADDRESS:
+        case D3D_SIT_RTACCELERATIONSTRUCTURE: return "SRV";
+        default: return "UAV";
+    }
+}
+
+static QString dimensionName(D3D_SRV_DIMENSION dimension)
+{
+    switch (dimension)
+    {
+        case D3D_SRV_DIMENSION_BUFFER: return "Buffer";
+        case D3D_SRV_DIMENSION_TEXTURE1D: return "Texture1D";
+        case D3D_SRV_DIMENSION_TEXTURE1DARRAY: return "Texture1DArray";
+        case D3D_SRV_DIMENSION_TEXTURE2D: return "Texture2D";
+        case D3D_SRV_DIMENSION_TEXTURE2DARRAY: return "Texture2DArray";
+        case D3D_SRV_DIMENSION_TEXTURE2DMS: return "Texture2DMS";
+        case D3D_SRV_DIMENSION_TEXTURE2DMSARRAY: return "Texture2DMSArray";
+        case D3D_SRV_DIMENSION_TEXTURE3D: return "Texture3D";
+        case D3D_SRV_DIMENSION_TEXTURECUBE: return "TextureCube";
+        case D3D_SRV_DIMENSION_TEXTURECUBEARRAY: return "TextureCubeArray";
+        default: return "Resource";
+    }
+}
+
+// HLSL 资源类型名称，如 Texture2D、RWStructuredBuffer、cbuffer
+static QString resourceTypeName(const D3D12_SHADER_INPUT_BIND_DESC &bindDesc)
+{
+    switch (bindDesc.Type)
+    {
+        case D3D_SIT_CBUFFER: return "cbuffer";
+        case D3D_SIT_TBUFFER: return "tbuffer";
+        case D3D_SIT_SAMPLER: return (bindDesc.uFlags & D3D_SIF_COMPARISON_SAMPLER) ? "SamplerComparisonState" : "SamplerState";
+        case D3D_SIT_TEXTURE: return dimensionName(bindDesc.Dimension);
+        case D3D_SIT_UAV_RWTYPED: return "RW" + dimensionName(bindDesc.Dimension);
+        case D3D_SIT_STRUCTURED: return "StructuredBuffer";
+        case D3D_SIT_UAV_RWSTRUCTURED: return "RWStructuredBuffer";
+        case D3D_SIT_BYTEADDRESS: return "ByteAddressBuffer";
+        case D3D_SIT_UAV_RWBYTEADDRESS: return "RWByteAddressBuffer";
+        case D3D_SIT_UAV_APPEND_STRUCTURED: return "AppendStructuredBuffer";
+        case D3D_SIT_UAV_CONSUME_STRUCTURED: return "ConsumeStructuredBuffer";
+        case D3D_SIT_UAV_RWSTRUCTURED_WITH_COUNTER: return "RWStructuredBuffer";
+        case D3D_SIT_RTACCELERATIONSTRUCTURE: return "RaytracingAccelerationStructure";
+        default: return "Unknown";
+    }
+}
+
+static QString systemValueName(D3D_NAME name)
+{
+    switch (name)
+    {
+        case D3D_NAME_UNDEFINED: return QString();
+        case D3D_NAME_POSITION: return "SV_Position";
+        case D3D_NAME_CLIP_DISTANCE: return "SV_ClipDistance";
+        case D3D_NAME_CULL_DISTANCE: return "SV_CullDistance";
+        case D3D_NAME_RENDER_TARGET_ARRAY_INDEX: return "SV_RenderTargetArrayIndex";
+        case D3D_NAME_VIEWPORT_ARRAY_INDEX: return "SV_ViewportArrayIndex";
+        case D3D_NAME_VERTEX_ID: return "SV_VertexID";
+        case D3D_NAME_PRIMITIVE_ID: return "SV_PrimitiveID";
+        case D3D_NAME_INSTANCE_ID: return "SV_InstanceID";
+        case D3D_NAME_IS_FRONT_FACE: return "SV_IsFrontFace";
+        case D3D_NAME_SAMPLE_INDEX: return "SV_SampleIndex";
+        case D3D_NAME_TARGET: return "SV_Target";
+        case D3D_NAME_DEPTH: return "SV_Depth";
+        case D3D_NAME_COVERAGE: return "SV_Coverage";
+        case D3D_NAME_DEPTH_GREATER_EQUAL: return "SV_DepthGreaterEqual";
+        case D3D_NAME_DEPTH_LESS_EQUAL: return "SV_DepthLessEqual";
+        case D3D_NAME_STENCIL_REF: return "SV_StencilRef";
+        default: return QString("SV(%1)").arg(static_cast<int>(name));
+    }
+}
+
+static QString componentTypeName(D3D_REGISTER_COMPONENT_TYPE type)
+{
+    switch (type)
+    {
+        case D3D_REGISTER_COMPONENT_UINT32: return "uint";
+        case D3D_REGISTER_COMPONENT_SINT32: return "int";
+        case D3D_REGISTER_COMPONENT_FLOAT32: return "float";
+        default: return "unknown";
+    }
+}
+
+static QString shaderStageName(UINT shaderVersion)
+{
+    switch (D3D12_SHVER_GET_TYPE(shaderVersion))
+    {
+        case D3D12_SHVER_PIXEL_SHADER: return "Pixel";
+        case D3D12_SHVER_VERTEX_SHADER: return "Vertex";
+        case D3D12_SHVER_GEOMETRY_SHADER: return "Geometry";
+        case D3D12_SHVER_HULL_SHADER: return "Hull";
+        case D3D12_SHVER_DOMAIN_SHADER: return "Domain";
+        case D3D12_SHVER_COMPUTE_SHADER: return "Compute";
+        case D3D12_SHVER_LIBRARY: return "Library";
+        case D3D12_SHVER_MESH_SHADER: return "Mesh";
+        case D3D12_SHVER_AMPLIFICATION_SHADER: return "Task";
+        default: return "Unknown";
+    }
+}
+
+// GetRequiresFlags 返回的可选特性
+static QStringList requiredFeatureNames(UINT64 flags)
+{
+    static const struct { UINT64 flag; const char *name; } kFeatures[] = {
+        { D3D_SHADER_REQUIRES_DOUBLES, "Doubles" },
+        { D3D_SHADER_REQUIRES_EARLY_DEPTH_STENCIL, "Early Depth Stencil" },
+        { D3D_SHADER_REQUIRES_UAVS_AT_EVERY_STAGE, "UAVs At Every Stage" },
+        { D3D_SHADER_REQUIRES_64_UAVS, "64 UAVs" },
+        { D3D_SHADER_REQUIRES_MINIMUM_PRECISION, "Minimum Precision" },
+        { D3D_SHADER_REQUIRES_11_1_DOUBLE_EXTENSIONS, "11.1 Double Extensions" },
+        { D3D_SHADER_REQUIRES_11_1_SHADER_EXTENSIONS, "11.1 Shader Extensions" },
+        { D3D_SHADER_REQUIRES_LEVEL_9_COMPARISON_FILTERING, "Level 9 Comparison Filtering" },
+        { D3D_SHADER_REQUIRES_TILED_RESOURCES, "Tiled Resources" },
+        { D3D_SHADER_REQUIRES_STENCIL_REF, "Stencil Ref" },
+        { D3D_SHADER_REQUIRES_INNER_COVERAGE, "Inner Coverage" },
+        { D3D_SHADER_REQUIRES_TYPED_UAV_LOAD_ADDITIONAL_FORMATS, "Typed UAV Load Additional Formats" },
+        { D3D_SHADER_REQUIRES_ROVS, "Rasterizer Ordered Views" },
+        { D3D_SHADER_REQUIRES_VIEWPORT_AND_RT_ARRAY_INDEX_FROM_ANY_SHADER_FEEDING_RASTERIZER, "Viewport/RT Array Index From Any Shader" },
+        { D3D_SHADER_REQUIRES_WAVE_OPS, "Wave Ops" },
+        { D3D_SHADER_REQUIRES_INT64_OPS, "Int64 Ops" },
+        { D3D_SHADER_REQUIRES_VIEW_ID, "View ID" },
+        { D3D_SHADER_REQUIRES_BARYCENTRICS, "Barycentrics" },
+        { D3D_SHADER_REQUIRES_NATIVE_16BIT_OPS, "Native 16-bit Ops" },
+        { D3D_SHADER_REQUIRES_SHADING_RATE, "Shading Rate" },
+        { D3D_SHADER_REQUIRES_RAYTRACING_TIER_1_1, "Raytracing Tier 1.1" },
+        { D3D_SHADER_REQUIRES_SAMPLER_FEEDBACK, "Sampler Feedback" },
+        { D3D_SHADER_REQUIRES_ATOMIC_INT64_ON_TYPED_RESOURCE, "Atomic Int64 On Typed Resource" },
+        { D3D_SHADER_REQUIRES_ATOMIC_INT64_ON_GROUP_SHARED, "Atomic Int64 On Group Shared" },
+        { D3D_SHADER_REQUIRES_DERIVATIVES_IN_MESH_AND_AMPLIFICATION_SHADERS, "Derivatives In Mesh/Amplification Shaders" },
+        { D3D_SHADER_REQUIRES_RESOURCE_DESCRIPTOR_HEAP_INDEXING, "Resource Descriptor Heap Indexing" },
+        { D3D_SHADER_REQUIRES_SAMPLER_DESCRIPTOR_HEAP_INDEXING, "Sampler Descriptor Heap Indexing" },
+        { D3D_SHADER_REQUIRES_WAVE_MMA, "Wave MMA" },
+    };
+
+    QStringList names;
+    for (const auto &feature : kFeatures) {
+        if (flags & feature.flag) {
+            names << feature.name;
+        }
+    }
+    return names;
+}
+
+// 填充成员的公共字段，数组步长按 cbuffer 16 字节寄存器对齐计算
+static ShaderReflectionMember makeMember(const QString &name, const D3D12_SHADER_TYPE_DESC &typeDesc, uint32_t offset, uint32_t absoluteOffset)
+{
+    ShaderReflectionMember member;
+    member.name = name;
+    member.typeName = typeNameOf(typeDesc);
+    member.offset = offset;
+    member.absoluteOffset = absoluteOffset;
+    member.rowMajor = typeDesc.Class == D3D_SVC_MATRIX_ROWS;
+
+    if (typeDesc.Class == D3D_SVC_MATRIX_ROWS || typeDesc.Class == D3D_SVC_MATRIX_COLUMNS) {
+        member.matrixStride = 16;
+    }
+
+    if (typeDesc.Elements > 0) {
+        member.arrayDims.append(typeDesc.Elements);
+        if (typeDesc.Class != D3D_SVC_STRUCT) {
+            uint32_t registerCount = typeDesc.Class == D3D_SVC_MATRIX_ROWS ? typeDesc.Rows : (typeDesc.Class == D3D_SVC_MATRIX_COLUMNS ? typeDesc.Columns : 1);
+            member.arrayStride = registerCount * 16;
+        }
+    }
+    return member;
+}
+
+// 递归填充结构体成员，成员大小由相邻成员偏移推算（含填充）
+static void fillMembers(ID3D12ShaderReflectionType *type, uint32_t parentAbsoluteOffset, uint32_t parentSize, QVector<ShaderReflectionMember> &members)
+{
+    D3D12_SHADER_TYPE_DESC typeDesc;
+    if (type == nullptr || FAILED(type->GetDesc(&typeDesc))) {
+        return;
+    }
+
+    QVector<ID3D12ShaderReflectionType *> memberTypes;
+    for (UINT i = 0; i < typeDesc.Members; ++i) {
+        ID3D12ShaderReflectionType *memberType = type->GetMemberTypeByIndex(i);
+        D3D12_SHADER_TYPE_DESC memberDesc;
+        if (memberType == nullptr || FAILED(memberType->GetDesc(&memberDesc))) {
+            continue;
+        }
+
+        LPCSTR memberName = type->GetMemberTypeName(i);
+        members.append(makeMember(memberName ? QString(memberName) : QString(), memberDesc, memberDesc.Offset, parentAbsoluteOffset + memberDesc.Offset));
+        memberTypes.append(memberType);
+    }
+
+    for (int i = 0; i < members.size(); ++i) {
+        uint32_t end = i + 1 < members.size() ? members[i + 1].offset : parentSize;
+        members[i].size = end > members[i].offset ? end - members[i].offset : 0;
+        members[i].paddedSize = members[i].size;
+
+        D3D12_SHADER_TYPE_DESC memberDesc;
+        memberTypes[i]->GetDesc(&memberDesc);
+        if (memberDesc.Class == D3D_SVC_STRUCT) {
+            uint32_t elementSize = memberDesc.Elements > 0 ? members[i].size / memberDesc.Elements : members[i].size;
+            fillMembers(memberTypes[i], members[i].absoluteOffset, elementSize, members[i].members);
+        }
+    }
+}
+
+// 子成员沿用顶层变量的使用标记，D3D12 只报告顶层变量是否被读取
+static void markAccessed(QVector<ShaderReflectionMember> &members, bool accessed)
+{
+    for (ShaderReflectionMember &member : members) {
+        member.accessed = accessed;
+        markAccessed(member.members, accessed);
+    }
+}
+
+static void fillConstantBuffer(ID3D12ShaderReflectionConstantBuffer *constantBuffer, ShaderReflectionBinding &binding)
+{
+    D3D12_SHADER_BUFFER_DESC bufferDesc;
+    if (constantBuffer == nullptr || FAILED(constantBuffer->GetDesc(&bufferDesc))) {
+        return;
+    }
+
+    binding.blockSize = bufferDesc.Size;
+    for (UINT i = 0; i < bufferDesc.Variables; ++i) {
+        ID3D12ShaderReflectionVariable *variable = constantBuffer->GetVariableByIndex(i);
+        D3D12_SHADER_VARIABLE_DESC variableDesc;
+        D3D12_SHADER_TYPE_DESC typeDesc;
+        if (variable == nullptr || FAILED(variable->GetDesc(&variableDesc)) || FAILED(variable->GetType()->GetDesc(&typeDesc))) {
+            continue;
+        }
+
+        ShaderReflectionMember member = makeMember(QString(variableDesc.Name), typeDesc, variableDesc.StartOffset, variableDesc.StartOffset);
+        member.size = variableDesc.Size;
+        member.paddedSize = variableDesc.Size;
+        if (typeDesc.Class == D3D_SVC_STRUCT) {
+            uint32_t elementSize = typeDesc.Elements > 0 ? variableDesc.Size / typeDesc.Elements : variableDesc.Size;
+            fillMembers(variable->GetType(), variableDesc.StartOffset, elementSize, member.members);
+        }
+        member.accessed = (variableDesc.uFlags & D3D_SVF_USED) != 0;
+        markAccessed(member.members, member.accessed);
+        binding.members.append(member);
+    }
+}
+
+static void fillSignature(ID3D12ShaderReflection *shaderReflection, UINT count, bool isInput, QVector<ShaderReflectionInterfaceVariable> &variables)
+{
+    for (UINT i = 0; i < count; ++i) {
+        D3D12_SIGNATURE_PARAMETER_DESC parameterDesc;
+        HRESULT hr = isInput ? shaderReflection->GetInputParameterDesc(i, &parameterDesc) : shaderReflection->GetOutputParameterDesc(i, &parameterDesc);
+        if (FAILED(hr)) {
+            continue;
+        }
+
+        // Mask 中的位表示使用的寄存器分量
+        int componentCount = 0;
+        int firstComponent = -1;
+        for (int bit = 0; bit < 4; ++bit) {
+            if (parameterDesc.Mask & (1 << bit)) {
+                ++componentCount;
+                if (firstComponent < 0) {
+                    firstComponent = bit;
+                }
+            }
+        }
+
+        ShaderReflectionInterfaceVariable variable;
+        variable.semantic = QString("%1%2").arg(parameterDesc.SemanticName).arg(parameterDesc.SemanticIndex);
+        variable.name = variable.semantic;
+        variable.typeName = componentTypeName(parameterDesc.ComponentType) + (componentCount > 1 ? QString::number(componentCount) : QString());
+        variable.location = parameterDesc.Register;
+        variable.component = firstComponent < 0 ? 0 : firstComponent;
+        variable.builtIn = systemValueName(parameterDesc.SystemValueType);
+        variables.append(variable);
+    }
+}
+
+bool ReflectDxil(const QByteArray &dxilBinary, ShaderReflection &reflection, QString *error)
+{
+    reflection.clear();
+
+    ComPtr<IDxcUtils> utils;
+    if (FAILED(DxcCreateInstance(CLSID_DxcUtils, IID_PPV_ARGS(&utils)))) {
+        if (error) {
+            *error = "Failed to create IDxcUtils.";
+        }
+        return false;
+    }
+
+    // CreateReflection 直接读取调用者的内存
+    DxcBuffer buffer;
+    buffer.Ptr = dxilBinary.constData();
+    buffer.Size = static_cast<SIZE_T>(dxilBinary.size());
+    buffer.Encoding = DXC_CP_ACP;
+
+    ComPtr<ID3D12ShaderReflection> shaderReflection;
+    HRESULT hr = utils->CreateReflection(&buffer, IID_PPV_ARGS(&shaderReflection));
+    if (FAILED(hr)) {
+        if (error) {
+            *error = QString("CreateReflection failed with HRESULT 0x%1").arg(static_cast<quint32>(hr), 8, 16, QChar('0'));
+        }
+        return false;
+    }
+
+    D3D12_SHADER_DESC shaderDesc;
+    if (FAILED(shaderReflection->GetDesc(&shaderDesc))) {
+        if (error) {
+            *error = "Failed to get shader description.";
+        }
+        return false;
+    }
+
+    reflection.binaryType = "DXIL";
+    reflection.sourceLanguage = "HLSL";
+
+    // 入口函数及线程组大小
+    ShaderReflectionEntryPoint entryPoint;
+    entryPoint.stage = shaderStageName(shaderDesc.Version);
+    UINT sizeX = 0, sizeY = 0, sizeZ = 0;
+    shaderReflection->GetThreadGroupSize(&sizeX, &sizeY, &sizeZ);
+    entryPoint.localSize[0] = sizeX;
+    entryPoint.localSize[1] = sizeY;
+    entryPoint.localSize[2] = sizeZ;
+    reflection.entryPoints.append(entryPoint);
+
+    // 绑定的资源，set/binding 分别对应 space/register
+    for (UINT i = 0; i < shaderDesc.BoundResources; ++i) {
+        D3D12_SHADER_INPUT_BIND_DESC bindDesc;
+        if (FAILED(shaderReflection->GetResourceBindingDesc(i, &bindDesc))) {
+            continue;
+        }
+
+        ShaderReflectionBinding binding;
+        binding.name = QString(bindDesc.Name);
+        binding.typeName = resourceTypeName(bindDesc);
+        binding.descriptorType = resourceClassName(bindDesc.Type);
+        binding.set = bindDesc.Space;
+        binding.binding = bindDesc.BindPoint;
+        // 无界数组的 BindCount 为 0 或 UINT_MAX，统一记为 0
+        binding.count = bindDesc.BindCount == UINT_MAX ? 0 : bindDesc.BindCount;
+        if (binding.count != 1) {
+            binding.arrayDims.append(binding.count);
+        }
+        if (bindDesc.Type == D3D_SIT_CBUFFER || bindDesc.Type == D3D_SIT_TBUFFER) {
+            fillConstantBuffer(shaderReflection->GetConstantBufferByName(bindDesc.Name), binding);
+        }
+        reflection.descriptorBindings.append(binding);
+    }
+
+    // 输入输出签名
+    fillSignature(shaderReflection.Get(), shaderDesc.InputParameters, true, reflection.inputVariables);
+    fillSignature(shaderReflection.Get(), shaderDesc.OutputParameters, false, reflection.outputVariables);
+
+    reflection.requiredFeatures = requiredFeatureNames(shaderReflection->GetRequiresFlags());
+
+    return true;
+}
+
+bool DumpDxilReflectionInfo(const QString &dxilFilePath, QString &outputReflectionInfo, ShaderReflection *reflection)
+{
+    outputReflectionInfo = "";
+
+    QFile file(dxilFilePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    QByteArray byteArray = file.readAll();
+    file.close();
+
+    ShaderReflection localReflection;
+    ShaderReflection &target = reflection ? *reflection : localReflection;
+    if (!ReflectDxil(byteArray, target)) {
+        return false;
+    }
+
+    outputReflectionInfo = target.toText();
+    return true;
+}
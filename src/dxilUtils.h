@@ -0,0 +1,14 @@
+#ifndef DXILUTILS_H
+#define DXILUTILS_H
+#include <QString>
+#include <QByteArray>
+
+class ShaderReflection;
+
+// 通过 IDxcUtils::CreateReflection 反射内存中的 DXIL 容器
+bool ReflectDxil(const QByteArray &dxilBinary, ShaderReflection &reflection, QString *error = nullptr);
+
+// 反射 dxil 文件并输出文本摘要，reflection 非空时同时填充结构化反射数据
+bool DumpDxilReflectionInfo(const QString &dxilFilePath, QString &outputReflectionInfo, ShaderReflection *reflection = nullptr);
+
+#endif
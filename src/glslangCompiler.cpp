@@ -5,9 +5,11 @@
 #include <QTextStream>
 #include <QDir>
 #include "spirvUtils.h"
+#include "shaderIntermediateCache.h"
+#include "shaderReflection.h"
 
 // 构造函数，初始化 glslangCompiler。
-glslangCompiler::glslangCompiler(QObject *parent) : QObject(parent) {}
+glslangCompiler::glslangCompiler(QObject *parent) : QObject(parent), intermediateCache(nullptr), spirvOptimizeOptions("-O") {}
 
 // 编译方法，执行编译操作。
 void glslangCompiler::compile(const QString &shaderCode, 
@@ -21,7 +23,7 @@ void glslangCompiler::compile(const QString &shaderCode,
                               const QString &additionOptions)
 {
     // 使用临时文件来存储 Shader 代码
-    QString tempFilePath = QDir::temp().filePath("temp_shader.tempcode");
+    QString tempFilePath = QDir::temp().filePath(QString("temp_shader%1.tempcode").arg(tempFileTag));
     QFile tempFile(tempFilePath);
     if (!tempFile.open(QIODevice::WriteOnly | QIODevice::Text)) {
         emit compilationError("Failed to create temporary shader file.");
@@ -33,17 +35,42 @@ void glslangCompiler::compile(const QString &shaderCode,
 
     bool isHLSL = languageType == "HLSL";
 
-    QString outputFilePath = QDir::temp().filePath("output_shader.spv");
+    QString outputFilePath = QDir::temp().filePath(QString("output_shader%1.spv").arg(tempFileTag));
 
     QFile::remove(outputFilePath);
     QString command = buildCommand(tempFilePath, isHLSL, shaderModel, entryPoint, shaderType, outputType, includePaths, macros, outputFilePath, additionOptions);
     
-    QProcess process;
-    process.start(command);
-    process.waitForFinished();
+    // 前端编译结果只取决于源码及编译参数，与输出类型无关
+    QByteArray frontEndKey;
+    bool reuseFrontEnd = false;
+    QString output;
+    QString error;
+
+    if (intermediateCache) {
+        frontEndKey = ShaderIntermediateCache::makeKey(QStringList()
+            << "GLSLANG" << shaderCode << languageType << shaderModel << entryPoint << shaderType
+            << includePaths.join(";") << macros.join(";") << additionOptions
+            << ShaderIntermediateCache::includedFilesStamp(shaderCode, QDir::temp().absolutePath(), includePaths));
+
+        QByteArray frontEndBlob;
+        if (intermediateCache->findFrontEnd(frontEndKey, frontEndBlob, error)) {
+            reuseFrontEnd = ShaderIntermediateCache::writeBlob(outputFilePath, frontEndBlob);
+        }
+    }
+
+    if (!reuseFrontEnd) {
+        QProcess process;
+        process.start(command);
+        process.waitForFinished();
 
-    QString output = process.readAllStandardOutput();
-    QString error = process.readAllStandardError();
+        output = process.readAllStandardOutput();
+        error = process.readAllStandardError();
+
+        QByteArray frontEndBlob;
+        if (!frontEndKey.isEmpty() && ShaderIntermediateCache::readBlob(outputFilePath, frontEndBlob)) {
+            intermediateCache->storeFrontEnd(frontEndKey, frontEndBlob, error);
+        }
+    }
 
     // 判断编译是否成功
     if (!QFile::exists(outputFilePath)) {
@@ -54,10 +81,21 @@ void glslangCompiler::compile(const QString &shaderCode,
     } else {
         QProcess process;
 
-        // 优化spirv
-        QString spirvOptCommand = QString("spirv-opt -O \"%1\" -o \"%1\"").arg(outputFilePath);
-        process.start(spirvOptCommand);
-        process.waitForFinished();
+        // 优化spirv，相同前端结果及优化参数的优化结果直接复用
+        QByteArray optimizedBlob;
+        if (!frontEndKey.isEmpty() && intermediateCache->findOptimized(frontEndKey, spirvOptimizeOptions, optimizedBlob)) {
+            ShaderIntermediateCache::writeBlob(outputFilePath, optimizedBlob);
+        } else {
+            if (!spirvOptimizeOptions.isEmpty()) {
+                QString spirvOptCommand = QString("spirv-opt %1 \"%2\" -o \"%2\"").arg(spirvOptimizeOptions).arg(outputFilePath);
+                process.start(spirvOptCommand);
+                process.waitForFinished();
+            }
+
+            if (!frontEndKey.isEmpty() && ShaderIntermediateCache::readBlob(outputFilePath, optimizedBlob)) {
+                intermediateCache->storeOptimized(frontEndKey, spirvOptimizeOptions, optimizedBlob);
+            }
+        }
 
         if (outputType == "SPIR-V"){
             // 使用spirv-dis反编译SPIR-V
@@ -81,11 +119,18 @@ void glslangCompiler::compile(const QString &shaderCode,
         if (output.isEmpty()) {
             emit compilationError(errorDisasm.isEmpty() ? "Compilation failed with no output." : errorDisasm);
         } else {
-            if (outputType == "SPIR-V") {
-                QString outputReflectionInfo;
-                if (DumpSpirVReflectionInfo(outputFilePath, outputReflectionInfo)) {
+            QString outputReflectionInfo;
+            ShaderReflection reflection;
+            if (DumpSpirVReflectionInfo(outputFilePath, outputReflectionInfo, &reflection)) {
+                if (outputType == "SPIR-V") {
                     output = output + "\n" + outputReflectionInfo;
                 }
+                emit reflectionGenerated(reflection);
+            }
+
+            QByteArray spirvBinary;
+            if (ShaderIntermediateCache::readBlob(outputFilePath, spirvBinary)) {
+                emit binaryGenerated(spirvBinary, "SPIR-V", QString());
             }
 
             emit compilationFinished(output);
@@ -4,6 +4,10 @@
 #include <QString>
 #include <QObject>
 #include <QStringList>
+#include <QByteArray>
+#include "shaderReflection.h"
+
+class ShaderIntermediateCache;
 
 // glslangCompiler 类用于管理 glslang 编译器的编译过程。
 class glslangCompiler : public QObject {
@@ -20,6 +24,15 @@ public:
                  const QStringList &includePaths, const QStringList &macros,
                  const QString &additionOptions);
 
+    // 设置文档的中间结果缓存，输入未变化时复用上次的 SPIR-V 只重新执行优化、反汇编等下游步骤
+    void setIntermediateCache(ShaderIntermediateCache *cache) { intermediateCache = cache; }
+
+    // 设置 spirv-opt 参数（如 -O、-Os），为空时不优化
+    void setSpirvOptimizeOptions(const QString &options) { spirvOptimizeOptions = options; }
+
+    // 设置临时文件名后缀，多个实例并行编译时用于区分临时文件
+    void setTempFileTag(const QString &tag) { tempFileTag = tag; }
+
 signals:
     // 编译完成信号，携带输出结果。
     void compilationFinished(const QString &output);
@@ -30,6 +43,12 @@ signals:
     // 编译警告信号，携带警告信息。
     void compilationWarning(const QString &warning);
 
+    // 反射数据生成信号，携带 SPIR-V 结构化反射数据。
+    void reflectionGenerated(const ShaderReflection &reflection);
+
+    // 编译产物信号，携带二进制内容、类型（SPIR-V/DXIL）及 DXIL 反汇编文本，用于代价分析。
+    void binaryGenerated(const QByteArray &binary, const QString &binaryType, const QString &disassembly);
+
 private:
     // 构建编译命令的方法。
     QString buildCommand(const QString &tempFilePath,  
@@ -42,6 +61,10 @@ private:
                          const QStringList &macros,
                          const QString &outputFilePath,
                          const QString &additionOptions);
+
+    ShaderIntermediateCache *intermediateCache; // 由文档持有的中间结果缓存
+    QString spirvOptimizeOptions; // spirv-opt 参数
+    QString tempFileTag; // 临时文件名后缀
 };
 
 #endif // GLSLANGCOMPILER_H
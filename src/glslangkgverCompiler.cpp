@@ -5,10 +5,16 @@
 #include <QFile>
 #include <QTextStream>
 #include <QDir>
+#include <QElapsedTimer>
+#include <QRegularExpression>
+#include <QMutex>
+#include <QMutexLocker>
+#include <future>
 #include "spirvUtils.h"
+#include "shaderIntermediateCache.h"
 
 // 构造函数，初始化 glslangkgverCompiler
-glslangkgverCompiler::glslangkgverCompiler(QObject *parent) : QObject(parent) {}
+glslangkgverCompiler::glslangkgverCompiler(QObject *parent) : QObject(parent), emitLineDirectives(false), codePrebuilderCache(nullptr), intermediateCache(nullptr), spirvOptimizeOptions("-O") {}
 
 // 编译方法，执行编译操作。
 void glslangkgverCompiler::compile(const QString &shaderCode,
@@ -20,80 +26,268 @@ void glslangkgverCompiler::compile(const QString &shaderCode,
                               const QStringList &macros, 
                               const QString &additionOptions)
 {
-    GlslKgverCodePrebuilder codePrebuilder(includePaths);
-    QString combinedShaderCode = codePrebuilder.parse(shaderCode, entryPoint);
-    QString shaderHeader;
+    // 未设置外部预处理器时使用临时预处理器，每次都完整展开
+    GlslKgverCodePrebuilder localPrebuilder(includePaths);
+    GlslKgverCodePrebuilder &codePrebuilder = codePrebuilderCache ? *codePrebuilderCache : localPrebuilder;
+    codePrebuilder.setIncludePaths(includePaths);
+    codePrebuilder.setEmitLineDirectives(emitLineDirectives);
+    codePrebuilder.setLinkedLibraries(linkedLibraries);
+    codePrebuilder.setShaderCode(shaderCode);
 
-    if (shaderType == "Vertex")
-    {
-        shaderHeader = 
-            "#version 450\r\n"
-            "#extension GL_ARB_separate_shader_objects : enable\r\n"
-            "#extension GL_ARB_shading_language_420pack : enable\r\n"
-            "#define SHADER_API 450\r\n";
+    StageCompileResult result = compileStage(codePrebuilder, entryPoint, shaderModel, shaderType, outputType, includePaths, macros, additionOptions, tempFileTag);
+
+    if (!result.success) {
+        emit compilationError(result.error);
+        return;
     }
-    else if (shaderType == "Compute")
-    {
-        shaderHeader = 
-            "#version 450\r\n"
-            "#extension GL_ARB_separate_shader_objects : enable\r\n"
-            "#extension GL_ARB_shading_language_420pack : enable\r\n"
-            "#define SHADER_API 450\r\n";
+
+    emit compilationFinished(result.output);
+
+    if (result.hasReflection) {
+        emit reflectionGenerated(result.reflection);
     }
-    else if (shaderType == "Pixel" || shaderType == "Fragment")
-    {
-        shaderHeader = 
-            "#version 450\r\n"
-            "#extension GL_ARB_separate_shader_objects : enable\r\n"
-            "#extension GL_ARB_shading_language_420pack : enable\r\n"
-            "#define SHADER_API 450\r\n";
+
+    if (!result.binary.isEmpty()) {
+        emit binaryGenerated(result.binary, "SPIR-V", QString());
+    }
+
+    // 编译器及反汇编工具的输出作为警告信息
+    for (const QString &warning : result.warnings) {
+        emit compilationWarning(warning);
+    }
+}
+
+// 同时编译所有阶段的代码块，各阶段共享已解析的包含文件并行编译
+void glslangkgverCompiler::compileAllStages(const QString &shaderCode,
+                                            const QString &shaderModel,
+                                            const QString &outputType,
+                                            const QStringList &includePaths,
+                                            const QStringList &macros,
+                                            const QString &additionOptions)
+{
+    QElapsedTimer totalTimer;
+    totalTimer.start();
+
+    GlslKgverCodePrebuilder localPrebuilder(includePaths);
+    GlslKgverCodePrebuilder &basePrebuilder = codePrebuilderCache ? *codePrebuilderCache : localPrebuilder;
+    basePrebuilder.setIncludePaths(includePaths);
+    basePrebuilder.setEmitLineDirectives(emitLineDirectives);
+    basePrebuilder.setLinkedLibraries(linkedLibraries);
+    basePrebuilder.setShaderCode(shaderCode);
+    basePrebuilder.preloadIncludes();
+
+    // 按 Vertex、Pixel、Compute 顺序收集阶段代码块
+    QStringList stageTypes = QStringList() << "Vertex" << "Pixel" << "Compute";
+    QList<QPair<QString, QString>> stageSections; // 阶段类型, 代码块名称
+    for (const QString &stageType : stageTypes) {
+        for (const QString &sectionName : basePrebuilder.getSectionNames()) {
+            if (stageFromSectionName(sectionName) == stageType) {
+                stageSections.append(qMakePair(stageType, sectionName));
+            }
+        }
+    }
+
+    if (stageSections.isEmpty()) {
+        emit compilationError("No stage sections found, name sections like [VS]/[PS]/[CS] or [vertex]/[pixel]/[compute].");
+        return;
+    }
+
+    // 先在共享的预处理器上依次展开各阶段代码块，填充增量预处理缓存；
+    // 阶段拷贝只在各自线程中复用缓存，展开结果不会随拷贝丢弃，下次编译也能命中
+    for (const auto &stageSection : stageSections) {
+        basePrebuilder.parseSection(stageSection.second);
+    }
+
+    // 每个阶段使用预处理器的拷贝，在各自线程中编译
+    std::vector<std::future<StageCompileResult>> stageFutures;
+    for (const auto &stageSection : stageSections) {
+        QString stageType = stageSection.first;
+        QString sectionName = stageSection.second;
+        QString stageFileTag = QString("%1_%2_%3").arg(tempFileTag).arg(stageType.toLower()).arg(stageFutures.size());
+        stageFutures.push_back(std::async(std::launch::async, [=, &basePrebuilder]() {
+            GlslKgverCodePrebuilder stagePrebuilder = basePrebuilder;
+            return compileStage(stagePrebuilder, sectionName, shaderModel, stageType, outputType, includePaths, macros, additionOptions, stageFileTag);
+        }));
+    }
+
+    double slowestStageSeconds = 0.0;
+    QList<StageCompileResult> stageResults;
+    for (auto &stageFuture : stageFutures) {
+        StageCompileResult result = stageFuture.get();
+        slowestStageSeconds = qMax(slowestStageSeconds, result.costSeconds);
+        stageResults.append(result);
+    }
+
+    double totalSeconds = totalTimer.nsecsElapsed() / 1e9;
+
+    for (int i = 0; i < stageResults.size(); ++i) {
+        const StageCompileResult &result = stageResults[i];
+        QString stageHeader = QString("// ===== %1 (section: %2, cost time: %3s) =====\n")
+            .arg(result.shaderType)
+            .arg(result.sectionName)
+            .arg(result.costSeconds);
+
+        QString stageSummary;
+        if (i == stageResults.size() - 1) {
+            stageSummary = QString("\n// all stages cost time: %1s, slowest stage: %2s").arg(totalSeconds).arg(slowestStageSeconds);
+        }
+
+        if (!result.success) {
+            emit compilationError(stageHeader + result.error + stageSummary);
+            continue;
+        }
+
+        emit compilationFinished(stageHeader + result.output + stageSummary);
+
+        if (result.hasReflection) {
+            emit reflectionGenerated(result.reflection);
+        }
+
+        if (!result.binary.isEmpty()) {
+            emit binaryGenerated(result.binary, "SPIR-V", QString());
+        }
+
+        for (const QString &warning : result.warnings) {
+            emit compilationWarning(stageHeader + warning);
+        }
+    }
+}
+
+// 根据代码块名称推断着色器阶段，如 VS、mainVS、vertex、PS_Main、frag、CS 等
+QString glslangkgverCompiler::stageFromSectionName(const QString &sectionName)
+{
+    QString separatedName = sectionName;
+    separatedName.replace(QRegularExpression("([a-z0-9])([A-Z])"), "\\1_\\2");
+    QStringList tokens = separatedName.toLower().split(QRegularExpression("[^a-z0-9]+"), QString::SkipEmptyParts);
+
+    static const QStringList vertexTokens = QStringList() << "vs" << "vert" << "vertex";
+    static const QStringList pixelTokens = QStringList() << "ps" << "fs" << "frag" << "fragment" << "pixel";
+    static const QStringList computeTokens = QStringList() << "cs" << "comp" << "compute";
+
+    for (const QString &token : tokens) {
+        if (vertexTokens.contains(token)) return "Vertex";
+        if (pixelTokens.contains(token)) return "Pixel";
+        if (computeTokens.contains(token)) return "Compute";
+    }
+    return QString();
+}
+
+// 展开并编译单个阶段的代码块，不发送信号，可在工作线程中调用
+glslangkgverCompiler::StageCompileResult glslangkgverCompiler::compileStage(GlslKgverCodePrebuilder &codePrebuilder,
+                                                                             const QString &sectionName,
+                                                                             const QString &shaderModel,
+                                                                             const QString &shaderType,
+                                                                             const QString &outputType,
+                                                                             const QStringList &includePaths,
+                                                                             const QStringList &macros,
+                                                                             const QString &additionOptions,
+                                                                             const QString &tempFileTag) const
+{
+    StageCompileResult result;
+    result.shaderType = shaderType;
+    result.sectionName = sectionName;
+    result.success = false;
+    result.costSeconds = 0.0;
+    result.hasReflection = false;
+
+    QElapsedTimer stageTimer;
+    stageTimer.start();
+
+    QString combinedShaderCode = codePrebuilder.parseSection(sectionName);
+    QString shaderHeader = buildShaderHeader(shaderType);
+
+    // 引用了预编译库时，主模块只包含库函数声明，以 --no-link 编译后与库模块链接
+    QStringList libraryPaths = codePrebuilder.getUsedLinkedLibraryPaths();
+    QStringList librarySources;
+    for (const QString &libraryPath : libraryPaths) {
+        librarySources.append(codePrebuilder.getLinkedLibrarySource(libraryPath));
+    }
+    QString compileOptions = additionOptions;
+    if (!libraryPaths.isEmpty()) {
+        compileOptions = (compileOptions + " --no-link").trimmed();
     }
 
     combinedShaderCode = shaderHeader + combinedShaderCode;
 
-    // 使用临时文件来存储 Shader 代码
-    QString tempFilePath = QDir::temp().filePath("temp_shader.tempcode");
+    // 使用临时文件来存储 Shader 代码，并行编译时以 tempFileTag 区分
+    QString tempFilePath = QDir::temp().filePath(QString("temp_shader%1.tempcode").arg(tempFileTag));
     QFile tempFile(tempFilePath);
     if (!tempFile.open(QIODevice::WriteOnly | QIODevice::Text)) {
-        emit compilationError("Failed to create temporary shader file.");
-        return;
+        result.error = "Failed to create temporary shader file.";
+        return result;
     }
     QTextStream out(&tempFile);
     out << combinedShaderCode;  // 写入 Shader 代码
     tempFile.close();
 
-    QString outputFilePath = QDir::temp().filePath("output_shader.spv");
+    QString outputFilePath = QDir::temp().filePath(QString("output_shader%1.spv").arg(tempFileTag));
 
     QFile::remove(outputFilePath);
-    QString command = buildCommand(tempFilePath, shaderModel, shaderType, outputType, includePaths, macros, outputFilePath, additionOptions);
+    QString command = buildCommand(tempFilePath, shaderModel, shaderType, outputType, includePaths, macros, outputFilePath, compileOptions);
     
-    QProcess process;
-    process.start(command);
-    process.waitForFinished();
+    // 前端结果（编译并链接预编译库后的 SPIR-V）只取决于展开后的代码及编译参数，与输出类型无关
+    QByteArray frontEndKey;
+    bool reuseFrontEnd = false;
+    QString output;
+    QString error;
+
+    if (intermediateCache) {
+        frontEndKey = ShaderIntermediateCache::makeKey(QStringList()
+            << "GLSLANGKGVER" << combinedShaderCode << librarySources.join("\n") << shaderModel << shaderType
+            << includePaths.join(";") << macros.join(";") << compileOptions);
+
+        QByteArray frontEndBlob;
+        if (intermediateCache->findFrontEnd(frontEndKey, frontEndBlob, error)) {
+            reuseFrontEnd = ShaderIntermediateCache::writeBlob(outputFilePath, frontEndBlob);
+        }
+    }
 
-    QString output = process.readAllStandardOutput();
-    QString error = process.readAllStandardError();
+    if (!reuseFrontEnd) {
+        QProcess process;
+        process.start(command);
+        process.waitForFinished();
+
+        output = process.readAllStandardOutput();
+        error = process.readAllStandardError();
+    }
 
     // 判断编译是否成功
     if (!QFile::exists(outputFilePath)) {
         if (!output.isEmpty())
         {
-            error = TransformGlslKgverCodeErrors(codePrebuilder, tempFilePath, output);
+            error = TransformGlslKgverCodeErrors(codePrebuilder, tempFilePath, combinedShaderCode, output);
 
-            error = error + "\n" + codePrebuilder.getErrorLog();
-            emit compilationError(error);
+            result.error = error + "\n" + codePrebuilder.getErrorLog();
         }
         else
         {
-            emit compilationError(error.isEmpty() ? "Compilation failed with no output." : error);
+            result.error = error.isEmpty() ? "Compilation failed with no output." : error;
         }
+    } else if (!reuseFrontEnd && !linkLibraryModules(outputFilePath, libraryPaths, librarySources, shaderModel, shaderType, outputType, includePaths, macros, additionOptions, tempFileTag, result.error)) {
+        // 库模块编译或链接失败，错误信息已写入 result.error
     } else {
         QProcess process;
 
-        // 优化spirv
-        QString spirvOptCommand = QString("spirv-opt -O \"%1\" -o \"%1\"").arg(outputFilePath);
-        process.start(spirvOptCommand);
-        process.waitForFinished();
+        QByteArray frontEndBlob;
+        if (!reuseFrontEnd && !frontEndKey.isEmpty() && ShaderIntermediateCache::readBlob(outputFilePath, frontEndBlob)) {
+            intermediateCache->storeFrontEnd(frontEndKey, frontEndBlob, error);
+        }
+
+        // 优化spirv，相同前端结果及优化参数的优化结果直接复用
+        QByteArray optimizedBlob;
+        if (!frontEndKey.isEmpty() && intermediateCache->findOptimized(frontEndKey, spirvOptimizeOptions, optimizedBlob)) {
+            ShaderIntermediateCache::writeBlob(outputFilePath, optimizedBlob);
+        } else {
+            if (!spirvOptimizeOptions.isEmpty()) {
+                QString spirvOptCommand = QString("spirv-opt %1 \"%2\" -o \"%2\"").arg(spirvOptimizeOptions).arg(outputFilePath);
+                process.start(spirvOptCommand);
+                process.waitForFinished();
+            }
+
+            if (!frontEndKey.isEmpty() && ShaderIntermediateCache::readBlob(outputFilePath, optimizedBlob)) {
+                intermediateCache->storeOptimized(frontEndKey, spirvOptimizeOptions, optimizedBlob);
+            }
+        }
 
         if (outputType == "SPIR-V"){
             // 使用spirv-dis反编译SPIR-V
@@ -115,24 +309,27 @@ void glslangkgverCompiler::compile(const QString &shaderCode,
         QString errorDisasm = process.readAllStandardError();
 
         if (output.isEmpty()) {
-            emit compilationError(errorDisasm.isEmpty() ? "Compilation failed with no output." : errorDisasm);
+            result.error = errorDisasm.isEmpty() ? "Compilation failed with no output." : errorDisasm;
         } else {
-            if (outputType == "SPIR-V") {
-                QString outputReflectionInfo;
-                if (DumpSpirVReflectionInfo(outputFilePath, outputReflectionInfo)) {
+            QString outputReflectionInfo;
+            if (DumpSpirVReflectionInfo(outputFilePath, outputReflectionInfo, &result.reflection)) {
+                if (outputType == "SPIR-V") {
                     output = output + "\n" + outputReflectionInfo;
                 }
+                result.hasReflection = true;
             }
+            ShaderIntermediateCache::readBlob(outputFilePath, result.binary);
 
-            emit compilationFinished(output);
+            result.success = true;
+            result.output = output;
 
             // 如果 error 非空，将其输出为警告信息
             if (!error.isEmpty()) {
-                emit compilationWarning(error);  // 直接发出错误信号
+                result.warnings.append(error);
             }
 
             if (!errorDisasm.isEmpty()) {
-                emit compilationWarning(errorDisasm);
+                result.warnings.append(errorDisasm);
             }
         }
     }
@@ -140,6 +337,154 @@ void glslangkgverCompiler::compile(const QString &shaderCode,
     // 删除临时文件
     QFile::remove(tempFilePath);
     QFile::remove(outputFilePath);
+
+    result.costSeconds = stageTimer.nsecsElapsed() / 1e9;
+    return result;
+}
+
+// 生成着色器头部代码
+QString glslangkgverCompiler::buildShaderHeader(const QString &shaderType) const
+{
+    QString shaderHeader;
+
+    if (shaderType == "Vertex")
+    {
+        shaderHeader = 
+            "#version 450\r\n"
+            "#extension GL_ARB_separate_shader_objects : enable\r\n"
+            "#extension GL_ARB_shading_language_420pack : enable\r\n"
+            "#define SHADER_API 450\r\n";
+    }
+    else if (shaderType == "Compute")
+    {
+        shaderHeader = 
+            "#version 450\r\n"
+            "#extension GL_ARB_separate_shader_objects : enable\r\n"
+            "#extension GL_ARB_shading_language_420pack : enable\r\n"
+            "#define SHADER_API 450\r\n";
+    }
+    else if (shaderType == "Pixel" || shaderType == "Fragment")
+    {
+        shaderHeader = 
+            "#version 450\r\n"
+            "#extension GL_ARB_separate_shader_objects : enable\r\n"
+            "#extension GL_ARB_shading_language_420pack : enable\r\n"
+            "#define SHADER_API 450\r\n";
+    }
+
+    if (emitLineDirectives)
+    {
+        // 允许 #line 指令携带文件名
+        shaderHeader += "#extension GL_GOOGLE_cpp_style_line_directive : require\r\n";
+    }
+
+    return shaderHeader;
+}
+
+// 编译预编译库并与主模块链接，库模块按内容作为前端结果存入中间结果缓存，随缓存一起按最近使用淘汰
+bool glslangkgverCompiler::linkLibraryModules(const QString &moduleFilePath,
+                                              const QStringList &libraryPaths,
+                                              const QStringList &librarySources,
+                                              const QString &shaderModel,
+                                              const QString &shaderType,
+                                              const QString &outputType,
+                                              const QStringList &includePaths,
+                                              const QStringList &macros,
+                                              const QString &additionOptions,
+                                              const QString &tempFileTag,
+                                              QString &error) const
+{
+    if (libraryPaths.isEmpty()) {
+        return true;
+    }
+
+    // 并行编译多个阶段时，避免同时生成同一个库模块
+    static QMutex libraryCacheMutex;
+
+    // 库模块只在链接期间写入临时文件
+    QStringList libraryModulePaths;
+    auto removeLibraryModules = [&libraryModulePaths]() {
+        for (const QString &libraryModulePath : libraryModulePaths) {
+            QFile::remove(libraryModulePath);
+        }
+    };
+
+    for (int i = 0; i < libraryPaths.size(); ++i) {
+        QString librarySource = buildShaderHeader(shaderType) + librarySources[i];
+        QString libraryOptions = (additionOptions + " --no-link").trimmed();
+
+        // 库源码、阶段、宏定义及编译选项都参与缓存键
+        QByteArray libraryKey = ShaderIntermediateCache::makeKey(QStringList()
+            << "GLSLKGVER_LIBRARY" << librarySource << shaderType << macros.join(";") << includePaths.join(";")
+            << libraryOptions << (emitLineDirectives ? "g" : ""));
+
+        QString libraryModulePath = QDir::temp().filePath(QString("output_shader%1_lib%2.spv").arg(tempFileTag).arg(i));
+        libraryModulePaths.append(libraryModulePath);
+
+        QMutexLocker locker(&libraryCacheMutex);
+        QByteArray libraryBlob;
+        QString libraryWarning;
+        if (intermediateCache && intermediateCache->findFrontEnd(libraryKey, libraryBlob, libraryWarning)
+            && ShaderIntermediateCache::writeBlob(libraryModulePath, libraryBlob)) {
+            continue;
+        }
+
+        QString librarySourcePath = QDir::temp().filePath(QString("output_shader%1_lib%2.tempcode").arg(tempFileTag).arg(i));
+        QFile librarySourceFile(librarySourcePath);
+        if (!librarySourceFile.open(QIODevice::WriteOnly | QIODevice::Text)) {
+            error = "Failed to create temporary library file.";
+            removeLibraryModules();
+            return false;
+        }
+        QTextStream out(&librarySourceFile);
+        out << librarySource;
+        librarySourceFile.close();
+
+        QFile::remove(libraryModulePath);
+        QString command = buildCommand(librarySourcePath, shaderModel, shaderType, outputType, includePaths, macros, libraryModulePath, libraryOptions);
+
+        QProcess process;
+        process.start(command);
+        process.waitForFinished();
+
+        QString output = process.readAllStandardOutput();
+        QString libraryError = process.readAllStandardError();
+        QFile::remove(librarySourcePath);
+
+        if (!ShaderIntermediateCache::readBlob(libraryModulePath, libraryBlob)) {
+            error = QString("Failed to compile linked library \"%1\":\n%2%3").arg(libraryPaths[i]).arg(output).arg(libraryError);
+            removeLibraryModules();
+            return false;
+        }
+        if (intermediateCache) {
+            intermediateCache->storeFrontEnd(libraryKey, libraryBlob, QString());
+        }
+    }
+
+    QString linkedFilePath = QDir::temp().filePath(QString("output_shader%1_linked.spv").arg(tempFileTag));
+    QFile::remove(linkedFilePath);
+
+    QString linkCommand = QString("spirv-link \"%1\"").arg(moduleFilePath);
+    for (const QString &libraryModulePath : libraryModulePaths) {
+        linkCommand += QString(" \"%1\"").arg(libraryModulePath);
+    }
+    linkCommand += QString(" -o \"%1\"").arg(linkedFilePath);
+
+    QProcess process;
+    process.start(linkCommand);
+    process.waitForFinished();
+    removeLibraryModules();
+
+    if (!QFile::exists(linkedFilePath)) {
+        QString linkError = process.readAllStandardError();
+        error = "spirv-link failed:\n" + (linkError.isEmpty() ? QString(process.readAllStandardOutput()) : linkError);
+        return false;
+    }
+
+    // 用链接后的模块替换主模块
+    QFile::remove(moduleFilePath);
+    QFile::rename(linkedFilePath, moduleFilePath);
+    return true;
 }
 
 QString glslangkgverCompiler::buildCommand(
@@ -151,7 +496,7 @@ QString glslangkgverCompiler::buildCommand(
                                       const QStringList &macros,
                                       const QString &outputFilePath, 
                                       const QString &additionOptions
-                                      )
+                                      ) const
 {
     // 基础命令
     QString command = "glslangValidator";
@@ -179,6 +524,11 @@ QString glslangkgverCompiler::buildCommand(
     command += " --auto-map-bindings";
     command += " --auto-map-locations";
 
+    // 生成调试信息，使 SPIR-V 中的 OpLine/OpSource 指向 #line 标记的原始文件
+    if (emitLineDirectives) {
+        command += " -g";
+    }
+
     if (!additionOptions.isEmpty()) {
         command += " " + additionOptions;
     }
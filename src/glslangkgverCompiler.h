@@ -4,6 +4,11 @@
 #include <QString>
 #include <QObject>
 #include <QStringList>
+#include <QByteArray>
+#include "shaderReflection.h"
+#include "glslkgverCodePrebuilder.h"
+
+class ShaderIntermediateCache;
 
 // glslangkgverCompiler 类用于管理 glslangkgver 编译器的编译过程。
 class glslangkgverCompiler : public QObject {
@@ -19,6 +24,32 @@ public:
                  const QString &outputType, const QStringList &includePaths, 
                  const QStringList &macros, const QString &additionOptions);
 
+    // 同时编译文件中所有阶段（Vertex/Pixel/Compute）的代码块，各阶段并行编译并分别输出结果
+    void compileAllStages(const QString &shaderCode, const QString &shaderModel,
+                          const QString &outputType, const QStringList &includePaths,
+                          const QStringList &macros, const QString &additionOptions);
+
+    // 根据代码块名称推断着色器阶段，无法识别时返回空字符串
+    static QString stageFromSectionName(const QString &sectionName);
+
+    // 设置预处理时是否输出 #line 指令
+    void setEmitLineDirectives(bool enable) { emitLineDirectives = enable; }
+
+    // 设置跨次编译保留的预处理器，未变化的代码块直接复用上次的展开结果
+    void setCodePrebuilder(GlslKgverCodePrebuilder *prebuilder) { codePrebuilderCache = prebuilder; }
+
+    // 设置预编译链接的cginc库，库单独编译为 SPIR-V 模块后通过 spirv-link 链接
+    void setLinkedLibraries(const QStringList &libraryNames) { linkedLibraries = libraryNames; }
+
+    // 设置文档的中间结果缓存，输入未变化时复用上次的 SPIR-V 只重新执行优化、反汇编等下游步骤
+    void setIntermediateCache(ShaderIntermediateCache *cache) { intermediateCache = cache; }
+
+    // 设置 spirv-opt 参数（如 -O、-Os），为空时不优化
+    void setSpirvOptimizeOptions(const QString &options) { spirvOptimizeOptions = options; }
+
+    // 设置临时文件名后缀，多个实例并行编译时用于区分临时文件
+    void setTempFileTag(const QString &tag) { tempFileTag = tag; }
+
 signals:
     // 编译完成信号，携带输出结果。
     void compilationFinished(const QString &output);
@@ -29,7 +60,54 @@ signals:
     // 编译警告信号，携带警告信息。
     void compilationWarning(const QString &warning);
 
+    // 反射数据生成信号，携带 SPIR-V 结构化反射数据。
+    void reflectionGenerated(const ShaderReflection &reflection);
+
+    // 编译产物信号，携带二进制内容、类型（SPIR-V/DXIL）及 DXIL 反汇编文本，用于代价分析。
+    void binaryGenerated(const QByteArray &binary, const QString &binaryType, const QString &disassembly);
+
 private:
+    // 单个阶段的编译结果
+    struct StageCompileResult {
+        QString shaderType; // 着色器阶段
+        QString sectionName; // 代码块名称
+        bool success; // 是否编译成功
+        QString output; // 编译输出
+        QString error; // 错误信息
+        QStringList warnings; // 警告信息
+        double costSeconds; // 耗时（秒）
+        bool hasReflection; // 是否生成了反射数据
+        ShaderReflection reflection; // SPIR-V 反射数据
+        QByteArray binary; // SPIR-V 二进制，为空表示未生成
+    };
+
+    // 展开并编译单个阶段的代码块，不发送信号，可在工作线程中调用
+    StageCompileResult compileStage(GlslKgverCodePrebuilder &codePrebuilder,
+                                    const QString &sectionName,
+                                    const QString &shaderModel,
+                                    const QString &shaderType,
+                                    const QString &outputType,
+                                    const QStringList &includePaths,
+                                    const QStringList &macros,
+                                    const QString &additionOptions,
+                                    const QString &tempFileTag) const;
+
+    // 生成着色器头部代码
+    QString buildShaderHeader(const QString &shaderType) const;
+
+    // 编译引用的预编译库模块（按内容存入中间结果缓存）并用 spirv-link 链接到主模块，失败时返回 false 并写入 error
+    bool linkLibraryModules(const QString &moduleFilePath,
+                            const QStringList &libraryPaths,
+                            const QStringList &librarySources,
+                            const QString &shaderModel,
+                            const QString &shaderType,
+                            const QString &outputType,
+                            const QStringList &includePaths,
+                            const QStringList &macros,
+                            const QString &additionOptions,
+                            const QString &tempFileTag,
+                            QString &error) const;
+
     // 构建编译命令的方法。
     QString buildCommand(const QString &tempFilePath,  
                          const QString &shaderModel, 
@@ -38,7 +116,14 @@ private:
                          const QStringList &includePaths,
                          const QStringList &macros,
                          const QString &outputFilePath, 
-                         const QString &additionOptions);
+                         const QString &additionOptions) const;
+
+    bool emitLineDirectives; // 是否输出 #line 指令
+    GlslKgverCodePrebuilder *codePrebuilderCache; // 由调用者持有的增量预处理器
+    QStringList linkedLibraries; // 预编译链接的cginc库文件名
+    ShaderIntermediateCache *intermediateCache; // 由文档持有的中间结果缓存
+    QString spirvOptimizeOptions; // spirv-opt 参数
+    QString tempFileTag; // 临时文件名后缀
 };
 
 #endif // GLSLANGKGVERCOMPILER_H
@@ -1,9 +1,16 @@
 #include "glslkgverCodePrebuilder.h"
 #include <QRegularExpression>
+#include <QCryptographicHash>
+#include <QFileInfo>
 
 // 构造函数，初始化基础目录和包含路径
 GlslKgverCodePrebuilder::GlslKgverCodePrebuilder(const QStringList &includePaths) 
-    : includePaths(includePaths), includeDepth(0) {}
+    : includePaths(includePaths), includeDepth(0), emitLineDirectives(false), globalLineIter(0), reusedSectionCount(0), expandedSectionCount(0) {}
+
+static QByteArray contentHash(const QString &content)
+{
+    return QCryptographicHash::hash(content.toUtf8(), QCryptographicHash::Md5);
+}
 
 QString LoadCginc(const QString& strPath)
 {
@@ -45,22 +52,338 @@ QString LoadBaseMacroInc()
 
 // 解析着色器代码
 QString GlslKgverCodePrebuilder::parse(const QString &shaderCode, const QString &startSection) {
+    setShaderCode(shaderCode);
+    return parseSection(startSection);
+}
+
+void GlslKgverCodePrebuilder::setShaderCode(const QString &shaderCode)
+{
+    // 保留代码块展开缓存，只丢弃磁盘上已修改的包含文件
+    invalidateChangedIncludes();
+
+    mainFile = CodeIncludeFile();
+    initCodeSections(mainFile, shaderCode);
+}
+
+QString GlslKgverCodePrebuilder::parseSection(const QString &startSection)
+{
     globalLineIter = 0;
     codeRecords.clear();
     content.clear();
     error.clear();
+    dependencyStack.clear();
+    reusedSectionCount = 0;
+    expandedSectionCount = 0;
 
     // 解析代码块
-    initCodeSections(mainFile, shaderCode);
     content = parseCodeSections(mainFile, startSection, 0);
 
     QString contentBaseMacroInc = LoadBaseMacroInc() + "\n";
+    if (emitLineDirectives) {
+        contentBaseMacroInc = lineDirective(1, "external/glslkgver/macros.cginc") + "\n" + contentBaseMacroInc;
+    }
     addToHead(contentBaseMacroInc, "external/glslkgver/macros.cginc", "");
 
     content = replaceAutoBind(content);
     return content;
 }
 
+void GlslKgverCodePrebuilder::preloadIncludes()
+{
+    QList<CodeIncludeFile> pendingFiles;
+    pendingFiles.append(mainFile);
+
+    while (!pendingFiles.isEmpty()) {
+        CodeIncludeFile currentFile = pendingFiles.takeFirst();
+
+        for (const CodeSection &section : currentFile.codeSections) {
+            for (const QString &line : section.content.split('\n')) {
+                if (!line.startsWith("#include")) {
+                    continue;
+                }
+
+                QStringList parts = line.split(' ');
+                if (parts.size() < 2) {
+                    continue;
+                }
+
+                QString filePath = parseIncludeFilePath(parts[1]);
+                if (filePath.endsWith(".cginc")) {
+                    QString fileName = filePath.mid(filePath.lastIndexOf('/') + 1);
+                    getCgincContent("external/glslkgver/" + fileName);
+                    continue;
+                }
+
+                if (filePath == "self" || filePath == "declare_samplers" || includedFiles.contains(filePath)) {
+                    continue;
+                }
+
+                CodeIncludeFile includeFile = getIncludeFile(filePath);
+                if (!includeFile.codeSections.isEmpty()) {
+                    pendingFiles.append(includeFile);
+                }
+            }
+        }
+    }
+}
+
+void GlslKgverCodePrebuilder::setIncludePaths(const QStringList &paths)
+{
+    if (includePaths == paths) {
+        return;
+    }
+
+    includePaths = paths;
+
+    // 同一引用路径可能解析到不同文件，丢弃已加载的包含文件
+    includedFiles.clear();
+    includeFilePaths.clear();
+    for (auto iter = fileTimestamps.begin(); iter != fileTimestamps.end();) {
+        if (iter.key().startsWith("include:")) {
+            iter = fileTimestamps.erase(iter);
+        } else {
+            ++iter;
+        }
+    }
+    clearSectionCache();
+}
+
+void GlslKgverCodePrebuilder::clearSectionCache()
+{
+    sectionCache.clear();
+}
+
+void GlslKgverCodePrebuilder::setEmitLineDirectives(bool enable)
+{
+    if (emitLineDirectives != enable) {
+        // 缓存的展开结果中包含或不包含 #line 指令，切换后全部失效
+        clearSectionCache();
+    }
+    emitLineDirectives = enable;
+}
+
+void GlslKgverCodePrebuilder::invalidateChangedIncludes()
+{
+    for (auto iter = fileTimestamps.begin(); iter != fileTimestamps.end();) {
+        QString key = iter.key();
+        bool isCginc = key.startsWith("cginc:");
+        QString path = isCginc ? QDir::currentPath() + "/" + key.mid(6) : includeFilePaths.value(key.mid(8));
+
+        if (QFileInfo(path).lastModified() == iter.value()) {
+            ++iter;
+            continue;
+        }
+
+        if (isCginc) {
+            cgincContents.remove(key.mid(6));
+            cgincHashes.remove(key.mid(6));
+        } else {
+            includedFiles.remove(key.mid(8));
+            includeFilePaths.remove(key.mid(8));
+        }
+        iter = fileTimestamps.erase(iter);
+    }
+}
+
+void GlslKgverCodePrebuilder::setLinkedLibraries(const QStringList &libraryNames)
+{
+    QStringList names;
+    for (const QString &libraryName : libraryNames) {
+        QString name = libraryName.trimmed().toLower();
+        if (!name.isEmpty() && !names.contains(name)) {
+            names.append(name);
+        }
+    }
+
+    if (names != linkedLibraries) {
+        // 库的展开方式改变，缓存的展开结果全部失效
+        clearSectionCache();
+    }
+    linkedLibraries = names;
+}
+
+QStringList GlslKgverCodePrebuilder::getUsedLinkedLibraryPaths() const
+{
+    QStringList libraryPaths;
+    for (const auto &rec : codeRecords) {
+        QString fileName = rec.IncludeFile.mid(rec.IncludeFile.lastIndexOf('/') + 1);
+        if (rec.IncludeFile.startsWith("external/glslkgver/") && linkedLibraries.contains(fileName) && !libraryPaths.contains(rec.IncludeFile)) {
+            libraryPaths.append(rec.IncludeFile);
+        }
+    }
+    return libraryPaths;
+}
+
+QString GlslKgverCodePrebuilder::getLinkedLibrarySource(const QString &cgincPath)
+{
+    return LoadBaseMacroInc() + "\n" + getCgincContent(cgincPath) + "\n";
+}
+
+QString GlslKgverCodePrebuilder::stripFunctionBodies(const QString &code)
+{
+    QString result;
+    result.reserve(code.size());
+
+    int braceDepth = 0;
+    bool inFunctionBody = false;
+    bool atLineStart = true;
+    QChar lastSignificant;
+    int i = 0;
+    const int codeLength = code.size();
+
+    while (i < codeLength) {
+        QChar c = code[i];
+        QChar next = i + 1 < codeLength ? code[i + 1] : QChar();
+
+        // 预处理指令整行处理（含续行），不参与花括号计数
+        if (atLineStart && c == '#') {
+            int lineEnd = i;
+            while (lineEnd < codeLength && code[lineEnd] != '\n') {
+                if (code[lineEnd] == '\\' && lineEnd + 1 < codeLength && code[lineEnd + 1] == '\n') {
+                    lineEnd++;
+                }
+                lineEnd++;
+            }
+            QString directive = code.mid(i, lineEnd - i);
+            result += inFunctionBody ? QString(directive.count('\n'), '\n') : directive;
+            i = lineEnd;
+            continue;
+        }
+
+        // 注释原样保留，函数体内的注释只保留换行
+        if (c == '/' && next == '/') {
+            int lineEnd = code.indexOf('\n', i);
+            if (lineEnd < 0) lineEnd = codeLength;
+            if (!inFunctionBody) result += code.mid(i, lineEnd - i);
+            i = lineEnd;
+            continue;
+        }
+        if (c == '/' && next == '*') {
+            int commentEnd = code.indexOf("*/", i + 2);
+            commentEnd = commentEnd < 0 ? codeLength : commentEnd + 2;
+            QString comment = code.mid(i, commentEnd - i);
+            result += inFunctionBody ? QString(comment.count('\n'), '\n') : comment;
+            i = commentEnd;
+            continue;
+        }
+
+        if (c == '\n') {
+            result += c;
+            atLineStart = true;
+            i++;
+            continue;
+        }
+
+        if (!c.isSpace()) {
+            atLineStart = false;
+        }
+
+        if (inFunctionBody) {
+            if (c == '{') {
+                braceDepth++;
+            } else if (c == '}') {
+                braceDepth--;
+                if (braceDepth == 0) {
+                    inFunctionBody = false;
+                    lastSignificant = ';';
+                }
+            }
+            i++;
+            continue;
+        }
+
+        // 顶层 ')' 之后的 '{' 为函数实现，替换为 ';' 变成函数声明
+        if (c == '{' && braceDepth == 0 && lastSignificant == ')') {
+            inFunctionBody = true;
+            braceDepth = 1;
+            result += ';';
+            i++;
+            continue;
+        }
+
+        if (c == '{') {
+            braceDepth++;
+        } else if (c == '}') {
+            braceDepth--;
+        }
+
+        result += c;
+        if (!c.isSpace()) {
+            lastSignificant = c;
+        }
+        i++;
+    }
+
+    return result;
+}
+
+QString GlslKgverCodePrebuilder::sectionCacheKey(const QString &includeKey, const QString &sectionName)
+{
+    return includeKey + "|" + sectionName;
+}
+
+void GlslKgverCodePrebuilder::addDependency(const QString &dependencyKey, const QByteArray &hash, int lineStart)
+{
+    if (dependencyStack.isEmpty()) {
+        return;
+    }
+    dependencyStack.last()[dependencyKey] = { hash, lineStart };
+}
+
+bool GlslKgverCodePrebuilder::isSectionCacheValid(const SectionCacheEntry &entry)
+{
+    for (auto iter = entry.dependencies.constBegin(); iter != entry.dependencies.constEnd(); ++iter) {
+        const QString &key = iter.key();
+
+        if (key.startsWith("cginc:")) {
+            QString cgincPath = key.mid(6);
+            getCgincContent(cgincPath);
+            if (cgincHashes.value(cgincPath) != iter.value().hash) {
+                return false;
+            }
+            continue;
+        }
+
+        // section:<包含文件键>|<代码块名>
+        QString sectionKey = key.mid(8);
+        int separator = sectionKey.indexOf('|');
+        QString includeKey = sectionKey.left(separator);
+        QString sectionName = sectionKey.mid(separator + 1);
+
+        CodeIncludeFile includeFile = includeKey.isEmpty() ? mainFile : getIncludeFile(includeKey);
+        if (!includeFile.codeSections.contains(sectionName)) {
+            return false;
+        }
+
+        const CodeSection section = includeFile.codeSections.value(sectionName);
+        if (section.hash != iter.value().hash) {
+            return false;
+        }
+
+        // #line 指令记录了代码块在文件中的位置，代码块移动后需要重新展开
+        if (emitLineDirectives && section.lineStart != iter.value().lineStart) {
+            return false;
+        }
+    }
+    return true;
+}
+
+QString GlslKgverCodePrebuilder::parseIncludeFilePath(const QString &includeArg)
+{
+    QString filePath = includeArg.mid(includeArg.indexOf('"') + 1, includeArg.lastIndexOf('"') - includeArg.indexOf('"') - 1);
+    return filePath.toLower();
+}
+
+QString GlslKgverCodePrebuilder::getCgincContent(const QString &cgincPath)
+{
+    if (!cgincContents.contains(cgincPath)) {
+        cgincContents[cgincPath] = LoadCginc(cgincPath);
+        cgincHashes[cgincPath] = contentHash(cgincContents[cgincPath]);
+        fileTimestamps["cginc:" + cgincPath] = QFileInfo(QDir::currentPath() + "/" + cgincPath).lastModified();
+    }
+    return cgincContents[cgincPath];
+}
+
 // 处理 #include 指令
 QString GlslKgverCodePrebuilder::handleInclude(const CodeIncludeFile& currentFile, const QString& line, int depth) {
     if (depth > 100) {
@@ -76,15 +399,16 @@ QString GlslKgverCodePrebuilder::handleInclude(const CodeIncludeFile& currentFil
         return ""; // 无效的 include 指令
     }
 
-    QString filePath = parts[1].mid(parts[1].indexOf('"') + 1, parts[1].lastIndexOf('"') - parts[1].indexOf('"') - 1);
-    filePath = filePath.toLower();
+    QString filePath = parseIncludeFilePath(parts[1]);
 
     // 检查是否为cginc文件
     if (filePath.endsWith(".cginc")) {
         QString fileName = filePath.mid(filePath.lastIndexOf('/') + 1);
         QString cgincPath = "external/glslkgver/" + fileName;
 
-        QString cgincContent = LoadCginc(cgincPath) + "\n";
+        // 预编译链接的库只展开声明，实现由 spirv-link 链接
+        QString cgincContent = (linkedLibraries.contains(fileName.toLower()) ? stripFunctionBodies(getCgincContent(cgincPath)) : getCgincContent(cgincPath)) + "\n";
+        addDependency("cginc:" + cgincPath, cgincHashes.value(cgincPath), 0);
         if (cgincContent.isEmpty())
         {
             QString log = QString("open file \"%1\" failed.").arg(cgincPath);
@@ -92,6 +416,12 @@ QString GlslKgverCodePrebuilder::handleInclude(const CodeIncludeFile& currentFil
         }
         QStringList lines = cgincContent.split('\n');
 
+        if (emitLineDirectives) {
+            // #line 指令本身占用一行
+            globalLineIter++;
+            cgincContent = lineDirective(1, cgincPath) + "\n" + cgincContent;
+        }
+
         AddCodeRecords(lines.size(), 1, cgincPath, "");
         return cgincContent;
     }
@@ -130,6 +460,63 @@ QString GlslKgverCodePrebuilder::handleInclude(const CodeIncludeFile& currentFil
 }
 
 QString GlslKgverCodePrebuilder::parseCodeSections(const CodeIncludeFile &includeFile, const QString &startSection, int depth)
+{
+    QString cacheKey = sectionCacheKey(includeFile.includeKey, startSection);
+
+    // 代码块及其传递依赖均未变化，直接拼接缓存结果并平移行号记录
+    auto cacheIter = sectionCache.constFind(cacheKey);
+    if (cacheIter != sectionCache.constEnd() && isSectionCacheValid(cacheIter.value())) {
+        for (CodeRecord rec : cacheIter.value().records) {
+            rec.globalLineStart += globalLineIter;
+            rec.globalLineEnd += globalLineIter;
+            codeRecords.push_back(rec);
+        }
+        globalLineIter += cacheIter.value().numGlobalLines;
+
+        for (auto depIter = cacheIter.value().dependencies.constBegin(); depIter != cacheIter.value().dependencies.constEnd(); ++depIter) {
+            addDependency(depIter.key(), depIter.value().hash, depIter.value().lineStart);
+        }
+
+        reusedSectionCount++;
+        return cacheIter.value().content;
+    }
+
+    size_t recordStart = codeRecords.size();
+    int globalLineStart = globalLineIter;
+    int errorStart = error.length();
+
+    const CodeSection section = includeFile.codeSections.value(startSection);
+    dependencyStack.append(QMap<QString, SectionDependency>());
+    addDependency("section:" + cacheKey, section.hash, section.lineStart);
+
+    QString sectionContent = expandCodeSection(includeFile, startSection, depth);
+
+    QMap<QString, SectionDependency> dependencies = dependencyStack.takeLast();
+    for (auto depIter = dependencies.constBegin(); depIter != dependencies.constEnd(); ++depIter) {
+        addDependency(depIter.key(), depIter.value().hash, depIter.value().lineStart);
+    }
+
+    expandedSectionCount++;
+
+    // 展开出错时不缓存，下次构建重新展开以输出错误信息
+    if (error.length() == errorStart && includeFile.codeSections.contains(startSection)) {
+        SectionCacheEntry entry;
+        entry.content = sectionContent;
+        entry.numGlobalLines = globalLineIter - globalLineStart;
+        entry.dependencies = dependencies;
+        for (size_t i = recordStart; i < codeRecords.size(); ++i) {
+            CodeRecord rec = codeRecords[i];
+            rec.globalLineStart -= globalLineStart;
+            rec.globalLineEnd -= globalLineStart;
+            entry.records.push_back(rec);
+        }
+        sectionCache[cacheKey] = entry;
+    }
+
+    return sectionContent;
+}
+
+QString GlslKgverCodePrebuilder::expandCodeSection(const CodeIncludeFile &includeFile, const QString &startSection, int depth)
 {
     QStringList lines = includeFile.codeSections[startSection].content.split('\n');
     QStringList processedLines;
@@ -183,6 +570,14 @@ QString GlslKgverCodePrebuilder::parseCodeSections(const CodeIncludeFile &includ
             if (pushedNumLines == 0)
             {
                 travelLineOffset = travelNumLines;
+
+                if (emitLineDirectives)
+                {
+                    // 每段连续代码前标记其在原始文件中的行号，#line 指令本身占用一行
+                    int fileLineNum = includeFile.codeSections[startSection].lineStart + travelNumLines;
+                    processedLines.append(lineDirective(fileLineNum, includeFile.filePath.isEmpty() ? "textEditor" : includeFile.filePath));
+                    globalLineIter++;
+                }
             }
 
             pushedNumLines++;
@@ -265,6 +660,11 @@ void GlslKgverCodePrebuilder::errorLog(const QString& errorLog)
     error.append(errorLog + "\n");
 }
 
+QString GlslKgverCodePrebuilder::lineDirective(int lineNum, const QString& fileName) const
+{
+    return QString("#line %1 \"%2\"").arg(lineNum).arg(fileName);
+}
+
 bool GlslKgverCodePrebuilder::matchGlobalLine(int globalLineNum, CodeFileLineInfo &retInfo)
 {
     if (globalLineNum < 0)
@@ -308,6 +708,14 @@ bool GlslKgverCodePrebuilder::matchGlobalLine(int globalLineNum, CodeFileLineInf
     return false;
 }
 
+int GlslKgverCodePrebuilder::contentLineOffset(const QString &integratedCode) const
+{
+    if (!integratedCode.endsWith(content)) {
+        return -1;
+    }
+    return integratedCode.left(integratedCode.size() - content.size()).count('\n');
+}
+
 // 解析代码块
 void GlslKgverCodePrebuilder::initCodeSections(CodeIncludeFile &includeFile, const QString &shaderCode)
 {
@@ -322,16 +730,12 @@ void GlslKgverCodePrebuilder::initCodeSections(CodeIncludeFile &includeFile, con
         lineEnd++;
         lineIter++;
 
-        // 跳过以@或@@开头的行
-        if (line.startsWith("@") || line.startsWith("@@")) {
-            continue;
-        }
-
+        // 以@或@@开头的行保留在代码块中，由parseCodeSections跳过，保证块内行号与文件行号一致
         if (line.startsWith("[")) {
             // 处理代码块定义
             if (!currentSectionName.isEmpty()) {
                 // 存储之前的代码块
-                includeFile.codeSections[currentSectionName] = {currentSectionName, currentSectionContent, lineStart, lineEnd };
+                includeFile.codeSections[currentSectionName] = {currentSectionName, currentSectionContent, lineStart, lineEnd, contentHash(currentSectionContent) };
             }
             currentSectionName = line.mid(1, line.length() - 2); // 获取代码块名称
             currentSectionContent.clear(); // 清空当前内容
@@ -345,10 +749,10 @@ void GlslKgverCodePrebuilder::initCodeSections(CodeIncludeFile &includeFile, con
 
     if (!currentSectionName.isEmpty()) {
         // 存储最后一个代码块
-        includeFile.codeSections[currentSectionName] = { currentSectionName, currentSectionContent, lineStart, lineEnd };
+        includeFile.codeSections[currentSectionName] = { currentSectionName, currentSectionContent, lineStart, lineEnd, contentHash(currentSectionContent) };
     } else if (!currentSectionContent.isEmpty() && includeFile.codeSections.empty()) {
         // 如果当前代码块内容不为空且包含文件没有代码块，则将当前代码块内容作为默认代码块
-        includeFile.codeSections[""] = {"", currentSectionContent, lineStart, lineEnd};
+        includeFile.codeSections[""] = {"", currentSectionContent, lineStart, lineEnd, contentHash(currentSectionContent)};
     }
 }
 
@@ -384,12 +788,15 @@ CodeIncludeFile GlslKgverCodePrebuilder::getIncludeFile(const QString &filePath)
 
         CodeIncludeFile includeFileInstance;
         includeFileInstance.filePath = includeFile.fileName().toLower(); // 获取完整路径
+        includeFileInstance.includeKey = filePath;
         initCodeSections(includeFileInstance, content);
         if (includeFileInstance.codeSections.isEmpty()) {
             qWarning() << "Failed to parse include file:" << includeFile.fileName();
             return CodeIncludeFile(); // 返回空字符串表示无法处理
         }
         includedFiles[filePath] = includeFileInstance;
+        includeFilePaths[filePath] = includeFile.fileName();
+        fileTimestamps["include:" + filePath] = QFileInfo(includeFile.fileName()).lastModified();
         return includeFileInstance;
     }
 
@@ -397,11 +804,17 @@ CodeIncludeFile GlslKgverCodePrebuilder::getIncludeFile(const QString &filePath)
     return CodeIncludeFile(); // 返回空字符串表示无法处理
 }
 
-QString TransformGlslKgverCodeErrors(GlslKgverCodePrebuilder &codePrebuilder, const QString& integrateCodeFileName, const QString& errorString)
+QString TransformGlslKgverCodeErrors(GlslKgverCodePrebuilder &codePrebuilder, const QString& integrateCodeFileName, const QString& integratedCode, const QString& errorString)
 {
     QStringList lines = errorString.split('\n');
     QString errorHeader = QString("ERROR: ") + integrateCodeFileName + QString(":");
 
+    // 行号记录相对于展开结果，需减去编译器在前面附加的头部行数；输出 #line 指令时 glslang 已直接报告原始文件行号
+    int lineOffset = codePrebuilder.contentLineOffset(integratedCode);
+    if (lineOffset < 0) {
+        return errorString;
+    }
+
     for (QString &line : lines)
     {
         bool isErrMsg = line.startsWith(errorHeader);
@@ -412,7 +825,7 @@ QString TransformGlslKgverCodeErrors(GlslKgverCodePrebuilder &codePrebuilder, co
             QString errorContent = errorMid.mid(errorMid.indexOf(":") + 1); // 提取错误内容
 
             GlslKgverCodePrebuilder::CodeFileLineInfo errFileLineInfo;
-            bool bret = codePrebuilder.matchGlobalLine(globalLineNum.toInt() - 4/*错误信息总会多4行？*/, errFileLineInfo);
+            bool bret = codePrebuilder.matchGlobalLine(globalLineNum.toInt() - lineOffset, errFileLineInfo);
             if (bret)
             {
                 if (errFileLineInfo.includeFile.isEmpty())
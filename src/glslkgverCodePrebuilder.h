@@ -8,6 +8,7 @@
 #include <QTextStream>
 #include <QDebug>
 #include <QMap>
+#include <QDateTime>
 
 class GlslKgverCodePrebuilder;
 
@@ -17,6 +18,7 @@ public:
     QString content; // 代码块内容
     int lineStart; // 行号从1开始
     int lineEnd; // 结束行号等于lineEnd - 1，lineNum = lineEnd - lineStart
+    QByteArray hash; // 代码块内容的哈希，用于判断增量预处理缓存是否失效
 };
 
 class CodeIncludeFile
@@ -24,6 +26,7 @@ class CodeIncludeFile
 public:
     QMap<QString, CodeSection> codeSections; // 存储代码块
     QString filePath; // 包含文件路径
+    QString includeKey; // #include 中引用的路径，主文件为空
 };
 
 class GlslKgverCodePrebuilder {
@@ -33,6 +36,41 @@ public:
     // 解析着色器代码
     QString parse(const QString &shaderCode, const QString &startSection);
 
+    // 设置主文件代码并拆分代码块，之后可多次调用 parseSection 展开不同代码块
+    void setShaderCode(const QString &shaderCode);
+
+    // 展开主文件中的指定代码块
+    QString parseSection(const QString &startSection);
+
+    // 预先加载主文件递归引用的所有包含文件，拷贝后的预处理器之间共享已解析的结果
+    void preloadIncludes();
+
+    // 设置包含路径，路径变化时清空已加载的包含文件及预处理缓存
+    void setIncludePaths(const QStringList &paths);
+
+    // 清空增量预处理缓存
+    void clearSectionCache();
+
+    // 最近一次 parseSection 中复用缓存及重新展开的代码块数量
+    int getReusedSectionCount() const { return reusedSectionCount; }
+    int getExpandedSectionCount() const { return expandedSectionCount; }
+
+    // 设置预编译链接的cginc库（文件名，如 BRDF.cginc），这些库在展开时只保留声明，函数实现由 spirv-link 链接
+    void setLinkedLibraries(const QStringList &libraryNames);
+    QStringList getLinkedLibraries() const { return linkedLibraries; }
+
+    // 最近一次 parseSection 中实际引用的预编译库路径
+    QStringList getUsedLinkedLibraryPaths() const;
+
+    // 获取预编译库的完整源码（macros.cginc + 库文件），用于单独编译库模块
+    QString getLinkedLibrarySource(const QString &cgincPath);
+
+    // 去掉顶层函数的实现只保留声明，保留换行使行号不变
+    static QString stripFunctionBodies(const QString &code);
+
+    // 获取主文件中的代码块名称
+    QStringList getSectionNames() const { return mainFile.codeSections.keys(); }
+
     struct CodeFileLineInfo
     {
         QString includeFile;
@@ -40,8 +78,15 @@ public:
     };
     bool matchGlobalLine(int globalLineNum, CodeFileLineInfo& retInfo);
 
+    // 最近一次展开结果在写入编译器的完整代码中的起始行偏移（前面附加的着色器头部行数），未找到时返回 -1
+    int contentLineOffset(const QString& integratedCode) const;
+
     QString getErrorLog() const { return error; }
 
+    // 是否输出 #line 指令，开启后 glslang 的错误信息及 SPIR-V 调试信息直接指向原始文件
+    void setEmitLineDirectives(bool enable);
+    bool isEmitLineDirectives() const { return emitLineDirectives; }
+
 private:
     // 初始化包含代码文件
     void initCodeSections(CodeIncludeFile &includeFile, const QString &shaderCode);
@@ -49,12 +94,21 @@ private:
     // 获取包含文件
     CodeIncludeFile getIncludeFile(const QString &filePath);
 
+    // 获取cginc文件内容，已加载过的直接返回缓存
+    QString getCgincContent(const QString &cgincPath);
+
+    // 从 #include 指令参数中提取文件路径
+    static QString parseIncludeFilePath(const QString &includeArg);
+
     // 处理 #include 指令
     QString handleInclude(const CodeIncludeFile &currentFile, const QString &line, int depth);
 
-    // 解析代码块
+    // 解析代码块，输入未变化时直接复用缓存的展开结果
     QString parseCodeSections(const CodeIncludeFile &includeFile, const QString &startSection, int depth);
 
+    // 展开代码块
+    QString expandCodeSection(const CodeIncludeFile &includeFile, const QString &startSection, int depth);
+
     // 替换autobind
     QString replaceAutoBind(const QString& shaderCode);
 
@@ -63,13 +117,28 @@ private:
 
     void errorLog(const QString& errorLog);
 
+    // 生成指向原始文件行号的 #line 指令
+    QString lineDirective(int lineNum, const QString& fileName) const;
+
+    // 移除磁盘上已修改的包含文件及cginc文件，下次使用时重新加载
+    void invalidateChangedIncludes();
+
+    // 记录当前展开过程依赖的输入
+    void addDependency(const QString &dependencyKey, const QByteArray &hash, int lineStart);
+
+    static QString sectionCacheKey(const QString &includeKey, const QString &sectionName);
+
 private:
     QString content;
     QString error;
     QStringList includePaths; // 包含路径
     CodeIncludeFile mainFile; // 当前包含起始文件
     QMap<QString, CodeIncludeFile> includedFiles; // 包含的文件集合
+    QMap<QString, QString> cgincContents; // 已加载的cginc文件内容
+    QMap<QString, QByteArray> cgincHashes; // 已加载的cginc文件内容哈希
+    QStringList linkedLibraries; // 预编译链接的cginc库文件名（小写）
     int includeDepth; // 当前包含深度
+    bool emitLineDirectives; // 是否输出 #line 指令
 
     struct CodeRecord
     {
@@ -82,9 +151,35 @@ private:
     std::vector<CodeRecord> codeRecords;
     int globalLineIter;
 
+    // 代码块展开结果依赖的输入：代码块（包含文件键 + 代码块名）或cginc文件
+    struct SectionDependency
+    {
+        QByteArray hash; // 内容哈希
+        int lineStart; // 代码块在文件中的起始行，仅在输出 #line 指令时参与比较
+    };
+
+    // 增量预处理缓存，保存代码块展开后的文本及相对行号记录
+    struct SectionCacheEntry
+    {
+        QString content; // 展开后的代码
+        std::vector<CodeRecord> records; // 行号记录，globalLineStart 相对于代码块起始
+        int numGlobalLines; // 展开后占用的全局行数
+        QMap<QString, SectionDependency> dependencies; // 全部传递依赖
+    };
+    QMap<QString, SectionCacheEntry> sectionCache;
+    QList<QMap<QString, SectionDependency>> dependencyStack; // 正在展开的代码块依赖栈
+    QMap<QString, QDateTime> fileTimestamps; // 已加载包含文件及cginc文件的修改时间
+    QMap<QString, QString> includeFilePaths; // 包含文件键对应的实际文件路径
+    int reusedSectionCount;
+    int expandedSectionCount;
+
+    // 检查缓存的代码块展开结果所依赖的输入是否都未变化
+    bool isSectionCacheValid(const SectionCacheEntry &entry);
+
     void AddCodeRecords(int numLines, int sectionLocalLineOffset, const QString &IncludeFile, const QString &Section);
 };
 
-QString TransformGlslKgverCodeErrors(GlslKgverCodePrebuilder& codePrebuilder, const QString& integrateCodeFileName, const QString& errorString);
+// 将 glslang 针对完整代码文件报告的行号映射回原始文件，integratedCode 为写入该文件的代码
+QString TransformGlslKgverCodeErrors(GlslKgverCodePrebuilder& codePrebuilder, const QString& integrateCodeFileName, const QString& integratedCode, const QString& errorString);
 
 #endif // GLSLKGVERCODEPREBUILDER_H
@@ -30,6 +30,9 @@
 #include <QtGui/QScreen>
 #include <QtGui/QGuiApplication>
  #include <QInputDialog>
+#include "stageInterfacePruneDialog.h"
+#include "bindingRemapDialog.h"
+#include "pipelineLayoutDialog.h"
 
 MainWindow::MainWindow(QWidget *parent)
     : QMainWindow(parent)
@@ -157,6 +160,23 @@ void MainWindow::createMenus()
     
     QMenu *buildMenu = bar->addMenu(tr("BUILD"));
     buildMenu->addAction(tr("Compile"), this, [this](){ DocumentWindow* currentDocument = getCurrentDocumentWindow(); if (currentDocument) currentDocument->compile(); }, Qt::Key_F5);
+    buildMenu->addAction(tr("Compile All Stages"), this, [this](){ DocumentWindow* currentDocument = getCurrentDocumentWindow(); if (currentDocument) currentDocument->compileAllStages(); }, Qt::SHIFT + Qt::Key_F5);
+    buildMenu->addSeparator();
+    buildMenu->addAction(tr("Export Reflection..."), this, [this](){ DocumentWindow* currentDocument = getCurrentDocumentWindow(); if (currentDocument) currentDocument->exportReflection(); });
+    buildMenu->addSeparator();
+    buildMenu->addAction(tr("Pin Baseline"), this, [this](){ DocumentWindow* currentDocument = getCurrentDocumentWindow(); if (currentDocument) currentDocument->pinBaseline(); });
+    buildMenu->addAction(tr("Clear Baseline"), this, [this](){ DocumentWindow* currentDocument = getCurrentDocumentWindow(); if (currentDocument) currentDocument->clearBaseline(); });
+    buildMenu->addSeparator();
+    buildMenu->addAction(tr("Autotune..."), this, [this](){ DocumentWindow* currentDocument = getCurrentDocumentWindow(); if (currentDocument) currentDocument->autotune(); });
+    buildMenu->addAction(tr("Pass Pipeline..."), this, [this](){ DocumentWindow* currentDocument = getCurrentDocumentWindow(); if (currentDocument) currentDocument->editPassPipeline(); });
+    buildMenu->addAction(tr("Compare Shader Models..."), this, [this](){ DocumentWindow* currentDocument = getCurrentDocumentWindow(); if (currentDocument) currentDocument->compareShaderModels(); });
+    buildMenu->addAction(tr("Compare DXC / GLSLANG..."), this, [this](){ DocumentWindow* currentDocument = getCurrentDocumentWindow(); if (currentDocument) currentDocument->compareFrontends(); });
+    buildMenu->addAction(tr("Prune Stage Interface..."), this, &MainWindow::onPruneStageInterface);
+    buildMenu->addAction(tr("Remap Bindings..."), this, &MainWindow::onRemapBindings);
+    buildMenu->addAction(tr("Pipeline Layout..."), this, &MainWindow::onGeneratePipelineLayout);
+    buildMenu->addAction(tr("Spec Constant Variants..."), this, [this](){ DocumentWindow* currentDocument = getCurrentDocumentWindow(); if (currentDocument) currentDocument->specConstantVariants(); });
+    buildMenu->addAction(tr("Control Flow Graph..."), this, [this](){ DocumentWindow* currentDocument = getCurrentDocumentWindow(); if (currentDocument) currentDocument->showControlFlowGraph(); });
+    buildMenu->addAction(tr("GPU Profiles..."), this, [this](){ DocumentWindow* currentDocument = getCurrentDocumentWindow(); if (currentDocument) currentDocument->editGpuProfiles(); });
 
     // 设置菜单栏鼠标事件追踪
     bar->setMouseTracking(true);
@@ -882,6 +902,7 @@ void MainWindow::loadSettings()
     // 恢复窗口位置和大小
     resize(settings.value("windowSize", QSize(800, 600)).toSize());
     move(settings.value("windowPosition", QPoint(100, 100)).toPoint());
+    bindingLayoutFile = settings.value("bindingLayoutFile").toString();
 
     // 自动恢复所有文档
     QDir tempDocsDir(QCoreApplication::applicationDirPath() + "/config/temp_docs");
@@ -908,11 +929,58 @@ void MainWindow::saveSettings()
     // 保存窗口位置和大小
     settings.setValue("windowSize", size());
     settings.setValue("windowPosition", pos());
+    settings.setValue("bindingLayoutFile", bindingLayoutFile);
     
     // 确保所有设置被写入到文件
     settings.sync();
 }
 
+// 跨文档的阶段接口裁剪，生产者与消费者分别来自两个打开的文档
+void MainWindow::onPruneStageInterface()
+{
+    int currentIndex = -1;
+    QList<DocumentWindow*> documents = openDocuments(&currentIndex);
+
+    if (documents.size() < 2) {
+        QMessageBox::information(this, tr("Prune Stage Interface"), tr("Open the producer and consumer stages as two documents first."));
+        return;
+    }
+
+    StageInterfacePruneDialog dialog(documents, currentIndex, this);
+    dialog.exec();
+}
+
+// 管线各阶段的描述符绑定重映射，阶段来自打开的文档
+void MainWindow::onRemapBindings()
+{
+    int currentIndex = -1;
+    QList<DocumentWindow*> documents = openDocuments(&currentIndex);
+
+    if (documents.isEmpty()) {
+        QMessageBox::information(this, tr("Remap Bindings"), tr("Open the pipeline stages as documents first."));
+        return;
+    }
+
+    BindingRemapDialog dialog(documents, currentIndex, bindingLayoutFile, this);
+    dialog.exec();
+    bindingLayoutFile = dialog.layoutFile();
+}
+
+// 合并打开文档的反射数据，生成管线布局或根签名
+void MainWindow::onGeneratePipelineLayout()
+{
+    int currentIndex = -1;
+    QList<DocumentWindow*> documents = openDocuments(&currentIndex);
+
+    if (documents.isEmpty()) {
+        QMessageBox::information(this, tr("Pipeline Layout"), tr("Open the pipeline stages as documents first."));
+        return;
+    }
+
+    PipelineLayoutDialog dialog(documents, currentIndex, this);
+    dialog.exec();
+}
+
 DocumentWindow* MainWindow::getCurrentDocumentWindow()
 {
     QWidget* tab = tabWidget->currentWidget(); // 获取当前选中的标签页
@@ -923,6 +991,23 @@ DocumentWindow* MainWindow::getCurrentDocumentWindow()
     return nullptr;
 }
 
+QList<DocumentWindow*> MainWindow::openDocuments(int *currentIndex)
+{
+    QList<DocumentWindow*> documents;
+    DocumentWindow* currentDocument = getCurrentDocumentWindow();
+    *currentIndex = -1;
+    for (int i = 0; i < tabWidget->count(); ++i) {
+        DocumentWindow* documentWindow = dynamic_cast<DocumentWindow*>(tabWidget->widget(i));
+        if (documentWindow) {
+            if (documentWindow == currentDocument) {
+                *currentIndex = documents.size();
+            }
+            documents.append(documentWindow);
+        }
+    }
+    return documents;
+}
+
 void MainWindow::resizeEvent(QResizeEvent *event)
 {
     QMainWindow::resizeEvent(event);
@@ -47,6 +47,9 @@ public slots:
     void onToggleTheme();
     void onTabCloseRequested(int index);
     void onTabMouseDoubleClickEvent(int tabIndex);
+    void onPruneStageInterface();
+    void onRemapBindings();
+    void onGeneratePipelineLayout();
 
 private:
     void createMenus();
@@ -56,6 +59,7 @@ private:
     void loadSettings();    
     void saveSettings();
     DocumentWindow* getCurrentDocumentWindow();
+    QList<DocumentWindow*> openDocuments(int *currentIndex); // 按标签页顺序，currentIndex 返回当前文档的下标，没有时为 -1
 
     // 主界面UI组件
     QToolButton *closeButton = nullptr;
@@ -69,6 +73,8 @@ private:
     static const int RESIZE_MARGIN = 5;  // 边缘调整区域的宽度
     bool isDarkTheme;
 
+    QString bindingLayoutFile; // 绑定重映射使用的布局描述文件
+
     QTabWidget *tabWidget; // 添加 Tab 控件
 };
 
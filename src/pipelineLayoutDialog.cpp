@@ -0,0 +1,142 @@
+#include "pipelineLayoutDialog.h"
+#include "documentWindow.h"
+#include <QtWidgets/QVBoxLayout>
+#include <QtWidgets/QFormLayout>
+#include <QtWidgets/QLabel>
+#include <QtWidgets/QTabWidget>
+#include <QtWidgets/QDialogButtonBox>
+#include <QtWidgets/QApplication>
+#include <QtWidgets/QFileDialog>
+#include <QtWidgets/QMessageBox>
+#include <QFile>
+#include <QJsonDocument>
+
+namespace {
+
+QTextEdit *createOutputEdit(QWidget *parent)
+{
+    QTextEdit *edit = new QTextEdit(parent);
+    edit->setReadOnly(true);
+    edit->setLineWrapMode(QTextEdit::NoWrap);
+    edit->setStyleSheet("QTextEdit { font-family: 'Consolas', monospace; }");
+    return edit;
+}
+
+bool writeText(const QString &filePath, const QByteArray &data)
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        return false;
+    }
+    bool success = file.write(data) == data.size();
+    file.close();
+    return success;
+}
+
+} // namespace
+
+// 构造函数，初始化管线布局对话框，默认勾选所有文档。
+PipelineLayoutDialog::PipelineLayoutDialog(const QList<DocumentWindow *> &documents, int currentIndex, QWidget *parent)
+    : QDialog(parent), documents(documents)
+{
+    setWindowTitle(tr("Pipeline Layout"));
+    resize(950, 700);
+
+    QVBoxLayout *mainLayout = new QVBoxLayout(this);
+
+    mainLayout->addWidget(new QLabel(tr("Pipeline stages:"), this));
+    stageList = new QListWidget(this);
+    for (DocumentWindow *document : documents) {
+        QListWidgetItem *item = new QListWidgetItem(document->getDocumentWindowTitle(), stageList);
+        item->setFlags(item->flags() | Qt::ItemIsUserCheckable);
+        item->setCheckState(Qt::Checked);
+    }
+    stageList->setCurrentRow(qMax(currentIndex, 0));
+    stageList->setMaximumHeight(120);
+    mainLayout->addWidget(stageList);
+
+    QFormLayout *formLayout = new QFormLayout();
+    nameEdit = new QLineEdit("PipelineLayout", this);
+    formLayout->addRow(tr("Namespace"), nameEdit);
+    mainLayout->addLayout(formLayout);
+
+    QTabWidget *outputTabs = new QTabWidget(this);
+    reportEdit = createOutputEdit(this);
+    headerEdit = createOutputEdit(this);
+    jsonEdit = createOutputEdit(this);
+    outputTabs->addTab(reportEdit, tr("Report"));
+    outputTabs->addTab(headerEdit, tr("C++ Header"));
+    outputTabs->addTab(jsonEdit, tr("JSON"));
+    mainLayout->addWidget(outputTabs, 1);
+
+    QDialogButtonBox *buttonBox = new QDialogButtonBox(QDialogButtonBox::Close, Qt::Horizontal, this);
+    QPushButton *generateButton = buttonBox->addButton(tr("Generate"), QDialogButtonBox::ActionRole);
+    saveHeaderButton = buttonBox->addButton(tr("Save Header..."), QDialogButtonBox::ActionRole);
+    saveJsonButton = buttonBox->addButton(tr("Save JSON..."), QDialogButtonBox::ActionRole);
+    saveHeaderButton->setEnabled(false);
+    saveJsonButton->setEnabled(false);
+    mainLayout->addWidget(buttonBox);
+
+    connect(generateButton, &QPushButton::clicked, this, &PipelineLayoutDialog::generate);
+    connect(saveHeaderButton, &QPushButton::clicked, this, &PipelineLayoutDialog::saveHeader);
+    connect(saveJsonButton, &QPushButton::clicked, this, &PipelineLayoutDialog::saveJson);
+    connect(buttonBox, &QDialogButtonBox::rejected, this, &QDialog::reject);
+}
+
+void PipelineLayoutDialog::generate()
+{
+    saveHeaderButton->setEnabled(false);
+    saveJsonButton->setEnabled(false);
+    headerEdit->clear();
+    jsonEdit->clear();
+
+    QVector<PipelineLayoutStage> stages;
+    QString error;
+    bool success = true;
+    QApplication::setOverrideCursor(Qt::WaitCursor);
+    for (int i = 0; i < stageList->count() && success; ++i) {
+        if (stageList->item(i)->checkState() != Qt::Checked) {
+            continue;
+        }
+        PipelineLayoutStage stage;
+        stage.name = documents[i]->getDocumentWindowTitle();
+        success = documents[i]->compileReflection(stage.reflection, error);
+        if (!success) {
+            error = tr("%1: %2").arg(stage.name).arg(error);
+        }
+        stages.append(stage);
+    }
+
+    QStringList warnings;
+    if (success) {
+        success = PipelineLayoutGenerator::merge(stages, layout, warnings, error);
+    }
+    QApplication::restoreOverrideCursor();
+
+    if (!success) {
+        reportEdit->setPlainText(tr("Generation failed:\n") + error);
+        return;
+    }
+
+    reportEdit->setPlainText(PipelineLayoutGenerator::reportText(layout, warnings));
+    headerEdit->setPlainText(PipelineLayoutGenerator::toCppHeader(layout, nameEdit->text().trimmed()));
+    jsonEdit->setPlainText(QString::fromUtf8(QJsonDocument(PipelineLayoutGenerator::toJson(layout)).toJson(QJsonDocument::Indented)));
+    saveHeaderButton->setEnabled(true);
+    saveJsonButton->setEnabled(true);
+}
+
+void PipelineLayoutDialog::saveHeader()
+{
+    QString filePath = QFileDialog::getSaveFileName(this, tr("Save Header"), nameEdit->text().trimmed() + ".h", tr("C++ Headers (*.h *.hpp)"));
+    if (!filePath.isEmpty() && !writeText(filePath, headerEdit->toPlainText().toUtf8())) {
+        QMessageBox::warning(this, windowTitle(), tr("Failed to write %1").arg(filePath));
+    }
+}
+
+void PipelineLayoutDialog::saveJson()
+{
+    QString filePath = QFileDialog::getSaveFileName(this, tr("Save JSON"), nameEdit->text().trimmed() + ".json", tr("JSON Files (*.json)"));
+    if (!filePath.isEmpty() && !writeText(filePath, jsonEdit->toPlainText().toUtf8())) {
+        QMessageBox::warning(this, windowTitle(), tr("Failed to write %1").arg(filePath));
+    }
+}
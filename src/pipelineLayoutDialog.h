@@ -0,0 +1,40 @@
+#ifndef PIPELINELAYOUTDIALOG_H
+#define PIPELINELAYOUTDIALOG_H
+
+#include <QtWidgets/QDialog>
+#include <QtWidgets/QListWidget>
+#include <QtWidgets/QLineEdit>
+#include <QtWidgets/QTextEdit>
+#include <QtWidgets/QPushButton>
+#include "pipelineLayoutGenerator.h"
+
+class DocumentWindow;
+
+// PipelineLayoutDialog 选择一条管线的各阶段文档，合并反射数据生成 Vulkan 管线布局或 D3D12 根签名，
+// 预览并保存为 C++ 头文件或 JSON。
+class PipelineLayoutDialog : public QDialog
+{
+    Q_OBJECT
+
+public:
+    PipelineLayoutDialog(const QList<DocumentWindow *> &documents, int currentIndex, QWidget *parent = nullptr);
+
+private slots:
+    void generate();
+    void saveHeader();
+    void saveJson();
+
+private:
+    QList<DocumentWindow *> documents;
+    PipelineLayout layout;
+
+    QListWidget *stageList;
+    QLineEdit *nameEdit;
+    QTextEdit *reportEdit;
+    QTextEdit *headerEdit;
+    QTextEdit *jsonEdit;
+    QPushButton *saveHeaderButton;
+    QPushButton *saveJsonButton;
+};
+
+#endif // PIPELINELAYOUTDIALOG_H
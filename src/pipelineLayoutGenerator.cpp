@@ -0,0 +1,522 @@
+#include "pipelineLayoutGenerator.h"
+#include <QJsonArray>
+#include <QMap>
+#include <algorithm>
+
+namespace {
+
+const QStringList kStageOrder = { "Vertex", "Hull", "TessControl", "Domain", "TessEvaluation", "Geometry", "Task", "Mesh", "Pixel", "Compute" };
+
+int stageRank(const QString &stage)
+{
+    int rank = kStageOrder.indexOf(stage);
+    return rank < 0 ? kStageOrder.size() : rank;
+}
+
+// DXIL 中 CBV、SRV、UAV、Sampler 使用各自的寄存器空间
+int rangeTypeRank(const QString &rangeType)
+{
+    static const QStringList kOrder = { "CBV", "SRV", "UAV", "Sampler" };
+    return kOrder.indexOf(rangeType);
+}
+
+QString registerPrefix(const QString &rangeType)
+{
+    if (rangeType == "CBV") {
+        return "b";
+    }
+    if (rangeType == "SRV") {
+        return "t";
+    }
+    return rangeType == "UAV" ? "u" : "s";
+}
+
+QString countText(uint32_t count)
+{
+    return count == 0 ? QString("unbounded") : QString::number(count);
+}
+
+// 资源的合并键：SPIR-V 为 set/binding，DXIL 另按资源类别区分
+QString resourceKey(const QString &binaryType, const ShaderReflectionBinding &binding)
+{
+    if (binaryType == "DXIL") {
+        return QString("%1 space%2 %3%4").arg(binding.descriptorType).arg(binding.set).arg(registerPrefix(binding.descriptorType)).arg(binding.binding);
+    }
+    return QString("set %1 binding %2").arg(binding.set).arg(binding.binding);
+}
+
+QString shaderVisibility(const QStringList &stages)
+{
+    if (stages.size() != 1) {
+        return "ALL";
+    }
+    const QString &stage = stages.first();
+    if (stage == "Vertex") return "VERTEX";
+    if (stage == "Hull") return "HULL";
+    if (stage == "Domain") return "DOMAIN";
+    if (stage == "Geometry") return "GEOMETRY";
+    if (stage == "Pixel") return "PIXEL";
+    if (stage == "Mesh") return "MESH";
+    if (stage == "Task") return "AMPLIFICATION";
+    return "ALL";
+}
+
+QString vulkanDescriptorType(const QString &descriptorType)
+{
+    static const QMap<QString, QString> kTypes = {
+        { "Sampler", "VK_DESCRIPTOR_TYPE_SAMPLER" },
+        { "Combined Image Sampler", "VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER" },
+        { "Sampled Image", "VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE" },
+        { "Storage Image", "VK_DESCRIPTOR_TYPE_STORAGE_IMAGE" },
+        { "Uniform Texel Buffer", "VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER" },
+        { "Storage Texel Buffer", "VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER" },
+        { "Uniform Buffer", "VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER" },
+        { "Storage Buffer", "VK_DESCRIPTOR_TYPE_STORAGE_BUFFER" },
+        { "Input Attachment", "VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT" },
+        { "Acceleration Structure", "VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR" },
+    };
+    return kTypes.value(descriptorType, "VK_DESCRIPTOR_TYPE_MAX_ENUM");
+}
+
+QString vulkanStageFlags(const QStringList &stages)
+{
+    static const QMap<QString, QString> kStages = {
+        { "Vertex", "VK_SHADER_STAGE_VERTEX_BIT" },
+        { "TessControl", "VK_SHADER_STAGE_TESSELLATION_CONTROL_BIT" },
+        { "TessEvaluation", "VK_SHADER_STAGE_TESSELLATION_EVALUATION_BIT" },
+        { "Geometry", "VK_SHADER_STAGE_GEOMETRY_BIT" },
+        { "Pixel", "VK_SHADER_STAGE_FRAGMENT_BIT" },
+        { "Compute", "VK_SHADER_STAGE_COMPUTE_BIT" },
+        { "Task", "VK_SHADER_STAGE_TASK_BIT_EXT" },
+        { "Mesh", "VK_SHADER_STAGE_MESH_BIT_EXT" },
+        { "RayGeneration", "VK_SHADER_STAGE_RAYGEN_BIT_KHR" },
+        { "RayAnyHit", "VK_SHADER_STAGE_ANY_HIT_BIT_KHR" },
+        { "RayClosestHit", "VK_SHADER_STAGE_CLOSEST_HIT_BIT_KHR" },
+        { "RayMiss", "VK_SHADER_STAGE_MISS_BIT_KHR" },
+        { "RayIntersection", "VK_SHADER_STAGE_INTERSECTION_BIT_KHR" },
+        { "RayCallable", "VK_SHADER_STAGE_CALLABLE_BIT_KHR" },
+    };
+    QStringList flags;
+    for (const QString &stage : stages) {
+        flags << kStages.value(stage, "VK_SHADER_STAGE_ALL");
+    }
+    return flags.isEmpty() ? QString("0") : flags.join(" | ");
+}
+
+// 按可见性分组生成描述符表：同一可见性的 CBV/SRV/UAV 放入一个表，Sampler 单独一个表
+QVector<RootParameter> buildRootParameters(const QVector<PipelineLayoutResource> &resources)
+{
+    QMap<QPair<int, QString>, RootParameter> tables; // (是否 Sampler, 可见性) -> 表
+    for (const PipelineLayoutResource &resource : resources) {
+        RootDescriptorRange range;
+        range.rangeType = resource.descriptorType;
+        range.baseRegister = resource.binding;
+        range.space = resource.set;
+        range.count = resource.count;
+        range.names << resource.name;
+
+        bool isSampler = resource.descriptorType == "Sampler";
+        RootParameter &table = tables[qMakePair(isSampler ? 1 : 0, shaderVisibility(resource.stages))];
+        table.visibility = shaderVisibility(resource.stages);
+        table.samplerTable = isSampler;
+        table.ranges.append(range);
+    }
+
+    QVector<RootParameter> parameters;
+    for (RootParameter table : tables) {
+        // 定长范围在前，unbounded 范围放在最后，避免其后的范围无法追加偏移
+        std::stable_sort(table.ranges.begin(), table.ranges.end(), [](const RootDescriptorRange &a, const RootDescriptorRange &b) {
+            if ((a.count == 0) != (b.count == 0)) {
+                return b.count == 0;
+            }
+            if (a.rangeType != b.rangeType) {
+                return rangeTypeRank(a.rangeType) < rangeTypeRank(b.rangeType);
+            }
+            if (a.space != b.space) {
+                return a.space < b.space;
+            }
+            return a.baseRegister < b.baseRegister;
+        });
+
+        // 合并寄存器连续的同类范围
+        QVector<RootDescriptorRange> ranges;
+        for (const RootDescriptorRange &range : table.ranges) {
+            if (!ranges.isEmpty()) {
+                RootDescriptorRange &last = ranges.last();
+                if (last.count != 0 && range.count != 0 && last.rangeType == range.rangeType && last.space == range.space
+                    && static_cast<quint64>(last.baseRegister) + last.count == range.baseRegister) {
+                    last.count += range.count;
+                    last.names << range.names;
+                    continue;
+                }
+            }
+            ranges.append(range);
+        }
+        table.ranges = ranges;
+        parameters.append(table);
+    }
+
+    // 所有阶段可见的表在前，其余按阶段顺序，Sampler 表排在同一可见性的资源表之后
+    static const QStringList kVisibilityOrder = { "ALL", "VERTEX", "HULL", "DOMAIN", "GEOMETRY", "AMPLIFICATION", "MESH", "PIXEL" };
+    std::stable_sort(parameters.begin(), parameters.end(), [](const RootParameter &a, const RootParameter &b) {
+        if (a.visibility != b.visibility) {
+            return kVisibilityOrder.indexOf(a.visibility) < kVisibilityOrder.indexOf(b.visibility);
+        }
+        return !a.samplerTable && b.samplerTable;
+    });
+    return parameters;
+}
+
+} // namespace
+
+bool PipelineLayoutGenerator::merge(const QVector<PipelineLayoutStage> &stages, PipelineLayout &layout, QStringList &warnings, QString &error)
+{
+    layout = PipelineLayout();
+    if (stages.isEmpty()) {
+        error = "No stage to merge.";
+        return false;
+    }
+
+    QMap<QString, int> resourceIndex;
+    QMap<QString, QString> resourceOwner; // 键 -> 首次声明的阶段文档
+    QMap<QString, QString> nameKeys; // 资源名称 -> 键
+    for (const PipelineLayoutStage &stage : stages) {
+        const ShaderReflection &reflection = stage.reflection;
+        if (layout.binaryType.isEmpty()) {
+            layout.binaryType = reflection.binaryType;
+        } else if (layout.binaryType != reflection.binaryType) {
+            error = QString("%1 is %2 but the other stages are %3.").arg(stage.name).arg(reflection.binaryType).arg(layout.binaryType);
+            return false;
+        }
+
+        QString stageName = reflection.entryPoints.isEmpty() ? stage.name : reflection.entryPoints.first().stage;
+        if (layout.stages.contains(stageName)) {
+            warnings << QString("%1 appears in more than one document.").arg(stageName);
+        } else {
+            layout.stages << stageName;
+        }
+        layout.allowInputAssembler = layout.allowInputAssembler || stageName == "Vertex";
+
+        for (const ShaderReflectionBinding &binding : reflection.descriptorBindings) {
+            QString key = resourceKey(layout.binaryType, binding);
+            if (!resourceIndex.contains(key)) {
+                PipelineLayoutResource resource;
+                resource.name = binding.name;
+                resource.descriptorType = binding.descriptorType;
+                resource.set = binding.set;
+                resource.binding = binding.binding;
+                resource.count = binding.count;
+                resourceIndex.insert(key, layout.resources.size());
+                resourceOwner.insert(key, stage.name);
+                layout.resources.append(resource);
+
+                if (nameKeys.contains(binding.name) && nameKeys.value(binding.name) != key) {
+                    warnings << QString("%1 is bound at %2 and %3 in different stages.").arg(binding.name).arg(nameKeys.value(binding.name)).arg(key);
+                }
+                nameKeys.insert(binding.name, key);
+            } else {
+                PipelineLayoutResource &resource = layout.resources[resourceIndex.value(key)];
+                if (resource.descriptorType != binding.descriptorType) {
+                    error = QString("Conflict at %1: %2 (%3) in %4, %5 (%6) in %7.").arg(key)
+                        .arg(resource.name).arg(resource.descriptorType).arg(resourceOwner.value(key))
+                        .arg(binding.name).arg(binding.descriptorType).arg(stage.name);
+                    return false;
+                }
+                if (resource.name != binding.name) {
+                    warnings << QString("%1 is named %2 in %3 and %4 in %5.").arg(key).arg(resource.name)
+                        .arg(resourceOwner.value(key)).arg(binding.name).arg(stage.name);
+                }
+                if (resource.count != binding.count) {
+                    warnings << QString("%1 has different array sizes across stages, using the largest.").arg(resource.name);
+                    resource.count = resource.count == 0 || binding.count == 0 ? 0 : qMax(resource.count, binding.count);
+                }
+            }
+
+            PipelineLayoutResource &resource = layout.resources[resourceIndex.value(key)];
+            if (!resource.stages.contains(stageName)) {
+                resource.stages << stageName;
+            }
+        }
+
+        // 各阶段的 push constant 块，偏移与大小相同的合并为一个范围
+        for (const ShaderReflectionPushConstant &pushConstant : reflection.pushConstants) {
+            bool merged = false;
+            for (PipelineLayoutPushConstant &range : layout.pushConstants) {
+                if (range.offset == pushConstant.offset && range.size == pushConstant.size) {
+                    if (!range.stages.contains(stageName)) {
+                        range.stages << stageName;
+                    }
+                    merged = true;
+                }
+            }
+            if (!merged) {
+                PipelineLayoutPushConstant range;
+                range.name = pushConstant.name;
+                range.offset = pushConstant.offset;
+                range.size = pushConstant.size;
+                range.stages << stageName;
+                layout.pushConstants.append(range);
+            }
+        }
+    }
+
+    for (PipelineLayoutResource &resource : layout.resources) {
+        std::sort(resource.stages.begin(), resource.stages.end(), [](const QString &a, const QString &b) {
+            return stageRank(a) < stageRank(b);
+        });
+    }
+    std::stable_sort(layout.resources.begin(), layout.resources.end(), [](const PipelineLayoutResource &a, const PipelineLayoutResource &b) {
+        if (a.set != b.set) {
+            return a.set < b.set;
+        }
+        if (a.descriptorType != b.descriptorType && rangeTypeRank(a.descriptorType) != rangeTypeRank(b.descriptorType)) {
+            return rangeTypeRank(a.descriptorType) < rangeTypeRank(b.descriptorType);
+        }
+        return a.binding < b.binding;
+    });
+
+    if (layout.binaryType == "DXIL") {
+        // 同类资源在同一 space 内的寄存器范围不能重叠
+        for (int i = 0; i < layout.resources.size(); ++i) {
+            for (int j = i + 1; j < layout.resources.size(); ++j) {
+                const PipelineLayoutResource &a = layout.resources[i];
+                const PipelineLayoutResource &b = layout.resources[j];
+                if (a.descriptorType != b.descriptorType || a.set != b.set) {
+                    continue;
+                }
+                // 无界数组（count 为 0）延伸到 space 末尾，按 64 位计算避免回绕
+                bool aBeforeB = a.count != 0 && static_cast<quint64>(a.binding) + a.count <= b.binding;
+                bool bBeforeA = b.count != 0 && static_cast<quint64>(b.binding) + b.count <= a.binding;
+                if (!aBeforeB && !bBeforeA) {
+                    error = QString("%1 and %2 overlap in %3 space%4.").arg(a.name).arg(b.name).arg(a.descriptorType).arg(a.set);
+                    return false;
+                }
+            }
+        }
+        layout.rootParameters = buildRootParameters(layout.resources);
+        if (layout.rootSignatureDwords() > 64) {
+            warnings << QString("The root signature needs %1 DWORDs, more than the 64 DWORD limit.").arg(layout.rootSignatureDwords());
+        }
+    } else {
+        for (const PipelineLayoutResource &resource : layout.resources) {
+            if (resource.count == 0) {
+                warnings << QString("%1 is a runtime array; set descriptorCount and VARIABLE_DESCRIPTOR_COUNT when creating the layout.").arg(resource.name);
+            }
+        }
+        for (int i = 0; i < layout.pushConstants.size(); ++i) {
+            for (int j = i + 1; j < layout.pushConstants.size(); ++j) {
+                for (const QString &stage : layout.pushConstants[i].stages) {
+                    if (layout.pushConstants[j].stages.contains(stage)) {
+                        warnings << QString("%1 uses more than one push constant range.").arg(stage);
+                    }
+                }
+            }
+        }
+    }
+    return true;
+}
+
+QString PipelineLayoutGenerator::rootSignatureString(const PipelineLayout &layout)
+{
+    QStringList parameters;
+    if (layout.allowInputAssembler) {
+        parameters << "RootFlags(ALLOW_INPUT_ASSEMBLER_INPUT_LAYOUT)";
+    }
+    for (const RootParameter &parameter : layout.rootParameters) {
+        QStringList ranges;
+        for (const RootDescriptorRange &range : parameter.ranges) {
+            QString text = QString("%1(%2%3").arg(range.rangeType).arg(registerPrefix(range.rangeType)).arg(range.baseRegister);
+            if (range.count != 1) {
+                text += QString(", numDescriptors=%1").arg(countText(range.count));
+            }
+            if (range.space != 0) {
+                text += QString(", space=%1").arg(range.space);
+            }
+            ranges << text + ")";
+        }
+        parameters << QString("DescriptorTable(%1, visibility=SHADER_VISIBILITY_%2)").arg(ranges.join(", ")).arg(parameter.visibility);
+    }
+    return parameters.join(", ");
+}
+
+QString PipelineLayoutGenerator::toCppHeader(const PipelineLayout &layout, const QString &layoutName)
+{
+    QString text;
+    text += QString("// Generated by ShaderCross from the %1 reflection of: %2\n").arg(layout.binaryType).arg(layout.stages.join(", "));
+    text += "#pragma once\n\n";
+
+    if (layout.binaryType == "DXIL") {
+        text += "#include <d3d12.h>\n\n";
+        text += QString("namespace %1 {\n\n").arg(layoutName);
+        for (int i = 0; i < layout.rootParameters.size(); ++i) {
+            const RootParameter &parameter = layout.rootParameters[i];
+            text += QString("static const D3D12_DESCRIPTOR_RANGE1 kTable%1Ranges[] = {\n").arg(i);
+            for (const RootDescriptorRange &range : parameter.ranges) {
+                text += QString("    { D3D12_DESCRIPTOR_RANGE_TYPE_%1, %2, %3, %4, D3D12_DESCRIPTOR_RANGE_FLAG_NONE, D3D12_DESCRIPTOR_RANGE_OFFSET_APPEND }, // %5\n")
+                    .arg(range.rangeType.toUpper()).arg(range.count == 0 ? QString("~0u") : QString::number(range.count))
+                    .arg(range.baseRegister).arg(range.space).arg(range.names.join(", "));
+            }
+            text += "};\n\n";
+        }
+
+        if (layout.rootParameters.isEmpty()) {
+            text += "static const D3D12_ROOT_PARAMETER1 *const kRootParameters = nullptr;\n";
+        } else {
+            text += "static const D3D12_ROOT_PARAMETER1 kRootParameters[] = {\n";
+            for (int i = 0; i < layout.rootParameters.size(); ++i) {
+                const RootParameter &parameter = layout.rootParameters[i];
+                text += QString("    { D3D12_ROOT_PARAMETER_TYPE_DESCRIPTOR_TABLE, { { %1, kTable%2Ranges } }, D3D12_SHADER_VISIBILITY_%3 },\n")
+                    .arg(parameter.ranges.size()).arg(i).arg(parameter.visibility);
+            }
+            text += "};\n";
+        }
+        text += QString("static const UINT kRootParameterCount = %1;\n").arg(layout.rootParameters.size());
+        text += QString("static const D3D12_ROOT_SIGNATURE_FLAGS kRootSignatureFlags = %1;\n")
+            .arg(layout.allowInputAssembler ? "D3D12_ROOT_SIGNATURE_FLAG_ALLOW_INPUT_ASSEMBLER_INPUT_LAYOUT" : "D3D12_ROOT_SIGNATURE_FLAG_NONE");
+        text += QString("static const char kRootSignature[] = \"%1\";\n").arg(rootSignatureString(layout));
+        text += QString("\n} // namespace %1\n").arg(layoutName);
+        return text;
+    }
+
+    text += "#include <vulkan/vulkan.h>\n\n";
+    text += QString("namespace %1 {\n\n").arg(layoutName);
+
+    // set 号不连续时中间补空的 set 布局
+    uint32_t setCount = 0;
+    for (const PipelineLayoutResource &resource : layout.resources) {
+        setCount = qMax(setCount, resource.set + 1);
+    }
+    QVector<int> bindingCounts(static_cast<int>(setCount), 0);
+    for (uint32_t set = 0; set < setCount; ++set) {
+        QString bindings;
+        for (const PipelineLayoutResource &resource : layout.resources) {
+            if (resource.set != set) {
+                continue;
+            }
+            ++bindingCounts[static_cast<int>(set)];
+            bindings += QString("    { %1, %2, %3, %4, nullptr }, // %5%6\n").arg(resource.binding).arg(vulkanDescriptorType(resource.descriptorType))
+                .arg(resource.count).arg(vulkanStageFlags(resource.stages)).arg(resource.name).arg(resource.count == 0 ? " (runtime array)" : "");
+        }
+        if (!bindings.isEmpty()) {
+            text += QString("static const VkDescriptorSetLayoutBinding kSet%1Bindings[] = {\n%2};\n\n").arg(set).arg(bindings);
+        }
+    }
+
+    if (setCount == 0) {
+        text += "static const VkDescriptorSetLayoutCreateInfo *const kSetLayouts = nullptr;\n";
+    } else {
+        text += "static const VkDescriptorSetLayoutCreateInfo kSetLayouts[] = {\n";
+        for (uint32_t set = 0; set < setCount; ++set) {
+            int count = bindingCounts[static_cast<int>(set)];
+            text += QString("    { VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO, nullptr, 0, %1, %2 },\n")
+                .arg(count).arg(count == 0 ? QString("nullptr") : QString("kSet%1Bindings").arg(set));
+        }
+        text += "};\n";
+    }
+    text += QString("static const uint32_t kSetLayoutCount = %1;\n\n").arg(setCount);
+
+    if (layout.pushConstants.isEmpty()) {
+        text += "static const VkPushConstantRange *const kPushConstantRanges = nullptr;\n";
+    } else {
+        text += "static const VkPushConstantRange kPushConstantRanges[] = {\n";
+        for (const PipelineLayoutPushConstant &range : layout.pushConstants) {
+            text += QString("    { %1, %2, %3 }, // %4\n").arg(vulkanStageFlags(range.stages)).arg(range.offset).arg(range.size).arg(range.name);
+        }
+        text += "};\n";
+    }
+    text += QString("static const uint32_t kPushConstantRangeCount = %1;\n").arg(layout.pushConstants.size());
+    text += QString("\n} // namespace %1\n").arg(layoutName);
+    return text;
+}
+
+QJsonObject PipelineLayoutGenerator::toJson(const PipelineLayout &layout)
+{
+    QJsonObject json;
+    json["binaryType"] = layout.binaryType;
+    json["stages"] = QJsonArray::fromStringList(layout.stages);
+
+    QJsonArray resourceArray;
+    for (const PipelineLayoutResource &resource : layout.resources) {
+        QJsonObject object;
+        object["name"] = resource.name;
+        object["descriptorType"] = resource.descriptorType;
+        object["set"] = static_cast<qint64>(resource.set);
+        object["binding"] = static_cast<qint64>(resource.binding);
+        object["count"] = static_cast<qint64>(resource.count);
+        object["stages"] = QJsonArray::fromStringList(resource.stages);
+        resourceArray.append(object);
+    }
+    json["resources"] = resourceArray;
+
+    QJsonArray pushConstantArray;
+    for (const PipelineLayoutPushConstant &range : layout.pushConstants) {
+        QJsonObject object;
+        object["name"] = range.name;
+        object["offset"] = static_cast<qint64>(range.offset);
+        object["size"] = static_cast<qint64>(range.size);
+        object["stages"] = QJsonArray::fromStringList(range.stages);
+        pushConstantArray.append(object);
+    }
+    json["pushConstants"] = pushConstantArray;
+
+    if (layout.binaryType == "DXIL") {
+        QJsonArray parameterArray;
+        for (const RootParameter &parameter : layout.rootParameters) {
+            QJsonArray rangeArray;
+            for (const RootDescriptorRange &range : parameter.ranges) {
+                QJsonObject object;
+                object["rangeType"] = range.rangeType;
+                object["baseRegister"] = static_cast<qint64>(range.baseRegister);
+                object["space"] = static_cast<qint64>(range.space);
+                object["count"] = static_cast<qint64>(range.count);
+                object["names"] = QJsonArray::fromStringList(range.names);
+                rangeArray.append(object);
+            }
+            QJsonObject object;
+            object["visibility"] = parameter.visibility;
+            object["ranges"] = rangeArray;
+            parameterArray.append(object);
+        }
+        json["rootParameters"] = parameterArray;
+        json["rootSignature"] = rootSignatureString(layout);
+        json["rootSignatureDwords"] = layout.rootSignatureDwords();
+    }
+    return json;
+}
+
+QString PipelineLayoutGenerator::reportText(const PipelineLayout &layout, const QStringList &warnings)
+{
+    QString text = QString("%1 pipeline: %2\n\n").arg(layout.binaryType).arg(layout.stages.join(", "));
+
+    bool isDxil = layout.binaryType == "DXIL";
+    text += QString("%1 %2  %3 %4  %5 %6\n").arg(isDxil ? "Space" : "Set", 5).arg(isDxil ? "Register" : "Binding", 8)
+        .arg("Type", -24).arg("Count", 9).arg("Stages", -28).arg("Name");
+    for (const PipelineLayoutResource &resource : layout.resources) {
+        QString slot = isDxil ? registerPrefix(resource.descriptorType) + QString::number(resource.binding) : QString::number(resource.binding);
+        text += QString("%1 %2  %3 %4  %5 %6\n").arg(resource.set, 5).arg(slot, 8).arg(resource.descriptorType, -24)
+            .arg(countText(resource.count), 9).arg(resource.stages.join(", "), -28).arg(resource.name);
+    }
+
+    if (!layout.pushConstants.isEmpty()) {
+        text += "\nPush constants:\n";
+        for (const PipelineLayoutPushConstant &range : layout.pushConstants) {
+            text += QString("  %1: offset %2, size %3 (%4)\n").arg(range.name).arg(range.offset).arg(range.size).arg(range.stages.join(", "));
+        }
+    }
+
+    if (isDxil) {
+        // 对比每个资源单独一个根参数（CBV 为根描述符）的大小
+        int naiveDwords = 0;
+        for (const PipelineLayoutResource &resource : layout.resources) {
+            naiveDwords += resource.descriptorType == "CBV" && resource.count == 1 ? 2 : 1;
+        }
+        text += QString("\nRoot signature: %1 parameters, %2 DWORDs (one parameter per resource: %3 DWORDs)\n")
+            .arg(layout.rootParameters.size()).arg(layout.rootSignatureDwords()).arg(naiveDwords);
+        text += rootSignatureString(layout) + "\n";
+    }
+
+    if (!warnings.isEmpty()) {
+        text += "\nWarnings:\n  " + warnings.join("\n  ") + "\n";
+    }
+    return text;
+}
@@ -0,0 +1,88 @@
+#ifndef PIPELINELAYOUTGENERATOR_H
+#define PIPELINELAYOUTGENERATOR_H
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QJsonObject>
+#include <cstdint>
+#include "shaderReflection.h"
+
+// 参与合并的一个阶段
+struct PipelineLayoutStage
+{
+    QString name; // 文档名称
+    ShaderReflection reflection;
+};
+
+// 合并后的资源，SPIR-V 为 set/binding，DXIL 为 space/register
+struct PipelineLayoutResource
+{
+    QString name;
+    QString descriptorType; // 与 ShaderReflection 相同的描述符类型名称
+    uint32_t set = 0;
+    uint32_t binding = 0;
+    uint32_t count = 1; // 0 表示不定长数组
+    QStringList stages;
+};
+
+// 合并后的 push constant 范围
+struct PipelineLayoutPushConstant
+{
+    QString name;
+    uint32_t offset = 0;
+    uint32_t size = 0;
+    QStringList stages;
+};
+
+// 根签名描述符表中的一个范围，寄存器连续的同类资源合并为一个范围
+struct RootDescriptorRange
+{
+    QString rangeType; // CBV、SRV、UAV 或 Sampler
+    uint32_t baseRegister = 0;
+    uint32_t space = 0;
+    uint32_t count = 1; // 0 表示 unbounded
+    QStringList names;
+};
+
+// 根参数，目前只生成描述符表
+struct RootParameter
+{
+    QString visibility; // ALL、VERTEX、PIXEL 等（D3D12_SHADER_VISIBILITY_ 后缀）
+    bool samplerTable = false;
+    QVector<RootDescriptorRange> ranges;
+};
+
+// 整条管线的布局
+struct PipelineLayout
+{
+    QString binaryType; // SPIR-V 或 DXIL
+    QStringList stages;
+    QVector<PipelineLayoutResource> resources; // 按 set、binding 排序
+    QVector<PipelineLayoutPushConstant> pushConstants;
+    QVector<RootParameter> rootParameters; // 仅 DXIL
+    bool allowInputAssembler = false; // 含顶点阶段时需要 ALLOW_INPUT_ASSEMBLER_INPUT_LAYOUT
+
+    int rootSignatureDwords() const { return rootParameters.size(); }
+};
+
+// PipelineLayoutGenerator 合并一条管线各阶段的反射数据，检测绑定冲突并计算各资源的阶段可见性，
+// 生成 Vulkan 管线布局或 D3D12 根签名（按可见性合并为最少的描述符表），输出 C++ 头文件或 JSON。
+class PipelineLayoutGenerator
+{
+public:
+    // 合并各阶段，同一绑定位置的描述符类型不同或 DXIL 寄存器范围重叠时失败
+    static bool merge(const QVector<PipelineLayoutStage> &stages, PipelineLayout &layout, QStringList &warnings, QString &error);
+
+    // 生成的 C++ 头文件，SPIR-V 使用 Vulkan 结构体，DXIL 使用 D3D12 结构体及 HLSL 根签名字符串
+    static QString toCppHeader(const PipelineLayout &layout, const QString &layoutName);
+
+    static QJsonObject toJson(const PipelineLayout &layout);
+
+    // HLSL 根签名字符串，可通过 [RootSignature()] 或 -rootsig-define 使用
+    static QString rootSignatureString(const PipelineLayout &layout);
+
+    static QString reportText(const PipelineLayout &layout, const QStringList &warnings);
+};
+
+#endif // PIPELINELAYOUTGENERATOR_H
@@ -0,0 +1,119 @@
+#include "shaderAutotuneDialog.h"
+#include <QtWidgets/QVBoxLayout>
+#include <QtWidgets/QHBoxLayout>
+#include <QtWidgets/QLabel>
+#include <QtWidgets/QHeaderView>
+#include <QtWidgets/QDialogButtonBox>
+#include <QtWidgets/QApplication>
+#include <QtWidgets/QMessageBox>
+
+// 构造函数，初始化自动调优对话框。
+ShaderAutotuneDialog::ShaderAutotuneDialog(const ShaderAutotuneRequest &request, const QString &recipesText, QWidget *parent)
+    : QDialog(parent), request(request)
+{
+    setWindowTitle(tr("Autotune (%1)").arg(request.compiler));
+    resize(900, 600);
+
+    QVBoxLayout *mainLayout = new QVBoxLayout(this);
+
+    mainLayout->addWidget(new QLabel(tr("Recipes (name | compiler options | spirv-opt options), one per line:"), this));
+    recipesEdit = new QPlainTextEdit(this);
+    recipesEdit->setStyleSheet("QPlainTextEdit { font-family: 'Consolas', monospace; }");
+    recipesEdit->setPlainText(recipesText.isEmpty() ? ShaderAutotuner::recipesToText(ShaderAutotuner::defaultRecipes(request.compiler, request.outputType)) : recipesText);
+    recipesEdit->setMaximumHeight(160);
+    mainLayout->addWidget(recipesEdit);
+
+    QHBoxLayout *runLayout = new QHBoxLayout();
+    QPushButton *resetButton = new QPushButton(tr("Reset Defaults"), this);
+    QPushButton *runButton = new QPushButton(tr("Run"), this);
+    runLayout->addWidget(resetButton);
+    runLayout->addStretch();
+    runLayout->addWidget(runButton);
+    mainLayout->addLayout(runLayout);
+
+    resultTable = new QTableWidget(this);
+    resultTable->setColumnCount(9);
+    resultTable->setHorizontalHeaderLabels(QStringList() << tr("Rank") << tr("Recipe") << tr("Compiler Options") << tr("spirv-opt")
+        << tr("Weighted Cost") << tr("Instructions") << tr("Size (bytes)") << tr("Time (s)") << tr("Status"));
+    resultTable->horizontalHeader()->setSectionResizeMode(QHeaderView::ResizeToContents);
+    resultTable->verticalHeader()->setVisible(false);
+    resultTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    resultTable->setSelectionBehavior(QAbstractItemView::SelectRows);
+    resultTable->setSelectionMode(QAbstractItemView::SingleSelection);
+    mainLayout->addWidget(resultTable, 1);
+
+    QDialogButtonBox *buttonBox = new QDialogButtonBox(QDialogButtonBox::Close, Qt::Horizontal, this);
+    saveButton = buttonBox->addButton(tr("Save Winner"), QDialogButtonBox::AcceptRole);
+    saveButton->setEnabled(false);
+    mainLayout->addWidget(buttonBox);
+
+    connect(resetButton, &QPushButton::clicked, this, &ShaderAutotuneDialog::resetRecipes);
+    connect(runButton, &QPushButton::clicked, this, &ShaderAutotuneDialog::runAutotune);
+    connect(saveButton, &QPushButton::clicked, this, &ShaderAutotuneDialog::saveWinner);
+    connect(buttonBox, &QDialogButtonBox::rejected, this, &QDialog::reject);
+}
+
+QString ShaderAutotuneDialog::recipesText() const
+{
+    return recipesEdit->toPlainText();
+}
+
+void ShaderAutotuneDialog::resetRecipes()
+{
+    recipesEdit->setPlainText(ShaderAutotuner::recipesToText(ShaderAutotuner::defaultRecipes(request.compiler, request.outputType)));
+}
+
+void ShaderAutotuneDialog::runAutotune()
+{
+    QVector<ShaderAutotuneRecipe> recipes = ShaderAutotuner::recipesFromText(recipesEdit->toPlainText());
+    if (recipes.isEmpty()) {
+        QMessageBox::information(this, windowTitle(), tr("No recipe to run."));
+        return;
+    }
+
+    // 各配方在工作线程中并行编译，完成前阻塞界面
+    QApplication::setOverrideCursor(Qt::WaitCursor);
+    results = ShaderAutotuner::run(request, recipes);
+    QApplication::restoreOverrideCursor();
+
+    resultTable->setRowCount(0);
+    for (int i = 0; i < results.size(); ++i) {
+        const ShaderAutotuneResult &result = results[i];
+        resultTable->insertRow(i);
+        resultTable->setItem(i, 0, new QTableWidgetItem(result.success ? QString::number(i + 1) : QString("-")));
+        resultTable->setItem(i, 1, new QTableWidgetItem(result.recipe.name));
+        resultTable->setItem(i, 2, new QTableWidgetItem(result.recipe.compilerOptions));
+        resultTable->setItem(i, 3, new QTableWidgetItem(request.compiler == "DXC" ? QString() : result.recipe.spirvOptimizeOptions));
+        if (result.success) {
+            resultTable->setItem(i, 4, new QTableWidgetItem(QString::number(result.weightedCost, 'f', 0)));
+            resultTable->setItem(i, 5, new QTableWidgetItem(QString::number(result.instructionCount, 'f', 0)));
+            resultTable->setItem(i, 6, new QTableWidgetItem(QString::number(result.binarySize)));
+            resultTable->setItem(i, 7, new QTableWidgetItem(QString::number(result.compileSeconds, 'f', 3)));
+            resultTable->setItem(i, 8, new QTableWidgetItem(tr("OK")));
+        } else {
+            QTableWidgetItem *statusItem = new QTableWidgetItem(tr("Failed"));
+            statusItem->setToolTip(result.error);
+            statusItem->setForeground(Qt::red);
+            resultTable->setItem(i, 8, statusItem);
+        }
+    }
+
+    saveButton->setEnabled(!results.isEmpty() && results.first().success);
+    if (saveButton->isEnabled()) {
+        resultTable->selectRow(0);
+    }
+}
+
+void ShaderAutotuneDialog::saveWinner()
+{
+    int row = resultTable->currentRow();
+    if (row < 0 || row >= results.size() || !results[row].success) {
+        row = 0;
+    }
+    if (results.isEmpty() || !results[row].success) {
+        return;
+    }
+
+    winner = results[row].recipe;
+    accept();
+}
@@ -0,0 +1,39 @@
+#ifndef SHADERAUTOTUNEDIALOG_H
+#define SHADERAUTOTUNEDIALOG_H
+
+#include <QtWidgets/QDialog>
+#include <QtWidgets/QPlainTextEdit>
+#include <QtWidgets/QTableWidget>
+#include <QtWidgets/QPushButton>
+#include "shaderAutotuner.h"
+
+// ShaderAutotuneDialog 编辑自动调优配方，并行编译后按代价排序显示，可将选中（默认第一名）的配方保存到文档设置。
+class ShaderAutotuneDialog : public QDialog
+{
+    Q_OBJECT
+
+public:
+    ShaderAutotuneDialog(const ShaderAutotuneRequest &request, const QString &recipesText, QWidget *parent = nullptr);
+
+    // 编辑后的配方文本
+    QString recipesText() const;
+
+    // 接受对话框后要保存的配方
+    ShaderAutotuneRecipe selectedRecipe() const { return winner; }
+
+private slots:
+    void runAutotune();
+    void resetRecipes();
+    void saveWinner();
+
+private:
+    ShaderAutotuneRequest request;
+    QVector<ShaderAutotuneResult> results;
+    ShaderAutotuneRecipe winner;
+
+    QPlainTextEdit *recipesEdit;
+    QTableWidget *resultTable;
+    QPushButton *saveButton;
+};
+
+#endif // SHADERAUTOTUNEDIALOG_H
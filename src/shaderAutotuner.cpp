@@ -0,0 +1,225 @@
+#include "shaderAutotuner.h"
+#include "shaderCostAnalyzer.h"
+#include "spirvModule.h"
+#include "dxcCompiler.h"
+#include "glslangCompiler.h"
+#include "glslangkgverCompiler.h"
+#include <QElapsedTimer>
+#include <QRegularExpression>
+#include <algorithm>
+#include <future>
+#include <vector>
+
+QVector<ShaderAutotuneRecipe> ShaderAutotuner::defaultRecipes(const QString &compiler, const QString &outputType)
+{
+    QVector<ShaderAutotuneRecipe> recipes;
+    if (compiler == "DXC") {
+        bool isSpirv = outputType == "SPIR-V" || outputType == "GLSL";
+        recipes.append({ "O0", "-O0", "" });
+        recipes.append({ "O1", "-O1", "" });
+        recipes.append({ "O2", "-O2", "" });
+        recipes.append({ "O3", "-O3", "" });
+        if (isSpirv) {
+            recipes.append({ "O3 + spv-reflect", "-O3 -fspv-reflect", "" });
+        }
+        // 16 位类型需要 SM 6.2 及以上，不满足时该配方编译失败
+        recipes.append({ "O3 + 16-bit types", "-O3 -enable-16bit-types", "" });
+    } else {
+        recipes.append({ "spirv-opt -O", "", "-O" });
+        recipes.append({ "spirv-opt -Os", "", "-Os" });
+        recipes.append({ "No spirv-opt", "", "" });
+        recipes.append({ "Unroll + -O", "", "--loop-unroll -O" });
+        recipes.append({ "Minimal cleanup", "",
+            "--merge-return --inline-entry-points-exhaustive --eliminate-dead-functions --scalar-replacement "
+            "--convert-local-access-chains --ssa-rewrite --eliminate-dead-code-aggressive --simplify-instructions "
+            "--vector-dce --merge-blocks --redundancy-elimination --eliminate-dead-code-aggressive" });
+    }
+    return recipes;
+}
+
+QString ShaderAutotuner::recipesToText(const QVector<ShaderAutotuneRecipe> &recipes)
+{
+    QString text = "# name | compiler options | spirv-opt options\n";
+    for (const ShaderAutotuneRecipe &recipe : recipes) {
+        text += QString("%1 | %2 | %3\n").arg(recipe.name).arg(recipe.compilerOptions).arg(recipe.spirvOptimizeOptions);
+    }
+    return text;
+}
+
+QVector<ShaderAutotuneRecipe> ShaderAutotuner::recipesFromText(const QString &text)
+{
+    QVector<ShaderAutotuneRecipe> recipes;
+    for (const QString &line : text.split('\n')) {
+        QString trimmed = line.trimmed();
+        if (trimmed.isEmpty() || trimmed.startsWith('#')) {
+            continue;
+        }
+
+        QStringList fields = trimmed.split('|');
+        ShaderAutotuneRecipe recipe;
+        recipe.name = fields.value(0).trimmed();
+        recipe.compilerOptions = fields.value(1).trimmed();
+        recipe.spirvOptimizeOptions = fields.value(2).trimmed();
+        if (!recipe.name.isEmpty()) {
+            recipes.append(recipe);
+        }
+    }
+    return recipes;
+}
+
+QString ShaderAutotuner::combinedOptions(const QString &baseOptions, const QString &recipeOptions)
+{
+    QStringList options;
+    for (const QString &option : baseOptions.split(QRegularExpression("\\s+"), QString::SkipEmptyParts)) {
+        if (option.startsWith("-O") || option == "-fspv-reflect" || option == "-enable-16bit-types") {
+            continue;
+        }
+        options.append(option);
+    }
+    options.append(recipeOptions.trimmed());
+    return options.join(' ').trimmed();
+}
+
+ShaderAutotuneResult ShaderAutotuner::compile(const ShaderAutotuneRequest &request, const ShaderAutotuneRecipe &recipe, const QString &tempFileTag)
+{
+    ShaderAutotuneResult result;
+    result.recipe = recipe;
+
+    QString options = combinedOptions(request.baseOptions, recipe.compilerOptions);
+    ShaderCostReport report;
+    bool hasBinary = false;
+
+    // 编译器实例在当前线程创建，信号以直接连接回调
+    auto onBinary = [&](const QByteArray &binary, const QString &binaryType, const QString &disassembly) {
+        hasBinary = true;
+        result.binarySize += binary.size();
+        result.binary = binary;
+        if (binaryType == "SPIR-V") {
+            SpirvModule module;
+            if (module.parse(binary)) {
+                report = ShaderCostAnalyzer::analyzeSpirv(module);
+                result.requiredFeatures = module.capabilityNames();
+                result.requiredFeatures.removeAll("Shader");
+                result.requiredFeatures.removeAll("Matrix");
+            }
+        } else {
+            report = ShaderCostAnalyzer::analyzeDxilDisassembly(disassembly);
+        }
+    };
+    auto onError = [&](const QString &error) {
+        result.error = error;
+    };
+    auto onReflection = [&](const ShaderReflection &reflection) {
+        result.hasReflection = true;
+        result.reflection = reflection;
+        if (reflection.binaryType == "DXIL") {
+            result.requiredFeatures = reflection.requiredFeatures;
+        }
+    };
+
+    QElapsedTimer timer;
+    timer.start();
+
+    if (request.compiler == "DXC") {
+        // DXIL 代价分析需要 -dumpbin 文本，SPIR-V 直接分析二进制
+        bool isSpirv = request.outputType == "SPIR-V" || request.outputType == "GLSL";
+        dxcCompiler compiler;
+        compiler.setTempFileTag(tempFileTag);
+        compiler.setIntermediateCache(request.intermediateCache);
+        QObject::connect(&compiler, &dxcCompiler::binaryGenerated, onBinary);
+        QObject::connect(&compiler, &dxcCompiler::compilationError, onError);
+        QObject::connect(&compiler, &dxcCompiler::reflectionGenerated, onReflection);
+        compiler.compile(request.shaderCode, request.languageType, request.shaderModel, request.entryPoint, request.shaderType,
+                         isSpirv ? "SPIR-V" : "DXIL", request.includePaths, request.macros, options);
+    } else if (request.compiler == "GLSLANG") {
+        glslangCompiler compiler;
+        compiler.setTempFileTag(tempFileTag);
+        compiler.setIntermediateCache(request.intermediateCache);
+        compiler.setSpirvOptimizeOptions(recipe.spirvOptimizeOptions);
+        QObject::connect(&compiler, &glslangCompiler::binaryGenerated, onBinary);
+        QObject::connect(&compiler, &glslangCompiler::compilationError, onError);
+        QObject::connect(&compiler, &glslangCompiler::reflectionGenerated, onReflection);
+        compiler.compile(request.shaderCode, request.languageType, request.shaderModel, request.entryPoint, request.shaderType,
+                         "SPIR-V", request.includePaths, request.macros, options);
+    } else if (request.compiler == "GLSLANGKGVER") {
+        glslangkgverCompiler compiler;
+        compiler.setTempFileTag(tempFileTag);
+        compiler.setIntermediateCache(request.intermediateCache);
+        compiler.setSpirvOptimizeOptions(recipe.spirvOptimizeOptions);
+        compiler.setEmitLineDirectives(request.emitLineDirectives);
+        compiler.setLinkedLibraries(request.linkedLibraries);
+        QObject::connect(&compiler, &glslangkgverCompiler::binaryGenerated, onBinary);
+        QObject::connect(&compiler, &glslangkgverCompiler::compilationError, onError);
+        QObject::connect(&compiler, &glslangkgverCompiler::reflectionGenerated, onReflection);
+        compiler.compile(request.shaderCode, request.shaderModel, request.entryPoint, request.shaderType,
+                         "SPIR-V", request.includePaths, request.macros, options);
+    } else {
+        result.error = QString("Autotune is not supported for %1.").arg(request.compiler);
+        return result;
+    }
+
+    result.compileSeconds = timer.nsecsElapsed() / 1e9;
+    result.success = hasBinary;
+
+    bool hasEntry = false;
+    for (const ShaderFunctionCost &function : report.functions) {
+        hasEntry = hasEntry || !function.stage.isEmpty();
+    }
+    for (const ShaderFunctionCost &function : report.functions) {
+        result.instructionCount += function.staticCounts.total();
+        if (!hasEntry || !function.stage.isEmpty()) {
+            result.weightedCost += function.weightedCounts.weightedCost();
+        }
+    }
+    return result;
+}
+
+QVector<ShaderAutotuneResult> ShaderAutotuner::run(const ShaderAutotuneRequest &request, const QVector<ShaderAutotuneRecipe> &recipes)
+{
+    std::vector<std::future<ShaderAutotuneResult>> futures;
+    for (int i = 0; i < recipes.size(); ++i) {
+        ShaderAutotuneRecipe recipe = recipes[i];
+        QString tempFileTag = QString("_autotune_%1").arg(i);
+        futures.push_back(std::async(std::launch::async, [&request, recipe, tempFileTag]() {
+            return compile(request, recipe, tempFileTag);
+        }));
+    }
+
+    QVector<ShaderAutotuneResult> results;
+    for (auto &future : futures) {
+        results.append(future.get());
+    }
+
+    std::stable_sort(results.begin(), results.end(), [](const ShaderAutotuneResult &a, const ShaderAutotuneResult &b) {
+        if (a.success != b.success) {
+            return a.success;
+        }
+        if (a.weightedCost != b.weightedCost) {
+            return a.weightedCost < b.weightedCost;
+        }
+        if (a.binarySize != b.binarySize) {
+            return a.binarySize < b.binarySize;
+        }
+        return a.compileSeconds < b.compileSeconds;
+    });
+    return results;
+}
+
+QVector<ShaderAutotuneResult> ShaderAutotuner::compileAll(const QVector<ShaderAutotuneRequest> &requests, const QString &tempFilePrefix,
+                                                          const ShaderAutotuneRecipe &recipe)
+{
+    std::vector<std::future<ShaderAutotuneResult>> futures;
+    for (int i = 0; i < requests.size(); ++i) {
+        const ShaderAutotuneRequest &request = requests[i];
+        QString tempFileTag = QString("%1_%2").arg(tempFilePrefix).arg(i);
+        futures.push_back(std::async(std::launch::async, [&request, &recipe, tempFileTag]() {
+            return compile(request, recipe, tempFileTag);
+        }));
+    }
+
+    QVector<ShaderAutotuneResult> results;
+    for (auto &future : futures) {
+        results.append(future.get());
+    }
+    return results;
+}
@@ -0,0 +1,79 @@
+#ifndef SHADERAUTOTUNER_H
+#define SHADERAUTOTUNER_H
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QByteArray>
+#include "shaderReflection.h"
+
+class ShaderIntermediateCache;
+
+// 一组待比较的编译参数
+struct ShaderAutotuneRecipe
+{
+    QString name; // 配方名称
+    QString compilerOptions; // 追加到编译命令的选项
+    QString spirvOptimizeOptions; // glslang 后端的 spirv-opt 参数，为空时不优化；DXC 忽略
+};
+
+// 自动调优的编译输入，与文档当前的编译设置一致
+struct ShaderAutotuneRequest
+{
+    QString compiler; // DXC、GLSLANG 或 GLSLANGKGVER
+    QString shaderCode;
+    QString languageType;
+    QString shaderModel;
+    QString entryPoint;
+    QString shaderType;
+    QString outputType;
+    QStringList includePaths;
+    QStringList macros;
+    QString baseOptions; // 用户的额外编译选项，所有配方共用
+    bool emitLineDirectives = false; // GLSLANGKGVER
+    QStringList linkedLibraries; // GLSLANGKGVER
+    ShaderIntermediateCache *intermediateCache = nullptr; // 只有 spirv-opt 参数不同的配方复用前端结果
+};
+
+// 单个配方的编译结果
+struct ShaderAutotuneResult
+{
+    ShaderAutotuneRecipe recipe;
+    bool success = false;
+    QString error;
+    qint64 binarySize = 0; // 字节
+    double instructionCount = 0; // 静态指令数
+    double weightedCost = 0; // 入口函数的加权代价
+    double compileSeconds = 0;
+    QStringList requiredFeatures; // DXIL 需要的可选硬件特性，SPIR-V 为 Shader 以外的 OpCapability
+    QByteArray binary; // 编译产物，多个阶段时为最后一个
+    bool hasReflection = false;
+    ShaderReflection reflection;
+};
+
+// ShaderAutotuner 用一组配方并行编译当前着色器，按静态指令代价及二进制大小排序。
+class ShaderAutotuner
+{
+public:
+    // 编译器的默认配方：DXC 为 -O0..-O3、-fspv-reflect 及 16 位类型，glslang 为 spirv-opt -O/-Os/不优化及自定义 pass 列表
+    static QVector<ShaderAutotuneRecipe> defaultRecipes(const QString &compiler, const QString &outputType);
+
+    // 配方文本格式：每行 "名称 | 编译选项 | spirv-opt 参数"，# 开头为注释
+    static QString recipesToText(const QVector<ShaderAutotuneRecipe> &recipes);
+    static QVector<ShaderAutotuneRecipe> recipesFromText(const QString &text);
+
+    // 用户选项去掉配方控制的 -O*、-fspv-reflect、-enable-16bit-types 后再追加配方选项，避免同类选项叠加
+    static QString combinedOptions(const QString &baseOptions, const QString &recipeOptions);
+
+    // 并行编译所有配方，成功的按加权代价、二进制大小、编译耗时排序，失败的排在最后
+    static QVector<ShaderAutotuneResult> run(const ShaderAutotuneRequest &request, const QVector<ShaderAutotuneRecipe> &recipes);
+
+    // 并行编译一组请求（如不同 Shader Model 或不同编译器），所有请求使用同一配方，结果与输入顺序一致
+    static QVector<ShaderAutotuneResult> compileAll(const QVector<ShaderAutotuneRequest> &requests, const QString &tempFilePrefix,
+                                                    const ShaderAutotuneRecipe &recipe = ShaderAutotuneRecipe());
+
+    // 在当前线程编译单个配方，编译器实例属于该线程，信号直接回调；tempFileTag 区分并行实例的临时文件
+    static ShaderAutotuneResult compile(const ShaderAutotuneRequest &request, const ShaderAutotuneRecipe &recipe, const QString &tempFileTag);
+};
+
+#endif // SHADERAUTOTUNER_H
@@ -0,0 +1,459 @@
+#include "shaderBuildDiff.h"
+#include <QRegularExpression>
+#include <QStringList>
+#include <QPair>
+#include <QHash>
+
+// 超过该规模的 LCS 对齐退化为按顺序贪心匹配，避免占用过多内存
+static const qint64 kMaxAlignCells = 4 * 1024 * 1024;
+
+// 单个块内最多输出的指令差异行数
+static const int kMaxInstructionDiffLines = 40;
+
+ShaderBuildSnapshot ShaderBuildSnapshot::capture(const QString &compiler, const QString &outputType, const QString &output,
+                                                 const QVector<QByteArray> &binaries, const QVector<ShaderCostReport> &costReports,
+                                                 double compileSeconds)
+{
+    static const QRegularExpression dclTempsRe(R"(\bdcl_temps (\d+))");
+    static const QRegularExpression spirvBoundRe(R"(^; Bound: (\d+))", QRegularExpression::MultilineOption);
+    static const QRegularExpression ssaValueRe(R"(^\s+%[\w.]+ = )", QRegularExpression::MultilineOption);
+
+    ShaderBuildSnapshot snapshot;
+    snapshot.time = QDateTime::currentDateTime();
+    snapshot.compiler = compiler;
+    snapshot.outputType = outputType;
+    snapshot.compileSeconds = compileSeconds;
+    snapshot.disassembly = output;
+
+    if (!binaries.isEmpty()) {
+        snapshot.binarySize = 0;
+        for (const QByteArray &binary : binaries) {
+            snapshot.binarySize += binary.size();
+        }
+    }
+
+    // 静态计数按函数累加即为整个模块的指令数；加权代价只统计入口函数（已展开调用）
+    for (const ShaderCostReport &report : costReports) {
+        bool hasEntry = false;
+        for (const ShaderFunctionCost &function : report.functions) {
+            hasEntry = hasEntry || !function.stage.isEmpty();
+        }
+        for (const ShaderFunctionCost &function : report.functions) {
+            snapshot.instructionCounts.add(function.staticCounts);
+            if (!hasEntry || !function.stage.isEmpty()) {
+                snapshot.weightedCost += function.weightedCounts.weightedCost();
+            }
+        }
+        snapshot.hasInstructionCounts = snapshot.hasInstructionCounts || !report.isEmpty();
+    }
+
+    // 寄存器压力的近似指标，取决于输出格式
+    int temps = 0;
+    QRegularExpressionMatchIterator dclTemps = dclTempsRe.globalMatch(output);
+    QRegularExpressionMatchIterator spirvBound = spirvBoundRe.globalMatch(output);
+    if (dclTemps.hasNext()) {
+        while (dclTemps.hasNext()) {
+            temps += dclTemps.next().captured(1).toInt();
+        }
+        snapshot.temps = temps;
+        snapshot.tempsLabel = "Temp registers";
+    } else if (spirvBound.hasNext()) {
+        while (spirvBound.hasNext()) {
+            temps += spirvBound.next().captured(1).toInt();
+        }
+        snapshot.temps = temps;
+        snapshot.tempsLabel = "ID bound";
+    } else if (outputType == "DXIL") {
+        QRegularExpressionMatchIterator ssaValues = ssaValueRe.globalMatch(output);
+        while (ssaValues.hasNext()) {
+            ssaValues.next();
+            temps++;
+        }
+        snapshot.temps = temps;
+        snapshot.tempsLabel = "SSA values";
+    }
+
+    return snapshot;
+}
+
+// ---------------- 指标对比 ----------------
+
+static QString metricRow(const QString &name, double baseline, double current, int precision)
+{
+    double delta = current - baseline;
+    QString deltaText = QString("%1%2").arg(delta > 0 ? "+" : "").arg(delta, 0, 'f', precision);
+    if (baseline != 0) {
+        deltaText += QString(" (%1%2%)").arg(delta > 0 ? "+" : "").arg(delta / baseline * 100.0, 0, 'f', 1);
+    }
+    return QString("%1 %2 %3   %4\n")
+        .arg(name, -24)
+        .arg(baseline, 12, 'f', precision)
+        .arg(current, 12, 'f', precision)
+        .arg(delta == 0 ? QString("=") : deltaText);
+}
+
+static QString unknownMetricRow(const QString &name)
+{
+    return QString("%1 %2 %3   %4\n").arg(name, -24).arg("n/a", 12).arg("n/a", 12).arg("");
+}
+
+QString ShaderBuildDiff::compareMetrics(const ShaderBuildSnapshot &baseline, const ShaderBuildSnapshot &current)
+{
+    QString text = QString("Baseline: %1 (%2, %3)\n").arg(baseline.time.toString("yyyy-MM-dd HH:mm:ss")).arg(baseline.compiler).arg(baseline.outputType);
+    text += QString("Current:  %1 (%2, %3)\n").arg(current.time.toString("yyyy-MM-dd HH:mm:ss")).arg(current.compiler).arg(current.outputType);
+    if (baseline.compiler != current.compiler || baseline.outputType != current.outputType) {
+        text += "Warning: compiler or output type differs from the baseline.\n";
+    }
+    text += "\n";
+    text += QString("%1 %2 %3   %4\n").arg("Metric", -24).arg("Baseline", 12).arg("Current", 12).arg("Delta");
+
+    if (baseline.binarySize >= 0 && current.binarySize >= 0) {
+        text += metricRow("Binary size (bytes)", baseline.binarySize, current.binarySize, 0);
+    } else {
+        text += unknownMetricRow("Binary size (bytes)");
+    }
+
+    if (baseline.hasInstructionCounts && current.hasInstructionCounts) {
+        const ShaderCostCounts &a = baseline.instructionCounts;
+        const ShaderCostCounts &b = current.instructionCounts;
+        text += metricRow("Instructions", a.total(), b.total(), 0);
+        text += metricRow("  ALU", a.alu, b.alu, 0);
+        text += metricRow("  Transcendental", a.transcendental, b.transcendental, 0);
+        text += metricRow("  Texture sample", a.textureSample, b.textureSample, 0);
+        text += metricRow("  Texture fetch", a.textureFetch, b.textureFetch, 0);
+        text += metricRow("  Memory load", a.memoryLoad, b.memoryLoad, 0);
+        text += metricRow("  Memory store", a.memoryStore, b.memoryStore, 0);
+        text += metricRow("  Barrier", a.barrier, b.barrier, 0);
+        text += metricRow("  Control flow", a.controlFlow, b.controlFlow, 0);
+        text += metricRow("Weighted cost", baseline.weightedCost, current.weightedCost, 0);
+    } else {
+        text += unknownMetricRow("Instructions");
+    }
+
+    if (baseline.temps >= 0 && current.temps >= 0 && baseline.tempsLabel == current.tempsLabel) {
+        text += metricRow(current.tempsLabel, baseline.temps, current.temps, 0);
+    } else {
+        text += unknownMetricRow("Registers/temps");
+    }
+
+    text += metricRow("Compile time (s)", baseline.compileSeconds, current.compileSeconds, 3);
+    return text;
+}
+
+// ---------------- 结构化差异 ----------------
+
+struct DisassemblyBlock
+{
+    QString label;
+    QStringList instructions; // 归一化后的指令
+    uint hash = 0;
+};
+
+struct DisassemblyFunction
+{
+    QString name;
+    QVector<DisassemblyBlock> blocks;
+
+    int instructionCount() const
+    {
+        int count = 0;
+        for (const DisassemblyBlock &block : blocks) {
+            count += block.instructions.size();
+        }
+        return count;
+    }
+};
+
+// 归一化指令文本：数字 SSA ID 及元数据编号替换为占位符，LLVM 名称的重名后缀去掉
+static QString normalizeInstruction(const QString &line, bool isSpirv)
+{
+    static const QRegularExpression numericIdRe(R"(%\d+\b)");
+    static const QRegularExpression llvmSuffixRe(R"((%[A-Za-z_.$][\w.$]*?)\d+\b)");
+    static const QRegularExpression debugLocationRe(R"(,\s*!dbg !\d+)");
+    static const QRegularExpression metadataRe(R"(!\d+\b)");
+
+    QString normalized = line.trimmed();
+    if (!isSpirv) {
+        int comment = normalized.indexOf(';');
+        if (comment >= 0) {
+            normalized = normalized.left(comment).trimmed();
+        }
+        normalized.remove(debugLocationRe);
+        normalized.replace(metadataRe, "!_");
+    }
+    normalized.replace(numericIdRe, "%_");
+    if (!isSpirv) {
+        normalized.replace(llvmSuffixRe, "\\1");
+    }
+    return normalized.simplified();
+}
+
+// 按函数、基本块拆分 spirv-dis 或 DXIL 反汇编文本；无法识别时整个文本作为一个块
+static QVector<DisassemblyFunction> parseDisassembly(const QString &text)
+{
+    static const QRegularExpression spirvFunctionRe(R"(^\s*(%[\w.$]+) = OpFunction\b)");
+    static const QRegularExpression spirvLabelRe(R"(^\s*(%[\w.$]+) = OpLabel\b)");
+    static const QRegularExpression dxilDefineRe(R"(^define\s+[^@]*@([\w.$]+)\()");
+    static const QRegularExpression dxilLabelRe(R"(^([\w.$]+):)");
+    static const QRegularExpression dxilNumberedLabelRe(R"(^; <label>:(\d+))");
+
+    const bool isSpirv = text.contains("OpFunctionEnd");
+    const QStringList lines = text.split('\n');
+
+    QVector<DisassemblyFunction> functions;
+    DisassemblyFunction *current = nullptr;
+    auto newBlock = [&](const QString &label) {
+        DisassemblyBlock block;
+        block.label = label;
+        current->blocks.append(block);
+    };
+
+    for (const QString &line : lines) {
+        if (current == nullptr) {
+            QRegularExpressionMatch match = isSpirv ? spirvFunctionRe.match(line) : dxilDefineRe.match(line);
+            if (match.hasMatch()) {
+                functions.append(DisassemblyFunction());
+                current = &functions.last();
+                current->name = match.captured(1);
+                // SPIR-V 的函数参数及 DXIL 的入口块没有标签
+                newBlock(isSpirv ? QString("(parameters)") : QString("entry"));
+            }
+            continue;
+        }
+
+        if (isSpirv ? line.contains("OpFunctionEnd") : line.startsWith('}')) {
+            current = nullptr;
+            continue;
+        }
+
+        QRegularExpressionMatch labelMatch = isSpirv ? spirvLabelRe.match(line) : dxilLabelRe.match(line);
+        if (!labelMatch.hasMatch() && !isSpirv) {
+            labelMatch = dxilNumberedLabelRe.match(line);
+        }
+        if (labelMatch.hasMatch()) {
+            // 没有参数的 SPIR-V 函数不保留空的参数块
+            if (current->blocks.size() == 1 && current->blocks.first().instructions.isEmpty()) {
+                current->blocks.clear();
+            }
+            newBlock(labelMatch.captured(1));
+            continue;
+        }
+
+        // 调试信息不参与比较
+        if (line.contains("OpLine") || line.contains("OpNoLine") || line.contains("@llvm.dbg.")) {
+            continue;
+        }
+
+        QString instruction = normalizeInstruction(line, isSpirv);
+        if (!instruction.isEmpty()) {
+            current->blocks.last().instructions.append(instruction);
+        }
+    }
+
+    if (functions.isEmpty()) {
+        DisassemblyFunction whole;
+        whole.name = "(output)";
+        DisassemblyBlock block;
+        for (const QString &line : lines) {
+            QString trimmed = line.trimmed();
+            if (!trimmed.isEmpty() && !trimmed.startsWith("//") && !trimmed.startsWith("cost time")) {
+                block.instructions.append(trimmed.simplified());
+            }
+        }
+        whole.blocks.append(block);
+        functions.append(whole);
+    }
+
+    for (DisassemblyFunction &function : functions) {
+        for (DisassemblyBlock &block : function.blocks) {
+            block.hash = qHash(block.instructions.join('\n'));
+        }
+    }
+    return functions;
+}
+
+// 最长公共子序列对齐，返回匹配的下标对；规模过大时按顺序在小窗口内贪心匹配
+template <typename T>
+static QVector<QPair<int, int>> alignSequences(const QVector<T> &a, const QVector<T> &b)
+{
+    QVector<QPair<int, int>> matches;
+    const int n = a.size();
+    const int m = b.size();
+
+    if (static_cast<qint64>(n + 1) * (m + 1) > kMaxAlignCells) {
+        int j = 0;
+        for (int i = 0; i < n && j < m; ++i) {
+            for (int k = j; k < m && k < j + 64; ++k) {
+                if (a[i] == b[k]) {
+                    matches.append(qMakePair(i, k));
+                    j = k + 1;
+                    break;
+                }
+            }
+        }
+        return matches;
+    }
+
+    QVector<int> lengths((n + 1) * (m + 1), 0);
+    auto at = [&](int i, int j) -> int & { return lengths[i * (m + 1) + j]; };
+    for (int i = n - 1; i >= 0; --i) {
+        for (int j = m - 1; j >= 0; --j) {
+            at(i, j) = a[i] == b[j] ? at(i + 1, j + 1) + 1 : qMax(at(i + 1, j), at(i, j + 1));
+        }
+    }
+
+    int i = 0;
+    int j = 0;
+    while (i < n && j < m) {
+        if (a[i] == b[j]) {
+            matches.append(qMakePair(i, j));
+            ++i;
+            ++j;
+        } else if (at(i + 1, j) >= at(i, j + 1)) {
+            ++i;
+        } else {
+            ++j;
+        }
+    }
+    return matches;
+}
+
+// 输出修改过的块的指令级差异
+static void diffInstructions(const DisassemblyBlock &baseline, const DisassemblyBlock &current, QString &text)
+{
+    QVector<QString> a = baseline.instructions.toVector();
+    QVector<QString> b = current.instructions.toVector();
+    QVector<QPair<int, int>> matches = alignSequences(a, b);
+    matches.append(qMakePair(a.size(), b.size()));
+
+    int removed = a.size() - (matches.size() - 1);
+    int added = b.size() - (matches.size() - 1);
+    text += QString("  ~ block %1 -> %2: -%3 +%4\n").arg(baseline.label).arg(current.label).arg(removed).arg(added);
+
+    int printed = 0;
+    int i = 0;
+    int j = 0;
+    for (const QPair<int, int> &match : matches) {
+        for (; i < match.first; ++i) {
+            if (printed++ < kMaxInstructionDiffLines) {
+                text += "      - " + a[i] + "\n";
+            }
+        }
+        for (; j < match.second; ++j) {
+            if (printed++ < kMaxInstructionDiffLines) {
+                text += "      + " + b[j] + "\n";
+            }
+        }
+        ++i;
+        ++j;
+    }
+    if (printed > kMaxInstructionDiffLines) {
+        text += QString("      ... %1 more lines\n").arg(printed - kMaxInstructionDiffLines);
+    }
+}
+
+// 按块内容对齐两个函数的基本块，未对齐的块按顺序配对为修改，其余为新增或删除
+static int diffFunction(const DisassemblyFunction &baseline, const DisassemblyFunction &current, QString &text)
+{
+    QVector<uint> a;
+    QVector<uint> b;
+    for (const DisassemblyBlock &block : baseline.blocks) {
+        a.append(block.hash);
+    }
+    for (const DisassemblyBlock &block : current.blocks) {
+        b.append(block.hash);
+    }
+    QVector<QPair<int, int>> matches = alignSequences(a, b);
+    matches.append(qMakePair(a.size(), b.size()));
+
+    QString blockText;
+    int changedBlocks = 0;
+    int i = 0;
+    int j = 0;
+    for (const QPair<int, int> &match : matches) {
+        while (i < match.first && j < match.second) {
+            diffInstructions(baseline.blocks[i++], current.blocks[j++], blockText);
+            changedBlocks++;
+        }
+        for (; i < match.first; ++i, ++changedBlocks) {
+            blockText += QString("  - block %1: %2 instructions\n").arg(baseline.blocks[i].label).arg(baseline.blocks[i].instructions.size());
+        }
+        for (; j < match.second; ++j, ++changedBlocks) {
+            blockText += QString("  + block %1: %2 instructions\n").arg(current.blocks[j].label).arg(current.blocks[j].instructions.size());
+        }
+        ++i;
+        ++j;
+    }
+
+    if (changedBlocks == 0) {
+        return 0;
+    }
+
+    text += QString("Function %1: %2 -> %3 blocks, %4 -> %5 instructions, %6 unchanged blocks\n")
+        .arg(current.name)
+        .arg(baseline.blocks.size())
+        .arg(current.blocks.size())
+        .arg(baseline.instructionCount())
+        .arg(current.instructionCount())
+        .arg(matches.size() - 1);
+    text += blockText;
+    return changedBlocks;
+}
+
+QString ShaderBuildDiff::structuralDiff(const QString &baselineDisassembly, const QString &currentDisassembly)
+{
+    QVector<DisassemblyFunction> baselineFunctions = parseDisassembly(baselineDisassembly);
+    QVector<DisassemblyFunction> currentFunctions = parseDisassembly(currentDisassembly);
+
+    // 先按名称匹配函数，剩余的未命名函数按顺序配对
+    QHash<QString, int> baselineByName;
+    for (int i = 0; i < baselineFunctions.size(); ++i) {
+        baselineByName.insert(baselineFunctions[i].name, i);
+    }
+    QVector<int> pairedBaseline(currentFunctions.size(), -1);
+    QVector<bool> baselineUsed(baselineFunctions.size(), false);
+    for (int i = 0; i < currentFunctions.size(); ++i) {
+        int baselineIndex = baselineByName.value(currentFunctions[i].name, -1);
+        if (baselineIndex >= 0 && !baselineUsed[baselineIndex]) {
+            pairedBaseline[i] = baselineIndex;
+            baselineUsed[baselineIndex] = true;
+        }
+    }
+    int nextUnused = 0;
+    for (int i = 0; i < currentFunctions.size(); ++i) {
+        if (pairedBaseline[i] >= 0) {
+            continue;
+        }
+        while (nextUnused < baselineFunctions.size() && baselineUsed[nextUnused]) {
+            ++nextUnused;
+        }
+        if (nextUnused < baselineFunctions.size()) {
+            pairedBaseline[i] = nextUnused;
+            baselineUsed[nextUnused] = true;
+        }
+    }
+
+    QString text;
+    int changedBlocks = 0;
+    for (int i = 0; i < currentFunctions.size(); ++i) {
+        if (pairedBaseline[i] < 0) {
+            text += QString("+ function %1: %2 blocks, %3 instructions\n")
+                .arg(currentFunctions[i].name).arg(currentFunctions[i].blocks.size()).arg(currentFunctions[i].instructionCount());
+            changedBlocks += currentFunctions[i].blocks.size();
+            continue;
+        }
+        changedBlocks += diffFunction(baselineFunctions[pairedBaseline[i]], currentFunctions[i], text);
+    }
+    for (int i = 0; i < baselineFunctions.size(); ++i) {
+        if (!baselineUsed[i]) {
+            text += QString("- function %1: %2 blocks, %3 instructions\n")
+                .arg(baselineFunctions[i].name).arg(baselineFunctions[i].blocks.size()).arg(baselineFunctions[i].instructionCount());
+            changedBlocks += baselineFunctions[i].blocks.size();
+        }
+    }
+
+    if (changedBlocks == 0) {
+        return "No structural changes.\n";
+    }
+    return text;
+}
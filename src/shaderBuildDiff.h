@@ -0,0 +1,45 @@
+#ifndef SHADERBUILDDIFF_H
+#define SHADERBUILDDIFF_H
+
+#include <QString>
+#include <QByteArray>
+#include <QVector>
+#include <QDateTime>
+#include "shaderCostAnalyzer.h"
+
+// 一次编译结果的快照，用于与固定的基线比较
+struct ShaderBuildSnapshot
+{
+    QDateTime time; // 编译时间
+    QString compiler; // 编译器
+    QString outputType; // 输出类型
+    qint64 binarySize = -1; // 二进制总大小（字节），未生成二进制时为 -1
+    bool hasInstructionCounts = false;
+    ShaderCostCounts instructionCounts; // 所有函数的静态指令计数
+    double weightedCost = 0; // 入口函数的加权代价之和
+    int temps = -1; // 临时寄存器数（DXBC dcl_temps）、ID 上界（SPIR-V）或 SSA 值数量（DXIL），未知为 -1
+    QString tempsLabel; // temps 的含义
+    double compileSeconds = 0; // 编译耗时（秒）
+    QString disassembly; // 编译输出文本
+
+    bool isValid() const { return time.isValid(); }
+
+    // 由编译输出、编译产物及代价报告生成快照
+    static ShaderBuildSnapshot capture(const QString &compiler, const QString &outputType, const QString &output,
+                                       const QVector<QByteArray> &binaries, const QVector<ShaderCostReport> &costReports,
+                                       double compileSeconds);
+};
+
+// ShaderBuildDiff 比较两次编译结果：指标差值，以及按函数、基本块对齐的反汇编结构差异，
+// 重新编号的 SSA ID 归一化后比较，避免编号变化淹没真正的差异。
+class ShaderBuildDiff
+{
+public:
+    // 指标对比表
+    static QString compareMetrics(const ShaderBuildSnapshot &baseline, const ShaderBuildSnapshot &current);
+
+    // 结构化反汇编差异，支持 spirv-dis 及 DXIL（LLVM IR）文本，其他文本按单个块比较
+    static QString structuralDiff(const QString &baselineDisassembly, const QString &currentDisassembly);
+};
+
+#endif // SHADERBUILDDIFF_H
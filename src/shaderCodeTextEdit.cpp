@@ -1,4 +1,9 @@
 #include "shaderCodeTextEdit.h"
+#include <QToolTip>
+#include <QHelpEvent>
+
+// 行代价热度条宽度
+static const int kHeatBarWidth = 6;
 
 QStringList GetKeyWords(const QString &language)
 {
@@ -168,7 +173,7 @@ void ShaderCodeHighlighter::highlightString(const QString &text) {
 }
 
 ShaderCodeTextEdit::ShaderCodeTextEdit(QWidget *parent)
-    : QPlainTextEdit(parent), highlighter(new ShaderCodeHighlighter(document())) {
+    : QPlainTextEdit(parent), highlighter(new ShaderCodeHighlighter(document())), maxLineCost(0) {
     // 设置默认的着色器语言
     setShaderLanguage("HLSL");
 
@@ -201,6 +206,9 @@ int ShaderCodeTextEdit::lineNumberAreaWidth() {
         ++digits;
     }
     int space = 10 + fontMetrics().horizontalAdvance(QLatin1Char('9')) * digits;
+    if (!lineCosts.isEmpty()) {
+        space += kHeatBarWidth;
+    }
     return space;
 }
 
@@ -229,6 +237,14 @@ inline void ShaderCodeTextEdit::lineNumberAreaPaintEvent(QPaintEvent* event) {
         if (block.isVisible()) {
             painter.drawText(-2, top, lineNumberArea->width(), boundingGeo.height(),
                 Qt::AlignRight, QString::number(blockNumber + 1));
+
+            // 热度由黄到红，代价越高颜色越红、越不透明
+            auto costIter = lineCosts.constFind(blockNumber + 1);
+            if (costIter != lineCosts.constEnd() && maxLineCost > 0) {
+                double ratio = qBound(0.0, costIter.value().weightedCounts.weightedCost() / maxLineCost, 1.0);
+                QColor heatColor = QColor::fromHsv(static_cast<int>(60 * (1.0 - ratio)), 255, 255, 96 + static_cast<int>(159 * ratio));
+                painter.fillRect(QRectF(0, top, kHeatBarWidth, boundingGeo.height()), heatColor);
+            }
         }
         block = block.next();
         boundingGeo = blockBoundingGeometry(block);
@@ -249,3 +265,66 @@ QSize LineNumberArea::sizeHint() const {
 void LineNumberArea::paintEvent(QPaintEvent* event) {
     editor->lineNumberAreaPaintEvent(event);
 }
+
+bool LineNumberArea::event(QEvent* event) {
+    if (event->type() == QEvent::ToolTip) {
+        QHelpEvent* helpEvent = static_cast<QHelpEvent*>(event);
+        QString toolTip = editor->lineCostToolTip(helpEvent->pos().y());
+        if (toolTip.isEmpty()) {
+            QToolTip::hideText();
+            event->ignore();
+        } else {
+            QToolTip::showText(helpEvent->globalPos(), toolTip, this);
+        }
+        return true;
+    }
+    return QWidget::event(event);
+}
+
+void ShaderCodeTextEdit::setLineCosts(const QMap<int, ShaderLineCost> &costs) {
+    lineCosts = costs;
+    maxLineCost = 0;
+    for (const ShaderLineCost &cost : lineCosts) {
+        maxLineCost = qMax(maxLineCost, cost.weightedCounts.weightedCost());
+    }
+    updateLineNumberAreaWidth(0);
+    QRect cr = contentsRect();
+    lineNumberArea->setGeometry(QRect(cr.left(), cr.top(), lineNumberAreaWidth(), cr.height()));
+    lineNumberArea->update();
+}
+
+QString ShaderCodeTextEdit::lineCostToolTip(int y) {
+    if (lineCosts.isEmpty()) {
+        return QString();
+    }
+
+    int line = cursorForPosition(QPoint(0, y)).blockNumber() + 1;
+    auto costIter = lineCosts.constFind(line);
+    if (costIter == lineCosts.constEnd()) {
+        return QString();
+    }
+
+    const ShaderCostCounts &weighted = costIter.value().weightedCounts;
+    const ShaderCostCounts &counts = costIter.value().staticCounts;
+    QString toolTip = tr("Line %1: cost %2, %3 instructions").arg(line).arg(weighted.weightedCost(), 0, 'f', 0).arg(counts.total());
+
+    // 只列出非零的类别，加权值与静态值不同时表示位于循环中
+    auto addCategory = [&](const QString &name, double weightedValue, double staticValue) {
+        if (staticValue <= 0) {
+            return;
+        }
+        toolTip += QString("\n%1: %2").arg(name).arg(staticValue);
+        if (weightedValue != staticValue) {
+            toolTip += tr(" (x%1 in loop)").arg(weightedValue / staticValue, 0, 'g', 4);
+        }
+    };
+    addCategory(tr("ALU"), weighted.alu, counts.alu);
+    addCategory(tr("Transcendental"), weighted.transcendental, counts.transcendental);
+    addCategory(tr("Texture Sample"), weighted.textureSample, counts.textureSample);
+    addCategory(tr("Texture Fetch"), weighted.textureFetch, counts.textureFetch);
+    addCategory(tr("Memory Load"), weighted.memoryLoad, counts.memoryLoad);
+    addCategory(tr("Memory Store"), weighted.memoryStore, counts.memoryStore);
+    addCategory(tr("Barrier"), weighted.barrier, counts.barrier);
+    addCategory(tr("Control Flow"), weighted.controlFlow, counts.controlFlow);
+    return toolTip;
+}
@@ -5,6 +5,7 @@
 #include <QSyntaxHighlighter>
 #include <QRegularExpression>
 #include <QPainter>
+#include "shaderCostAnalyzer.h"
 
 class ShaderCodeTextEdit;
 
@@ -33,6 +34,7 @@ public:
 
 protected:
     void paintEvent(QPaintEvent* event) override;
+    bool event(QEvent* event) override; // 显示行代价提示
 
 private:
     ShaderCodeTextEdit* editor;
@@ -51,6 +53,13 @@ public:
 
     void lineNumberAreaPaintEvent(QPaintEvent* event);
 
+    // 设置每行的指令代价，在行号栏左侧绘制热度条；为空时隐藏热度条
+    void setLineCosts(const QMap<int, ShaderLineCost> &costs);
+    void clearLineCosts() { setLineCosts(QMap<int, ShaderLineCost>()); }
+
+    // 行号栏指定纵坐标处行的代价提示，没有代价时为空
+    QString lineCostToolTip(int y);
+
 private slots:
     void updateLineNumberAreaWidth(int newBlockCount) {
         setViewportMargins(lineNumberAreaWidth(), 0, 0, 0);
@@ -68,6 +77,9 @@ private slots:
 private:
     ShaderCodeHighlighter *highlighter;
     LineNumberArea* lineNumberArea;
+
+    QMap<int, ShaderLineCost> lineCosts; // 行号（从 1 开始）-> 代价
+    double maxLineCost; // 最大加权代价，用于归一化热度
 };
 
 #endif // SHADERCODETEXTEDIT_H
@@ -0,0 +1,768 @@
+#define SPV_ENABLE_UTILITY_CODE
+#include "SPIRV-Reflect/include/spirv/unified1/spirv.h"
+#include "shaderCostAnalyzer.h"
+#include "spirvModule.h"
+#include <QHash>
+#include <QPair>
+#include <QRegularExpression>
+
+// 迭代次数超过该值时视为无法证明，避免模拟过久
+static const qint64 kMaxProvenTripCount = 1 << 20;
+
+enum CostCategory
+{
+    CostNone,
+    CostAlu,
+    CostTranscendental,
+    CostSample,
+    CostFetch,
+    CostLoad,
+    CostStore,
+    CostBarrier,
+    CostControlFlow
+};
+
+static void addCategory(ShaderCostCounts &counts, CostCategory category, double weight)
+{
+    switch (category)
+    {
+        case CostAlu: counts.alu += weight; break;
+        case CostTranscendental: counts.transcendental += weight; break;
+        case CostSample: counts.textureSample += weight; break;
+        case CostFetch: counts.textureFetch += weight; break;
+        case CostLoad: counts.memoryLoad += weight; break;
+        case CostStore: counts.memoryStore += weight; break;
+        case CostBarrier: counts.barrier += weight; break;
+        case CostControlFlow: counts.controlFlow += weight; break;
+        default: break;
+    }
+}
+
+void ShaderCostCounts::add(const ShaderCostCounts &other, double scale)
+{
+    alu += other.alu * scale;
+    transcendental += other.transcendental * scale;
+    textureSample += other.textureSample * scale;
+    textureFetch += other.textureFetch * scale;
+    memoryLoad += other.memoryLoad * scale;
+    memoryStore += other.memoryStore * scale;
+    barrier += other.barrier * scale;
+    controlFlow += other.controlFlow * scale;
+}
+
+double ShaderCostCounts::total() const
+{
+    return alu + transcendental + textureSample + textureFetch + memoryLoad + memoryStore + barrier + controlFlow;
+}
+
+double ShaderCostCounts::weightedCost() const
+{
+    // 相对代价为经验值，只用于比较同一着色器的不同变体
+    return alu * 1.0 + transcendental * 4.0 + textureSample * 8.0 + textureFetch * 4.0 +
+           memoryLoad * 4.0 + memoryStore * 4.0 + barrier * 8.0 + controlFlow * 2.0;
+}
+
+QString ShaderCostReport::toText() const
+{
+    QString text = QString("; Static Cost (%1):\n").arg(binaryType);
+    text += ";    Function                      ALU  Transc  Sample   Fetch    Load   Store Barrier    Flow      Cost\n";
+    for (const ShaderFunctionCost &function : functions) {
+        const ShaderCostCounts &counts = function.weightedCounts;
+        QString name = function.stage.isEmpty() ? function.name : QString("%1 (%2)").arg(function.name).arg(function.stage);
+        text += QString(";    %1 %2 %3 %4 %5 %6 %7 %8 %9 %10\n")
+            .arg(name.left(24), -24)
+            .arg(counts.alu, 8, 'f', 0)
+            .arg(counts.transcendental, 7, 'f', 0)
+            .arg(counts.textureSample, 7, 'f', 0)
+            .arg(counts.textureFetch, 7, 'f', 0)
+            .arg(counts.memoryLoad, 7, 'f', 0)
+            .arg(counts.memoryStore, 7, 'f', 0)
+            .arg(counts.barrier, 7, 'f', 0)
+            .arg(counts.controlFlow, 7, 'f', 0)
+            .arg(counts.weightedCost(), 9, 'f', 0);
+    }
+    return text;
+}
+
+// ---------------- SPIR-V ----------------
+
+// 单个 SPIR-V 模块的代价分析状态
+class SpirvCostAnalysis
+{
+public:
+    explicit SpirvCostAnalysis(const SpirvModule &module);
+
+    // 分析函数的静态计数、循环权重及调用关系
+    void analyzeFunction(int functionIndex);
+
+    // 展开调用后的加权计数
+    ShaderCostCounts weightedCounts(int functionIndex);
+
+    // 按 OpLine/DebugLine 将指令代价汇总到主源文件的行
+    void collectLineCosts(QMap<int, ShaderLineCost> &lineCosts, const QString &sourceFile);
+
+    // 每个基本块的静态计数
+    QVector<ShaderCostCounts> blockCounts(int functionIndex);
+
+    struct FunctionInfo
+    {
+        bool analyzed = false;
+        bool weightedDone = false;
+        bool inProgress = false; // 防止非法递归
+        ShaderCostCounts staticCounts;
+        ShaderCostCounts ownWeighted; // 不含被调用函数
+        ShaderCostCounts weighted; // 含被调用函数
+        QVector<QPair<int, double>> calls; // 被调用函数下标及调用点权重
+        QVector<double> blockWeights; // 每个基本块的循环权重
+        int loopCount = 0;
+        int unknownTripCountLoops = 0;
+    };
+
+    QVector<FunctionInfo> infos;
+
+private:
+    CostCategory classify(const SpirvModule::Instruction &inst) const;
+    bool constantValue(uint32_t id, qint64 &value) const;
+    qint64 tripCount(const SpirvModule::Function &function, int header, uint32_t mergeLabel, const QVector<bool> &inLoop, const QHash<uint32_t, int> &blockOfLabel) const;
+
+    const SpirvModule &module;
+};
+
+SpirvCostAnalysis::SpirvCostAnalysis(const SpirvModule &module)
+    : module(module)
+{
+    infos.resize(module.functions().size());
+}
+
+static bool isMemoryStorageClass(uint32_t storageClass)
+{
+    switch (storageClass)
+    {
+        case SpvStorageClassUniform:
+        case SpvStorageClassWorkgroup:
+        case SpvStorageClassCrossWorkgroup:
+        case SpvStorageClassPushConstant:
+        case SpvStorageClassImage:
+        case SpvStorageClassStorageBuffer:
+        case SpvStorageClassPhysicalStorageBuffer:
+            return true;
+        default:
+            return false;
+    }
+}
+
+CostCategory SpirvCostAnalysis::classify(const SpirvModule::Instruction &inst) const
+{
+    const uint32_t opcode = inst.opcode;
+
+    switch (opcode)
+    {
+        case SpvOpLoad:
+            return isMemoryStorageClass(module.storageClassOf(module.operand(inst, 2))) ? CostLoad : CostNone;
+        case SpvOpStore:
+            return isMemoryStorageClass(module.storageClassOf(module.operand(inst, 0))) ? CostStore : CostNone;
+        case SpvOpImageGather:
+        case SpvOpImageDrefGather:
+        case SpvOpImageSparseGather:
+        case SpvOpImageSparseDrefGather:
+            return CostSample;
+        case SpvOpImageFetch:
+        case SpvOpImageRead:
+        case SpvOpImageSparseFetch:
+        case SpvOpImageSparseRead:
+            return CostFetch;
+        case SpvOpImageWrite:
+            return CostStore;
+        case SpvOpAtomicLoad:
+            return CostLoad;
+        case SpvOpControlBarrier:
+        case SpvOpMemoryBarrier:
+            return CostBarrier;
+        case SpvOpBranchConditional:
+        case SpvOpSwitch:
+        case SpvOpKill:
+        case SpvOpTerminateInvocation:
+        case SpvOpDemoteToHelperInvocation:
+        case SpvOpFunctionCall:
+            return CostControlFlow;
+        case SpvOpExtInst: {
+            QString setName = module.extInstSetName(module.operand(inst, 2));
+            if (setName.startsWith("NonSemantic.")) {
+                return CostNone;
+            }
+            // GLSL.std.450 的 13-32 为 Sin ... InverseSqrt
+            uint32_t extOpcode = module.operand(inst, 3);
+            if (setName == "GLSL.std.450" && extOpcode >= 13 && extOpcode <= 32) {
+                return CostTranscendental;
+            }
+            return CostAlu;
+        }
+        default:
+            break;
+    }
+
+    if ((opcode >= SpvOpImageSampleImplicitLod && opcode <= SpvOpImageSampleProjDrefExplicitLod) ||
+        (opcode >= SpvOpImageSparseSampleImplicitLod && opcode <= SpvOpImageSparseSampleProjDrefExplicitLod)) {
+        return CostSample;
+    }
+    if (opcode >= SpvOpAtomicStore && opcode <= SpvOpAtomicXor) {
+        return CostStore;
+    }
+    if ((opcode >= SpvOpConvertFToU && opcode <= SpvOpBitcast) ||
+        (opcode >= SpvOpSNegate && opcode <= SpvOpSMulExtended) ||
+        (opcode >= SpvOpAny && opcode <= SpvOpFUnordGreaterThanEqual) ||
+        (opcode >= SpvOpShiftRightLogical && opcode <= SpvOpBitCount) ||
+        (opcode >= SpvOpDPdx && opcode <= SpvOpFwidthCoarse)) {
+        return CostAlu;
+    }
+    return CostNone;
+}
+
+bool SpirvCostAnalysis::constantValue(uint32_t id, qint64 &value) const
+{
+    int definition = module.definition(id);
+    if (definition < 0 || module.instruction(definition).opcode != SpvOpConstant) {
+        return false;
+    }
+
+    const SpirvModule::Instruction &inst = module.instruction(definition);
+    int typeDefinition = module.definition(inst.resultType);
+    if (typeDefinition < 0 || module.instruction(typeDefinition).opcode != SpvOpTypeInt) {
+        return false;
+    }
+
+    const SpirvModule::Instruction &typeInst = module.instruction(typeDefinition);
+    uint32_t width = module.operand(typeInst, 1);
+    bool isSigned = module.operand(typeInst, 2) != 0;
+    if (width == 64) {
+        value = static_cast<qint64>(static_cast<quint64>(module.operand(inst, 2)) | (static_cast<quint64>(module.operand(inst, 3)) << 32));
+    } else {
+        uint32_t word = module.operand(inst, 2);
+        value = isSigned ? static_cast<qint64>(static_cast<int32_t>(word)) : static_cast<qint64>(word);
+    }
+    return true;
+}
+
+static bool compareValues(uint32_t opcode, qint64 a, qint64 b, bool &result)
+{
+    switch (opcode)
+    {
+        case SpvOpSLessThan: case SpvOpULessThan: result = a < b; return true;
+        case SpvOpSLessThanEqual: case SpvOpULessThanEqual: result = a <= b; return true;
+        case SpvOpSGreaterThan: case SpvOpUGreaterThan: result = a > b; return true;
+        case SpvOpSGreaterThanEqual: case SpvOpUGreaterThanEqual: result = a >= b; return true;
+        case SpvOpIEqual: result = a == b; return true;
+        case SpvOpINotEqual: result = a != b; return true;
+        default: return false;
+    }
+}
+
+// 识别 for (i = C0; i < C1; i += C2) 形式的归纳变量，返回迭代次数，无法证明时返回 -1
+qint64 SpirvCostAnalysis::tripCount(const SpirvModule::Function &function, int header, uint32_t mergeLabel, const QVector<bool> &inLoop, const QHash<uint32_t, int> &blockOfLabel) const
+{
+    const SpirvModule::BasicBlock &headerBlock = function.blocks[header];
+
+    for (int i = headerBlock.firstInstruction; i < headerBlock.firstInstruction + headerBlock.instructionCount; ++i) {
+        const SpirvModule::Instruction &phi = module.instruction(i);
+        if (phi.opcode != SpvOpPhi) {
+            continue;
+        }
+
+        // 入口值来自循环外，步进值来自循环内
+        qint64 initValue = 0;
+        uint32_t stepId = 0;
+        bool hasInit = false;
+        for (int k = 2; k + 1 < module.operandCount(phi); k += 2) {
+            uint32_t valueId = module.operand(phi, k);
+            int parent = blockOfLabel.value(module.operand(phi, k + 1), -1);
+            if (parent >= 0 && inLoop[parent]) {
+                stepId = valueId;
+            } else {
+                hasInit = constantValue(valueId, initValue);
+            }
+        }
+        if (!hasInit || stepId == 0) {
+            continue;
+        }
+
+        int stepDefinition = module.definition(stepId);
+        if (stepDefinition < 0) {
+            continue;
+        }
+        const SpirvModule::Instruction &stepInst = module.instruction(stepDefinition);
+        qint64 step = 0;
+        if (stepInst.opcode == SpvOpIAdd) {
+            bool matched = (module.operand(stepInst, 2) == phi.resultId && constantValue(module.operand(stepInst, 3), step)) ||
+                           (module.operand(stepInst, 3) == phi.resultId && constantValue(module.operand(stepInst, 2), step));
+            if (!matched) {
+                continue;
+            }
+        } else if (stepInst.opcode == SpvOpISub && module.operand(stepInst, 2) == phi.resultId && constantValue(module.operand(stepInst, 3), step)) {
+            step = -step;
+        } else {
+            continue;
+        }
+        if (step == 0) {
+            continue;
+        }
+
+        // 查找跳出到 merge 块的条件分支
+        for (int b = 0; b < function.blocks.size(); ++b) {
+            if (!inLoop[b]) {
+                continue;
+            }
+            const SpirvModule::BasicBlock &block = function.blocks[b];
+            const SpirvModule::Instruction &terminator = module.instruction(block.firstInstruction + block.instructionCount - 1);
+            if (terminator.opcode != SpvOpBranchConditional) {
+                continue;
+            }
+
+            uint32_t trueLabel = module.operand(terminator, 1);
+            uint32_t falseLabel = module.operand(terminator, 2);
+            if (trueLabel != mergeLabel && falseLabel != mergeLabel) {
+                continue;
+            }
+            bool continueWhen = trueLabel != mergeLabel;
+
+            int conditionDefinition = module.definition(module.operand(terminator, 0));
+            if (conditionDefinition < 0) {
+                continue;
+            }
+            const SpirvModule::Instruction &compare = module.instruction(conditionDefinition);
+            uint32_t lhs = module.operand(compare, 2);
+            uint32_t rhs = module.operand(compare, 3);
+
+            // 比较对象为 phi（先判断后执行）或步进值（先执行后判断）
+            bool counterOnLeft = lhs == phi.resultId || lhs == stepId;
+            uint32_t counterId = counterOnLeft ? lhs : rhs;
+            qint64 limit = 0;
+            if ((counterId != phi.resultId && counterId != stepId) || !constantValue(counterOnLeft ? rhs : lhs, limit)) {
+                continue;
+            }
+
+            qint64 count = counterId == stepId ? 1 : 0;
+            qint64 value = counterId == stepId ? initValue + step : initValue;
+            bool result = false;
+            while (count <= kMaxProvenTripCount) {
+                if (!(counterOnLeft ? compareValues(compare.opcode, value, limit, result) : compareValues(compare.opcode, limit, value, result))) {
+                    return -1;
+                }
+                if (result != continueWhen) {
+                    return count;
+                }
+                ++count;
+                value += step;
+            }
+            return -1;
+        }
+    }
+    return -1;
+}
+
+void SpirvCostAnalysis::analyzeFunction(int functionIndex)
+{
+    FunctionInfo &info = infos[functionIndex];
+    if (info.analyzed) {
+        return;
+    }
+    info.analyzed = true;
+
+    const SpirvModule::Function &function = module.functions()[functionIndex];
+    const int blockCount = function.blocks.size();
+
+    QHash<uint32_t, int> blockOfLabel = SpirvModule::blockIndexOfLabel(function);
+    QVector<QVector<int>> blockSuccessors = module.blockSuccessors(function);
+
+    QVector<QVector<int>> predecessors(blockCount);
+    for (int b = 0; b < blockCount; ++b) {
+        for (int successor : blockSuccessors[b]) {
+            predecessors[successor].append(b);
+        }
+    }
+
+    // 每个循环头按自然循环求循环体，循环体内的块乘以迭代次数
+    QVector<double> blockWeights(blockCount, 1.0);
+    for (int header = 0; header < blockCount; ++header) {
+        const SpirvModule::BasicBlock &block = function.blocks[header];
+        uint32_t mergeLabel = 0;
+        for (int i = block.firstInstruction; i < block.firstInstruction + block.instructionCount; ++i) {
+            if (module.instruction(i).opcode == SpvOpLoopMerge) {
+                mergeLabel = module.operand(module.instruction(i), 0);
+                break;
+            }
+        }
+        if (mergeLabel == 0) {
+            continue;
+        }
+
+        // 结构化 SPIR-V 中回边的源块排在循环头之后
+        QVector<bool> inLoop(blockCount, false);
+        inLoop[header] = true;
+        QVector<int> worklist;
+        for (int predecessor : predecessors[header]) {
+            if (predecessor >= header && !inLoop[predecessor]) {
+                inLoop[predecessor] = true;
+                worklist.append(predecessor);
+            }
+        }
+        while (!worklist.isEmpty()) {
+            int b = worklist.takeLast();
+            for (int predecessor : predecessors[b]) {
+                if (!inLoop[predecessor]) {
+                    inLoop[predecessor] = true;
+                    worklist.append(predecessor);
+                }
+            }
+        }
+
+        info.loopCount++;
+        qint64 trips = tripCount(function, header, mergeLabel, inLoop, blockOfLabel);
+        if (trips < 0) {
+            info.unknownTripCountLoops++;
+            continue;
+        }
+        for (int b = 0; b < blockCount; ++b) {
+            if (inLoop[b]) {
+                blockWeights[b] *= static_cast<double>(trips);
+            }
+        }
+    }
+
+    info.blockWeights = blockWeights;
+
+    for (int b = 0; b < blockCount; ++b) {
+        const SpirvModule::BasicBlock &block = function.blocks[b];
+        for (int i = block.firstInstruction; i < block.firstInstruction + block.instructionCount; ++i) {
+            const SpirvModule::Instruction &inst = module.instruction(i);
+            CostCategory category = classify(inst);
+            addCategory(info.staticCounts, category, 1.0);
+            addCategory(info.ownWeighted, category, blockWeights[b]);
+
+            if (inst.opcode == SpvOpFunctionCall) {
+                int callee = module.functionIndex(module.operand(inst, 2));
+                if (callee >= 0) {
+                    info.calls.append(qMakePair(callee, blockWeights[b]));
+                }
+            }
+        }
+    }
+}
+
+ShaderCostCounts SpirvCostAnalysis::weightedCounts(int functionIndex)
+{
+    analyzeFunction(functionIndex);
+
+    FunctionInfo &info = infos[functionIndex];
+    if (info.weightedDone || info.inProgress) {
+        return info.weighted;
+    }
+
+    info.inProgress = true;
+    ShaderCostCounts result = info.ownWeighted;
+    const QVector<QPair<int, double>> calls = info.calls;
+    for (const QPair<int, double> &call : calls) {
+        result.add(weightedCounts(call.first), call.second);
+    }
+
+    FunctionInfo &doneInfo = infos[functionIndex];
+    doneInfo.weighted = result;
+    doneInfo.weightedDone = true;
+    doneInfo.inProgress = false;
+    return result;
+}
+
+QVector<ShaderCostCounts> SpirvCostAnalysis::blockCounts(int functionIndex)
+{
+    analyzeFunction(functionIndex);
+
+    const SpirvModule::Function &function = module.functions()[functionIndex];
+    QVector<ShaderCostCounts> counts(function.blocks.size());
+    for (int b = 0; b < function.blocks.size(); ++b) {
+        const SpirvModule::BasicBlock &block = function.blocks[b];
+        for (int i = block.firstInstruction; i < block.firstInstruction + block.instructionCount; ++i) {
+            addCategory(counts[b], classify(module.instruction(i)), 1.0);
+        }
+    }
+    return counts;
+}
+
+void SpirvCostAnalysis::collectLineCosts(QMap<int, ShaderLineCost> &lineCosts, const QString &sourceFile)
+{
+    QString mainFile = sourceFile.isEmpty() ? module.mainSourceFile() : sourceFile;
+    QVector<SpirvModule::SourceLocation> locations = module.sourceLocations();
+
+    const QVector<SpirvModule::Function> &functions = module.functions();
+    for (int f = 0; f < functions.size(); ++f) {
+        analyzeFunction(f);
+        const FunctionInfo &info = infos[f];
+
+        for (int b = 0; b < functions[f].blocks.size(); ++b) {
+            const SpirvModule::BasicBlock &block = functions[f].blocks[b];
+            for (int i = block.firstInstruction; i < block.firstInstruction + block.instructionCount; ++i) {
+                const SpirvModule::SourceLocation &location = locations[i];
+                CostCategory category = classify(module.instruction(i));
+                if (!location.isValid() || category == CostNone || (!mainFile.isEmpty() && location.file != mainFile)) {
+                    continue;
+                }
+                ShaderLineCost &lineCost = lineCosts[location.line];
+                addCategory(lineCost.staticCounts, category, 1.0);
+                addCategory(lineCost.weightedCounts, category, info.blockWeights.value(b, 1.0));
+            }
+        }
+    }
+}
+
+ShaderCostReport ShaderCostAnalyzer::analyzeSpirv(const SpirvModule &module, const QString &sourceFile)
+{
+    ShaderCostReport report;
+    report.binaryType = "SPIR-V";
+
+    SpirvCostAnalysis analysis(module);
+    const QVector<SpirvModule::Function> &functions = module.functions();
+
+    QVector<bool> isEntry(functions.size(), false);
+    for (const SpirvModule::EntryPoint &entryPoint : module.entryPoints()) {
+        int functionIndex = module.functionIndex(entryPoint.functionId);
+        if (functionIndex < 0) {
+            continue;
+        }
+        isEntry[functionIndex] = true;
+
+        ShaderFunctionCost cost;
+        cost.name = entryPoint.name;
+        cost.stage = SpirvModule::stageName(entryPoint.executionModel);
+        cost.weightedCounts = analysis.weightedCounts(functionIndex);
+        cost.staticCounts = analysis.infos[functionIndex].staticCounts;
+        cost.loopCount = analysis.infos[functionIndex].loopCount;
+        cost.unknownTripCountLoops = analysis.infos[functionIndex].unknownTripCountLoops;
+        report.functions.append(cost);
+    }
+
+    for (int i = 0; i < functions.size(); ++i) {
+        if (isEntry[i]) {
+            continue;
+        }
+
+        ShaderFunctionCost cost;
+        cost.name = module.name(functions[i].id);
+        if (cost.name.isEmpty()) {
+            cost.name = QString("%%1").arg(functions[i].id);
+        }
+        cost.weightedCounts = analysis.weightedCounts(i);
+        cost.staticCounts = analysis.infos[i].staticCounts;
+        cost.loopCount = analysis.infos[i].loopCount;
+        cost.unknownTripCountLoops = analysis.infos[i].unknownTripCountLoops;
+        report.functions.append(cost);
+    }
+
+    analysis.collectLineCosts(report.lineCosts, sourceFile);
+
+    return report;
+}
+
+QVector<ShaderCostCounts> ShaderCostAnalyzer::spirvBlockCounts(const SpirvModule &module, int functionIndex, QVector<double> *blockWeights)
+{
+    SpirvCostAnalysis analysis(module);
+    QVector<ShaderCostCounts> counts = analysis.blockCounts(functionIndex);
+    if (blockWeights) {
+        *blockWeights = analysis.infos[functionIndex].blockWeights;
+    }
+    return counts;
+}
+
+// ---------------- DXIL ----------------
+
+static CostCategory classifyDxOp(const QString &opClass, int opcode)
+{
+    if (opClass.startsWith("sample") || opClass.startsWith("textureGather")) {
+        return CostSample;
+    }
+    if (opClass == "textureLoad") {
+        return CostFetch;
+    }
+    if (opClass == "bufferLoad" || opClass == "rawBufferLoad" || opClass.startsWith("cbufferLoad")) {
+        return CostLoad;
+    }
+    if (opClass.startsWith("textureStore") || opClass == "bufferStore" || opClass == "rawBufferStore" || opClass.startsWith("atomic")) {
+        return CostStore;
+    }
+    if (opClass == "barrier") {
+        return CostBarrier;
+    }
+    if (opClass == "discard") {
+        return CostControlFlow;
+    }
+    if (opClass == "unary") {
+        // DXIL 操作码 12-21 为 Cos ... Exp，23-25 为 Log、Sqrt、Rsqrt
+        return ((opcode >= 12 && opcode <= 21) || (opcode >= 23 && opcode <= 25)) ? CostTranscendental : CostAlu;
+    }
+    if (opClass == "binary" || opClass == "tertiary" || opClass == "quaternary" || opClass.startsWith("dot") ||
+        opClass == "unaryBits" || opClass == "binaryWithCarryOrBorrow" || opClass == "isSpecialFloat" ||
+        opClass.startsWith("legacy") || opClass == "makeDouble" || opClass == "splitDouble") {
+        return CostAlu;
+    }
+    return CostNone;
+}
+
+static CostCategory classifyLlvmInstruction(const QString &keyword, const QString &line)
+{
+    static const QStringList kAluInstructions = {
+        "fadd", "fsub", "fmul", "fdiv", "frem", "fneg", "add", "sub", "mul", "udiv", "sdiv", "urem", "srem",
+        "shl", "lshr", "ashr", "and", "or", "xor", "fcmp", "icmp", "select",
+        "fptoui", "fptosi", "uitofp", "sitofp", "fpext", "fptrunc", "zext", "sext", "trunc"
+    };
+
+    if (kAluInstructions.contains(keyword)) {
+        return CostAlu;
+    }
+    if (keyword == "br") {
+        return line.contains("br i1") ? CostControlFlow : CostNone;
+    }
+    if (keyword == "switch" || keyword == "call") {
+        return CostControlFlow;
+    }
+    // addrspace(3) 为 groupshared
+    if (keyword == "load" || keyword == "store" || keyword == "atomicrmw" || keyword == "cmpxchg") {
+        if (!line.contains("addrspace(3)")) {
+            return CostNone;
+        }
+        return keyword == "load" ? CostLoad : CostStore;
+    }
+    return CostNone;
+}
+
+static QString dxilStageName(const QString &shaderKind)
+{
+    if (shaderKind == "vs") return "Vertex";
+    if (shaderKind == "ps") return "Pixel";
+    if (shaderKind == "cs") return "Compute";
+    if (shaderKind == "gs") return "Geometry";
+    if (shaderKind == "hs") return "Hull";
+    if (shaderKind == "ds") return "Domain";
+    if (shaderKind == "ms") return "Mesh";
+    if (shaderKind == "as") return "Task";
+    return QString();
+}
+
+QHash<int, int> ShaderCostAnalyzer::dxilDebugLocationLines(const QStringList &lines)
+{
+    static const QRegularExpression metadataRe(R"(^!(\d+) = (?:distinct )?!(\w+)\((.*)\)\s*$)");
+    static const QRegularExpression lineRe(R"(\bline: (\d+))");
+    static const QRegularExpression scopeRe(R"(\bscope: !(\d+))");
+    static const QRegularExpression fileRe(R"(\bfile: !(\d+))");
+
+    QHash<int, int> scopeFiles; // 作用域元数据 ID -> DIFile 元数据 ID
+    QHash<int, QPair<int, int>> locations; // DILocation 元数据 ID -> (行号, 作用域)
+    int mainFile = -1;
+    for (const QString &line : lines) {
+        if (!line.startsWith('!')) {
+            continue;
+        }
+        QRegularExpressionMatch match = metadataRe.match(line);
+        if (!match.hasMatch()) {
+            continue;
+        }
+
+        int id = match.captured(1).toInt();
+        QString kind = match.captured(2);
+        QString fields = match.captured(3);
+        if (kind == "DILocation") {
+            QRegularExpressionMatch lineMatch = lineRe.match(fields);
+            QRegularExpressionMatch scopeMatch = scopeRe.match(fields);
+            if (lineMatch.hasMatch()) {
+                locations[id] = qMakePair(lineMatch.captured(1).toInt(), scopeMatch.hasMatch() ? scopeMatch.captured(1).toInt() : -1);
+            }
+            continue;
+        }
+
+        QRegularExpressionMatch fileMatch = fileRe.match(fields);
+        if (fileMatch.hasMatch()) {
+            scopeFiles[id] = fileMatch.captured(1).toInt();
+            if (kind == "DICompileUnit") {
+                mainFile = fileMatch.captured(1).toInt();
+            }
+        }
+    }
+
+    QHash<int, int> locationLines;
+    for (auto it = locations.constBegin(); it != locations.constEnd(); ++it) {
+        int file = scopeFiles.value(it.value().second, -1);
+        if (mainFile < 0 || file < 0 || file == mainFile) {
+            locationLines[it.key()] = it.value().first;
+        }
+    }
+    return locationLines;
+}
+
+ShaderCostReport ShaderCostAnalyzer::analyzeDxilDisassembly(const QString &disassembly)
+{
+    static const QRegularExpression defineRe(R"(^define\s+[^@]*@([\w.$]+)\()");
+    static const QRegularExpression dxOpRe(R"(@dx\.op\.(\w+)(?:\.[\w.]+)?\(i32\s+(\d+))");
+    static const QRegularExpression instructionRe(R"(^\s*(?:%[\w.]+\s*=\s*)?(\w+))");
+    static const QRegularExpression shaderModelRe(R"re(!\{!"(\w+)", i32 \d+, i32 \d+\})re");
+    static const QRegularExpression debugLocationRe(R"(!dbg !(\d+))");
+
+    ShaderCostReport report;
+    report.binaryType = "DXIL";
+
+    QString stage;
+    QRegularExpressionMatch shaderModelMatch = shaderModelRe.match(disassembly);
+    if (shaderModelMatch.hasMatch()) {
+        stage = dxilStageName(shaderModelMatch.captured(1));
+    }
+
+    ShaderFunctionCost *current = nullptr;
+    const QStringList lines = disassembly.split('\n');
+    const QHash<int, int> locationLines = dxilDebugLocationLines(lines);
+    for (const QString &line : lines) {
+        if (current == nullptr) {
+            QRegularExpressionMatch match = defineRe.match(line);
+            if (match.hasMatch()) {
+                report.functions.append(ShaderFunctionCost());
+                current = &report.functions.last();
+                current->name = match.captured(1);
+            }
+            continue;
+        }
+
+        if (line.startsWith('}')) {
+            current->weightedCounts = current->staticCounts;
+            current = nullptr;
+            continue;
+        }
+
+        QString trimmed = line.trimmed();
+        if (trimmed.isEmpty() || trimmed.startsWith(';') || trimmed.endsWith(':')) {
+            continue;
+        }
+
+        CostCategory category = CostNone;
+        QRegularExpressionMatch dxOpMatch = dxOpRe.match(line);
+        if (dxOpMatch.hasMatch()) {
+            category = classifyDxOp(dxOpMatch.captured(1), dxOpMatch.captured(2).toInt());
+        } else {
+            QRegularExpressionMatch instructionMatch = instructionRe.match(line);
+            if (instructionMatch.hasMatch()) {
+                category = classifyLlvmInstruction(instructionMatch.captured(1), line);
+            }
+        }
+        addCategory(current->staticCounts, category, 1.0);
+
+        if (category != CostNone && !locationLines.isEmpty()) {
+            QRegularExpressionMatch debugLocationMatch = debugLocationRe.match(line);
+            int sourceLine = debugLocationMatch.hasMatch() ? locationLines.value(debugLocationMatch.captured(1).toInt(), 0) : 0;
+            if (sourceLine > 0) {
+                ShaderLineCost &lineCost = report.lineCosts[sourceLine];
+                addCategory(lineCost.staticCounts, category, 1.0);
+                addCategory(lineCost.weightedCounts, category, 1.0);
+            }
+        }
+    }
+
+    // 非库着色器只有一个入口函数，其余为辅助函数
+    if (!stage.isEmpty() && !report.functions.isEmpty()) {
+        report.functions.first().stage = stage;
+    }
+
+    return report;
+}
@@ -0,0 +1,78 @@
+#ifndef SHADERCOSTANALYZER_H
+#define SHADERCOSTANALYZER_H
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QMap>
+#include <QHash>
+
+class SpirvModule;
+
+// 各类指令数量，循环体按可证明的迭代次数加权后可能为小数
+struct ShaderCostCounts
+{
+    double alu = 0; // 算术、逻辑、比较、类型转换
+    double transcendental = 0; // exp/log/sin/cos/pow/sqrt/rsqrt 等超越函数
+    double textureSample = 0; // 纹理采样及 gather
+    double textureFetch = 0; // 纹理读取（fetch/load/read）
+    double memoryLoad = 0; // 缓冲区、共享内存读取
+    double memoryStore = 0; // 缓冲区、共享内存、图像写入及原子操作
+    double barrier = 0; // 控制屏障及内存屏障
+    double controlFlow = 0; // 条件分支、switch、discard、函数调用
+
+    void add(const ShaderCostCounts &other, double scale = 1.0);
+    double total() const;
+
+    // 按类别相对代价加权的总代价，用于比较变体，单位为一条 ALU 指令
+    double weightedCost() const;
+};
+
+// 单个函数的代价，入口函数的 weighted 计数包含被调用函数
+struct ShaderFunctionCost
+{
+    QString name; // 函数名称
+    QString stage; // 入口函数的着色器阶段，非入口函数为空
+    ShaderCostCounts staticCounts; // 每条指令计一次
+    ShaderCostCounts weightedCounts; // 循环体按迭代次数加权，并展开函数调用
+    int loopCount = 0; // 循环数量
+    int unknownTripCountLoops = 0; // 无法证明迭代次数的循环（按 1 次计算）
+};
+
+// 单个源代码行的代价，由 OpLine/DebugLine 或 DXIL !dbg 调试信息映射
+struct ShaderLineCost
+{
+    ShaderCostCounts staticCounts;
+    ShaderCostCounts weightedCounts; // 循环体按迭代次数加权，不展开函数调用
+};
+
+// 一次编译结果的代价报告
+struct ShaderCostReport
+{
+    QString binaryType; // SPIR-V 或 DXIL
+    QVector<ShaderFunctionCost> functions; // 入口函数在前
+    QMap<int, ShaderLineCost> lineCosts; // 主源文件行号（从 1 开始）-> 代价，无调试信息时为空
+
+    bool isEmpty() const { return functions.isEmpty(); }
+    QString toText() const;
+};
+
+// ShaderCostAnalyzer 对编译后的 SPIR-V/DXIL 进行静态代价分析，统计每个函数及入口函数的指令构成。
+class ShaderCostAnalyzer
+{
+public:
+    // 分析已索引的 SPIR-V 模块，循环迭代次数可由常量归纳变量证明时按次数加权。
+    // sourceFile 为统计行代价的源文件名（如 #line 指令中的名称），为空时取 OpSource 的文件
+    static ShaderCostReport analyzeSpirv(const SpirvModule &module, const QString &sourceFile = QString());
+
+    // SPIR-V 函数每个基本块的静态计数，blockWeights 返回可证明迭代次数的循环权重（与 analyzeSpirv 相同）
+    static QVector<ShaderCostCounts> spirvBlockCounts(const SpirvModule &module, int functionIndex, QVector<double> *blockWeights = nullptr);
+
+    // 分析 dxc -dumpbin 输出的 DXIL 反汇编（LLVM IR 文本），不进行循环加权
+    static ShaderCostReport analyzeDxilDisassembly(const QString &disassembly);
+
+    // 解析 -Zi 生成的调试元数据，返回 DILocation 元数据 ID -> 主源文件行号，不属于主源文件的位置不返回
+    static QHash<int, int> dxilDebugLocationLines(const QStringList &lines);
+};
+
+#endif // SHADERCOSTANALYZER_H
@@ -0,0 +1,67 @@
+#include "shaderCostPanel.h"
+#include <QtWidgets/QVBoxLayout>
+#include <QtWidgets/QHeaderView>
+
+// 构造函数，初始化代价面板。
+ShaderCostPanel::ShaderCostPanel(QWidget *parent)
+    : QWidget(parent)
+{
+    QVBoxLayout *mainLayout = new QVBoxLayout(this);
+    mainLayout->setContentsMargins(0, 0, 0, 0);
+
+    costTable = new QTableWidget(this);
+    costTable->setColumnCount(12);
+    costTable->setHorizontalHeaderLabels(QStringList() << tr("Function") << tr("Stage") << tr("ALU") << tr("Transc.")
+        << tr("Sample") << tr("Fetch") << tr("Load") << tr("Store") << tr("Barrier") << tr("Control") << tr("Weighted Cost") << tr("Loops"));
+    costTable->horizontalHeader()->setSectionResizeMode(QHeaderView::ResizeToContents);
+    costTable->verticalHeader()->setVisible(false);
+    costTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    costTable->setSelectionBehavior(QAbstractItemView::SelectRows);
+    costTable->setStyleSheet("QTableWidget { font-family: 'Consolas', monospace; }");
+    mainLayout->addWidget(costTable);
+}
+
+static QTableWidgetItem *countItem(double weighted, double staticCount)
+{
+    QTableWidgetItem *item = new QTableWidgetItem(QString::number(weighted, 'f', weighted == static_cast<qint64>(weighted) ? 0 : 1));
+    item->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
+    item->setToolTip(QObject::tr("Static: %1").arg(staticCount));
+    return item;
+}
+
+void ShaderCostPanel::addReport(const ShaderCostReport &report)
+{
+    for (const ShaderFunctionCost &function : report.functions) {
+        const ShaderCostCounts &weighted = function.weightedCounts;
+        const ShaderCostCounts &counts = function.staticCounts;
+
+        int row = costTable->rowCount();
+        costTable->insertRow(row);
+        QTableWidgetItem *nameItem = new QTableWidgetItem(function.name);
+        nameItem->setToolTip(report.binaryType);
+        costTable->setItem(row, 0, nameItem);
+        costTable->setItem(row, 1, new QTableWidgetItem(function.stage));
+        costTable->setItem(row, 2, countItem(weighted.alu, counts.alu));
+        costTable->setItem(row, 3, countItem(weighted.transcendental, counts.transcendental));
+        costTable->setItem(row, 4, countItem(weighted.textureSample, counts.textureSample));
+        costTable->setItem(row, 5, countItem(weighted.textureFetch, counts.textureFetch));
+        costTable->setItem(row, 6, countItem(weighted.memoryLoad, counts.memoryLoad));
+        costTable->setItem(row, 7, countItem(weighted.memoryStore, counts.memoryStore));
+        costTable->setItem(row, 8, countItem(weighted.barrier, counts.barrier));
+        costTable->setItem(row, 9, countItem(weighted.controlFlow, counts.controlFlow));
+        costTable->setItem(row, 10, countItem(weighted.weightedCost(), counts.weightedCost()));
+
+        QString loops = QString::number(function.loopCount);
+        if (function.unknownTripCountLoops > 0) {
+            loops += tr(" (%1 unknown)").arg(function.unknownTripCountLoops);
+        }
+        QTableWidgetItem *loopItem = new QTableWidgetItem(loops);
+        loopItem->setToolTip(tr("Loops with unknown trip count are counted once"));
+        costTable->setItem(row, 11, loopItem);
+    }
+}
+
+void ShaderCostPanel::clear()
+{
+    costTable->setRowCount(0);
+}
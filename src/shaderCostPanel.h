@@ -0,0 +1,26 @@
+#ifndef SHADERCOSTPANEL_H
+#define SHADERCOSTPANEL_H
+
+#include <QtWidgets/QWidget>
+#include <QtWidgets/QTableWidget>
+#include "shaderCostAnalyzer.h"
+
+// ShaderCostPanel 以表格显示每个函数的指令构成及加权代价，编译所有阶段时依次追加。
+class ShaderCostPanel : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit ShaderCostPanel(QWidget *parent = nullptr);
+
+    // 追加一次编译结果的代价报告
+    void addReport(const ShaderCostReport &report);
+
+    // 清空显示
+    void clear();
+
+private:
+    QTableWidget *costTable;
+};
+
+#endif // SHADERCOSTPANEL_H
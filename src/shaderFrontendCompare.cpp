@@ -0,0 +1,372 @@
+#include "shaderFrontendCompare.h"
+#include "spirvModule.h"
+#include "shaderIntermediateCache.h"
+#include <QProcess>
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QFileInfo>
+#include <QTextStream>
+#include <QMap>
+#include <QPair>
+#include <QRegularExpression>
+
+namespace {
+
+// 编译成功且通过校验的前端中加权代价更低者
+QString preferredFrontend(const ShaderFrontendComparison &comparison)
+{
+    bool dxcUsable = comparison.dxc.compile.success && (!comparison.dxc.validated || comparison.dxc.valid);
+    bool glslangUsable = comparison.glslang.compile.success && (!comparison.glslang.validated || comparison.glslang.valid);
+    if (dxcUsable && glslangUsable) {
+        return comparison.dxc.compile.weightedCost <= comparison.glslang.compile.weightedCost ? "DXC" : "GLSLANG";
+    }
+    if (dxcUsable) {
+        return "DXC";
+    }
+    return glslangUsable ? "GLSLANG" : QString();
+}
+
+QString statusText(const ShaderFrontendResult &result)
+{
+    if (!result.compile.success) {
+        return "Failed";
+    }
+    if (!result.validated) {
+        return "OK (not validated)";
+    }
+    return result.valid ? "OK" : "Invalid";
+}
+
+QString bindingText(const ShaderReflectionBinding &binding)
+{
+    QString text = QString("%1 (%2").arg(binding.name).arg(binding.descriptorType);
+    if (binding.count != 1) {
+        text += QString(" [%1]").arg(binding.count);
+    }
+    if (binding.blockSize > 0) {
+        text += QString(", %1 bytes").arg(binding.blockSize);
+    }
+    return text + ")";
+}
+
+QString csvField(const QString &value)
+{
+    QString escaped = value;
+    escaped.replace("\"", "\"\"");
+    return escaped.contains(',') || escaped.contains('"') || escaped.contains('\n') ? "\"" + escaped + "\"" : escaped;
+}
+
+} // namespace
+
+ShaderAutotuneRequest ShaderFrontendCompare::frontendRequest(const ShaderAutotuneRequest &request, const QString &compiler)
+{
+    ShaderAutotuneRequest result = request;
+    result.compiler = compiler;
+    result.outputType = "SPIR-V";
+    if (request.compiler != compiler) {
+        // 额外选项是编译器专用的，不传给另一个前端
+        result.baseOptions.clear();
+    }
+
+    if (compiler == "DXC") {
+        if (request.compiler != "DXC") {
+            result.shaderModel = "6_0";
+        }
+        if (result.shaderType == "TessControl") result.shaderType = "Hull";
+        else if (result.shaderType == "TessEvaluation") result.shaderType = "Domain";
+        else if (result.shaderType == "Task") result.shaderType = "Amplification";
+    } else {
+        // glslang 只识别 HLSL，HLSL2021 按 HLSL 编译
+        result.languageType = "HLSL";
+        if (result.shaderType == "Hull") result.shaderType = "TessControl";
+        else if (result.shaderType == "Domain") result.shaderType = "TessEvaluation";
+        else if (result.shaderType == "Amplification") result.shaderType = "Task";
+    }
+    return result;
+}
+
+ShaderFrontendComparison ShaderFrontendCompare::compare(const ShaderAutotuneRequest &dxcRequest, const ShaderAutotuneRequest &glslangRequest,
+                                                        const QString &glslangOptimizeOptions, const QString &sourceName,
+                                                        const QString &tempFilePrefix)
+{
+    ShaderFrontendComparison comparison;
+    comparison.sourceName = sourceName;
+    comparison.shaderType = dxcRequest.shaderType;
+
+    // DXC 忽略配方中的 spirv-opt 参数，glslang 输出按文档设置优化，与 DXC 默认的 -O3 对齐
+    ShaderAutotuneRecipe recipe;
+    recipe.spirvOptimizeOptions = glslangOptimizeOptions;
+    QVector<ShaderAutotuneRequest> requests;
+    requests.append(dxcRequest);
+    requests.append(glslangRequest);
+    QVector<ShaderAutotuneResult> results = ShaderAutotuner::compileAll(requests, tempFilePrefix, recipe);
+
+    comparison.dxc.compiler = "DXC";
+    comparison.dxc.compile = results.value(0);
+    comparison.glslang.compiler = "GLSLANG";
+    comparison.glslang.compile = results.value(1);
+
+    for (ShaderFrontendResult *result : { &comparison.dxc, &comparison.glslang }) {
+        if (!result->compile.success) {
+            continue;
+        }
+
+        SpirvModule module;
+        if (module.parse(result->compile.binary)) {
+            ShaderCostReport report = ShaderCostAnalyzer::analyzeSpirv(module);
+            for (const ShaderFunctionCost &function : report.functions) {
+                result->instructionMix.add(function.staticCounts);
+            }
+        }
+        validate(*result, tempFilePrefix + "_" + result->compiler.toLower());
+    }
+
+    if (comparison.dxc.compile.hasReflection && comparison.glslang.compile.hasReflection) {
+        comparison.layoutDifferences = layoutDifferences(comparison.dxc.compile.reflection, comparison.glslang.compile.reflection);
+    }
+    return comparison;
+}
+
+void ShaderFrontendCompare::validate(ShaderFrontendResult &result, const QString &tempFileTag)
+{
+    SpirvModule module;
+    if (!module.parse(result.compile.binary)) {
+        return;
+    }
+
+    // SPIR-V 1.3/1.5/1.6 分别是 Vulkan 1.1/1.2/1.3 的默认版本
+    uint32_t minor = (module.version() >> 8) & 0xff;
+    QString targetEnv = minor >= 6 ? "vulkan1.3" : minor >= 4 ? "vulkan1.2" : minor >= 3 ? "vulkan1.1" : "vulkan1.0";
+
+    QString filePath = QDir::temp().filePath(QString("validate_shader%1.spv").arg(tempFileTag));
+    if (!ShaderIntermediateCache::writeBlob(filePath, result.compile.binary)) {
+        return;
+    }
+
+    QProcess process;
+    process.start(QString("spirv-val --target-env %1 \"%2\"").arg(targetEnv).arg(filePath));
+    // spirv-val 未安装时不判定结果
+    result.validated = process.waitForFinished();
+    result.valid = result.validated && process.exitCode() == 0;
+    result.validationMessage = QString(process.readAllStandardError() + process.readAllStandardOutput()).trimmed();
+    QFile::remove(filePath);
+}
+
+QVector<ShaderFrontendComparison> ShaderFrontendCompare::compareDirectory(const ShaderAutotuneRequest &dxcRequest, const ShaderAutotuneRequest &glslangRequest,
+                                                                          const QString &glslangOptimizeOptions, const QString &directory,
+                                                                          const QStringList &nameFilters)
+{
+    QStringList filePaths;
+    QDirIterator it(directory, nameFilters, QDir::Files, QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        filePaths << it.next();
+    }
+    filePaths.sort();
+
+    QVector<ShaderFrontendComparison> comparisons;
+    QDir baseDir(directory);
+    for (int i = 0; i < filePaths.size(); ++i) {
+        QFile file(filePaths[i]);
+        if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+            continue;
+        }
+        QTextStream in(&file);
+        in.setCodec("UTF-8");
+        QString shaderCode = in.readAll();
+        file.close();
+
+        QFileInfo fileInfo(filePaths[i]);
+        QString shaderType = inferShaderType(fileInfo.fileName());
+
+        // 文件所在目录加入包含路径，相对 #include 可以解析
+        ShaderAutotuneRequest dxcFileRequest = dxcRequest;
+        dxcFileRequest.shaderCode = shaderCode;
+        dxcFileRequest.includePaths.prepend(fileInfo.absolutePath());
+        dxcFileRequest.intermediateCache = nullptr;
+        if (!shaderType.isEmpty()) {
+            dxcFileRequest.shaderType = shaderType;
+        }
+
+        ShaderAutotuneRequest glslangFileRequest = frontendRequest(dxcFileRequest, "GLSLANG");
+        glslangFileRequest.baseOptions = glslangRequest.baseOptions;
+
+        comparisons.append(compare(dxcFileRequest, glslangFileRequest, glslangOptimizeOptions,
+                                   baseDir.relativeFilePath(filePaths[i]), QString("_frontend_%1").arg(i)));
+    }
+    return comparisons;
+}
+
+QString ShaderFrontendCompare::inferShaderType(const QString &fileName)
+{
+    static const QMap<QString, QString> stageTokens = {
+        { "vs", "Vertex" }, { "vert", "Vertex" }, { "vertex", "Vertex" },
+        { "ps", "Pixel" }, { "fs", "Pixel" }, { "frag", "Pixel" }, { "pixel", "Pixel" },
+        { "cs", "Compute" }, { "comp", "Compute" }, { "compute", "Compute" },
+        { "gs", "Geometry" }, { "geom", "Geometry" },
+        { "hs", "Hull" }, { "tesc", "Hull" }, { "hull", "Hull" },
+        { "ds", "Domain" }, { "tese", "Domain" }, { "domain", "Domain" },
+        { "ms", "Mesh" }, { "mesh", "Mesh" },
+        { "as", "Amplification" }, { "task", "Amplification" }, { "amp", "Amplification" }
+    };
+
+    // 从后往前找，xxx_vs.hlsl 和 xxx.vs.hlsl 都以最后一个阶段标记为准
+    QStringList tokens = QFileInfo(fileName).completeBaseName().toLower().split(QRegularExpression("[._\\-]"), QString::SkipEmptyParts);
+    for (int i = tokens.size() - 1; i >= 0; --i) {
+        if (stageTokens.contains(tokens[i])) {
+            return stageTokens.value(tokens[i]);
+        }
+    }
+    return QString();
+}
+
+QStringList ShaderFrontendCompare::layoutDifferences(const ShaderReflection &dxcReflection, const ShaderReflection &glslangReflection)
+{
+    typedef QPair<uint32_t, uint32_t> BindingSlot;
+    QMap<BindingSlot, ShaderReflectionBinding> dxcBindings;
+    QMap<BindingSlot, ShaderReflectionBinding> glslangBindings;
+    for (const ShaderReflectionBinding &binding : dxcReflection.descriptorBindings) {
+        dxcBindings.insert(qMakePair(binding.set, binding.binding), binding);
+    }
+    for (const ShaderReflectionBinding &binding : glslangReflection.descriptorBindings) {
+        glslangBindings.insert(qMakePair(binding.set, binding.binding), binding);
+    }
+
+    // 两边绑定位置的并集，QMap 保证按 set、binding 排序
+    QMap<BindingSlot, bool> bindingSlots;
+    for (const BindingSlot &slot : dxcBindings.keys() + glslangBindings.keys()) {
+        bindingSlots.insert(slot, true);
+    }
+
+    QStringList differences;
+    for (const BindingSlot &slot : bindingSlots.keys()) {
+        QString location = QString("set %1 binding %2").arg(slot.first).arg(slot.second);
+        if (!glslangBindings.contains(slot)) {
+            differences << QString("%1: DXC only %2").arg(location).arg(bindingText(dxcBindings[slot]));
+        } else if (!dxcBindings.contains(slot)) {
+            differences << QString("%1: GLSLANG only %2").arg(location).arg(bindingText(glslangBindings[slot]));
+        } else {
+            const ShaderReflectionBinding &a = dxcBindings[slot];
+            const ShaderReflectionBinding &b = glslangBindings[slot];
+            if (a.descriptorType != b.descriptorType || a.count != b.count || a.blockSize != b.blockSize || a.name != b.name) {
+                differences << QString("%1: DXC %2, GLSLANG %3").arg(location).arg(bindingText(a)).arg(bindingText(b));
+            }
+        }
+    }
+    return differences;
+}
+
+QString ShaderFrontendCompare::reportText(const ShaderFrontendComparison &comparison)
+{
+    const ShaderFrontendResult &dxc = comparison.dxc;
+    const ShaderFrontendResult &glslang = comparison.glslang;
+
+    QString text = QString("; %1 (%2)\n").arg(comparison.sourceName).arg(comparison.shaderType);
+    auto row = [&text](const QString &label, const QString &dxcValue, const QString &glslangValue) {
+        text += QString("%1%2%3\n").arg(label, -28).arg(dxcValue, -22).arg(glslangValue);
+    };
+    auto countRow = [&row](const QString &label, double dxcValue, double glslangValue) {
+        row(label, QString::number(dxcValue, 'f', 0), QString::number(glslangValue, 'f', 0));
+    };
+
+    row("", "DXC", "GLSLANG");
+    row("Status", statusText(dxc), statusText(glslang));
+    if (dxc.compile.success && glslang.compile.success) {
+        countRow("Instructions", dxc.compile.instructionCount, glslang.compile.instructionCount);
+        countRow("  ALU", dxc.instructionMix.alu, glslang.instructionMix.alu);
+        countRow("  Transcendental", dxc.instructionMix.transcendental, glslang.instructionMix.transcendental);
+        countRow("  Texture Sample", dxc.instructionMix.textureSample, glslang.instructionMix.textureSample);
+        countRow("  Texture Fetch", dxc.instructionMix.textureFetch, glslang.instructionMix.textureFetch);
+        countRow("  Memory Load", dxc.instructionMix.memoryLoad, glslang.instructionMix.memoryLoad);
+        countRow("  Memory Store", dxc.instructionMix.memoryStore, glslang.instructionMix.memoryStore);
+        countRow("  Barrier", dxc.instructionMix.barrier, glslang.instructionMix.barrier);
+        countRow("  Control Flow", dxc.instructionMix.controlFlow, glslang.instructionMix.controlFlow);
+        countRow("Weighted Cost", dxc.compile.weightedCost, glslang.compile.weightedCost);
+        row("Size (bytes)", QString::number(dxc.compile.binarySize), QString::number(glslang.compile.binarySize));
+        row("Descriptor Bindings", QString::number(dxc.compile.reflection.descriptorBindings.size()),
+            QString::number(glslang.compile.reflection.descriptorBindings.size()));
+    }
+    row("Compile Time (s)", QString::number(dxc.compile.compileSeconds, 'f', 3), QString::number(glslang.compile.compileSeconds, 'f', 3));
+
+    for (const ShaderFrontendResult *result : { &dxc, &glslang }) {
+        if (!result->compile.requiredFeatures.isEmpty()) {
+            text += QString("\n%1 capabilities: %2\n").arg(result->compiler).arg(result->compile.requiredFeatures.join(", "));
+        }
+    }
+
+    if (!comparison.layoutDifferences.isEmpty()) {
+        text += "\nDescriptor layout differences:\n";
+        for (const QString &difference : comparison.layoutDifferences) {
+            text += "  " + difference + "\n";
+        }
+    }
+
+    for (const ShaderFrontendResult *result : { &dxc, &glslang }) {
+        if (!result->compile.success) {
+            text += QString("\n%1 error:\n%2\n").arg(result->compiler).arg(result->compile.error.trimmed());
+        } else if (result->validated && !result->valid) {
+            text += QString("\n%1 spirv-val:\n%2\n").arg(result->compiler).arg(result->validationMessage);
+        }
+    }
+
+    QString preferred = preferredFrontend(comparison);
+    if (!preferred.isEmpty()) {
+        text += QString("\nPreferred: %1\n").arg(preferred);
+    }
+    return text;
+}
+
+QString ShaderFrontendCompare::summaryText(const QVector<ShaderFrontendComparison> &comparisons)
+{
+    QString text = QString("%1%2%3%4%5%6%7%8\n")
+        .arg("File", -40).arg("Stage", -10).arg("DXC", -20).arg("DXC Cost", -10)
+        .arg("GLSLANG", -20).arg("GLSLANG Cost", -14).arg("Layout Diffs", -14).arg("Preferred");
+
+    QMap<QString, int> preferredCounts;
+    for (const ShaderFrontendComparison &comparison : comparisons) {
+        QString preferred = preferredFrontend(comparison);
+        preferredCounts[preferred.isEmpty() ? QString("None") : preferred]++;
+        text += QString("%1%2%3%4%5%6%7%8\n")
+            .arg(comparison.sourceName, -40).arg(comparison.shaderType, -10)
+            .arg(statusText(comparison.dxc), -20).arg(comparison.dxc.compile.success ? QString::number(comparison.dxc.compile.weightedCost, 'f', 0) : QString("-"), -10)
+            .arg(statusText(comparison.glslang), -20).arg(comparison.glslang.compile.success ? QString::number(comparison.glslang.compile.weightedCost, 'f', 0) : QString("-"), -14)
+            .arg(comparison.layoutDifferences.size(), -14).arg(preferred.isEmpty() ? QString("-") : preferred);
+    }
+
+    text += QString("\n%1 files").arg(comparisons.size());
+    for (auto it = preferredCounts.constBegin(); it != preferredCounts.constEnd(); ++it) {
+        text += QString(", %1: %2").arg(it.key()).arg(it.value());
+    }
+    return text + "\n";
+}
+
+QString ShaderFrontendCompare::toCsv(const QVector<ShaderFrontendComparison> &comparisons)
+{
+    QStringList header;
+    header << "file" << "stage";
+    for (const QString &prefix : { QString("dxc"), QString("glslang") }) {
+        header << prefix + "_status" << prefix + "_instructions" << prefix + "_alu" << prefix + "_transcendental"
+               << prefix + "_texture_sample" << prefix + "_texture_fetch" << prefix + "_memory_load" << prefix + "_memory_store"
+               << prefix + "_barrier" << prefix + "_control_flow" << prefix + "_weighted_cost" << prefix + "_size" << prefix + "_seconds";
+    }
+    header << "layout_differences" << "preferred";
+
+    QString csv = header.join(",") + "\n";
+    for (const ShaderFrontendComparison &comparison : comparisons) {
+        QStringList fields;
+        fields << csvField(comparison.sourceName) << comparison.shaderType;
+        for (const ShaderFrontendResult *result : { &comparison.dxc, &comparison.glslang }) {
+            const ShaderCostCounts &mix = result->instructionMix;
+            fields << statusText(*result) << QString::number(result->compile.instructionCount, 'f', 0)
+                   << QString::number(mix.alu, 'f', 0) << QString::number(mix.transcendental, 'f', 0)
+                   << QString::number(mix.textureSample, 'f', 0) << QString::number(mix.textureFetch, 'f', 0)
+                   << QString::number(mix.memoryLoad, 'f', 0) << QString::number(mix.memoryStore, 'f', 0)
+                   << QString::number(mix.barrier, 'f', 0) << QString::number(mix.controlFlow, 'f', 0)
+                   << QString::number(result->compile.weightedCost, 'f', 0) << QString::number(result->compile.binarySize)
+                   << QString::number(result->compile.compileSeconds, 'f', 3);
+        }
+        fields << csvField(comparison.layoutDifferences.join("; ")) << preferredFrontend(comparison);
+        csv += fields.join(",") + "\n";
+    }
+    return csv;
+}
@@ -0,0 +1,67 @@
+#ifndef SHADERFRONTENDCOMPARE_H
+#define SHADERFRONTENDCOMPARE_H
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include "shaderAutotuner.h"
+#include "shaderCostAnalyzer.h"
+
+// 单个前端（DXC 或 GLSLANG）编译 HLSL 到 SPIR-V 的结果
+struct ShaderFrontendResult
+{
+    QString compiler;
+    ShaderAutotuneResult compile; // 编译结果及反射数据
+    bool validated = false; // 是否执行了 spirv-val
+    bool valid = false;
+    QString validationMessage;
+    ShaderCostCounts instructionMix; // 所有函数的静态指令分类计数
+};
+
+// 同一份 HLSL 经两个前端编译的对比
+struct ShaderFrontendComparison
+{
+    QString sourceName; // 文件名或文档标题
+    QString shaderType;
+    ShaderFrontendResult dxc;
+    ShaderFrontendResult glslang;
+    QStringList layoutDifferences; // 描述符布局差异
+};
+
+// ShaderFrontendCompare 将 HLSL 同时交给 DXC（-spirv）和 glslang（-D -e）编译，
+// 对比 spirv-val 校验结果、指令分类、描述符布局及编译耗时，支持批量对比整个目录。
+class ShaderFrontendCompare
+{
+public:
+    // 由文档的编译请求生成两个前端的请求：阶段名互相转换，输出 SPIR-V，额外编译选项只保留给当前使用的编译器
+    static ShaderAutotuneRequest frontendRequest(const ShaderAutotuneRequest &request, const QString &compiler);
+
+    // 并行编译并对比，glslangOptimizeOptions 为 glslang 输出使用的 spirv-opt 参数
+    static ShaderFrontendComparison compare(const ShaderAutotuneRequest &dxcRequest, const ShaderAutotuneRequest &glslangRequest,
+                                            const QString &glslangOptimizeOptions, const QString &sourceName,
+                                            const QString &tempFilePrefix = "_frontend");
+
+    // 批量对比目录下的 HLSL 文件，阶段由文件名推断（如 xxx_ps.hlsl、xxx.vs.hlsl），推断不出时使用请求中的阶段
+    static QVector<ShaderFrontendComparison> compareDirectory(const ShaderAutotuneRequest &dxcRequest, const ShaderAutotuneRequest &glslangRequest,
+                                                              const QString &glslangOptimizeOptions, const QString &directory,
+                                                              const QStringList &nameFilters = QStringList() << "*.hlsl" << "*.fx");
+
+    // 由文件名推断 DXC 阶段名，推断不出返回空
+    static QString inferShaderType(const QString &fileName);
+
+    // 比较两份反射数据的描述符绑定
+    static QStringList layoutDifferences(const ShaderReflection &dxcReflection, const ShaderReflection &glslangReflection);
+
+    // 单个对比的并排报告
+    static QString reportText(const ShaderFrontendComparison &comparison);
+
+    // 批量对比的汇总表及 CSV
+    static QString summaryText(const QVector<ShaderFrontendComparison> &comparisons);
+    static QString toCsv(const QVector<ShaderFrontendComparison> &comparisons);
+
+private:
+    // 用 spirv-val 校验，目标环境由模块的 SPIR-V 版本决定
+    static void validate(ShaderFrontendResult &result, const QString &tempFileTag);
+};
+
+#endif // SHADERFRONTENDCOMPARE_H
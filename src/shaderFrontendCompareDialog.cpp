@@ -0,0 +1,102 @@
+#include "shaderFrontendCompareDialog.h"
+#include <QtWidgets/QVBoxLayout>
+#include <QtWidgets/QHBoxLayout>
+#include <QtWidgets/QDialogButtonBox>
+#include <QtWidgets/QApplication>
+#include <QtWidgets/QFileDialog>
+#include <QtWidgets/QMessageBox>
+#include <QFile>
+#include <QTextStream>
+
+// 构造函数，初始化前端对比对话框。
+ShaderFrontendCompareDialog::ShaderFrontendCompareDialog(const ShaderAutotuneRequest &dxcRequest, const ShaderAutotuneRequest &glslangRequest,
+                                                         const QString &glslangOptimizeOptions, const QString &sourceName,
+                                                         const QString &lastDirectory, QWidget *parent)
+    : QDialog(parent), dxcRequest(dxcRequest), glslangRequest(glslangRequest), glslangOptimizeOptions(glslangOptimizeOptions),
+      sourceName(sourceName), directory(lastDirectory)
+{
+    setWindowTitle(tr("Compare DXC / GLSLANG (HLSL to SPIR-V)"));
+    resize(1000, 700);
+
+    QVBoxLayout *mainLayout = new QVBoxLayout(this);
+
+    QHBoxLayout *buttonLayout = new QHBoxLayout();
+    QPushButton *currentButton = new QPushButton(tr("Compare Current Shader"), this);
+    QPushButton *directoryButton = new QPushButton(tr("Batch Directory..."), this);
+    exportButton = new QPushButton(tr("Export CSV..."), this);
+    exportButton->setEnabled(false);
+    buttonLayout->addWidget(currentButton);
+    buttonLayout->addWidget(directoryButton);
+    buttonLayout->addStretch();
+    buttonLayout->addWidget(exportButton);
+    mainLayout->addLayout(buttonLayout);
+
+    reportEdit = new QTextEdit(this);
+    reportEdit->setReadOnly(true);
+    reportEdit->setLineWrapMode(QTextEdit::NoWrap);
+    reportEdit->setStyleSheet("QTextEdit { font-family: 'Consolas', monospace; }");
+    mainLayout->addWidget(reportEdit, 1);
+
+    QDialogButtonBox *buttonBox = new QDialogButtonBox(QDialogButtonBox::Close, Qt::Horizontal, this);
+    mainLayout->addWidget(buttonBox);
+
+    connect(currentButton, &QPushButton::clicked, this, &ShaderFrontendCompareDialog::compareCurrent);
+    connect(directoryButton, &QPushButton::clicked, this, &ShaderFrontendCompareDialog::compareDirectory);
+    connect(exportButton, &QPushButton::clicked, this, &ShaderFrontendCompareDialog::exportCsv);
+    connect(buttonBox, &QDialogButtonBox::rejected, this, &QDialog::reject);
+}
+
+void ShaderFrontendCompareDialog::compareCurrent()
+{
+    QApplication::setOverrideCursor(Qt::WaitCursor);
+    ShaderFrontendComparison comparison = ShaderFrontendCompare::compare(dxcRequest, glslangRequest, glslangOptimizeOptions, sourceName);
+    QApplication::restoreOverrideCursor();
+
+    comparisons.clear();
+    comparisons.append(comparison);
+    exportButton->setEnabled(true);
+    reportEdit->setPlainText(ShaderFrontendCompare::reportText(comparison));
+}
+
+void ShaderFrontendCompareDialog::compareDirectory()
+{
+    QString selected = QFileDialog::getExistingDirectory(this, tr("Select Shader Directory"), directory);
+    if (selected.isEmpty()) {
+        return;
+    }
+    directory = selected;
+
+    QApplication::setOverrideCursor(Qt::WaitCursor);
+    comparisons = ShaderFrontendCompare::compareDirectory(dxcRequest, glslangRequest, glslangOptimizeOptions, directory);
+    QApplication::restoreOverrideCursor();
+
+    if (comparisons.isEmpty()) {
+        reportEdit->setPlainText(tr("No HLSL file found in %1").arg(directory));
+        exportButton->setEnabled(false);
+        return;
+    }
+
+    QString text = ShaderFrontendCompare::summaryText(comparisons);
+    for (const ShaderFrontendComparison &comparison : comparisons) {
+        text += "\n" + ShaderFrontendCompare::reportText(comparison);
+    }
+    reportEdit->setPlainText(text);
+    exportButton->setEnabled(true);
+}
+
+void ShaderFrontendCompareDialog::exportCsv()
+{
+    QString filePath = QFileDialog::getSaveFileName(this, tr("Export CSV"), directory, tr("CSV Files (*.csv)"));
+    if (filePath.isEmpty()) {
+        return;
+    }
+
+    QFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        QMessageBox::warning(this, tr("Export CSV"), tr("Failed to write %1").arg(filePath));
+        return;
+    }
+    QTextStream out(&file);
+    out.setCodec("UTF-8");
+    out << ShaderFrontendCompare::toCsv(comparisons);
+}
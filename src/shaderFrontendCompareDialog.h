@@ -0,0 +1,39 @@
+#ifndef SHADERFRONTENDCOMPAREDIALOG_H
+#define SHADERFRONTENDCOMPAREDIALOG_H
+
+#include <QtWidgets/QDialog>
+#include <QtWidgets/QTextEdit>
+#include <QtWidgets/QPushButton>
+#include "shaderFrontendCompare.h"
+
+// ShaderFrontendCompareDialog 对比当前 HLSL 经 DXC 与 glslang 编译出的 SPIR-V，或批量对比一个目录并导出 CSV。
+class ShaderFrontendCompareDialog : public QDialog
+{
+    Q_OBJECT
+
+public:
+    ShaderFrontendCompareDialog(const ShaderAutotuneRequest &dxcRequest, const ShaderAutotuneRequest &glslangRequest,
+                                const QString &glslangOptimizeOptions, const QString &sourceName,
+                                const QString &lastDirectory, QWidget *parent = nullptr);
+
+    // 最近一次批量对比或导出使用的目录
+    QString lastDirectory() const { return directory; }
+
+private slots:
+    void compareCurrent();
+    void compareDirectory();
+    void exportCsv();
+
+private:
+    ShaderAutotuneRequest dxcRequest;
+    ShaderAutotuneRequest glslangRequest;
+    QString glslangOptimizeOptions;
+    QString sourceName;
+    QString directory;
+    QVector<ShaderFrontendComparison> comparisons;
+
+    QTextEdit *reportEdit;
+    QPushButton *exportButton;
+};
+
+#endif // SHADERFRONTENDCOMPAREDIALOG_H
@@ -0,0 +1,188 @@
+#include "shaderIntermediateCache.h"
+#include <QCryptographicHash>
+#include <QDirIterator>
+#include <QFileInfo>
+#include <QDateTime>
+#include <QFile>
+#include <QMutexLocker>
+#include <QPair>
+#include <QRegularExpression>
+#include <QSet>
+#include <QDir>
+
+ShaderIntermediateCache::ShaderIntermediateCache(int maxEntries)
+    : maxEntries(maxEntries) {}
+
+QByteArray ShaderIntermediateCache::makeKey(const QStringList &inputs)
+{
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    for (const QString &input : inputs) {
+        QByteArray data = input.toUtf8();
+        // 写入长度避免不同输入拼接后相同
+        hash.addData(QByteArray::number(data.size()) + ":");
+        hash.addData(data);
+    }
+    return hash.result();
+}
+
+namespace {
+
+// 包含路径下所有文件的路径及修改时间
+QString includePathsStamp(const QStringList &includePaths)
+{
+    QStringList stamps;
+    for (const QString &includePath : includePaths) {
+        QDirIterator iter(includePath, QDir::Files, QDirIterator::Subdirectories);
+        while (iter.hasNext()) {
+            iter.next();
+            QFileInfo fileInfo = iter.fileInfo();
+            stamps << fileInfo.filePath() + "@" + QString::number(fileInfo.lastModified().toMSecsSinceEpoch());
+        }
+    }
+    return stamps.join("|");
+}
+
+} // namespace
+
+QString ShaderIntermediateCache::includedFilesStamp(const QString &shaderCode, const QString &sourceDir, const QStringList &includePaths)
+{
+    static const QRegularExpression includePattern("^\\s*#\\s*include\\s*([<\"])([^>\"]+)[>\"]", QRegularExpression::MultilineOption);
+    static const QRegularExpression macroIncludePattern("^\\s*#\\s*include\\s+[A-Za-z_]", QRegularExpression::MultilineOption);
+
+    QStringList stamps;
+    QSet<QString> visited;
+    QList<QPair<QString, QString>> pending; // 代码, 所在目录
+    pending.append(qMakePair(shaderCode, sourceDir));
+    while (!pending.isEmpty()) {
+        QPair<QString, QString> current = pending.takeFirst();
+        if (macroIncludePattern.match(current.first).hasMatch()) {
+            return includePathsStamp(includePaths);
+        }
+
+        QRegularExpressionMatchIterator matches = includePattern.globalMatch(current.first);
+        while (matches.hasNext()) {
+            QRegularExpressionMatch match = matches.next();
+            QString includeName = match.captured(2).trimmed();
+            QStringList searchDirs = includePaths;
+            if (match.captured(1) == "\"") {
+                searchDirs.prepend(current.second);
+            }
+
+            QFileInfo fileInfo;
+            for (const QString &dir : searchDirs) {
+                fileInfo = QFileInfo(QDir(dir).filePath(includeName));
+                if (fileInfo.isFile()) {
+                    break;
+                }
+            }
+            if (!fileInfo.isFile()) {
+                // 找不到的文件之后出现时查找结果变化，键随之变化
+                stamps << "missing:" + includeName;
+                continue;
+            }
+
+            QString filePath = fileInfo.canonicalFilePath();
+            if (visited.contains(filePath)) {
+                continue;
+            }
+            visited.insert(filePath);
+            stamps << filePath + "@" + QString::number(fileInfo.lastModified().toMSecsSinceEpoch());
+
+            QFile file(filePath);
+            if (file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+                pending.append(qMakePair(QString::fromUtf8(file.readAll()), fileInfo.absolutePath()));
+            }
+        }
+    }
+    return stamps.join("|");
+}
+
+bool ShaderIntermediateCache::findFrontEnd(const QByteArray &key, QByteArray &blob, QString &warning)
+{
+    QMutexLocker locker(&mutex);
+    if (!entries.contains(key)) {
+        return false;
+    }
+
+    const Entry &entry = entries[key];
+    blob = entry.frontEndBlob;
+    warning = entry.frontEndWarning;
+    touch(key);
+    return true;
+}
+
+void ShaderIntermediateCache::storeFrontEnd(const QByteArray &key, const QByteArray &blob, const QString &warning)
+{
+    QMutexLocker locker(&mutex);
+    Entry entry;
+    entry.frontEndBlob = blob;
+    entry.frontEndWarning = warning;
+    entries[key] = entry;
+    touch(key);
+}
+
+bool ShaderIntermediateCache::findOptimized(const QByteArray &key, const QString &optimizeOptions, QByteArray &blob)
+{
+    QMutexLocker locker(&mutex);
+    if (!entries.contains(key) || !entries[key].optimizedBlobs.contains(optimizeOptions)) {
+        return false;
+    }
+
+    blob = entries[key].optimizedBlobs[optimizeOptions];
+    touch(key);
+    return true;
+}
+
+void ShaderIntermediateCache::storeOptimized(const QByteArray &key, const QString &optimizeOptions, const QByteArray &blob)
+{
+    QMutexLocker locker(&mutex);
+    if (!entries.contains(key)) {
+        return;
+    }
+    entries[key].optimizedBlobs[optimizeOptions] = blob;
+}
+
+bool ShaderIntermediateCache::isEmpty() const
+{
+    QMutexLocker locker(&mutex);
+    return entries.isEmpty();
+}
+
+void ShaderIntermediateCache::clear()
+{
+    QMutexLocker locker(&mutex);
+    entries.clear();
+    recentKeys.clear();
+}
+
+void ShaderIntermediateCache::touch(const QByteArray &key)
+{
+    recentKeys.removeAll(key);
+    recentKeys.append(key);
+
+    while (recentKeys.size() > maxEntries) {
+        entries.remove(recentKeys.takeFirst());
+    }
+}
+
+bool ShaderIntermediateCache::readBlob(const QString &filePath, QByteArray &blob)
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    blob = file.readAll();
+    file.close();
+    return true;
+}
+
+bool ShaderIntermediateCache::writeBlob(const QString &filePath, const QByteArray &blob)
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+    bool success = file.write(blob) == blob.size();
+    file.close();
+    return success;
+}
@@ -0,0 +1,58 @@
+#ifndef SHADERINTERMEDIATECACHE_H
+#define SHADERINTERMEDIATECACHE_H
+
+#include <QString>
+#include <QStringList>
+#include <QByteArray>
+#include <QMap>
+#include <QList>
+#include <QMutex>
+
+// ShaderIntermediateCache 保存每个文档最近的前端编译结果（SPIR-V/DXIL），
+// 只有下游阶段（反汇编、spirv-cross 目标、反射、spirv-opt 级别）变化时直接复用，不再重新编译源码。
+class ShaderIntermediateCache
+{
+public:
+    explicit ShaderIntermediateCache(int maxEntries = 16);
+
+    // 根据前端编译的全部输入生成缓存键
+    static QByteArray makeKey(const QStringList &inputs);
+
+    // 源码递归引用的包含文件的路径及修改时间，作为缓存键的一部分，包含文件修改后前端结果失效；
+    // 引号包含先在 sourceDir（或包含它的文件所在目录）中查找，再查找 includePaths。
+    // 遇到以宏给出的 #include 时无法确定文件，退回到包含路径下的所有文件
+    static QString includedFilesStamp(const QString &shaderCode, const QString &sourceDir, const QStringList &includePaths);
+
+    // 查找/保存前端编译结果及编译器输出的警告
+    bool findFrontEnd(const QByteArray &key, QByteArray &blob, QString &warning);
+    void storeFrontEnd(const QByteArray &key, const QByteArray &blob, const QString &warning);
+
+    // 查找/保存指定 spirv-opt 参数优化后的 SPIR-V
+    bool findOptimized(const QByteArray &key, const QString &optimizeOptions, QByteArray &blob);
+    void storeOptimized(const QByteArray &key, const QString &optimizeOptions, const QByteArray &blob);
+
+    bool isEmpty() const;
+    void clear();
+
+    // 读写中间文件
+    static bool readBlob(const QString &filePath, QByteArray &blob);
+    static bool writeBlob(const QString &filePath, const QByteArray &blob);
+
+private:
+    struct Entry
+    {
+        QByteArray frontEndBlob; // 前端编译结果
+        QString frontEndWarning; // 前端编译警告
+        QMap<QString, QByteArray> optimizedBlobs; // spirv-opt 参数 -> 优化后的 SPIR-V
+    };
+
+    // 将 key 移到最近使用的位置，超出容量时淘汰最久未使用的结果
+    void touch(const QByteArray &key);
+
+    QMap<QByteArray, Entry> entries;
+    QList<QByteArray> recentKeys; // 最近使用顺序，末尾为最新
+    int maxEntries;
+    mutable QMutex mutex; // 并行编译多个阶段时保护缓存
+};
+
+#endif // SHADERINTERMEDIATECACHE_H
@@ -0,0 +1,124 @@
+#include "shaderModelCompareDialog.h"
+#include <QtWidgets/QVBoxLayout>
+#include <QtWidgets/QHBoxLayout>
+#include <QtWidgets/QLabel>
+#include <QtWidgets/QPushButton>
+#include <QtWidgets/QHeaderView>
+#include <QtWidgets/QDialogButtonBox>
+#include <QtWidgets/QApplication>
+#include <QtWidgets/QMessageBox>
+
+// 构造函数，初始化 Shader Model 对比对话框。
+ShaderModelCompareDialog::ShaderModelCompareDialog(const ShaderAutotuneRequest &request, const QStringList &shaderModels,
+                                                   const QStringList &selectedModels, QWidget *parent)
+    : QDialog(parent), request(request)
+{
+    setWindowTitle(tr("Compare Shader Models (%1, %2)").arg(request.shaderType).arg(request.outputType));
+    resize(1000, 500);
+
+    QHBoxLayout *mainLayout = new QHBoxLayout(this);
+
+    QVBoxLayout *modelLayout = new QVBoxLayout();
+    modelLayout->addWidget(new QLabel(tr("Shader Models"), this));
+    modelList = new QListWidget(this);
+    for (const QString &model : shaderModels) {
+        QListWidgetItem *item = new QListWidgetItem(model, modelList);
+        item->setFlags(item->flags() | Qt::ItemIsUserCheckable);
+        item->setCheckState(selectedModels.contains(model) ? Qt::Checked : Qt::Unchecked);
+    }
+    modelList->setMaximumWidth(120);
+    modelLayout->addWidget(modelList);
+    QPushButton *runButton = new QPushButton(tr("Run"), this);
+    modelLayout->addWidget(runButton);
+    mainLayout->addLayout(modelLayout);
+
+    QVBoxLayout *resultLayout = new QVBoxLayout();
+    resultTable = new QTableWidget(this);
+    resultTable->setColumnCount(8);
+    resultTable->setHorizontalHeaderLabels(QStringList() << tr("Shader Model") << tr("Instructions") << tr("Weighted Cost")
+        << tr("Cost vs First") << tr("Size (bytes)") << tr("Time (s)") << tr("Required Features") << tr("Status"));
+    resultTable->horizontalHeader()->setSectionResizeMode(QHeaderView::ResizeToContents);
+    resultTable->horizontalHeader()->setStretchLastSection(true);
+    resultTable->verticalHeader()->setVisible(false);
+    resultTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    resultTable->setSelectionBehavior(QAbstractItemView::SelectRows);
+    resultLayout->addWidget(resultTable);
+
+    QDialogButtonBox *buttonBox = new QDialogButtonBox(QDialogButtonBox::Close, Qt::Horizontal, this);
+    resultLayout->addWidget(buttonBox);
+    mainLayout->addLayout(resultLayout, 1);
+
+    connect(runButton, &QPushButton::clicked, this, &ShaderModelCompareDialog::runCompare);
+    connect(buttonBox, &QDialogButtonBox::rejected, this, &QDialog::reject);
+}
+
+QStringList ShaderModelCompareDialog::selectedModels() const
+{
+    QStringList models;
+    for (int i = 0; i < modelList->count(); ++i) {
+        if (modelList->item(i)->checkState() == Qt::Checked) {
+            models << modelList->item(i)->text();
+        }
+    }
+    return models;
+}
+
+void ShaderModelCompareDialog::runCompare()
+{
+    QStringList models = selectedModels();
+    if (models.isEmpty()) {
+        QMessageBox::information(this, windowTitle(), tr("Select at least one shader model."));
+        return;
+    }
+
+    QVector<ShaderAutotuneRequest> requests;
+    for (const QString &model : models) {
+        ShaderAutotuneRequest modelRequest = request;
+        modelRequest.shaderModel = model;
+        requests.append(modelRequest);
+    }
+
+    // 各 Shader Model 在工作线程中并行编译，完成前阻塞界面
+    QApplication::setOverrideCursor(Qt::WaitCursor);
+    QVector<ShaderAutotuneResult> results = ShaderAutotuner::compileAll(requests, "_smcompare");
+    QApplication::restoreOverrideCursor();
+
+    // 代价与第一个编译成功的 Shader Model 比较
+    const ShaderAutotuneResult *reference = nullptr;
+    for (const ShaderAutotuneResult &result : results) {
+        if (result.success) {
+            reference = &result;
+            break;
+        }
+    }
+
+    resultTable->setRowCount(0);
+    for (int i = 0; i < results.size(); ++i) {
+        const ShaderAutotuneResult &result = results[i];
+        resultTable->insertRow(i);
+        resultTable->setItem(i, 0, new QTableWidgetItem(models[i]));
+        if (!result.success) {
+            QTableWidgetItem *statusItem = new QTableWidgetItem(tr("Failed"));
+            statusItem->setToolTip(result.error);
+            statusItem->setForeground(Qt::red);
+            resultTable->setItem(i, 7, statusItem);
+            continue;
+        }
+
+        QString relative;
+        if (reference && reference != &result && reference->weightedCost > 0) {
+            double percent = (result.weightedCost - reference->weightedCost) * 100.0 / reference->weightedCost;
+            relative = QString("%1%2%").arg(percent > 0 ? "+" : "").arg(percent, 0, 'f', 1);
+        }
+
+        QTableWidgetItem *featuresItem = new QTableWidgetItem(result.requiredFeatures.join(", "));
+        featuresItem->setToolTip(result.requiredFeatures.join("\n"));
+        resultTable->setItem(i, 1, new QTableWidgetItem(QString::number(result.instructionCount, 'f', 0)));
+        resultTable->setItem(i, 2, new QTableWidgetItem(QString::number(result.weightedCost, 'f', 0)));
+        resultTable->setItem(i, 3, new QTableWidgetItem(relative));
+        resultTable->setItem(i, 4, new QTableWidgetItem(QString::number(result.binarySize)));
+        resultTable->setItem(i, 5, new QTableWidgetItem(QString::number(result.compileSeconds, 'f', 3)));
+        resultTable->setItem(i, 6, featuresItem);
+        resultTable->setItem(i, 7, new QTableWidgetItem(tr("OK")));
+    }
+}
@@ -0,0 +1,31 @@
+#ifndef SHADERMODELCOMPAREDIALOG_H
+#define SHADERMODELCOMPAREDIALOG_H
+
+#include <QtWidgets/QDialog>
+#include <QtWidgets/QListWidget>
+#include <QtWidgets/QTableWidget>
+#include "shaderAutotuner.h"
+
+// ShaderModelCompareDialog 以选中的多个 Shader Model 并行编译当前着色器，并排显示指令数、大小、耗时及所需硬件特性。
+class ShaderModelCompareDialog : public QDialog
+{
+    Q_OBJECT
+
+public:
+    ShaderModelCompareDialog(const ShaderAutotuneRequest &request, const QStringList &shaderModels,
+                             const QStringList &selectedModels, QWidget *parent = nullptr);
+
+    // 勾选的 Shader Model
+    QStringList selectedModels() const;
+
+private slots:
+    void runCompare();
+
+private:
+    ShaderAutotuneRequest request;
+
+    QListWidget *modelList;
+    QTableWidget *resultTable;
+};
+
+#endif // SHADERMODELCOMPAREDIALOG_H
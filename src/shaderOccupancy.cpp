@@ -0,0 +1,395 @@
+#include "SPIRV-Reflect/include/spirv/unified1/spirv.h"
+#include "shaderOccupancy.h"
+#include "spirvModule.h"
+#include <QHash>
+#include <QRegularExpression>
+#include <climits>
+#include <cmath>
+
+namespace {
+
+// 类型大小（字节），共享内存按自然布局计算，有显式步长/偏移修饰时使用修饰
+uint32_t spirvTypeSize(const SpirvModule &module, uint32_t typeId)
+{
+    int index = module.definition(typeId);
+    if (index < 0) {
+        return 0;
+    }
+
+    const SpirvModule::Instruction &inst = module.instruction(index);
+    switch (inst.opcode) {
+    case SpvOpTypeBool:
+        return 4;
+    case SpvOpTypeInt:
+    case SpvOpTypeFloat:
+        return module.operand(inst, 1) / 8;
+    case SpvOpTypeVector:
+    case SpvOpTypeMatrix:
+        return module.operand(inst, 2) * spirvTypeSize(module, module.operand(inst, 1));
+    case SpvOpTypeArray: {
+        uint32_t stride = 0;
+        if (!module.hasDecoration(typeId, SpvDecorationArrayStride, &stride)) {
+            stride = spirvTypeSize(module, module.operand(inst, 1));
+        }
+        return module.constantValue(module.operand(inst, 2)) * stride;
+    }
+    case SpvOpTypeStruct: {
+        uint32_t size = 0;
+        for (int member = 1; member < module.operandCount(inst); ++member) {
+            uint32_t memberSize = spirvTypeSize(module, module.operand(inst, member));
+            uint32_t offset = size;
+            for (const SpirvModule::Decoration &decoration : module.decorations(typeId)) {
+                if (decoration.member == static_cast<uint32_t>(member - 1) && decoration.decoration == SpvDecorationOffset) {
+                    offset = module.operand(module.instruction(decoration.instruction), 3);
+                }
+            }
+            size = qMax(size, offset + memberSize);
+        }
+        return size;
+    }
+    case SpvOpTypePointer:
+        return 8;
+    default:
+        return 0;
+    }
+}
+
+QString stageOfExecutionModel(uint32_t executionModel)
+{
+    switch (executionModel) {
+    case SpvExecutionModelGLCompute: return "Compute";
+    case SpvExecutionModelMeshNV: case SpvExecutionModelMeshEXT: return "Mesh";
+    case SpvExecutionModelTaskNV: case SpvExecutionModelTaskEXT: return "Task";
+    default: return QString();
+    }
+}
+
+// LLVM IR 类型大小，struct 按成员大小之和计算
+uint32_t llvmTypeSize(const QString &type, const QHash<QString, QString> &structTypes, int depth = 0)
+{
+    QString text = type.trimmed();
+    if (depth > 16 || text.isEmpty()) {
+        return 0;
+    }
+
+    static const QRegularExpression arrayPattern("^[\\[<]\\s*(\\d+)\\s+x\\s+(.+)[\\]>]$");
+    QRegularExpressionMatch match = arrayPattern.match(text);
+    if (match.hasMatch()) {
+        return match.captured(1).toUInt() * llvmTypeSize(match.captured(2), structTypes, depth + 1);
+    }
+    if (text == "half") return 2;
+    if (text == "float") return 4;
+    if (text == "double") return 8;
+    if (text.startsWith('i') && text.mid(1).toUInt() > 0) {
+        return qMax(1u, text.mid(1).toUInt() / 8);
+    }
+    if (text.startsWith('%')) {
+        return llvmTypeSize(structTypes.value(text), structTypes, depth + 1);
+    }
+
+    // { T, T } 或 <{ T, T }>，按顶层逗号拆分成员
+    if (text.startsWith("<{") && text.endsWith("}>")) {
+        text = text.mid(1, text.size() - 2);
+    }
+    if (text.startsWith('{') && text.endsWith('}')) {
+        uint32_t size = 0;
+        int level = 0;
+        int start = 1;
+        for (int i = 1; i < text.size(); ++i) {
+            QChar c = text[i];
+            if (c == '[' || c == '<' || c == '{') {
+                ++level;
+            } else if (c == ']' || c == '>' || (c == '}' && level > 0)) {
+                --level;
+            } else if ((c == ',' && level == 0) || i == text.size() - 1) {
+                size += llvmTypeSize(text.mid(start, i - start), structTypes, depth + 1);
+                start = i + 1;
+            }
+        }
+        return size;
+    }
+    return 0;
+}
+
+// 变量名去掉 MSVC 名称修饰，如 "\01?cache@@3PAMA" -> cache
+QString demangledName(QString name)
+{
+    name.remove(QChar('"'));
+    int start = name.indexOf('?');
+    int end = name.indexOf("@@");
+    if (start >= 0 && end > start) {
+        return name.mid(start + 1, end - start - 1);
+    }
+    return name;
+}
+
+uint32_t alignUp(uint32_t value, uint32_t alignment)
+{
+    return alignment > 1 ? (value + alignment - 1) / alignment * alignment : value;
+}
+
+} // namespace
+
+QVector<GpuProfile> ShaderOccupancy::defaultProfiles()
+{
+    QVector<GpuProfile> profiles;
+    profiles.append({ "AMD GCN (wave64)", 64, 4, 10, 16, 65536, 32768, 256 });
+    profiles.append({ "AMD RDNA2 WGP (wave32)", 32, 4, 16, 32, 131072, 65536, 1024 });
+    profiles.append({ "AMD RDNA2 WGP (wave64)", 64, 4, 8, 32, 131072, 65536, 1024 });
+    profiles.append({ "NVIDIA Ampere SM", 32, 4, 12, 16, 102400, 101376, 128 });
+    profiles.append({ "Intel Xe-HPG (SIMD16)", 16, 8, 8, 64, 131072, 65536, 1024 });
+    return profiles;
+}
+
+QString ShaderOccupancy::profilesToText(const QVector<GpuProfile> &profiles)
+{
+    QString text = "# name | wave size | SIMDs | max waves per SIMD | max groups | shared memory | max shared memory per group | granularity\n";
+    for (const GpuProfile &profile : profiles) {
+        text += QString("%1 | %2 | %3 | %4 | %5 | %6 | %7 | %8\n").arg(profile.name).arg(profile.waveSize).arg(profile.simdCount)
+            .arg(profile.maxWavesPerSimd).arg(profile.maxGroupsPerUnit).arg(profile.sharedMemoryBytes)
+            .arg(profile.maxSharedMemoryPerGroup).arg(profile.sharedMemoryGranularity);
+    }
+    return text;
+}
+
+QVector<GpuProfile> ShaderOccupancy::profilesFromText(const QString &text)
+{
+    QVector<GpuProfile> profiles;
+    for (const QString &line : text.split('\n')) {
+        QString trimmed = line.trimmed();
+        if (trimmed.isEmpty() || trimmed.startsWith('#')) {
+            continue;
+        }
+
+        QStringList fields = trimmed.split('|');
+        GpuProfile profile;
+        profile.name = fields.value(0).trimmed();
+        profile.waveSize = fields.value(1).trimmed().toInt();
+        profile.simdCount = fields.value(2).trimmed().toInt();
+        profile.maxWavesPerSimd = fields.value(3).trimmed().toInt();
+        profile.maxGroupsPerUnit = fields.value(4).trimmed().toInt();
+        profile.sharedMemoryBytes = fields.value(5).trimmed().toInt();
+        profile.maxSharedMemoryPerGroup = fields.value(6).trimmed().toInt();
+        profile.sharedMemoryGranularity = qMax(1, fields.value(7).trimmed().toInt());
+        if (!profile.name.isEmpty() && profile.waveSize > 0 && profile.simdCount > 0 && profile.maxWavesPerSimd > 0 && profile.maxGroupsPerUnit > 0) {
+            profiles.append(profile);
+        }
+    }
+    return profiles;
+}
+
+ComputeShaderResources ShaderOccupancy::analyzeSpirv(const SpirvModule &module)
+{
+    ComputeShaderResources resources;
+    if (module.entryPoints().isEmpty()) {
+        return resources;
+    }
+
+    const SpirvModule::EntryPoint &entryPoint = module.entryPoints().first();
+    resources.stage = stageOfExecutionModel(entryPoint.executionModel);
+    if (!resources.isCompute()) {
+        return resources;
+    }
+    for (int i = 0; i < 3; ++i) {
+        resources.localSize[i] = entryPoint.localSize[i];
+    }
+
+    for (int i = 0; i < module.instructionCount(); ++i) {
+        const SpirvModule::Instruction &inst = module.instruction(i);
+        if (inst.opcode == SpvOpFunction) {
+            break;
+        }
+
+        if (inst.opcode == SpvOpExecutionModeId && module.operand(inst, 0) == entryPoint.functionId
+            && module.operand(inst, 1) == SpvExecutionModeLocalSizeId) {
+            // LocalSizeId 的操作数为常量 ID
+            for (int c = 0; c < 3; ++c) {
+                resources.localSize[c] = module.constantValue(module.operand(inst, 2 + c), 0, &resources.localSizeFromSpecConstant);
+            }
+        } else if ((inst.opcode == SpvOpConstantComposite || inst.opcode == SpvOpSpecConstantComposite)
+                   && module.operandCount(inst) >= 5) {
+            // BuiltIn WorkgroupSize 修饰的常量优先于执行模式
+            uint32_t builtIn = 0;
+            if (module.hasDecoration(inst.resultId, SpvDecorationBuiltIn, &builtIn) && builtIn == SpvBuiltInWorkgroupSize) {
+                for (int c = 0; c < 3; ++c) {
+                    resources.localSize[c] = module.constantValue(module.operand(inst, 2 + c), 0, &resources.localSizeFromSpecConstant);
+                }
+            }
+        } else if (inst.opcode == SpvOpVariable && module.operand(inst, 2) == SpvStorageClassWorkgroup) {
+            int pointerIndex = module.definition(inst.resultType);
+            uint32_t size = pointerIndex >= 0 ? spirvTypeSize(module, module.operand(module.instruction(pointerIndex), 2)) : 0;
+            QString name = module.name(inst.resultId);
+            resources.sharedMemoryBytes += size;
+            resources.sharedVariables << QString("%1: %2 bytes").arg(name.isEmpty() ? QString("%%1").arg(inst.resultId) : name).arg(size);
+        }
+    }
+    return resources;
+}
+
+ComputeShaderResources ShaderOccupancy::analyzeDxilDisassembly(const QString &disassembly)
+{
+    ComputeShaderResources resources;
+
+    static const QRegularExpression metadataPattern("^(!\\w[\\w.]*|!\\d+) = (?:distinct )?!\\{(.*)\\}\\s*$");
+    static const QRegularExpression structPattern("^(%[\\w.\"$]+) = type (.+)$");
+    static const QRegularExpression sharedPattern("^@(\"[^\"]*\"|[\\w.$]+) = .*addrspace\\(3\\) global (.+?)(?: undef| zeroinitializer)?(?:, align \\d+)?\\s*$");
+
+    QHash<QString, QString> metadata;
+    QHash<QString, QString> structTypes;
+    QVector<QPair<QString, QString>> sharedVariables;
+    for (const QString &rawLine : disassembly.split('\n')) {
+        QString line = rawLine.trimmed();
+        QRegularExpressionMatch match = metadataPattern.match(line);
+        if (match.hasMatch()) {
+            metadata.insert(match.captured(1), match.captured(2));
+            continue;
+        }
+        match = structPattern.match(line);
+        if (match.hasMatch()) {
+            structTypes.insert(match.captured(1), match.captured(2));
+            continue;
+        }
+        match = sharedPattern.match(line);
+        if (match.hasMatch()) {
+            sharedVariables.append(qMakePair(demangledName(match.captured(1)), match.captured(2)));
+        }
+    }
+
+    // !dx.shaderModel = !{!N}，!N = !{!"cs", i32 6, i32 0}
+    QString shaderModel = metadata.value(metadata.value("!dx.shaderModel"));
+    if (shaderModel.startsWith("!\"cs\"")) {
+        resources.stage = "Compute";
+    } else if (shaderModel.startsWith("!\"ms\"")) {
+        resources.stage = "Mesh";
+    } else if (shaderModel.startsWith("!\"as\"")) {
+        resources.stage = "Task";
+    }
+    if (!resources.isCompute()) {
+        return resources;
+    }
+
+    // !dx.entryPoints = !{!N}，入口的最后一个操作数为属性列表，标签 4 为 numthreads
+    QString entry = metadata.value(metadata.value("!dx.entryPoints").split(',').value(0).trimmed());
+    QString properties = metadata.value(entry.split(',').last().trimmed());
+    static const QRegularExpression numThreadsPattern("i32 4, (!\\d+)");
+    QRegularExpressionMatch numThreads = numThreadsPattern.match(properties);
+    if (numThreads.hasMatch()) {
+        QStringList sizes = metadata.value(numThreads.captured(1)).split(',');
+        for (int c = 0; c < 3 && c < sizes.size(); ++c) {
+            resources.localSize[c] = sizes[c].trimmed().split(' ').last().toUInt();
+        }
+    }
+
+    for (const auto &variable : sharedVariables) {
+        uint32_t size = llvmTypeSize(variable.second, structTypes);
+        resources.sharedMemoryBytes += size;
+        resources.sharedVariables << QString("%1: %2 bytes").arg(variable.first).arg(size);
+    }
+    return resources;
+}
+
+OccupancyEstimate ShaderOccupancy::estimate(const ComputeShaderResources &resources, const GpuProfile &profile)
+{
+    OccupancyEstimate result;
+    result.profile = profile.name;
+
+    uint32_t threads = resources.threadCount();
+    if (threads == 0) {
+        result.limiter = "Unknown workgroup size";
+        return result;
+    }
+
+    int totalWaves = profile.simdCount * profile.maxWavesPerSimd;
+    result.wavesPerGroup = static_cast<int>((threads + profile.waveSize - 1) / profile.waveSize);
+    if (result.wavesPerGroup > totalWaves) {
+        result.limiter = "Workgroup too large";
+        result.warnings << QString("%1 threads need %2 waves, more than the %3 wave slots of a unit.").arg(threads).arg(result.wavesPerGroup).arg(totalWaves);
+        return result;
+    }
+
+    int groupsByWaves = totalWaves / result.wavesPerGroup;
+    int groupsBySharedMemory = INT_MAX;
+    uint32_t allocatedShared = alignUp(resources.sharedMemoryBytes, static_cast<uint32_t>(profile.sharedMemoryGranularity));
+    if (allocatedShared > 0) {
+        groupsBySharedMemory = profile.sharedMemoryBytes / static_cast<int>(allocatedShared);
+    }
+    if (resources.sharedMemoryBytes > static_cast<uint32_t>(profile.maxSharedMemoryPerGroup)) {
+        result.limiter = "Shared memory";
+        result.warnings << QString("%1 bytes of shared memory exceed the %2 byte limit per workgroup.")
+            .arg(resources.sharedMemoryBytes).arg(profile.maxSharedMemoryPerGroup);
+        return result;
+    }
+
+    result.groupsPerUnit = qMin(qMin(groupsByWaves, groupsBySharedMemory), profile.maxGroupsPerUnit);
+    if (result.groupsPerUnit == groupsBySharedMemory && groupsBySharedMemory < groupsByWaves) {
+        result.limiter = "Shared memory";
+    } else if (result.groupsPerUnit == profile.maxGroupsPerUnit && profile.maxGroupsPerUnit < groupsByWaves) {
+        result.limiter = "Workgroups per unit";
+    } else {
+        result.limiter = "Wave slots";
+    }
+
+    result.wavesPerSimd = static_cast<double>(result.groupsPerUnit * result.wavesPerGroup) / profile.simdCount;
+    result.occupancy = result.wavesPerSimd / profile.maxWavesPerSimd;
+
+    if (result.limiter == "Shared memory") {
+        // 再多驻留一个工作组所需的共享内存上限
+        int targetGroups = qMin(groupsByWaves, profile.maxGroupsPerUnit);
+        int nextGroups = result.groupsPerUnit + 1;
+        uint32_t budget = static_cast<uint32_t>(profile.sharedMemoryBytes / nextGroups) / profile.sharedMemoryGranularity * profile.sharedMemoryGranularity;
+        double nextWaves = static_cast<double>(nextGroups * result.wavesPerGroup) / profile.simdCount;
+        result.warnings << QString("Shared memory (%1 bytes, %2 allocated) limits residency to %3 workgroups (%4 waves per SIMD, %5 possible). "
+                                   "Reduce it to %6 bytes to reach %7 waves per SIMD.")
+            .arg(resources.sharedMemoryBytes).arg(allocatedShared).arg(result.groupsPerUnit).arg(result.wavesPerSimd, 0, 'f', 1)
+            .arg(static_cast<double>(targetGroups * result.wavesPerGroup) / profile.simdCount, 0, 'f', 1)
+            .arg(budget).arg(nextWaves, 0, 'f', 1);
+    } else if (result.limiter == "Workgroups per unit") {
+        result.warnings << QString("Small workgroups (%1 threads) hit the limit of %2 workgroups per unit; use at least %3 threads per workgroup.")
+            .arg(threads).arg(profile.maxGroupsPerUnit).arg(totalWaves / profile.maxGroupsPerUnit * profile.waveSize);
+    }
+    if (threads % profile.waveSize != 0) {
+        result.warnings << QString("%1 threads is not a multiple of the wave size %2, %3 lanes of the last wave are idle.")
+            .arg(threads).arg(profile.waveSize).arg(profile.waveSize - threads % profile.waveSize);
+    }
+    return result;
+}
+
+QString ShaderOccupancy::reportText(const QVector<ComputeShaderResources> &stages, const QVector<GpuProfile> &profiles)
+{
+    QString text;
+    for (const ComputeShaderResources &resources : stages) {
+        if (!resources.isCompute()) {
+            continue;
+        }
+
+        text += QString("== %1 ==\n").arg(resources.stage);
+        text += QString("Workgroup size: %1 x %2 x %3 = %4 threads%5\n").arg(resources.localSize[0]).arg(resources.localSize[1])
+            .arg(resources.localSize[2]).arg(resources.threadCount()).arg(resources.localSizeFromSpecConstant ? " (spec constant defaults)" : "");
+        text += QString("Shared memory: %1 bytes\n").arg(resources.sharedMemoryBytes);
+        for (const QString &variable : resources.sharedVariables) {
+            text += "  " + variable + "\n";
+        }
+        if (resources.threadCount() > 1024) {
+            text += "Warning: more than 1024 threads per workgroup exceeds the D3D12 limit and most Vulkan devices.\n";
+        }
+
+        text += QString("\n%1 %2 %3 %4 %5 %6  %7\n").arg("Profile", -26).arg("Wave", 5).arg("Waves/Group", 12).arg("Groups/Unit", 12)
+            .arg("Waves/SIMD", 11).arg("Occupancy", 10).arg("Limiter");
+        QStringList warnings;
+        for (const GpuProfile &profile : profiles) {
+            OccupancyEstimate estimate = ShaderOccupancy::estimate(resources, profile);
+            text += QString("%1 %2 %3 %4 %5 %6  %7\n").arg(profile.name, -26).arg(profile.waveSize, 5).arg(estimate.wavesPerGroup, 12)
+                .arg(estimate.groupsPerUnit, 12)
+                .arg(QString("%1/%2").arg(estimate.wavesPerSimd, 0, 'f', 1).arg(profile.maxWavesPerSimd), 11)
+                .arg(QString("%1%").arg(std::round(estimate.occupancy * 100.0)), 10).arg(estimate.limiter);
+            for (const QString &warning : estimate.warnings) {
+                warnings << QString("[%1] %2").arg(profile.name).arg(warning);
+            }
+        }
+        if (!warnings.isEmpty()) {
+            text += "\nWarnings:\n  " + warnings.join("\n  ") + "\n";
+        }
+        text += "\n";
+    }
+    return text;
+}
@@ -0,0 +1,71 @@
+#ifndef SHADEROCCUPANCY_H
+#define SHADEROCCUPANCY_H
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <cstdint>
+
+class SpirvModule;
+
+// GPU 的计算单元参数（AMD CU/WGP、NVIDIA SM），用于估算理论占用率
+struct GpuProfile
+{
+    QString name;
+    int waveSize = 64; // wave/warp 宽度
+    int simdCount = 4; // 每个计算单元的 SIMD（调度器）数量
+    int maxWavesPerSimd = 10; // 每个 SIMD 可驻留的最大 wave 数
+    int maxGroupsPerUnit = 16; // 每个计算单元可驻留的最大工作组数
+    int sharedMemoryBytes = 65536; // 每个计算单元的共享内存（LDS）大小
+    int maxSharedMemoryPerGroup = 32768; // 单个工作组可分配的共享内存上限
+    int sharedMemoryGranularity = 256; // 共享内存的分配粒度
+};
+
+// 计算类着色器（Compute/Mesh/Task）的工作组大小及共享内存用量
+struct ComputeShaderResources
+{
+    QString stage; // Compute、Mesh、Task，其他阶段为空
+    uint32_t localSize[3] = { 0, 0, 0 };
+    bool localSizeFromSpecConstant = false; // 工作组大小来自特化常量的默认值
+    uint32_t sharedMemoryBytes = 0;
+    QStringList sharedVariables; // "名称: 字节数"
+
+    bool isCompute() const { return !stage.isEmpty(); }
+    uint32_t threadCount() const { return localSize[0] * localSize[1] * localSize[2]; }
+};
+
+// 单个 GPU 配置下的占用率估算
+struct OccupancyEstimate
+{
+    QString profile;
+    int wavesPerGroup = 0;
+    int groupsPerUnit = 0;
+    double wavesPerSimd = 0;
+    double occupancy = 0; // 0..1
+    QString limiter; // 限制驻留工作组数的因素
+    QStringList warnings;
+};
+
+// ShaderOccupancy 从 SPIR-V（LocalSize/LocalSizeId/WorkgroupSize、Workgroup 存储类变量）及
+// DXIL 反汇编（numthreads 元数据、addrspace(3) 全局变量）提取工作组大小及共享内存用量，
+// 按 GPU 配置估算每个 SIMD 可驻留的 wave 数，不需要实际的 GPU。
+class ShaderOccupancy
+{
+public:
+    // 内置的 GPU 配置
+    static QVector<GpuProfile> defaultProfiles();
+
+    // 配置文本格式：每行 "名称 | wave 宽度 | SIMD 数 | 每 SIMD 最大 wave 数 | 每单元最大工作组数 | 共享内存 | 每组共享内存上限 | 分配粒度"，# 开头为注释
+    static QString profilesToText(const QVector<GpuProfile> &profiles);
+    static QVector<GpuProfile> profilesFromText(const QString &text);
+
+    static ComputeShaderResources analyzeSpirv(const SpirvModule &module);
+    static ComputeShaderResources analyzeDxilDisassembly(const QString &disassembly);
+
+    static OccupancyEstimate estimate(const ComputeShaderResources &resources, const GpuProfile &profile);
+
+    // 所有计算类阶段在所有配置下的报告
+    static QString reportText(const QVector<ComputeShaderResources> &stages, const QVector<GpuProfile> &profiles);
+};
+
+#endif // SHADEROCCUPANCY_H
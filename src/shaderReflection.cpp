@@ -0,0 +1,875 @@
+#include "shaderReflection.h"
+#include "SPIRV-Reflect/spirv_reflect.h"
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QDataStream>
+#include <QFile>
+#include <vector>
+
+// 二进制格式文件头及版本
+static const quint32 kReflectionBinaryMagic = 0x46524353; // "SCRF"
+static const quint32 kReflectionBinaryVersion = 3;
+
+// 标量类型名称，沿用 GLSL 命名
+static QString scalarTypeName(const SpvReflectTypeDescription *type)
+{
+    const uint32_t width = type->traits.numeric.scalar.width;
+    if (type->type_flags & SPV_REFLECT_TYPE_FLAG_BOOL) {
+        return "bool";
+    }
+    if (type->type_flags & SPV_REFLECT_TYPE_FLAG_FLOAT) {
+        return width == 64 ? "double" : (width == 16 ? "float16_t" : "float");
+    }
+    if (type->type_flags & SPV_REFLECT_TYPE_FLAG_INT) {
+        QString name = type->traits.numeric.scalar.signedness ? "int" : "uint";
+        return width == 32 ? name : name + QString::number(width) + "_t";
+    }
+    return "void";
+}
+
+static QString vectorPrefix(const QString &scalarName)
+{
+    if (scalarName == "float") return "vec";
+    if (scalarName == "double") return "dvec";
+    if (scalarName == "int") return "ivec";
+    if (scalarName == "uint") return "uvec";
+    if (scalarName == "bool") return "bvec";
+    if (scalarName == "float16_t") return "f16vec";
+    return scalarName + "vec";
+}
+
+// 根据 SPIRV-Reflect 类型描述生成类型名称，如 vec4、mat3x4、结构体名
+static QString typeNameOf(const SpvReflectTypeDescription *type)
+{
+    if (type == nullptr) {
+        return "unknown";
+    }
+
+    if (type->type_flags & SPV_REFLECT_TYPE_FLAG_STRUCT) {
+        return type->type_name ? QString(type->type_name) : QString("struct");
+    }
+
+    if (type->type_flags & SPV_REFLECT_TYPE_FLAG_EXTERNAL_MASK) {
+        if (type->type_name) return QString(type->type_name);
+        if (type->type_flags & SPV_REFLECT_TYPE_FLAG_EXTERNAL_SAMPLED_IMAGE) return "sampledImage";
+        if (type->type_flags & SPV_REFLECT_TYPE_FLAG_EXTERNAL_IMAGE) return "image";
+        if (type->type_flags & SPV_REFLECT_TYPE_FLAG_EXTERNAL_SAMPLER) return "sampler";
+        if (type->type_flags & SPV_REFLECT_TYPE_FLAG_EXTERNAL_ACCELERATION_STRUCTURE) return "accelerationStructure";
+        return "block";
+    }
+
+    QString scalarName = scalarTypeName(type);
+    if (type->type_flags & SPV_REFLECT_TYPE_FLAG_MATRIX) {
+        uint32_t columns = type->traits.numeric.matrix.column_count;
+        uint32_t rows = type->traits.numeric.matrix.row_count;
+        QString prefix = scalarName == "double" ? "dmat" : "mat";
+        return columns == rows ? prefix + QString::number(columns) : QString("%1%2x%3").arg(prefix).arg(columns).arg(rows);
+    }
+    if (type->type_flags & SPV_REFLECT_TYPE_FLAG_VECTOR) {
+        return vectorPrefix(scalarName) + QString::number(type->traits.numeric.vector.component_count);
+    }
+    return scalarName;
+}
+
+static QString descriptorTypeName(SpvReflectDescriptorType descriptorType)
+{
+    switch (descriptorType)
+    {
+        case SPV_REFLECT_DESCRIPTOR_TYPE_SAMPLER: return "Sampler";
+        case SPV_REFLECT_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER: return "Combined Image Sampler";
+        case SPV_REFLECT_DESCRIPTOR_TYPE_SAMPLED_IMAGE: return "Sampled Image";
+        case SPV_REFLECT_DESCRIPTOR_TYPE_STORAGE_IMAGE: return "Storage Image";
+        case SPV_REFLECT_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER: return "Uniform Texel Buffer";
+        case SPV_REFLECT_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER: return "Storage Texel Buffer";
+        case SPV_REFLECT_DESCRIPTOR_TYPE_UNIFORM_BUFFER: return "Uniform Buffer";
+        case SPV_REFLECT_DESCRIPTOR_TYPE_STORAGE_BUFFER: return "Storage Buffer";
+        case SPV_REFLECT_DESCRIPTOR_TYPE_INPUT_ATTACHMENT: return "Input Attachment";
+        case SPV_REFLECT_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR: return "Acceleration Structure";
+        default: return "Unknown";
+    }
+}
+
+static QString shaderStageName(SpvReflectShaderStageFlagBits stage)
+{
+    switch (stage)
+    {
+        case SPV_REFLECT_SHADER_STAGE_VERTEX_BIT: return "Vertex";
+        case SPV_REFLECT_SHADER_STAGE_TESSELLATION_CONTROL_BIT: return "TessControl";
+        case SPV_REFLECT_SHADER_STAGE_TESSELLATION_EVALUATION_BIT: return "TessEvaluation";
+        case SPV_REFLECT_SHADER_STAGE_GEOMETRY_BIT: return "Geometry";
+        case SPV_REFLECT_SHADER_STAGE_FRAGMENT_BIT: return "Pixel";
+        case SPV_REFLECT_SHADER_STAGE_COMPUTE_BIT: return "Compute";
+        case SPV_REFLECT_SHADER_STAGE_TASK_BIT_EXT: return "Task";
+        case SPV_REFLECT_SHADER_STAGE_MESH_BIT_EXT: return "Mesh";
+        case SPV_REFLECT_SHADER_STAGE_RAYGEN_BIT_KHR: return "RayGeneration";
+        case SPV_REFLECT_SHADER_STAGE_ANY_HIT_BIT_KHR: return "RayAnyHit";
+        case SPV_REFLECT_SHADER_STAGE_CLOSEST_HIT_BIT_KHR: return "RayClosestHit";
+        case SPV_REFLECT_SHADER_STAGE_MISS_BIT_KHR: return "RayMiss";
+        case SPV_REFLECT_SHADER_STAGE_INTERSECTION_BIT_KHR: return "RayIntersection";
+        case SPV_REFLECT_SHADER_STAGE_CALLABLE_BIT_KHR: return "RayCallable";
+        default: return "Unknown";
+    }
+}
+
+static QString builtInName(const SpvReflectInterfaceVariable *variable)
+{
+    if (!(variable->decoration_flags & SPV_REFLECT_DECORATION_BUILT_IN)) {
+        return QString();
+    }
+
+    switch (variable->built_in)
+    {
+        case SpvBuiltInPosition: return "Position";
+        case SpvBuiltInPointSize: return "PointSize";
+        case SpvBuiltInClipDistance: return "ClipDistance";
+        case SpvBuiltInCullDistance: return "CullDistance";
+        case SpvBuiltInVertexIndex: return "VertexIndex";
+        case SpvBuiltInInstanceIndex: return "InstanceIndex";
+        case SpvBuiltInFragCoord: return "FragCoord";
+        case SpvBuiltInFrontFacing: return "FrontFacing";
+        case SpvBuiltInFragDepth: return "FragDepth";
+        case SpvBuiltInSampleId: return "SampleId";
+        case SpvBuiltInSampleMask: return "SampleMask";
+        case SpvBuiltInLocalInvocationId: return "LocalInvocationId";
+        case SpvBuiltInLocalInvocationIndex: return "LocalInvocationIndex";
+        case SpvBuiltInGlobalInvocationId: return "GlobalInvocationId";
+        case SpvBuiltInWorkgroupId: return "WorkgroupId";
+        case SpvBuiltInNumWorkgroups: return "NumWorkgroups";
+        case SpvBuiltInLayer: return "Layer";
+        case SpvBuiltInViewportIndex: return "ViewportIndex";
+        case SpvBuiltInPrimitiveId: return "PrimitiveId";
+        default: return QString("BuiltIn(%1)").arg(static_cast<int>(variable->built_in));
+    }
+}
+
+static QVector<uint32_t> arrayDimsOf(const SpvReflectArrayTraits &array)
+{
+    QVector<uint32_t> dims;
+    for (uint32_t i = 0; i < array.dims_count; ++i) {
+        dims.append(array.dims[i]);
+    }
+    return dims;
+}
+
+static void fillMembers(const SpvReflectBlockVariable &block, QVector<ShaderReflectionMember> &members)
+{
+    members.clear();
+    members.reserve(block.member_count);
+    for (uint32_t i = 0; i < block.member_count; ++i) {
+        const SpvReflectBlockVariable &memberBlock = block.members[i];
+
+        ShaderReflectionMember member;
+        member.name = memberBlock.name ? QString(memberBlock.name) : QString();
+        member.typeName = typeNameOf(memberBlock.type_description);
+        member.offset = memberBlock.offset;
+        member.absoluteOffset = memberBlock.absolute_offset;
+        member.size = memberBlock.size;
+        member.paddedSize = memberBlock.padded_size;
+        member.arrayDims = arrayDimsOf(memberBlock.array);
+        member.arrayStride = memberBlock.array.stride;
+        member.matrixStride = memberBlock.numeric.matrix.stride;
+        member.rowMajor = (memberBlock.decoration_flags & SPV_REFLECT_DECORATION_ROW_MAJOR) != 0;
+        member.accessed = (memberBlock.flags & SPV_REFLECT_VARIABLE_FLAGS_UNUSED) == 0;
+        fillMembers(memberBlock, member.members);
+        members.append(member);
+    }
+}
+
+static void fillInterfaceVariables(const SpvReflectInterfaceVariable *const *variables, uint32_t count, QVector<ShaderReflectionInterfaceVariable> &result)
+{
+    result.clear();
+    result.reserve(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        const SpvReflectInterfaceVariable *variable = variables[i];
+
+        ShaderReflectionInterfaceVariable item;
+        item.name = variable->name ? QString(variable->name) : QString();
+        item.typeName = typeNameOf(variable->type_description);
+        item.semantic = variable->semantic ? QString(variable->semantic) : QString();
+        item.location = variable->location;
+        item.component = variable->component;
+        item.builtIn = builtInName(variable);
+        item.format = static_cast<uint32_t>(variable->format);
+        item.arrayDims = arrayDimsOf(variable->array);
+        result.append(item);
+    }
+}
+
+ShaderReflection::ShaderReflection() {}
+
+void ShaderReflection::clear()
+{
+    binaryType.clear();
+    sourceLanguage.clear();
+    entryPoints.clear();
+    descriptorBindings.clear();
+    inputVariables.clear();
+    outputVariables.clear();
+    pushConstants.clear();
+    specConstants.clear();
+    requiredFeatures.clear();
+}
+
+bool ShaderReflection::reflectSpirv(const uint32_t *words, size_t wordCount, QString *error)
+{
+    clear();
+
+    // 使用 NO_COPY 直接引用调用者的内存
+    SpvReflectShaderModule module;
+    SpvReflectResult result = spvReflectCreateShaderModule2(SPV_REFLECT_MODULE_FLAG_NO_COPY, wordCount * sizeof(uint32_t), words, &module);
+    if (result != SPV_REFLECT_RESULT_SUCCESS) {
+        if (error) {
+            *error = QString("SPIRV-Reflect failed with error %1").arg(static_cast<int>(result));
+        }
+        return false;
+    }
+
+    binaryType = "SPIR-V";
+    sourceLanguage = spvReflectSourceLanguage(module.source_language);
+
+    // 入口函数及线程组大小
+    entryPoints.reserve(module.entry_point_count);
+    for (uint32_t i = 0; i < module.entry_point_count; ++i) {
+        const SpvReflectEntryPoint &entry = module.entry_points[i];
+        ShaderReflectionEntryPoint entryPoint;
+        entryPoint.name = entry.name ? QString(entry.name) : QString();
+        entryPoint.stage = shaderStageName(entry.shader_stage);
+        entryPoint.localSize[0] = entry.local_size.x;
+        entryPoint.localSize[1] = entry.local_size.y;
+        entryPoint.localSize[2] = entry.local_size.z;
+        entryPoints.append(entryPoint);
+    }
+
+    // 描述符绑定
+    uint32_t count = 0;
+    spvReflectEnumerateDescriptorBindings(&module, &count, nullptr);
+    std::vector<SpvReflectDescriptorBinding*> bindings(count);
+    spvReflectEnumerateDescriptorBindings(&module, &count, bindings.data());
+
+    descriptorBindings.reserve(count);
+    for (const SpvReflectDescriptorBinding *binding : bindings) {
+        ShaderReflectionBinding item;
+        item.name = binding->name ? QString(binding->name) : QString();
+        item.typeName = typeNameOf(binding->type_description);
+        item.descriptorType = descriptorTypeName(binding->descriptor_type);
+        item.set = binding->set;
+        item.binding = binding->binding;
+        item.count = binding->count;
+        for (uint32_t i = 0; i < binding->array.dims_count; ++i) {
+            item.arrayDims.append(binding->array.dims[i]);
+        }
+        item.accessed = binding->accessed != 0;
+        if (binding->descriptor_type == SPV_REFLECT_DESCRIPTOR_TYPE_UNIFORM_BUFFER ||
+            binding->descriptor_type == SPV_REFLECT_DESCRIPTOR_TYPE_STORAGE_BUFFER) {
+            item.blockSize = binding->block.size;
+            fillMembers(binding->block, item.members);
+        }
+        descriptorBindings.append(item);
+    }
+
+    // 输入输出变量
+    spvReflectEnumerateInputVariables(&module, &count, nullptr);
+    std::vector<SpvReflectInterfaceVariable*> inputs(count);
+    spvReflectEnumerateInputVariables(&module, &count, inputs.data());
+    fillInterfaceVariables(inputs.data(), count, inputVariables);
+
+    spvReflectEnumerateOutputVariables(&module, &count, nullptr);
+    std::vector<SpvReflectInterfaceVariable*> outputs(count);
+    spvReflectEnumerateOutputVariables(&module, &count, outputs.data());
+    fillInterfaceVariables(outputs.data(), count, outputVariables);
+
+    // push constant 块
+    spvReflectEnumeratePushConstantBlocks(&module, &count, nullptr);
+    std::vector<SpvReflectBlockVariable*> blocks(count);
+    spvReflectEnumeratePushConstantBlocks(&module, &count, blocks.data());
+
+    pushConstants.reserve(count);
+    for (const SpvReflectBlockVariable *block : blocks) {
+        ShaderReflectionPushConstant item;
+        item.name = block->name ? QString(block->name) : QString();
+        item.typeName = typeNameOf(block->type_description);
+        item.offset = block->offset;
+        item.size = block->size;
+        fillMembers(*block, item.members);
+        pushConstants.append(item);
+    }
+
+    // 特化常量
+    spvReflectEnumerateSpecializationConstants(&module, &count, nullptr);
+    std::vector<SpvReflectSpecializationConstant*> constants(count);
+    spvReflectEnumerateSpecializationConstants(&module, &count, constants.data());
+
+    specConstants.reserve(count);
+    for (const SpvReflectSpecializationConstant *constant : constants) {
+        ShaderReflectionSpecConstant item;
+        item.name = constant->name ? QString(constant->name) : QString();
+        item.constantId = constant->constant_id;
+        item.spirvId = constant->spirv_id;
+        specConstants.append(item);
+    }
+
+    spvReflectDestroyShaderModule(&module);
+    return true;
+}
+
+static QString arrayDimsText(const QVector<uint32_t> &dims)
+{
+    QString text;
+    for (uint32_t dim : dims) {
+        text += dim == 0 ? QString("[]") : QString("[%1]").arg(dim);
+    }
+    return text;
+}
+
+static void appendMembersText(QString &text, const QVector<ShaderReflectionMember> &members, int indent)
+{
+    QString padding(indent * 4, ' ');
+    for (const ShaderReflectionMember &member : members) {
+        text += QString(";    %1%2 %3%4, Offset: %5, Size: %6%7\n")
+            .arg(padding)
+            .arg(member.typeName)
+            .arg(member.name)
+            .arg(arrayDimsText(member.arrayDims))
+            .arg(member.absoluteOffset)
+            .arg(member.size)
+            .arg(member.accessed ? QString() : QString(" (unused)"));
+        appendMembersText(text, member.members, indent + 1);
+    }
+}
+
+static QString interfaceLocationText(const ShaderReflectionInterfaceVariable &variable)
+{
+    QString text = variable.builtIn.isEmpty() ? QString("Location: %1").arg(variable.location) : QString("BuiltIn: %1").arg(variable.builtIn);
+    if (!variable.semantic.isEmpty()) {
+        text += QString(", Semantic: %1").arg(variable.semantic);
+    }
+    return text;
+}
+
+QString ShaderReflection::toText() const
+{
+    QString text;
+
+    // DXIL 使用 register/space 描述绑定位置
+    bool isDxil = binaryType == "DXIL";
+    text += isDxil ? "; Resource Bindings:\n" : "; Descriptor Bindings:\n";
+    for (const ShaderReflectionBinding &binding : descriptorBindings) {
+        text += QString(isDxil ? ";    Name: %1, Register: %2, Space: %3, Resource Type: %4, Type Name: %5%6\n"
+                               : ";    Name: %1, Binding: %2, Set: %3, Descriptor Type: %4, Type Name: %5%6\n")
+            .arg(binding.name)
+            .arg(binding.binding)
+            .arg(binding.set)
+            .arg(binding.descriptorType)
+            .arg(binding.typeName)
+            .arg(binding.accessed ? QString() : QString(" (unused)"));
+        appendMembersText(text, binding.members, 1);
+    }
+
+    if (!pushConstants.isEmpty()) {
+        text += "; Push Constants:\n";
+        for (const ShaderReflectionPushConstant &block : pushConstants) {
+            text += QString(";    Name: %1, Offset: %2, Size: %3\n").arg(block.name).arg(block.offset).arg(block.size);
+            appendMembersText(text, block.members, 1);
+        }
+    }
+
+    if (!inputVariables.isEmpty()) {
+        text += "; Inputs:\n";
+        for (const ShaderReflectionInterfaceVariable &variable : inputVariables) {
+            text += QString(";    %1 %2%3, %4\n")
+                .arg(variable.typeName)
+                .arg(variable.name)
+                .arg(arrayDimsText(variable.arrayDims))
+                .arg(interfaceLocationText(variable));
+        }
+    }
+
+    if (!outputVariables.isEmpty()) {
+        text += "; Outputs:\n";
+        for (const ShaderReflectionInterfaceVariable &variable : outputVariables) {
+            text += QString(";    %1 %2%3, %4\n")
+                .arg(variable.typeName)
+                .arg(variable.name)
+                .arg(arrayDimsText(variable.arrayDims))
+                .arg(interfaceLocationText(variable));
+        }
+    }
+
+    if (!specConstants.isEmpty()) {
+        text += "; Specialization Constants:\n";
+        for (const ShaderReflectionSpecConstant &constant : specConstants) {
+            text += QString(";    Name: %1, SpecId: %2\n").arg(constant.name).arg(constant.constantId);
+        }
+    }
+
+    if (!requiredFeatures.isEmpty()) {
+        text += "; Required Features: " + requiredFeatures.join(", ") + "\n";
+    }
+
+    for (const ShaderReflectionEntryPoint &entryPoint : entryPoints) {
+        if (entryPoint.stage == "Compute" || entryPoint.stage == "Mesh" || entryPoint.stage == "Task") {
+            text += QString("; Workgroup Size (%1): %2 x %3 x %4\n")
+                .arg(entryPoint.name)
+                .arg(entryPoint.localSize[0])
+                .arg(entryPoint.localSize[1])
+                .arg(entryPoint.localSize[2]);
+        }
+    }
+
+    return text;
+}
+
+// ---------------- JSON ----------------
+
+static QJsonArray dimsToJson(const QVector<uint32_t> &dims)
+{
+    QJsonArray array;
+    for (uint32_t dim : dims) {
+        array.append(static_cast<qint64>(dim));
+    }
+    return array;
+}
+
+static QVector<uint32_t> dimsFromJson(const QJsonArray &array)
+{
+    QVector<uint32_t> dims;
+    for (const QJsonValue &value : array) {
+        dims.append(static_cast<uint32_t>(value.toDouble()));
+    }
+    return dims;
+}
+
+static QJsonArray membersToJson(const QVector<ShaderReflectionMember> &members)
+{
+    QJsonArray array;
+    for (const ShaderReflectionMember &member : members) {
+        QJsonObject object;
+        object["name"] = member.name;
+        object["type"] = member.typeName;
+        object["offset"] = static_cast<qint64>(member.offset);
+        object["absoluteOffset"] = static_cast<qint64>(member.absoluteOffset);
+        object["size"] = static_cast<qint64>(member.size);
+        object["paddedSize"] = static_cast<qint64>(member.paddedSize);
+        object["arrayDims"] = dimsToJson(member.arrayDims);
+        object["arrayStride"] = static_cast<qint64>(member.arrayStride);
+        object["matrixStride"] = static_cast<qint64>(member.matrixStride);
+        object["rowMajor"] = member.rowMajor;
+        object["accessed"] = member.accessed;
+        object["members"] = membersToJson(member.members);
+        array.append(object);
+    }
+    return array;
+}
+
+static QVector<ShaderReflectionMember> membersFromJson(const QJsonArray &array)
+{
+    QVector<ShaderReflectionMember> members;
+    for (const QJsonValue &value : array) {
+        QJsonObject object = value.toObject();
+        ShaderReflectionMember member;
+        member.name = object["name"].toString();
+        member.typeName = object["type"].toString();
+        member.offset = static_cast<uint32_t>(object["offset"].toDouble());
+        member.absoluteOffset = static_cast<uint32_t>(object["absoluteOffset"].toDouble());
+        member.size = static_cast<uint32_t>(object["size"].toDouble());
+        member.paddedSize = static_cast<uint32_t>(object["paddedSize"].toDouble());
+        member.arrayDims = dimsFromJson(object["arrayDims"].toArray());
+        member.arrayStride = static_cast<uint32_t>(object["arrayStride"].toDouble());
+        member.matrixStride = static_cast<uint32_t>(object["matrixStride"].toDouble());
+        member.rowMajor = object["rowMajor"].toBool();
+        member.accessed = object["accessed"].toBool(true);
+        member.members = membersFromJson(object["members"].toArray());
+        members.append(member);
+    }
+    return members;
+}
+
+static QJsonArray interfaceVariablesToJson(const QVector<ShaderReflectionInterfaceVariable> &variables)
+{
+    QJsonArray array;
+    for (const ShaderReflectionInterfaceVariable &variable : variables) {
+        QJsonObject object;
+        object["name"] = variable.name;
+        object["type"] = variable.typeName;
+        object["semantic"] = variable.semantic;
+        object["location"] = static_cast<qint64>(variable.location);
+        object["component"] = static_cast<qint64>(variable.component);
+        object["builtIn"] = variable.builtIn;
+        object["format"] = static_cast<qint64>(variable.format);
+        object["arrayDims"] = dimsToJson(variable.arrayDims);
+        array.append(object);
+    }
+    return array;
+}
+
+static QVector<ShaderReflectionInterfaceVariable> interfaceVariablesFromJson(const QJsonArray &array)
+{
+    QVector<ShaderReflectionInterfaceVariable> variables;
+    for (const QJsonValue &value : array) {
+        QJsonObject object = value.toObject();
+        ShaderReflectionInterfaceVariable variable;
+        variable.name = object["name"].toString();
+        variable.typeName = object["type"].toString();
+        variable.semantic = object["semantic"].toString();
+        variable.location = static_cast<uint32_t>(object["location"].toDouble());
+        variable.component = static_cast<uint32_t>(object["component"].toDouble());
+        variable.builtIn = object["builtIn"].toString();
+        variable.format = static_cast<uint32_t>(object["format"].toDouble());
+        variable.arrayDims = dimsFromJson(object["arrayDims"].toArray());
+        variables.append(variable);
+    }
+    return variables;
+}
+
+QJsonObject ShaderReflection::toJson() const
+{
+    QJsonObject json;
+    json["binaryType"] = binaryType;
+    json["sourceLanguage"] = sourceLanguage;
+
+    QJsonArray entryPointArray;
+    for (const ShaderReflectionEntryPoint &entryPoint : entryPoints) {
+        QJsonObject object;
+        object["name"] = entryPoint.name;
+        object["stage"] = entryPoint.stage;
+        object["localSize"] = QJsonArray({ static_cast<qint64>(entryPoint.localSize[0]), static_cast<qint64>(entryPoint.localSize[1]), static_cast<qint64>(entryPoint.localSize[2]) });
+        entryPointArray.append(object);
+    }
+    json["entryPoints"] = entryPointArray;
+
+    QJsonArray bindingArray;
+    for (const ShaderReflectionBinding &binding : descriptorBindings) {
+        QJsonObject object;
+        object["name"] = binding.name;
+        object["type"] = binding.typeName;
+        object["descriptorType"] = binding.descriptorType;
+        object["set"] = static_cast<qint64>(binding.set);
+        object["binding"] = static_cast<qint64>(binding.binding);
+        object["count"] = static_cast<qint64>(binding.count);
+        object["arrayDims"] = dimsToJson(binding.arrayDims);
+        object["accessed"] = binding.accessed;
+        object["blockSize"] = static_cast<qint64>(binding.blockSize);
+        object["members"] = membersToJson(binding.members);
+        bindingArray.append(object);
+    }
+    json["descriptorBindings"] = bindingArray;
+
+    json["inputs"] = interfaceVariablesToJson(inputVariables);
+    json["outputs"] = interfaceVariablesToJson(outputVariables);
+
+    QJsonArray pushConstantArray;
+    for (const ShaderReflectionPushConstant &block : pushConstants) {
+        QJsonObject object;
+        object["name"] = block.name;
+        object["type"] = block.typeName;
+        object["offset"] = static_cast<qint64>(block.offset);
+        object["size"] = static_cast<qint64>(block.size);
+        object["members"] = membersToJson(block.members);
+        pushConstantArray.append(object);
+    }
+    json["pushConstants"] = pushConstantArray;
+
+    QJsonArray specConstantArray;
+    for (const ShaderReflectionSpecConstant &constant : specConstants) {
+        QJsonObject object;
+        object["name"] = constant.name;
+        object["constantId"] = static_cast<qint64>(constant.constantId);
+        object["spirvId"] = static_cast<qint64>(constant.spirvId);
+        specConstantArray.append(object);
+    }
+    json["specConstants"] = specConstantArray;
+    json["requiredFeatures"] = QJsonArray::fromStringList(requiredFeatures);
+
+    return json;
+}
+
+bool ShaderReflection::fromJson(const QJsonObject &json)
+{
+    clear();
+    if (!json.contains("binaryType")) {
+        return false;
+    }
+
+    binaryType = json["binaryType"].toString();
+    sourceLanguage = json["sourceLanguage"].toString();
+
+    for (const QJsonValue &value : json["entryPoints"].toArray()) {
+        QJsonObject object = value.toObject();
+        ShaderReflectionEntryPoint entryPoint;
+        entryPoint.name = object["name"].toString();
+        entryPoint.stage = object["stage"].toString();
+        QJsonArray localSize = object["localSize"].toArray();
+        for (int i = 0; i < 3 && i < localSize.size(); ++i) {
+            entryPoint.localSize[i] = static_cast<uint32_t>(localSize.at(i).toDouble());
+        }
+        entryPoints.append(entryPoint);
+    }
+
+    for (const QJsonValue &value : json["descriptorBindings"].toArray()) {
+        QJsonObject object = value.toObject();
+        ShaderReflectionBinding binding;
+        binding.name = object["name"].toString();
+        binding.typeName = object["type"].toString();
+        binding.descriptorType = object["descriptorType"].toString();
+        binding.set = static_cast<uint32_t>(object["set"].toDouble());
+        binding.binding = static_cast<uint32_t>(object["binding"].toDouble());
+        binding.count = static_cast<uint32_t>(object["count"].toDouble());
+        binding.arrayDims = dimsFromJson(object["arrayDims"].toArray());
+        binding.accessed = object["accessed"].toBool();
+        binding.blockSize = static_cast<uint32_t>(object["blockSize"].toDouble());
+        binding.members = membersFromJson(object["members"].toArray());
+        descriptorBindings.append(binding);
+    }
+
+    inputVariables = interfaceVariablesFromJson(json["inputs"].toArray());
+    outputVariables = interfaceVariablesFromJson(json["outputs"].toArray());
+
+    for (const QJsonValue &value : json["pushConstants"].toArray()) {
+        QJsonObject object = value.toObject();
+        ShaderReflectionPushConstant block;
+        block.name = object["name"].toString();
+        block.typeName = object["type"].toString();
+        block.offset = static_cast<uint32_t>(object["offset"].toDouble());
+        block.size = static_cast<uint32_t>(object["size"].toDouble());
+        block.members = membersFromJson(object["members"].toArray());
+        pushConstants.append(block);
+    }
+
+    for (const QJsonValue &value : json["specConstants"].toArray()) {
+        QJsonObject object = value.toObject();
+        ShaderReflectionSpecConstant constant;
+        constant.name = object["name"].toString();
+        constant.constantId = static_cast<uint32_t>(object["constantId"].toDouble());
+        constant.spirvId = static_cast<uint32_t>(object["spirvId"].toDouble());
+        specConstants.append(constant);
+    }
+
+    for (const QJsonValue &value : json["requiredFeatures"].toArray()) {
+        requiredFeatures << value.toString();
+    }
+
+    return true;
+}
+
+// ---------------- 二进制 ----------------
+
+static void writeDims(QDataStream &stream, const QVector<uint32_t> &dims)
+{
+    stream << static_cast<quint32>(dims.size());
+    for (uint32_t dim : dims) {
+        stream << static_cast<quint32>(dim);
+    }
+}
+
+static void readDims(QDataStream &stream, QVector<uint32_t> &dims)
+{
+    quint32 count = 0;
+    stream >> count;
+    dims.clear();
+    for (quint32 i = 0; i < count && stream.status() == QDataStream::Ok; ++i) {
+        quint32 dim = 0;
+        stream >> dim;
+        dims.append(dim);
+    }
+}
+
+static void writeMembers(QDataStream &stream, const QVector<ShaderReflectionMember> &members)
+{
+    stream << static_cast<quint32>(members.size());
+    for (const ShaderReflectionMember &member : members) {
+        stream << member.name << member.typeName
+               << static_cast<quint32>(member.offset) << static_cast<quint32>(member.absoluteOffset)
+               << static_cast<quint32>(member.size) << static_cast<quint32>(member.paddedSize)
+               << static_cast<quint32>(member.arrayStride) << static_cast<quint32>(member.matrixStride)
+               << member.rowMajor << member.accessed;
+        writeDims(stream, member.arrayDims);
+        writeMembers(stream, member.members);
+    }
+}
+
+static void readMembers(QDataStream &stream, QVector<ShaderReflectionMember> &members, quint32 version)
+{
+    quint32 count = 0;
+    stream >> count;
+    members.clear();
+    for (quint32 i = 0; i < count && stream.status() == QDataStream::Ok; ++i) {
+        ShaderReflectionMember member;
+        quint32 offset = 0, absoluteOffset = 0, size = 0, paddedSize = 0, arrayStride = 0, matrixStride = 0;
+        stream >> member.name >> member.typeName >> offset >> absoluteOffset >> size >> paddedSize >> arrayStride >> matrixStride >> member.rowMajor;
+        // 版本 3 增加成员是否被读取
+        if (version >= 3) {
+            stream >> member.accessed;
+        }
+        member.offset = offset;
+        member.absoluteOffset = absoluteOffset;
+        member.size = size;
+        member.paddedSize = paddedSize;
+        member.arrayStride = arrayStride;
+        member.matrixStride = matrixStride;
+        readDims(stream, member.arrayDims);
+        readMembers(stream, member.members, version);
+        members.append(member);
+    }
+}
+
+static void writeInterfaceVariables(QDataStream &stream, const QVector<ShaderReflectionInterfaceVariable> &variables)
+{
+    stream << static_cast<quint32>(variables.size());
+    for (const ShaderReflectionInterfaceVariable &variable : variables) {
+        stream << variable.name << variable.typeName << variable.semantic
+               << static_cast<quint32>(variable.location) << static_cast<quint32>(variable.component)
+               << variable.builtIn << static_cast<quint32>(variable.format);
+        writeDims(stream, variable.arrayDims);
+    }
+}
+
+static void readInterfaceVariables(QDataStream &stream, QVector<ShaderReflectionInterfaceVariable> &variables)
+{
+    quint32 count = 0;
+    stream >> count;
+    variables.clear();
+    for (quint32 i = 0; i < count && stream.status() == QDataStream::Ok; ++i) {
+        ShaderReflectionInterfaceVariable variable;
+        quint32 location = 0, component = 0, format = 0;
+        stream >> variable.name >> variable.typeName >> variable.semantic >> location >> component >> variable.builtIn >> format;
+        variable.location = location;
+        variable.component = component;
+        variable.format = format;
+        readDims(stream, variable.arrayDims);
+        variables.append(variable);
+    }
+}
+
+QByteArray ShaderReflection::toBinary() const
+{
+    QByteArray data;
+    QDataStream stream(&data, QIODevice::WriteOnly);
+    stream.setVersion(QDataStream::Qt_5_12);
+    stream.setByteOrder(QDataStream::LittleEndian);
+
+    stream << kReflectionBinaryMagic << kReflectionBinaryVersion;
+    stream << binaryType << sourceLanguage;
+
+    stream << static_cast<quint32>(entryPoints.size());
+    for (const ShaderReflectionEntryPoint &entryPoint : entryPoints) {
+        stream << entryPoint.name << entryPoint.stage
+               << static_cast<quint32>(entryPoint.localSize[0])
+               << static_cast<quint32>(entryPoint.localSize[1])
+               << static_cast<quint32>(entryPoint.localSize[2]);
+    }
+
+    stream << static_cast<quint32>(descriptorBindings.size());
+    for (const ShaderReflectionBinding &binding : descriptorBindings) {
+        stream << binding.name << binding.typeName << binding.descriptorType
+               << static_cast<quint32>(binding.set) << static_cast<quint32>(binding.binding)
+               << static_cast<quint32>(binding.count) << binding.accessed
+               << static_cast<quint32>(binding.blockSize);
+        writeDims(stream, binding.arrayDims);
+        writeMembers(stream, binding.members);
+    }
+
+    writeInterfaceVariables(stream, inputVariables);
+    writeInterfaceVariables(stream, outputVariables);
+
+    stream << static_cast<quint32>(pushConstants.size());
+    for (const ShaderReflectionPushConstant &block : pushConstants) {
+        stream << block.name << block.typeName << static_cast<quint32>(block.offset) << static_cast<quint32>(block.size);
+        writeMembers(stream, block.members);
+    }
+
+    stream << static_cast<quint32>(specConstants.size());
+    for (const ShaderReflectionSpecConstant &constant : specConstants) {
+        stream << constant.name << static_cast<quint32>(constant.constantId) << static_cast<quint32>(constant.spirvId);
+    }
+
+    stream << requiredFeatures;
+
+    return data;
+}
+
+bool ShaderReflection::fromBinary(const QByteArray &data)
+{
+    clear();
+
+    QDataStream stream(data);
+    stream.setVersion(QDataStream::Qt_5_12);
+    stream.setByteOrder(QDataStream::LittleEndian);
+
+    quint32 magic = 0, version = 0;
+    stream >> magic >> version;
+    if (magic != kReflectionBinaryMagic || version == 0 || version > kReflectionBinaryVersion) {
+        return false;
+    }
+
+    stream >> binaryType >> sourceLanguage;
+
+    quint32 count = 0;
+    stream >> count;
+    for (quint32 i = 0; i < count && stream.status() == QDataStream::Ok; ++i) {
+        ShaderReflectionEntryPoint entryPoint;
+        quint32 x = 0, y = 0, z = 0;
+        stream >> entryPoint.name >> entryPoint.stage >> x >> y >> z;
+        entryPoint.localSize[0] = x;
+        entryPoint.localSize[1] = y;
+        entryPoint.localSize[2] = z;
+        entryPoints.append(entryPoint);
+    }
+
+    stream >> count;
+    for (quint32 i = 0; i < count && stream.status() == QDataStream::Ok; ++i) {
+        ShaderReflectionBinding binding;
+        quint32 set = 0, bindingIndex = 0, bindingCount = 0, blockSize = 0;
+        stream >> binding.name >> binding.typeName >> binding.descriptorType >> set >> bindingIndex >> bindingCount >> binding.accessed >> blockSize;
+        binding.set = set;
+        binding.binding = bindingIndex;
+        binding.count = bindingCount;
+        binding.blockSize = blockSize;
+        readDims(stream, binding.arrayDims);
+        readMembers(stream, binding.members, version);
+        descriptorBindings.append(binding);
+    }
+
+    readInterfaceVariables(stream, inputVariables);
+    readInterfaceVariables(stream, outputVariables);
+
+    stream >> count;
+    for (quint32 i = 0; i < count && stream.status() == QDataStream::Ok; ++i) {
+        ShaderReflectionPushConstant block;
+        quint32 offset = 0, size = 0;
+        stream >> block.name >> block.typeName >> offset >> size;
+        block.offset = offset;
+        block.size = size;
+        readMembers(stream, block.members, version);
+        pushConstants.append(block);
+    }
+
+    stream >> count;
+    for (quint32 i = 0; i < count && stream.status() == QDataStream::Ok; ++i) {
+        ShaderReflectionSpecConstant constant;
+        quint32 constantId = 0, spirvId = 0;
+        stream >> constant.name >> constantId >> spirvId;
+        constant.constantId = constantId;
+        constant.spirvId = spirvId;
+        specConstants.append(constant);
+    }
+
+    // 版本 2 增加 DXIL 所需特性
+    if (version >= 2) {
+        stream >> requiredFeatures;
+    }
+
+    return stream.status() == QDataStream::Ok;
+}
+
+bool ShaderReflection::saveToFile(const QString &filePath) const
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+
+    QByteArray data = filePath.endsWith(".json", Qt::CaseInsensitive) ? QJsonDocument(toJson()).toJson(QJsonDocument::Indented) : toBinary();
+    bool success = file.write(data) == data.size();
+    file.close();
+    return success;
+}
@@ -0,0 +1,123 @@
+#ifndef SHADERREFLECTION_H
+#define SHADERREFLECTION_H
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QByteArray>
+#include <QJsonObject>
+#include <cstdint>
+#include <cstddef>
+
+// 结构体成员（cbuffer/uniform block/push constant 成员），成员为结构体时递归保存子成员
+struct ShaderReflectionMember
+{
+    QString name; // 成员名称
+    QString typeName; // 类型名称，如 vec4、mat4、float3x3、结构体名
+    uint32_t offset = 0; // 相对父结构体的偏移（字节）
+    uint32_t absoluteOffset = 0; // 相对块起始的偏移（字节）
+    uint32_t size = 0; // 大小（字节）
+    uint32_t paddedSize = 0; // 含尾部填充的大小（字节）
+    QVector<uint32_t> arrayDims; // 数组维度，空表示非数组
+    uint32_t arrayStride = 0; // 数组步长（字节）
+    uint32_t matrixStride = 0; // 矩阵步长（字节）
+    bool rowMajor = false; // 是否行主序
+    bool accessed = true; // 是否被着色器读取
+    QVector<ShaderReflectionMember> members; // 子成员
+};
+
+// 描述符绑定（SPIR-V descriptor binding / DXIL 资源绑定）
+struct ShaderReflectionBinding
+{
+    QString name; // 变量名称
+    QString typeName; // 类型名称
+    QString descriptorType; // 描述符类型，如 Uniform Buffer、Sampled Image、CBV、SRV
+    uint32_t set = 0; // descriptor set / register space
+    uint32_t binding = 0; // binding / register
+    uint32_t count = 1; // 数组元素数量
+    QVector<uint32_t> arrayDims; // 数组维度
+    bool accessed = true; // 是否被入口函数访问
+    uint32_t blockSize = 0; // 缓冲区块大小（字节），非缓冲区为 0
+    QVector<ShaderReflectionMember> members; // 缓冲区块成员
+};
+
+// 输入/输出变量
+struct ShaderReflectionInterfaceVariable
+{
+    QString name; // 变量名称
+    QString typeName; // 类型名称
+    QString semantic; // HLSL 语义，GLSL 为空
+    uint32_t location = 0; // location / 语义索引
+    uint32_t component = 0; // component
+    QString builtIn; // 内置变量名称，非内置为空
+    uint32_t format = 0; // 对应的 VkFormat 值
+    QVector<uint32_t> arrayDims; // 数组维度
+};
+
+// push constant 块
+struct ShaderReflectionPushConstant
+{
+    QString name; // 块名称
+    QString typeName; // 类型名称
+    uint32_t offset = 0; // 最小成员偏移（字节）
+    uint32_t size = 0; // 大小（字节）
+    QVector<ShaderReflectionMember> members; // 成员
+};
+
+// 特化常量
+struct ShaderReflectionSpecConstant
+{
+    QString name; // 常量名称
+    uint32_t constantId = 0; // SpecId
+    uint32_t spirvId = 0; // SPIR-V result id
+};
+
+// 入口函数
+struct ShaderReflectionEntryPoint
+{
+    QString name; // 入口函数名称
+    QString stage; // 着色器阶段，如 Vertex、Pixel、Compute
+    uint32_t localSize[3] = { 0, 0, 0 }; // 计算着色器线程组大小
+};
+
+// ShaderReflection 为 SPIR-V 及 DXIL 共用的反射数据模型，可导出为 JSON 或紧凑的二进制格式。
+class ShaderReflection
+{
+public:
+    ShaderReflection();
+
+    // 从内存中的 SPIR-V 字节码反射，不复制字节码；words 在调用期间必须保持有效
+    bool reflectSpirv(const uint32_t *words, size_t wordCount, QString *error = nullptr);
+
+    // DXIL 反射由 dxilUtils 通过 IDxcUtils::CreateReflection 填充
+
+    // 清空反射数据，保留容器容量以便复用
+    void clear();
+
+    // 文本摘要，用于输出窗口
+    QString toText() const;
+
+    // 导出/导入 JSON
+    QJsonObject toJson() const;
+    bool fromJson(const QJsonObject &json);
+
+    // 导出/导入二进制格式（QDataStream，带文件头及版本号）
+    QByteArray toBinary() const;
+    bool fromBinary(const QByteArray &data);
+
+    // 按文件扩展名保存，.json 为 JSON，其余为二进制
+    bool saveToFile(const QString &filePath) const;
+
+public:
+    QString binaryType; // SPIR-V 或 DXIL
+    QString sourceLanguage; // 源语言
+    QVector<ShaderReflectionEntryPoint> entryPoints;
+    QVector<ShaderReflectionBinding> descriptorBindings;
+    QVector<ShaderReflectionInterfaceVariable> inputVariables;
+    QVector<ShaderReflectionInterfaceVariable> outputVariables;
+    QVector<ShaderReflectionPushConstant> pushConstants;
+    QVector<ShaderReflectionSpecConstant> specConstants;
+    QStringList requiredFeatures; // DXIL 需要的可选硬件特性，如 Wave Ops、Native 16-bit Ops
+};
+
+#endif // SHADERREFLECTION_H
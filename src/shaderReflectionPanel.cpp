@@ -0,0 +1,130 @@
+#include "shaderReflectionPanel.h"
+#include <QtWidgets/QVBoxLayout>
+#include <QtWidgets/QHeaderView>
+
+// 构造函数，初始化反射面板。
+ShaderReflectionPanel::ShaderReflectionPanel(QWidget *parent)
+    : QWidget(parent)
+{
+    QVBoxLayout *mainLayout = new QVBoxLayout(this);
+    mainLayout->setContentsMargins(0, 0, 0, 0);
+
+    reflectionTree = new QTreeWidget(this);
+    reflectionTree->setColumnCount(4);
+    reflectionTree->setHeaderLabels(QStringList() << tr("Name") << tr("Type") << tr("Location") << tr("Detail"));
+    reflectionTree->header()->setSectionResizeMode(QHeaderView::ResizeToContents);
+    reflectionTree->setStyleSheet("QTreeWidget { font-family: 'Consolas', monospace; }");
+    mainLayout->addWidget(reflectionTree);
+}
+
+QTreeWidgetItem *ShaderReflectionPanel::addItem(QTreeWidgetItem *parent, const QString &name, const QString &type, const QString &location, const QString &detail)
+{
+    QTreeWidgetItem *item = new QTreeWidgetItem(QStringList() << name << type << location << detail);
+    if (parent) {
+        parent->addChild(item);
+    } else {
+        reflectionTree->addTopLevelItem(item);
+    }
+    return item;
+}
+
+static QString arrayDimsText(const QVector<uint32_t> &dims)
+{
+    QString text;
+    for (uint32_t dim : dims) {
+        text += dim == 0 ? QString("[]") : QString("[%1]").arg(dim);
+    }
+    return text;
+}
+
+void ShaderReflectionPanel::addMembers(QTreeWidgetItem *parent, const QVector<ShaderReflectionMember> &members)
+{
+    for (const ShaderReflectionMember &member : members) {
+        QString detail = QString("size %1").arg(member.size);
+        if (member.arrayStride > 0) {
+            detail += QString(", array stride %1").arg(member.arrayStride);
+        }
+        if (member.matrixStride > 0) {
+            detail += QString(", matrix stride %1%2").arg(member.matrixStride).arg(member.rowMajor ? ", row major" : "");
+        }
+
+        QTreeWidgetItem *item = addItem(parent, member.name + arrayDimsText(member.arrayDims), member.typeName, QString("offset %1").arg(member.absoluteOffset), detail);
+        addMembers(item, member.members);
+    }
+}
+
+void ShaderReflectionPanel::addReflection(const ShaderReflection &reflection)
+{
+    bool isDxil = reflection.binaryType == "DXIL";
+
+    QString stage = reflection.entryPoints.isEmpty() ? QString() : reflection.entryPoints.first().stage;
+    QString entryName = reflection.entryPoints.isEmpty() ? QString() : reflection.entryPoints.first().name;
+    QTreeWidgetItem *root = addItem(nullptr, entryName.isEmpty() ? stage : QString("%1 (%2)").arg(entryName).arg(stage), reflection.binaryType, QString(), reflection.sourceLanguage);
+
+    if (!reflection.descriptorBindings.isEmpty()) {
+        QTreeWidgetItem *group = addItem(root, isDxil ? tr("Resource Bindings") : tr("Descriptor Bindings"));
+        for (const ShaderReflectionBinding &binding : reflection.descriptorBindings) {
+            QString location = isDxil ? QString("register %1, space %2").arg(binding.binding).arg(binding.set)
+                                      : QString("binding %1, set %2").arg(binding.binding).arg(binding.set);
+            QString detail = binding.descriptorType;
+            if (binding.blockSize > 0) {
+                detail += QString(", size %1").arg(binding.blockSize);
+            }
+            if (!binding.accessed) {
+                detail += ", unused";
+            }
+
+            QTreeWidgetItem *item = addItem(group, binding.name + arrayDimsText(binding.arrayDims), binding.typeName, location, detail);
+            addMembers(item, binding.members);
+        }
+    }
+
+    if (!reflection.pushConstants.isEmpty()) {
+        QTreeWidgetItem *group = addItem(root, tr("Push Constants"));
+        for (const ShaderReflectionPushConstant &block : reflection.pushConstants) {
+            QTreeWidgetItem *item = addItem(group, block.name, block.typeName, QString("offset %1").arg(block.offset), QString("size %1").arg(block.size));
+            addMembers(item, block.members);
+        }
+    }
+
+    const QVector<ShaderReflectionInterfaceVariable> *interfaces[2] = { &reflection.inputVariables, &reflection.outputVariables };
+    const QString interfaceNames[2] = { tr("Inputs"), tr("Outputs") };
+    for (int i = 0; i < 2; ++i) {
+        if (interfaces[i]->isEmpty()) {
+            continue;
+        }
+
+        QTreeWidgetItem *group = addItem(root, interfaceNames[i]);
+        for (const ShaderReflectionInterfaceVariable &variable : *interfaces[i]) {
+            QString location = variable.builtIn.isEmpty() || isDxil ? QString("%1 %2").arg(isDxil ? "register" : "location").arg(variable.location) : QString();
+            addItem(group, variable.name + arrayDimsText(variable.arrayDims), variable.typeName, location, variable.builtIn);
+        }
+    }
+
+    if (!reflection.specConstants.isEmpty()) {
+        QTreeWidgetItem *group = addItem(root, tr("Specialization Constants"));
+        for (const ShaderReflectionSpecConstant &constant : reflection.specConstants) {
+            addItem(group, constant.name, QString(), QString("constant_id %1").arg(constant.constantId));
+        }
+    }
+
+    for (const ShaderReflectionEntryPoint &entryPoint : reflection.entryPoints) {
+        if (entryPoint.localSize[0] > 0) {
+            addItem(root, tr("Workgroup Size"), QString(), QString(), QString("%1 x %2 x %3").arg(entryPoint.localSize[0]).arg(entryPoint.localSize[1]).arg(entryPoint.localSize[2]));
+        }
+    }
+
+    if (!reflection.requiredFeatures.isEmpty()) {
+        QTreeWidgetItem *group = addItem(root, tr("Required Features"));
+        for (const QString &feature : reflection.requiredFeatures) {
+            addItem(group, feature);
+        }
+    }
+
+    root->setExpanded(true);
+}
+
+void ShaderReflectionPanel::clear()
+{
+    reflectionTree->clear();
+}
@@ -0,0 +1,29 @@
+#ifndef SHADERREFLECTIONPANEL_H
+#define SHADERREFLECTIONPANEL_H
+
+#include <QtWidgets/QWidget>
+#include <QtWidgets/QTreeWidget>
+#include "shaderReflection.h"
+
+// ShaderReflectionPanel 以树形结构显示 SPIR-V/DXIL 反射数据，编译所有阶段时每个阶段一个顶层节点。
+class ShaderReflectionPanel : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit ShaderReflectionPanel(QWidget *parent = nullptr);
+
+    // 添加一个阶段的反射数据
+    void addReflection(const ShaderReflection &reflection);
+
+    // 清空显示
+    void clear();
+
+private:
+    QTreeWidgetItem *addItem(QTreeWidgetItem *parent, const QString &name, const QString &type = QString(), const QString &location = QString(), const QString &detail = QString());
+    void addMembers(QTreeWidgetItem *parent, const QVector<ShaderReflectionMember> &members);
+
+    QTreeWidget *reflectionTree;
+};
+
+#endif // SHADERREFLECTIONPANEL_H
@@ -0,0 +1,204 @@
+#include "specConstantVariantDialog.h"
+#include "shaderIntermediateCache.h"
+#include <QtWidgets/QVBoxLayout>
+#include <QtWidgets/QHBoxLayout>
+#include <QtWidgets/QTextEdit>
+#include <QtWidgets/QHeaderView>
+#include <QtWidgets/QDialogButtonBox>
+#include <QtWidgets/QApplication>
+#include <QtWidgets/QFileDialog>
+#include <QtWidgets/QMessageBox>
+#include <QDir>
+#include <QFile>
+#include <QTextStream>
+
+namespace {
+
+const int kMaxVariants = 256;
+
+} // namespace
+
+// 构造函数，初始化特化常量变体对话框。
+SpecConstantVariantDialog::SpecConstantVariantDialog(const QByteArray &module, const QVector<SpecConstantAxis> &axes, double frontEndSeconds,
+                                                     const QVector<MacroAxisAnalysis> &macroAnalysis, const QStringList &savedValues, QWidget *parent)
+    : QDialog(parent), module(module), axes(axes), frontEndSeconds(frontEndSeconds)
+{
+    setWindowTitle(tr("Specialization Constant Variants"));
+    resize(1000, 750);
+
+    QVBoxLayout *mainLayout = new QVBoxLayout(this);
+
+    // 特化常量轴，取值列可编辑，逗号分隔
+    mainLayout->addWidget(new QLabel(tr("Specialization constants (values are comma separated):"), this));
+    axisTable = new QTableWidget(this);
+    axisTable->setColumnCount(5);
+    axisTable->setHorizontalHeaderLabels(QStringList() << tr("SpecId") << tr("Name") << tr("Type") << tr("Default") << tr("Values"));
+    axisTable->horizontalHeader()->setSectionResizeMode(QHeaderView::ResizeToContents);
+    axisTable->horizontalHeader()->setStretchLastSection(true);
+    axisTable->verticalHeader()->setVisible(false);
+    axisTable->setRowCount(axes.size());
+    for (int i = 0; i < axes.size(); ++i) {
+        QStringList values = axes[i].values;
+        QString savedPrefix = QString("%1=").arg(axes[i].specId);
+        for (const QString &saved : savedValues) {
+            if (saved.startsWith(savedPrefix)) {
+                values = saved.mid(savedPrefix.size()).split(',', QString::SkipEmptyParts);
+            }
+        }
+
+        QTableWidgetItem *items[] = {
+            new QTableWidgetItem(QString::number(axes[i].specId)), new QTableWidgetItem(axes[i].name),
+            new QTableWidgetItem(axes[i].typeName), new QTableWidgetItem(axes[i].defaultValue)
+        };
+        for (int column = 0; column < 4; ++column) {
+            items[column]->setFlags(items[column]->flags() & ~Qt::ItemIsEditable);
+            axisTable->setItem(i, column, items[column]);
+        }
+        axisTable->setItem(i, 4, new QTableWidgetItem(values.join(",")));
+    }
+    axisTable->setMaximumHeight(180);
+    mainLayout->addWidget(axisTable);
+
+    // 宏分析
+    QString macroText;
+    for (const MacroAxisAnalysis &analysis : macroAnalysis) {
+        macroText += QString("%1  %2: %3\n").arg(analysis.convertible ? "[spec constant]" : "[keep macro]   ")
+            .arg(analysis.macro).arg(analysis.reasons.join("; "));
+    }
+    mainLayout->addWidget(new QLabel(tr("Macro axes:"), this));
+    QTextEdit *macroEdit = new QTextEdit(this);
+    macroEdit->setReadOnly(true);
+    macroEdit->setLineWrapMode(QTextEdit::NoWrap);
+    macroEdit->setStyleSheet("QTextEdit { font-family: 'Consolas', monospace; }");
+    macroEdit->setPlainText(macroText.isEmpty() ? tr("No macro used for conditional compilation.") : macroText);
+    macroEdit->setMaximumHeight(120);
+    mainLayout->addWidget(macroEdit);
+
+    QHBoxLayout *runLayout = new QHBoxLayout();
+    runLayout->addWidget(new QLabel(tr("spirv-opt"), this));
+    optimizeEdit = new QLineEdit("-O", this);
+    runLayout->addWidget(optimizeEdit, 1);
+    QPushButton *runButton = new QPushButton(tr("Run"), this);
+    runButton->setEnabled(!axes.isEmpty());
+    runLayout->addWidget(runButton);
+    mainLayout->addLayout(runLayout);
+
+    variantTable = new QTableWidget(this);
+    variantTable->setColumnCount(6);
+    variantTable->setHorizontalHeaderLabels(QStringList() << tr("Variant") << tr("Instructions") << tr("Weighted Cost")
+        << tr("Size (bytes)") << tr("Time (ms)") << tr("Status"));
+    variantTable->horizontalHeader()->setSectionResizeMode(QHeaderView::ResizeToContents);
+    variantTable->verticalHeader()->setVisible(false);
+    variantTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    variantTable->setSelectionBehavior(QAbstractItemView::SelectRows);
+    mainLayout->addWidget(variantTable, 1);
+
+    summaryLabel = new QLabel(axes.isEmpty() ? tr("The module has no specialization constant.") : QString(), this);
+    summaryLabel->setWordWrap(true);
+    mainLayout->addWidget(summaryLabel);
+
+    QDialogButtonBox *buttonBox = new QDialogButtonBox(QDialogButtonBox::Close, Qt::Horizontal, this);
+    saveButton = buttonBox->addButton(tr("Save Variants..."), QDialogButtonBox::ActionRole);
+    saveButton->setEnabled(false);
+    mainLayout->addWidget(buttonBox);
+
+    connect(runButton, &QPushButton::clicked, this, &SpecConstantVariantDialog::runVariants);
+    connect(saveButton, &QPushButton::clicked, this, &SpecConstantVariantDialog::saveVariants);
+    connect(buttonBox, &QDialogButtonBox::rejected, this, &QDialog::reject);
+}
+
+QVector<SpecConstantAxis> SpecConstantVariantDialog::currentAxes() const
+{
+    QVector<SpecConstantAxis> result = axes;
+    for (int i = 0; i < result.size(); ++i) {
+        QTableWidgetItem *item = axisTable->item(i, 4);
+        result[i].values = item ? item->text().split(',', QString::SkipEmptyParts) : QStringList();
+        for (QString &value : result[i].values) {
+            value = value.trimmed();
+        }
+    }
+    return result;
+}
+
+QStringList SpecConstantVariantDialog::axisValues() const
+{
+    QStringList values;
+    for (const SpecConstantAxis &axis : currentAxes()) {
+        values << QString("%1=%2").arg(axis.specId).arg(axis.values.join(","));
+    }
+    return values;
+}
+
+void SpecConstantVariantDialog::runVariants()
+{
+    QVector<SpecConstantAxis> variantAxes = currentAxes();
+    QVector<QMap<uint32_t, QString>> valueSets = SpecConstantVariants::expand(variantAxes, kMaxVariants);
+
+    QApplication::setOverrideCursor(Qt::WaitCursor);
+    variants = SpecConstantVariants::specializeAll(module, variantAxes, valueSets, optimizeEdit->text().trimmed());
+    QApplication::restoreOverrideCursor();
+
+    variantTable->setRowCount(0);
+    double totalSeconds = 0;
+    int successCount = 0;
+    for (int i = 0; i < variants.size(); ++i) {
+        const SpecConstantVariant &variant = variants[i];
+        variantTable->insertRow(i);
+        variantTable->setItem(i, 0, new QTableWidgetItem(SpecConstantVariants::variantLabel(variantAxes, variant.values)));
+        variantTable->setItem(i, 4, new QTableWidgetItem(QString::number(variant.seconds * 1000.0, 'f', 1)));
+        totalSeconds += variant.seconds;
+        if (!variant.success) {
+            QTableWidgetItem *statusItem = new QTableWidgetItem(tr("Failed"));
+            statusItem->setToolTip(variant.error);
+            statusItem->setForeground(Qt::red);
+            variantTable->setItem(i, 5, statusItem);
+            continue;
+        }
+
+        ++successCount;
+        variantTable->setItem(i, 1, new QTableWidgetItem(QString::number(variant.instructionCount, 'f', 0)));
+        variantTable->setItem(i, 2, new QTableWidgetItem(QString::number(variant.weightedCost, 'f', 0)));
+        variantTable->setItem(i, 3, new QTableWidgetItem(QString::number(variant.binarySize)));
+        variantTable->setItem(i, 5, new QTableWidgetItem(tr("OK")));
+    }
+
+    // 与逐个变体完整编译前端的耗时比较
+    QString summary = tr("%1 of %2 variants specialized, %3 ms in total (%4 ms each). Front-end compile: %5 ms, "
+                         "a full compile per variant would take about %6 ms.")
+        .arg(successCount).arg(variants.size())
+        .arg(totalSeconds * 1000.0, 0, 'f', 1)
+        .arg(variants.isEmpty() ? 0.0 : totalSeconds * 1000.0 / variants.size(), 0, 'f', 1)
+        .arg(frontEndSeconds * 1000.0, 0, 'f', 1)
+        .arg(frontEndSeconds * 1000.0 * variants.size(), 0, 'f', 0);
+    if (valueSets.size() >= kMaxVariants) {
+        summary += tr(" Only the first %1 variants were generated.").arg(kMaxVariants);
+    }
+    summaryLabel->setText(summary);
+    saveButton->setEnabled(successCount > 0);
+}
+
+void SpecConstantVariantDialog::saveVariants()
+{
+    QString directory = QFileDialog::getExistingDirectory(this, tr("Save Variants"));
+    if (directory.isEmpty()) {
+        return;
+    }
+
+    // 每个变体一个 .spv，variants.txt 记录文件与取值的对应关系
+    QDir dir(directory);
+    QFile indexFile(dir.filePath("variants.txt"));
+    if (!indexFile.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        QMessageBox::warning(this, windowTitle(), tr("Failed to write %1").arg(indexFile.fileName()));
+        return;
+    }
+    QTextStream index(&indexFile);
+    QVector<SpecConstantAxis> variantAxes = currentAxes();
+    for (int i = 0; i < variants.size(); ++i) {
+        if (!variants[i].success) {
+            continue;
+        }
+        QString fileName = QString("variant_%1.spv").arg(i);
+        ShaderIntermediateCache::writeBlob(dir.filePath(fileName), variants[i].binary);
+        index << fileName << ": " << SpecConstantVariants::variantLabel(variantAxes, variants[i].values) << "\n";
+    }
+}
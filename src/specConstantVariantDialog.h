@@ -0,0 +1,44 @@
+#ifndef SPECCONSTANTVARIANTDIALOG_H
+#define SPECCONSTANTVARIANTDIALOG_H
+
+#include <QtWidgets/QDialog>
+#include <QtWidgets/QTableWidget>
+#include <QtWidgets/QLineEdit>
+#include <QtWidgets/QLabel>
+#include <QtWidgets/QPushButton>
+#include "specConstantVariants.h"
+
+// SpecConstantVariantDialog 编辑特化常量的变体取值，对一次编译出的 SPIR-V 逐个特化并显示代价，
+// 同时列出哪些宏可以改写为特化常量。
+class SpecConstantVariantDialog : public QDialog
+{
+    Q_OBJECT
+
+public:
+    // savedValues 为上次的取值，每项 "SpecId=值1,值2"
+    SpecConstantVariantDialog(const QByteArray &module, const QVector<SpecConstantAxis> &axes, double frontEndSeconds,
+                              const QVector<MacroAxisAnalysis> &macroAnalysis, const QStringList &savedValues, QWidget *parent = nullptr);
+
+    // 当前的取值，格式同 savedValues
+    QStringList axisValues() const;
+
+private slots:
+    void runVariants();
+    void saveVariants();
+
+private:
+    QVector<SpecConstantAxis> currentAxes() const;
+
+    QByteArray module;
+    QVector<SpecConstantAxis> axes;
+    double frontEndSeconds;
+    QVector<SpecConstantVariant> variants;
+
+    QTableWidget *axisTable;
+    QLineEdit *optimizeEdit;
+    QTableWidget *variantTable;
+    QLabel *summaryLabel;
+    QPushButton *saveButton;
+};
+
+#endif // SPECCONSTANTVARIANTDIALOG_H
@@ -0,0 +1,329 @@
+#include "SPIRV-Reflect/include/spirv/unified1/spirv.h"
+#include "specConstantVariants.h"
+#include "spirvModule.h"
+#include "spirvPassPipeline.h"
+#include "shaderCostAnalyzer.h"
+#include <QRegularExpression>
+#include <QThread>
+#include <QElapsedTimer>
+#include <QSet>
+#include <cstring>
+#include <future>
+#include <vector>
+
+namespace {
+
+// 代码块的种类，用于区分函数体与结构体、常量缓冲区等声明
+enum class BlockKind { Function, Declaration };
+
+QString normalizedValue(const SpecConstantAxis &axis, const QString &value)
+{
+    QString trimmed = value.trimmed();
+    if (axis.typeName == "bool") {
+        return (trimmed == "0" || trimmed.compare("false", Qt::CaseInsensitive) == 0) ? QString("false") : QString("true");
+    }
+    return trimmed;
+}
+
+// 去掉注释，保留换行以维持行号
+QString stripComments(const QString &source)
+{
+    QString result;
+    result.reserve(source.size());
+    bool inBlockComment = false;
+    bool inLineComment = false;
+    for (int i = 0; i < source.size(); ++i) {
+        QChar c = source[i];
+        QChar next = i + 1 < source.size() ? source[i + 1] : QChar();
+        if (inBlockComment) {
+            if (c == '*' && next == '/') {
+                inBlockComment = false;
+                ++i;
+            } else if (c == '\n') {
+                result += c;
+            }
+        } else if (inLineComment) {
+            if (c == '\n') {
+                inLineComment = false;
+                result += c;
+            }
+        } else if (c == '/' && next == '*') {
+            inBlockComment = true;
+            ++i;
+        } else if (c == '/' && next == '/') {
+            inLineComment = true;
+            ++i;
+        } else {
+            result += c;
+        }
+    }
+    return result;
+}
+
+} // namespace
+
+QVector<SpecConstantAxis> SpecConstantVariants::axes(const SpirvModule &module)
+{
+    QVector<SpecConstantAxis> result;
+    for (uint32_t id : module.constantIds()) {
+        int index = module.definition(id);
+        if (index < 0) {
+            continue;
+        }
+        const SpirvModule::Instruction &inst = module.instruction(index);
+        uint32_t specId = 0;
+        if ((inst.opcode != SpvOpSpecConstantTrue && inst.opcode != SpvOpSpecConstantFalse && inst.opcode != SpvOpSpecConstant)
+            || !module.hasDecoration(id, SpvDecorationSpecId, &specId)) {
+            continue;
+        }
+
+        int typeIndex = module.definition(inst.resultType);
+        if (typeIndex < 0) {
+            continue;
+        }
+        const SpirvModule::Instruction &type = module.instruction(typeIndex);
+
+        SpecConstantAxis axis;
+        axis.specId = specId;
+        axis.name = module.name(id).isEmpty() ? QString("SpecId %1").arg(specId) : module.name(id);
+        uint32_t value = module.operand(inst, 2);
+        if (type.opcode == SpvOpTypeBool) {
+            axis.typeName = "bool";
+            axis.defaultValue = inst.opcode == SpvOpSpecConstantTrue ? "true" : "false";
+            axis.values << "false" << "true";
+        } else if (type.opcode == SpvOpTypeInt && module.operand(type, 1) == 32) {
+            bool isSigned = module.operand(type, 2) != 0;
+            axis.typeName = isSigned ? "int" : "uint";
+            axis.defaultValue = isSigned ? QString::number(static_cast<int32_t>(value)) : QString::number(value);
+            axis.values << axis.defaultValue;
+        } else if (type.opcode == SpvOpTypeFloat && module.operand(type, 1) == 32) {
+            float floatValue = 0.0f;
+            std::memcpy(&floatValue, &value, sizeof(floatValue));
+            axis.typeName = "float";
+            // 9 位有效数字可以精确还原 32 位浮点数，默认值变体才与模块中的默认值一致
+            axis.defaultValue = QString::number(floatValue, 'g', 9);
+            axis.values << axis.defaultValue;
+        } else {
+            continue;
+        }
+        result.append(axis);
+    }
+    return result;
+}
+
+QVector<QMap<uint32_t, QString>> SpecConstantVariants::expand(const QVector<SpecConstantAxis> &axes, int maxVariants)
+{
+    QVector<QMap<uint32_t, QString>> valueSets;
+    valueSets.append(QMap<uint32_t, QString>());
+    for (const SpecConstantAxis &axis : axes) {
+        QStringList values = axis.values.isEmpty() ? QStringList() << axis.defaultValue : axis.values;
+        QVector<QMap<uint32_t, QString>> expanded;
+        for (const QMap<uint32_t, QString> &valueSet : valueSets) {
+            for (const QString &value : values) {
+                if (expanded.size() >= maxVariants) {
+                    break;
+                }
+                QMap<uint32_t, QString> next = valueSet;
+                next.insert(axis.specId, normalizedValue(axis, value));
+                expanded.append(next);
+            }
+        }
+        valueSets = expanded;
+    }
+    return valueSets;
+}
+
+QString SpecConstantVariants::variantLabel(const QVector<SpecConstantAxis> &axes, const QMap<uint32_t, QString> &values)
+{
+    QStringList parts;
+    for (const SpecConstantAxis &axis : axes) {
+        if (values.contains(axis.specId)) {
+            parts << QString("%1=%2").arg(axis.name).arg(values.value(axis.specId));
+        }
+    }
+    return parts.join(", ");
+}
+
+SpecConstantVariant SpecConstantVariants::specialize(const QByteArray &module, const QVector<SpecConstantAxis> &axes,
+                                                     const QMap<uint32_t, QString> &values, const QString &optimizeOptions,
+                                                     const QString &tempFileTag)
+{
+    SpecConstantVariant variant;
+    variant.values = values;
+
+    // 设置默认值后冻结为普通常量，再折叠常量、删除死分支并优化
+    QStringList defaults;
+    for (const SpecConstantAxis &axis : axes) {
+        defaults << QString("%1:%2").arg(axis.specId).arg(values.value(axis.specId, axis.defaultValue));
+    }
+    QString options = QString("--set-spec-const-default-value \"%1\" --freeze-spec-const --fold-spec-const-op-composite --ccp --eliminate-dead-branches %2")
+        .arg(defaults.join(" ")).arg(optimizeOptions).trimmed();
+
+    if (!SpirvPassPipeline::optimize(module, options, variant.binary, variant.error, &variant.seconds, tempFileTag)) {
+        return variant;
+    }
+
+    SpirvModule specialized;
+    if (!specialized.parse(variant.binary, &variant.error)) {
+        return variant;
+    }
+
+    variant.success = true;
+    variant.binarySize = variant.binary.size();
+    ShaderCostReport report = ShaderCostAnalyzer::analyzeSpirv(specialized);
+    for (const ShaderFunctionCost &function : report.functions) {
+        variant.instructionCount += function.staticCounts.total();
+        if (!function.stage.isEmpty()) {
+            variant.weightedCost += function.weightedCounts.weightedCost();
+        }
+    }
+    return variant;
+}
+
+QVector<SpecConstantVariant> SpecConstantVariants::specializeAll(const QByteArray &module, const QVector<SpecConstantAxis> &axes,
+                                                                 const QVector<QMap<uint32_t, QString>> &valueSets, const QString &optimizeOptions)
+{
+    // 按 CPU 核数分批并行，避免一次启动过多 spirv-opt 进程
+    QVector<SpecConstantVariant> variants;
+    int batchSize = qMax(1, QThread::idealThreadCount());
+    for (int start = 0; start < valueSets.size(); start += batchSize) {
+        std::vector<std::future<SpecConstantVariant>> futures;
+        for (int i = start; i < qMin(start + batchSize, valueSets.size()); ++i) {
+            const QMap<uint32_t, QString> &values = valueSets[i];
+            QString tempFileTag = QString("_variant_%1").arg(i);
+            futures.push_back(std::async(std::launch::async, [&module, &axes, &values, &optimizeOptions, tempFileTag]() {
+                return specialize(module, axes, values, optimizeOptions, tempFileTag);
+            }));
+        }
+        for (auto &future : futures) {
+            variants.append(future.get());
+        }
+    }
+    return variants;
+}
+
+QVector<MacroAxisAnalysis> SpecConstantVariants::analyzeMacros(const QString &source, const QStringList &macros)
+{
+    QStringList lines = stripComments(source).split('\n');
+    QRegularExpression identifierPattern("\\b[A-Za-z_][A-Za-z0-9_]*\\b");
+    QRegularExpression conditionalPattern("^\\s*#\\s*(if|ifdef|ifndef|elif)\\b(.*)$");
+    QRegularExpression definePattern("^\\s*#\\s*define\\s+([A-Za-z_][A-Za-z0-9_]*)(.*)$");
+
+    // 候选宏：宏列表中的名称及条件编译中出现、源码内未定义的名称
+    QStringList candidates;
+    QSet<QString> definedInSource;
+    for (const QString &line : lines) {
+        QRegularExpressionMatch match = definePattern.match(line);
+        if (match.hasMatch()) {
+            definedInSource.insert(match.captured(1));
+        }
+    }
+    for (const QString &macro : macros) {
+        QString name = macro.split('=').value(0).trimmed();
+        if (!name.isEmpty() && !candidates.contains(name)) {
+            candidates << name;
+        }
+    }
+    for (const QString &line : lines) {
+        QRegularExpressionMatch match = conditionalPattern.match(line);
+        if (!match.hasMatch()) {
+            continue;
+        }
+        QRegularExpressionMatchIterator it = identifierPattern.globalMatch(match.captured(2));
+        while (it.hasNext()) {
+            QString name = it.next().captured(0);
+            if (name != "defined" && !definedInSource.contains(name) && !candidates.contains(name)) {
+                candidates << name;
+            }
+        }
+    }
+
+    QVector<MacroAxisAnalysis> results;
+    for (const QString &name : candidates) {
+        MacroAxisAnalysis analysis;
+        analysis.macro = name;
+        QRegularExpression namePattern(QString("\\b%1\\b").arg(QRegularExpression::escape(name)));
+        QRegularExpression arraySizePattern(QString("\\[[^\\]]*\\b%1\\b").arg(QRegularExpression::escape(name)));
+        QRegularExpression attributePattern(QString("(numthreads|register|packoffset|binding|set|location|local_size_[xyz])\\s*[(=][^)]*\\b%1\\b")
+                                                .arg(QRegularExpression::escape(name)));
+
+        QSet<QString> blockers;
+        bool selectsFunctionCode = false;
+        bool usedAsValue = false;
+
+        QVector<BlockKind> blockStack;
+        QString pendingCode; // 上一个 ; { } 之后的代码，用于判断 { 开始的是函数体还是声明
+        for (int lineIndex = 0; lineIndex < lines.size(); ++lineIndex) {
+            const QString &line = lines[lineIndex];
+            bool inFunction = blockStack.contains(BlockKind::Function);
+            bool mentions = namePattern.match(line).hasMatch();
+
+            if (line.trimmed().startsWith('#')) {
+                if (mentions) {
+                    if (conditionalPattern.match(line).hasMatch()) {
+                        if (inFunction) {
+                            selectsFunctionCode = true;
+                        } else {
+                            blockers << "guards global declarations (resources, functions, struct/cbuffer members or interface)";
+                        }
+                    } else if (definePattern.match(line).hasMatch()) {
+                        blockers << "used inside another #define";
+                    }
+                }
+                continue;
+            }
+
+            if (mentions) {
+                if (line.contains("##")) {
+                    blockers << "used in token pasting";
+                } else if (attributePattern.match(line).hasMatch()) {
+                    blockers << "used in an attribute or binding/layout qualifier";
+                } else if (arraySizePattern.match(line).hasMatch()) {
+                    blockers << "used as an array size";
+                } else if (!inFunction) {
+                    blockers << "used in a global declaration";
+                } else {
+                    usedAsValue = true;
+                }
+            }
+
+            for (QChar c : line) {
+                if (c == '{') {
+                    static const QRegularExpression declarationKeyword("\\b(struct|cbuffer|tbuffer|uniform|buffer|in|out|namespace|enum)\\b");
+                    bool isFunction = blockStack.contains(BlockKind::Function)
+                        || (pendingCode.contains('(') && !declarationKeyword.match(pendingCode).hasMatch() && !pendingCode.contains('='));
+                    blockStack.append(isFunction ? BlockKind::Function : BlockKind::Declaration);
+                    pendingCode.clear();
+                } else if (c == '}') {
+                    if (!blockStack.isEmpty()) {
+                        blockStack.removeLast();
+                    }
+                    pendingCode.clear();
+                } else if (c == ';') {
+                    pendingCode.clear();
+                } else {
+                    pendingCode += c;
+                }
+            }
+            pendingCode += ' ';
+        }
+
+        for (const QString &blocker : blockers) {
+            analysis.reasons << blocker;
+        }
+        analysis.reasons.sort();
+        analysis.convertible = blockers.isEmpty() && (selectsFunctionCode || usedAsValue);
+        if (analysis.convertible) {
+            if (selectsFunctionCode) {
+                analysis.reasons << "only selects code inside functions (#if -> if on a spec constant)";
+            }
+            if (usedAsValue) {
+                analysis.reasons << "used as a value inside functions";
+            }
+        } else if (blockers.isEmpty()) {
+            analysis.reasons << "not referenced by the source";
+        }
+        results.append(analysis);
+    }
+    return results;
+}
@@ -0,0 +1,70 @@
+#ifndef SPECCONSTANTVARIANTS_H
+#define SPECCONSTANTVARIANTS_H
+
+#include <QString>
+#include <QStringList>
+#include <QByteArray>
+#include <QVector>
+#include <QMap>
+#include <cstdint>
+
+class SpirvModule;
+
+// 模块中的一个特化常量及要生成的取值
+struct SpecConstantAxis
+{
+    uint32_t specId = 0; // SpecId 修饰
+    QString name;
+    QString typeName; // bool、int、uint、float
+    QString defaultValue;
+    QStringList values; // 变体取值，为空时只使用默认值
+};
+
+// 一组特化常量取值生成的变体
+struct SpecConstantVariant
+{
+    QMap<uint32_t, QString> values; // SpecId -> 取值
+    bool success = false;
+    QString error;
+    double instructionCount = 0; // 静态指令数
+    double weightedCost = 0; // 入口函数的加权代价
+    qint64 binarySize = 0;
+    double seconds = 0; // 特化及优化耗时
+    QByteArray binary;
+};
+
+// 宏能否改写为特化常量的分析结果
+struct MacroAxisAnalysis
+{
+    QString macro;
+    bool convertible = false;
+    QStringList reasons;
+};
+
+// SpecConstantVariants 只编译一次前端，再对 SPIR-V 按每组特化常量取值执行
+// --set-spec-const-default-value、--freeze-spec-const、常量折叠及优化生成变体，代替逐个宏排列完整编译。
+class SpecConstantVariants
+{
+public:
+    // 模块中带 SpecId 的标量特化常量，bool 默认取值为 false/true，其他类型为默认值
+    static QVector<SpecConstantAxis> axes(const SpirvModule &module);
+
+    // 各轴取值的笛卡尔积，超过 maxVariants 时截断
+    static QVector<QMap<uint32_t, QString>> expand(const QVector<SpecConstantAxis> &axes, int maxVariants = 256);
+
+    // 并行特化所有变体，optimizeOptions 为冻结及折叠后执行的 spirv-opt 参数（如 -O）
+    static QVector<SpecConstantVariant> specializeAll(const QByteArray &module, const QVector<SpecConstantAxis> &axes,
+                                                      const QVector<QMap<uint32_t, QString>> &valueSets, const QString &optimizeOptions);
+
+    // 分析宏列表及源码中条件编译使用的宏，判断能否改写为特化常量
+    static QVector<MacroAxisAnalysis> analyzeMacros(const QString &source, const QStringList &macros);
+
+    // 变体名称，如 "USE_FOG=true, LIGHT_COUNT=4"
+    static QString variantLabel(const QVector<SpecConstantAxis> &axes, const QMap<uint32_t, QString> &values);
+
+private:
+    static SpecConstantVariant specialize(const QByteArray &module, const QVector<SpecConstantAxis> &axes,
+                                          const QMap<uint32_t, QString> &values, const QString &optimizeOptions, const QString &tempFileTag);
+};
+
+#endif // SPECCONSTANTVARIANTS_H
@@ -0,0 +1,422 @@
+#include "SPIRV-Reflect/include/spirv/unified1/spirv.h"
+#include "spirvBindingRemapper.h"
+#include "spirvModule.h"
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMap>
+#include <QSet>
+#include <algorithm>
+
+namespace {
+
+// 变量的描述符类型及数量，不是描述符资源时返回空
+QString descriptorType(const SpirvModule &module, const SpirvModule::Instruction &variable, uint32_t &count, uint32_t &typeId)
+{
+    count = 1;
+    uint32_t storageClass = module.operand(variable, 2);
+    int pointerIndex = module.definition(variable.resultType);
+    if (pointerIndex < 0) {
+        return QString();
+    }
+
+    // 去掉描述符数组
+    typeId = module.operand(module.instruction(pointerIndex), 2);
+    int typeIndex = module.definition(typeId);
+    while (typeIndex >= 0) {
+        const SpirvModule::Instruction &type = module.instruction(typeIndex);
+        if (type.opcode == SpvOpTypeArray) {
+            count *= module.constantValue(module.operand(type, 2), 1);
+        } else if (type.opcode == SpvOpTypeRuntimeArray) {
+            count = 0;
+        } else {
+            break;
+        }
+        typeId = module.operand(type, 1);
+        typeIndex = module.definition(typeId);
+    }
+    if (typeIndex < 0) {
+        return QString();
+    }
+
+    const SpirvModule::Instruction &type = module.instruction(typeIndex);
+    switch (type.opcode) {
+    case SpvOpTypeStruct:
+        if (storageClass == SpvStorageClassStorageBuffer || module.hasDecoration(typeId, SpvDecorationBufferBlock)) {
+            return "Storage Buffer";
+        }
+        return storageClass == SpvStorageClassUniform ? QString("Uniform Buffer") : QString();
+    case SpvOpTypeImage: {
+        uint32_t dim = module.operand(type, 2);
+        bool storage = module.operand(type, 6) == 2;
+        if (dim == SpvDimSubpassData) {
+            return "Input Attachment";
+        }
+        if (dim == SpvDimBuffer) {
+            return storage ? "Storage Texel Buffer" : "Uniform Texel Buffer";
+        }
+        return storage ? "Storage Image" : "Sampled Image";
+    }
+    case SpvOpTypeSampler:
+        return "Sampler";
+    case SpvOpTypeSampledImage:
+        return "Combined Image Sampler";
+    case SpvOpTypeAccelerationStructureKHR:
+        return "Acceleration Structure";
+    default:
+        return QString();
+    }
+}
+
+quint64 slotKey(uint32_t set, uint32_t binding)
+{
+    return (static_cast<quint64>(set) << 32) | binding;
+}
+
+// 合并资源的键，匿名资源按原始位置合并
+QString resourceKey(const SpirvResourceBinding &resource)
+{
+    return resource.name.isEmpty() ? QString("<set %1 binding %2>").arg(resource.set).arg(resource.binding) : resource.name;
+}
+
+QString countText(uint32_t count)
+{
+    return count == 0 ? QString("[]") : QString::number(count);
+}
+
+// 模块用到的 set 数量及最大 binding
+void layoutExtent(const QByteArray &binary, QSet<uint32_t> &sets, int &maxBinding)
+{
+    SpirvModule module;
+    if (!module.parse(binary)) {
+        return;
+    }
+    for (const SpirvResourceBinding &resource : SpirvBindingRemapper::resourceBindings(module)) {
+        sets.insert(resource.set);
+        maxBinding = qMax(maxBinding, static_cast<int>(resource.binding));
+    }
+}
+
+} // namespace
+
+QVector<SpirvResourceBinding> SpirvBindingRemapper::resourceBindings(const SpirvModule &module)
+{
+    QVector<SpirvResourceBinding> resources;
+    for (int i = 0; i < module.instructionCount(); ++i) {
+        const SpirvModule::Instruction &inst = module.instruction(i);
+        if (inst.opcode == SpvOpFunction) {
+            break;
+        }
+        if (inst.opcode != SpvOpVariable) {
+            continue;
+        }
+
+        SpirvResourceBinding resource;
+        if (!module.hasDecoration(inst.resultId, SpvDecorationBinding, &resource.binding)) {
+            continue;
+        }
+        module.hasDecoration(inst.resultId, SpvDecorationDescriptorSet, &resource.set);
+
+        uint32_t typeId = 0;
+        resource.variableId = inst.resultId;
+        resource.descriptorType = descriptorType(module, inst, resource.count, typeId);
+        if (resource.descriptorType.isEmpty()) {
+            continue;
+        }
+        resource.name = module.name(inst.resultId);
+        if (resource.name.isEmpty()) {
+            resource.name = module.name(typeId);
+        }
+        resources.append(resource);
+    }
+
+    std::stable_sort(resources.begin(), resources.end(), [](const SpirvResourceBinding &a, const SpirvResourceBinding &b) {
+        return slotKey(a.set, a.binding) < slotKey(b.set, b.binding);
+    });
+    return resources;
+}
+
+bool SpirvBindingRemapper::loadLayout(const QString &filePath, QVector<SpirvLayoutBinding> &layout, QString &error)
+{
+    layout.clear();
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        error = QString("Failed to open %1").arg(filePath);
+        return false;
+    }
+
+    QJsonParseError parseError;
+    QJsonDocument document = QJsonDocument::fromJson(file.readAll(), &parseError);
+    if (document.isNull()) {
+        error = QString("%1: %2").arg(filePath).arg(parseError.errorString());
+        return false;
+    }
+
+    QSet<quint64> occupied;
+    QSet<QString> names;
+    for (const QJsonValue &value : document.object()["bindings"].toArray()) {
+        QJsonObject object = value.toObject();
+        SpirvLayoutBinding entry;
+        entry.name = object["name"].toString();
+        entry.set = static_cast<uint32_t>(object["set"].toInt());
+        entry.binding = static_cast<uint32_t>(object["binding"].toInt());
+        entry.descriptorType = object["descriptorType"].toString();
+        entry.count = static_cast<uint32_t>(object["count"].toInt(1));
+        for (const QJsonValue &stage : object["stages"].toArray()) {
+            entry.stages << stage.toString();
+        }
+        entry.fixed = true;
+
+        if (entry.name.isEmpty() || !object.contains("set") || !object.contains("binding")) {
+            error = QString("%1: every binding needs a name, set and binding.").arg(filePath);
+            return false;
+        }
+        if (names.contains(entry.name) || occupied.contains(slotKey(entry.set, entry.binding))) {
+            error = QString("%1: %2 (set %3 binding %4) is declared twice.").arg(filePath).arg(entry.name).arg(entry.set).arg(entry.binding);
+            return false;
+        }
+        names.insert(entry.name);
+        occupied.insert(slotKey(entry.set, entry.binding));
+        layout.append(entry);
+    }
+    return true;
+}
+
+bool SpirvBindingRemapper::saveLayout(const QString &filePath, const QVector<SpirvLayoutBinding> &layout)
+{
+    QJsonArray bindings;
+    for (const SpirvLayoutBinding &entry : layout) {
+        QJsonObject object;
+        object["name"] = entry.name;
+        object["set"] = static_cast<qint64>(entry.set);
+        object["binding"] = static_cast<qint64>(entry.binding);
+        object["descriptorType"] = entry.descriptorType;
+        object["count"] = static_cast<qint64>(entry.count);
+        object["stages"] = QJsonArray::fromStringList(entry.stages);
+        bindings.append(object);
+    }
+    QJsonObject json;
+    json["bindings"] = bindings;
+
+    QFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+    QByteArray data = QJsonDocument(json).toJson(QJsonDocument::Indented);
+    bool success = file.write(data) == data.size();
+    file.close();
+    return success;
+}
+
+bool SpirvBindingRemapper::remap(QVector<SpirvRemapStage> &stages, const QVector<SpirvLayoutBinding> &fixedLayout, const SpirvRemapOptions &options,
+                                 QVector<SpirvLayoutBinding> &layout, QStringList &warnings, QString &error)
+{
+    // 解析各阶段的资源，同名资源合并
+    QVector<SpirvModule> modules(stages.size());
+    QVector<QVector<SpirvResourceBinding>> stageResources(stages.size());
+    QMap<QString, SpirvResourceBinding> merged; // 键 -> 首次出现的资源（原始位置）
+    QMap<QString, QStringList> mergedStages;
+    for (int i = 0; i < stages.size(); ++i) {
+        if (!modules[i].parse(stages[i].binary, &error)) {
+            error = QString("%1: %2").arg(stages[i].name).arg(error);
+            return false;
+        }
+        stages[i].stage = modules[i].entryPoints().isEmpty() ? QString("Unknown")
+            : SpirvModule::stageName(modules[i].entryPoints().first().executionModel);
+        stageResources[i] = resourceBindings(modules[i]);
+
+        for (const SpirvResourceBinding &resource : stageResources[i]) {
+            QString key = resourceKey(resource);
+            if (!merged.contains(key)) {
+                merged.insert(key, resource);
+            } else if (merged[key].descriptorType != resource.descriptorType) {
+                error = QString("%1 is a %2 in one stage and a %3 in %4.").arg(key).arg(merged[key].descriptorType)
+                    .arg(resource.descriptorType).arg(stages[i].name);
+                return false;
+            } else if (merged[key].count != resource.count) {
+                warnings << QString("%1 has different array sizes across stages, using the largest.").arg(key);
+                merged[key].count = merged[key].count == 0 || resource.count == 0 ? 0 : qMax(merged[key].count, resource.count);
+            }
+            if (!mergedStages[key].contains(stages[i].stage)) {
+                mergedStages[key] << stages[i].stage;
+            }
+        }
+    }
+
+    // 布局文件中的项原样占位
+    layout = fixedLayout;
+    QHash<QString, int> layoutIndex;
+    QSet<quint64> occupied;
+    QSet<uint32_t> fixedSets;
+    for (int i = 0; i < layout.size(); ++i) {
+        layout[i].fixed = true;
+        layout[i].stages.clear();
+        layoutIndex.insert(layout[i].name, i);
+        occupied.insert(slotKey(layout[i].set, layout[i].binding));
+        fixedSets.insert(layout[i].set);
+    }
+
+    QVector<SpirvResourceBinding> pending;
+    for (auto it = merged.constBegin(); it != merged.constEnd(); ++it) {
+        if (!layoutIndex.contains(it.key())) {
+            pending.append(it.value());
+            continue;
+        }
+
+        SpirvLayoutBinding &entry = layout[layoutIndex.value(it.key())];
+        entry.stages = mergedStages.value(it.key());
+        if (entry.descriptorType.isEmpty()) {
+            entry.descriptorType = it.value().descriptorType;
+        } else if (entry.descriptorType != it.value().descriptorType) {
+            warnings << QString("%1 is a %2 in the shaders but a %3 in the layout file.").arg(it.key())
+                .arg(it.value().descriptorType).arg(entry.descriptorType);
+        }
+        if (entry.count != it.value().count) {
+            warnings << QString("%1 has %2 descriptors in the shaders but %3 in the layout file.").arg(it.key())
+                .arg(countText(it.value().count)).arg(countText(entry.count));
+        }
+    }
+    for (const SpirvLayoutBinding &entry : layout) {
+        if (entry.stages.isEmpty()) {
+            warnings << QString("%1 (set %2 binding %3) from the layout file is not used by any stage.").arg(entry.name).arg(entry.set).arg(entry.binding);
+        }
+    }
+
+    // 未列出的资源按原始位置排序后分配
+    std::stable_sort(pending.begin(), pending.end(), [](const SpirvResourceBinding &a, const SpirvResourceBinding &b) {
+        return slotKey(a.set, a.binding) < slotKey(b.set, b.binding);
+    });
+
+    QMap<uint32_t, uint32_t> setMap;
+    for (const SpirvResourceBinding &resource : pending) {
+        setMap.insert(resource.set, resource.set);
+    }
+    if (options.compactSets) {
+        uint32_t nextSet = 0;
+        for (auto it = setMap.begin(); it != setMap.end(); ++it) {
+            while (fixedSets.contains(nextSet)) {
+                ++nextSet;
+            }
+            it.value() = nextSet++;
+        }
+    }
+
+    for (const SpirvResourceBinding &resource : pending) {
+        SpirvLayoutBinding entry;
+        entry.name = resourceKey(resource);
+        entry.descriptorType = resource.descriptorType;
+        entry.count = resource.count;
+        entry.stages = mergedStages.value(entry.name);
+        entry.set = setMap.value(resource.set);
+        entry.binding = resource.binding;
+        if (options.compactBindings || occupied.contains(slotKey(entry.set, entry.binding))) {
+            entry.binding = 0;
+            while (occupied.contains(slotKey(entry.set, entry.binding))) {
+                ++entry.binding;
+            }
+        }
+        occupied.insert(slotKey(entry.set, entry.binding));
+        layoutIndex.insert(entry.name, layout.size());
+        layout.append(entry);
+    }
+
+    std::stable_sort(layout.begin(), layout.end(), [](const SpirvLayoutBinding &a, const SpirvLayoutBinding &b) {
+        return slotKey(a.set, a.binding) < slotKey(b.set, b.binding);
+    });
+    layoutIndex.clear();
+    for (int i = 0; i < layout.size(); ++i) {
+        layoutIndex.insert(layout[i].name, i);
+    }
+
+    // 改写各阶段
+    for (int i = 0; i < stages.size(); ++i) {
+        QHash<uint32_t, QPair<uint32_t, uint32_t>> targets;
+        stages[i].changes.clear();
+        for (const SpirvResourceBinding &resource : stageResources[i]) {
+            const SpirvLayoutBinding &entry = layout[layoutIndex.value(resourceKey(resource))];
+            targets.insert(resource.variableId, qMakePair(entry.set, entry.binding));
+            if (entry.set != resource.set || entry.binding != resource.binding) {
+                stages[i].changes << QString("%1: set %2 binding %3 -> set %4 binding %5").arg(resourceKey(resource))
+                    .arg(resource.set).arg(resource.binding).arg(entry.set).arg(entry.binding);
+            }
+        }
+        stages[i].remappedBinary = rewriteBindings(modules[i], targets);
+    }
+    return true;
+}
+
+QByteArray SpirvBindingRemapper::rewriteBindings(const SpirvModule &module, const QHash<uint32_t, QPair<uint32_t, uint32_t>> &targets)
+{
+    if (module.instructionCount() == 0) {
+        return QByteArray();
+    }
+
+    QVector<uint32_t> words = module.headerWords();
+    words.reserve(static_cast<int>(module.wordCount()) + targets.size() * 4);
+
+    for (int i = 0; i < module.instructionCount(); ++i) {
+        const SpirvModule::Instruction &inst = module.instruction(i);
+        const uint32_t *instWords = module.words(inst);
+        int start = words.size();
+        for (int w = 0; w < inst.wordCount; ++w) {
+            words.append(instWords[w]);
+        }
+
+        if (inst.opcode != SpvOpDecorate || inst.wordCount < 4 || !targets.contains(instWords[1])) {
+            continue;
+        }
+
+        QPair<uint32_t, uint32_t> target = targets.value(instWords[1]);
+        if (instWords[2] == SpvDecorationDescriptorSet) {
+            words[start + 3] = target.first;
+        } else if (instWords[2] == SpvDecorationBinding) {
+            words[start + 3] = target.second;
+            // 省略 DescriptorSet 修饰时默认为 set 0，目标 set 非 0 时补上
+            if (target.first != 0 && !module.hasDecoration(instWords[1], SpvDecorationDescriptorSet)) {
+                words.append((4u << SpvWordCountShift) | SpvOpDecorate);
+                words.append(instWords[1]);
+                words.append(SpvDecorationDescriptorSet);
+                words.append(target.first);
+            }
+        }
+    }
+
+    return QByteArray(reinterpret_cast<const char *>(words.constData()), words.size() * static_cast<int>(sizeof(uint32_t)));
+}
+
+QString SpirvBindingRemapper::layoutTable(const QVector<SpirvLayoutBinding> &layout)
+{
+    QString text = QString("%1 %2  %3 %4  %5 %6\n").arg("Set", 4).arg("Binding", 8).arg("Type", -24).arg("Count", 5)
+        .arg("Stages", -28).arg("Name");
+    for (const SpirvLayoutBinding &entry : layout) {
+        text += QString("%1 %2  %3 %4  %5 %6%7\n").arg(entry.set, 4).arg(entry.binding, 8).arg(entry.descriptorType, -24)
+            .arg(countText(entry.count), 5).arg(entry.stages.join(", "), -28).arg(entry.name).arg(entry.fixed ? " (layout file)" : "");
+    }
+    return text;
+}
+
+QString SpirvBindingRemapper::reportText(const QVector<SpirvRemapStage> &stages, const QVector<SpirvLayoutBinding> &layout, const QStringList &warnings)
+{
+    QString text;
+    QSet<uint32_t> setsBefore;
+    QSet<uint32_t> setsAfter;
+    int maxBindingBefore = -1;
+    int maxBindingAfter = -1;
+    for (const SpirvRemapStage &stage : stages) {
+        layoutExtent(stage.binary, setsBefore, maxBindingBefore);
+        layoutExtent(stage.remappedBinary, setsAfter, maxBindingAfter);
+
+        text += QString("== %1 (%2) ==\n").arg(stage.name).arg(stage.stage);
+        text += stage.changes.isEmpty() ? QString("  No change\n") : "  " + stage.changes.join("\n  ") + "\n";
+        text += "\n";
+    }
+
+    text += QString("Descriptor sets used: %1 -> %2\n").arg(setsBefore.size()).arg(setsAfter.size());
+    text += QString("Highest binding: %1 -> %2\n\n").arg(maxBindingBefore).arg(maxBindingAfter);
+    if (!warnings.isEmpty()) {
+        text += "Warnings:\n  " + warnings.join("\n  ") + "\n\n";
+    }
+    text += "Pipeline layout:\n" + layoutTable(layout);
+    return text;
+}
@@ -0,0 +1,80 @@
+#ifndef SPIRVBINDINGREMAPPER_H
+#define SPIRVBINDINGREMAPPER_H
+
+#include <QString>
+#include <QStringList>
+#include <QByteArray>
+#include <QVector>
+#include <QHash>
+#include <QPair>
+#include <cstdint>
+
+class SpirvModule;
+
+// 模块中带 DescriptorSet/Binding 修饰的资源变量
+struct SpirvResourceBinding
+{
+    uint32_t variableId = 0;
+    QString name; // 变量名称，匿名块使用块类型名称
+    QString descriptorType; // 与 ShaderReflection 相同的描述符类型名称
+    uint32_t set = 0;
+    uint32_t binding = 0;
+    uint32_t count = 1; // 描述符数量，运行时数组为 0
+};
+
+// 管线布局中的一项，各阶段同名资源合并为一项
+struct SpirvLayoutBinding
+{
+    QString name;
+    QString descriptorType;
+    uint32_t set = 0;
+    uint32_t binding = 0;
+    uint32_t count = 1;
+    QStringList stages; // 使用该资源的阶段
+    bool fixed = false; // 由布局文件指定
+};
+
+// 参与重映射的一个阶段
+struct SpirvRemapStage
+{
+    QString name; // 文档名称
+    QByteArray binary;
+    QString stage; // 执行模型名称，由 remap 填充
+    QByteArray remappedBinary;
+    QStringList changes; // "名称: set a binding b -> set c binding d"
+};
+
+// 重映射选项
+struct SpirvRemapOptions
+{
+    bool compactBindings = true; // 未在布局文件中列出的资源占用所在 set 的最小空闲 binding
+    bool compactSets = false; // 未列出资源所在的 set 依次改用布局文件未占用的最小 set 号
+};
+
+// SpirvBindingRemapper 在编译后按布局描述文件改写 SPIR-V 的 DescriptorSet/Binding 修饰，
+// 将一条管线各阶段的资源合并为同一个布局并压缩空洞，使共用材质的着色器能共用管线布局。
+class SpirvBindingRemapper
+{
+public:
+    // 模块中的资源变量，按 set、binding 排序
+    static QVector<SpirvResourceBinding> resourceBindings(const SpirvModule &module);
+
+    // 布局描述文件（JSON）：{ "bindings": [ { "name", "set", "binding", "descriptorType", "count", "stages" } ] }，
+    // 只有 name、set、binding 是必需的；saveLayout 写出同样的格式，可作为下一次的输入固定布局
+    static bool loadLayout(const QString &filePath, QVector<SpirvLayoutBinding> &layout, QString &error);
+    static bool saveLayout(const QString &filePath, const QVector<SpirvLayoutBinding> &layout);
+
+    // 合并各阶段的资源生成最终布局并改写每个阶段。布局文件中的项原样保留（即使当前阶段未使用），
+    // 其余资源按选项分配；同名资源在各阶段的描述符类型不一致时失败
+    static bool remap(QVector<SpirvRemapStage> &stages, const QVector<SpirvLayoutBinding> &fixedLayout, const SpirvRemapOptions &options,
+                      QVector<SpirvLayoutBinding> &layout, QStringList &warnings, QString &error);
+
+    // 改写指定变量的 (set, binding)，缺少 DescriptorSet 修饰的变量补上该修饰
+    static QByteArray rewriteBindings(const SpirvModule &module, const QHash<uint32_t, QPair<uint32_t, uint32_t>> &targets);
+
+    // 布局表及重映射报告
+    static QString layoutTable(const QVector<SpirvLayoutBinding> &layout);
+    static QString reportText(const QVector<SpirvRemapStage> &stages, const QVector<SpirvLayoutBinding> &layout, const QStringList &warnings);
+};
+
+#endif // SPIRVBINDINGREMAPPER_H
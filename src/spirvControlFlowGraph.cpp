@@ -0,0 +1,221 @@
+#include "SPIRV-Reflect/include/spirv/unified1/spirv.h"
+#include "spirvControlFlowGraph.h"
+#include "spirvModule.h"
+#include "spirvUniformity.h"
+#include <QHash>
+#include <QPair>
+#include <QSet>
+
+namespace {
+
+class ControlFlowAnalysis
+{
+public:
+    ControlFlowAnalysis(const SpirvModule &module, const QString &sourceFile);
+
+    ControlFlowFunction build(int functionIndex);
+
+private:
+    QString idText(uint32_t id) const;
+    QString instructionText(const SpirvModule::Instruction &inst) const;
+    bool isDebugInstruction(const SpirvModule::Instruction &inst) const;
+
+    const SpirvModule &module;
+    QString mainFile;
+    QVector<SpirvModule::SourceLocation> locations; // 指令下标 -> 源代码位置
+    QSet<uint32_t> nonUniform; // 各线程可能不同的值
+};
+
+ControlFlowAnalysis::ControlFlowAnalysis(const SpirvModule &module, const QString &sourceFile)
+    : module(module)
+    , mainFile(sourceFile.isEmpty() ? module.mainSourceFile() : sourceFile)
+    , locations(module.sourceLocations())
+{
+    nonUniform = SpirvUniformity::nonUniformValues(module);
+}
+
+QString ControlFlowAnalysis::idText(uint32_t id) const
+{
+    QString name = module.name(id);
+    return name.isEmpty() ? QString("%%1").arg(id) : "%" + name;
+}
+
+// 简单的反汇编：已定义的 ID 显示为 %名称，其余操作数按字面量显示
+QString ControlFlowAnalysis::instructionText(const SpirvModule::Instruction &inst) const
+{
+    QString text;
+    int first = 0;
+    if (inst.resultId != 0) {
+        text = idText(inst.resultId) + " = ";
+    }
+    text += "Op" + SpirvModule::opcodeName(inst.opcode);
+    if (inst.resultType != 0) {
+        text += " " + idText(inst.resultType);
+        first = 2;
+    } else if (inst.resultId != 0) {
+        first = 1;
+    }
+
+    if (inst.opcode == SpvOpExtInst) {
+        text += QString(" %1 %2").arg(module.extInstSetName(module.operand(inst, 2))).arg(module.operand(inst, 3));
+        first += 2;
+    }
+    for (int o = first; o < module.operandCount(inst); ++o) {
+        uint32_t word = module.operand(inst, o);
+        text += " " + (word != 0 && word < module.bound() && module.definition(word) >= 0 ? idText(word) : QString::number(word));
+    }
+    return text;
+}
+
+bool ControlFlowAnalysis::isDebugInstruction(const SpirvModule::Instruction &inst) const
+{
+    return inst.opcode == SpvOpLabel || inst.opcode == SpvOpLine || inst.opcode == SpvOpNoLine
+        || (inst.opcode == SpvOpExtInst && module.extInstSetName(module.operand(inst, 2)).startsWith("NonSemantic."));
+}
+
+ControlFlowFunction ControlFlowAnalysis::build(int functionIndex)
+{
+    const SpirvModule::Function &function = module.functions()[functionIndex];
+    const int blockCount = function.blocks.size();
+
+    ControlFlowFunction result;
+    result.id = function.id;
+    result.name = module.name(function.id);
+    if (result.name.isEmpty()) {
+        result.name = QString("%%1").arg(function.id);
+    }
+
+    QVector<double> loopWeights;
+    QVector<ShaderCostCounts> counts = ShaderCostAnalyzer::spirvBlockCounts(module, functionIndex, &loopWeights);
+
+    QVector<QVector<int>> blockSuccessors = module.blockSuccessors(function);
+
+    result.blocks.resize(blockCount);
+    for (int b = 0; b < blockCount; ++b) {
+        const SpirvModule::BasicBlock &block = function.blocks[b];
+        ControlFlowBlock &node = result.blocks[b];
+        node.labelId = block.labelId;
+        node.label = idText(block.labelId);
+        node.counts = counts.value(b);
+        node.cost = node.counts.weightedCost();
+        node.loopWeight = loopWeights.value(b, 1.0);
+
+        for (int i = block.firstInstruction; i < block.firstInstruction + block.instructionCount; ++i) {
+            const SpirvModule::Instruction &inst = module.instruction(i);
+            node.disassembly << instructionText(inst);
+            if (!isDebugInstruction(inst)) {
+                node.instructionCount++;
+            }
+
+            // 取块内第一个属于主源文件的行
+            const SpirvModule::SourceLocation &location = locations[i];
+            if (node.sourceLine == 0 && location.isValid() && (mainFile.isEmpty() || location.file == mainFile)) {
+                node.sourceLine = location.line;
+            }
+        }
+
+        const SpirvModule::Instruction &terminator = module.instruction(block.firstInstruction + block.instructionCount - 1);
+        if ((terminator.opcode == SpvOpBranchConditional || terminator.opcode == SpvOpSwitch) && blockSuccessors[b].size() > 1
+            && nonUniform.contains(module.operand(terminator, 0))) {
+            node.divergentBranch = true;
+            result.divergentBranchCount++;
+        }
+    }
+
+    // 回边在路径计算中视为跳到循环的合并块
+    QHash<QPair<int, int>, int> backEdgeExits; // (源块, 循环头) -> 合并块
+    for (const SpirvModule::Loop &loop : module.loops(function, blockSuccessors)) {
+        for (int source : loop.backEdgeSources) {
+            backEdgeExits.insert(qMakePair(source, loop.header), loop.mergeBlock);
+        }
+
+        result.loopCount++;
+        result.blocks[loop.header].loopHeader = true;
+        for (int b = 0; b < blockCount; ++b) {
+            if (loop.blocks[b]) {
+                result.blocks[b].loopDepth++;
+            }
+        }
+    }
+
+    // 路径计算使用的后继：前向边，回边换成循环的合并块；second 为对应的边下标
+    QVector<QVector<QPair<int, int>>> pathSuccessors(blockCount);
+    for (int b = 0; b < blockCount; ++b) {
+        for (int successor : blockSuccessors[b]) {
+            ControlFlowEdge edge;
+            edge.from = b;
+            edge.to = successor;
+            edge.backEdge = successor <= b;
+            result.edges.append(edge);
+
+            int target = edge.backEdge ? backEdgeExits.value(qMakePair(b, successor), -1) : successor;
+            if (target > b) {
+                pathSuccessors[b].append(qMakePair(target, result.edges.size() - 1));
+            }
+        }
+    }
+
+    // 执行频率：按布局顺序传播，分支各目标等概率
+    QVector<double> probability(blockCount, 0.0);
+    if (blockCount > 0) {
+        probability[0] = 1.0;
+    }
+    for (int b = 0; b < blockCount; ++b) {
+        result.blocks[b].frequency = probability[b] * result.blocks[b].loopWeight;
+        for (const QPair<int, int> &successor : pathSuccessors[b]) {
+            probability[successor.first] += probability[b] / pathSuccessors[b].size();
+        }
+    }
+
+    // 最热路径：逆布局顺序求每个块到出口的最大代价
+    QVector<double> best(blockCount, 0.0);
+    QVector<QPair<int, int>> next(blockCount, qMakePair(-1, -1));
+    for (int b = blockCount - 1; b >= 0; --b) {
+        double tail = 0;
+        for (const QPair<int, int> &successor : pathSuccessors[b]) {
+            if (next[b].first < 0 || best[successor.first] > tail) {
+                tail = best[successor.first];
+                next[b] = successor;
+            }
+        }
+        best[b] = result.blocks[b].cost * result.blocks[b].loopWeight + tail;
+    }
+    for (int b = blockCount > 0 ? 0 : -1; b >= 0; b = next[b].first) {
+        result.blocks[b].hot = true;
+        if (next[b].second >= 0) {
+            result.edges[next[b].second].hot = true;
+        }
+    }
+    result.hotPathCost = best.value(0, 0.0);
+    return result;
+}
+
+} // namespace
+
+QVector<ControlFlowFunction> SpirvControlFlowGraph::build(const SpirvModule &module, const QString &sourceFile)
+{
+    ControlFlowAnalysis analysis(module, sourceFile);
+    const QVector<SpirvModule::Function> &functions = module.functions();
+
+    QVector<ControlFlowFunction> result;
+    QVector<bool> isEntry(functions.size(), false);
+    for (const SpirvModule::EntryPoint &entryPoint : module.entryPoints()) {
+        int functionIndex = module.functionIndex(entryPoint.functionId);
+        if (functionIndex < 0 || isEntry[functionIndex]) {
+            continue;
+        }
+        isEntry[functionIndex] = true;
+
+        ControlFlowFunction function = analysis.build(functionIndex);
+        function.name = entryPoint.name;
+        function.stage = SpirvModule::stageName(entryPoint.executionModel);
+        result.append(function);
+    }
+
+    for (int i = 0; i < functions.size(); ++i) {
+        if (!isEntry[i]) {
+            result.append(analysis.build(i));
+        }
+    }
+    return result;
+}
@@ -0,0 +1,62 @@
+#ifndef SPIRVCONTROLFLOWGRAPH_H
+#define SPIRVCONTROLFLOWGRAPH_H
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <cstdint>
+#include "shaderCostAnalyzer.h"
+
+class SpirvModule;
+
+// 控制流图中的基本块
+struct ControlFlowBlock
+{
+    uint32_t labelId = 0;
+    QString label; // OpName 或 %id
+    int instructionCount = 0; // 不含 OpLabel 及调试指令
+    ShaderCostCounts counts; // 静态计数，每条指令计一次
+    double cost = 0; // counts 的加权代价，单位为一条 ALU 指令
+    double loopWeight = 1.0; // 可证明迭代次数的循环权重，无法证明时按 1 次
+    double frequency = 0; // 静态估算的执行频率：分支各目标等概率，再乘以 loopWeight
+    int loopDepth = 0;
+    bool loopHeader = false;
+    bool divergentBranch = false; // 终结指令为条件依赖逐线程数据的分支或 switch
+    bool hot = false; // 位于最热路径上
+    int sourceLine = 0; // 主源文件行号，无调试信息时为 0
+    QStringList disassembly; // 块内指令，每行一条
+};
+
+// 块之间的边
+struct ControlFlowEdge
+{
+    int from = 0;
+    int to = 0;
+    bool backEdge = false; // 回到循环头的边
+    bool hot = false;
+};
+
+// 单个函数的控制流图
+struct ControlFlowFunction
+{
+    uint32_t id = 0;
+    QString name;
+    QString stage; // 入口函数的着色器阶段，非入口函数为空
+    QVector<ControlFlowBlock> blocks; // 按模块中的布局顺序，入口块在前
+    QVector<ControlFlowEdge> edges;
+    double hotPathCost = 0; // 最热路径上各块 cost * loopWeight 之和
+    int loopCount = 0;
+    int divergentBranchCount = 0;
+};
+
+// SpirvControlFlowGraph 直接从已索引的模块建立各函数的控制流图，不经过 spirv-cfg，
+// 并按 ShaderCostAnalyzer 的代价模型标注每个基本块、循环及条件不一致的分支。
+// 最热路径为沿前向边代价最大的入口到出口路径，回边视为跳到循环的合并块。
+class SpirvControlFlowGraph
+{
+public:
+    // sourceFile 同 ShaderCostAnalyzer::analyzeSpirv，为空时取 OpSource 的文件；入口函数在前
+    static QVector<ControlFlowFunction> build(const SpirvModule &module, const QString &sourceFile = QString());
+};
+
+#endif // SPIRVCONTROLFLOWGRAPH_H
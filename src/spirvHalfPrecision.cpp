@@ -0,0 +1,1084 @@
+#include "SPIRV-Reflect/include/spirv/unified1/spirv.h"
+#include "spirvHalfPrecision.h"
+#include "spirvModule.h"
+#include <QHash>
+#include <QSet>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace {
+
+const double kHalfMax = 65504.0;
+const double kInf = std::numeric_limits<double>::infinity();
+const double kPi = 3.14159265358979323846;
+// FP16 在 1024（2^10）以上的间隔为 1，周期函数及取小数部分的参数超过此值时结果失去意义
+const double kHalfRangeReductionLimit = 1024.0;
+
+// GLSL.std.450 扩展指令编号
+enum GlslStd450
+{
+    Glsl450Round = 1,
+    Glsl450RoundEven = 2,
+    Glsl450Trunc = 3,
+    Glsl450FAbs = 4,
+    Glsl450FSign = 6,
+    Glsl450Floor = 8,
+    Glsl450Ceil = 9,
+    Glsl450Fract = 10,
+    Glsl450Radians = 11,
+    Glsl450Degrees = 12,
+    Glsl450Sin = 13,
+    Glsl450Cos = 14,
+    Glsl450Tan = 15,
+    Glsl450Asin = 16,
+    Glsl450Acos = 17,
+    Glsl450Atan = 18,
+    Glsl450Sinh = 19,
+    Glsl450Cosh = 20,
+    Glsl450Tanh = 21,
+    Glsl450Atan2 = 25,
+    Glsl450Pow = 26,
+    Glsl450Exp = 27,
+    Glsl450Log = 28,
+    Glsl450Exp2 = 29,
+    Glsl450Log2 = 30,
+    Glsl450Sqrt = 31,
+    Glsl450InverseSqrt = 32,
+    Glsl450FMin = 37,
+    Glsl450FMax = 40,
+    Glsl450FClamp = 43,
+    Glsl450FMix = 46,
+    Glsl450Step = 48,
+    Glsl450SmoothStep = 49,
+    Glsl450Fma = 50,
+    Glsl450Ldexp = 53,
+    Glsl450Length = 66,
+    Glsl450Distance = 67,
+    Glsl450Cross = 68,
+    Glsl450Normalize = 69,
+    Glsl450NMin = 79,
+    Glsl450NMax = 80,
+    Glsl450NClamp = 81
+};
+
+// 取值区间，任一端为无穷表示范围未知
+struct Range
+{
+    double lo = -kInf;
+    double hi = kInf;
+
+    bool bounded() const { return std::isfinite(lo) && std::isfinite(hi); }
+    double magnitude() const { return qMax(std::fabs(lo), std::fabs(hi)); }
+    bool operator==(const Range &other) const { return lo == other.lo && hi == other.hi; }
+    bool operator!=(const Range &other) const { return !(*this == other); }
+};
+
+Range makeRange(double lo, double hi)
+{
+    Range range;
+    range.lo = lo;
+    range.hi = hi;
+    return range;
+}
+
+Range unite(const Range &a, const Range &b)
+{
+    return makeRange(qMin(a.lo, b.lo), qMax(a.hi, b.hi));
+}
+
+Range negate(const Range &a)
+{
+    return makeRange(-a.hi, -a.lo);
+}
+
+Range add(const Range &a, const Range &b)
+{
+    if (!a.bounded() || !b.bounded()) {
+        return Range();
+    }
+    return makeRange(a.lo + b.lo, a.hi + b.hi);
+}
+
+Range multiply(const Range &a, const Range &b)
+{
+    if (!a.bounded() || !b.bounded()) {
+        return Range();
+    }
+    double products[4] = { a.lo * b.lo, a.lo * b.hi, a.hi * b.lo, a.hi * b.hi };
+    return makeRange(*std::min_element(products, products + 4), *std::max_element(products, products + 4));
+}
+
+Range scale(const Range &a, double factor)
+{
+    return multiply(a, makeRange(factor, factor));
+}
+
+double decodeFloat(uint32_t bits, int width)
+{
+    if (width == 32) {
+        float value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    uint32_t exponent = (bits >> 10) & 0x1f;
+    uint32_t mantissa = bits & 0x3ff;
+    double value = exponent == 0 ? std::ldexp(static_cast<double>(mantissa), -24)
+        : exponent == 31 ? kInf : std::ldexp(static_cast<double>(mantissa | 0x400), static_cast<int>(exponent) - 25);
+    return (bits & 0x8000) ? -value : value;
+}
+
+// 函数内或常量声明的 16/32 位浮点值
+struct Value
+{
+    uint32_t id = 0;
+    int instruction = -1;
+    int function = -1; // 常量为 -1
+    int bits = 32;
+    bool alu = false; // 浮点运算指令
+    bool relaxed = false; // 已有 RelaxedPrecision 修饰
+    bool visited = false; // 区间已计算过
+    Range range;
+    QString fullSource; // 需要绝对精度的来源，如 FragCoord
+    QString risk; // 需要保留 32 位的原因，空表示可改为 16 位
+    QString source; // 作为链的输入时的描述，如 "texture albedoMap"
+};
+
+class HalfPrecisionAnalysis
+{
+public:
+    explicit HalfPrecisionAnalysis(const SpirvModule &module);
+
+    HalfPrecisionReport run(int maxChains);
+
+private:
+    void collectValues();
+    void propagateRanges();
+    void markSinks();
+    void markLoopAccumulators();
+    void markForwardRisks();
+    void markBackward(const QVector<int> &seeds, const QString &reason);
+
+    int floatWidth(uint32_t typeId) const;
+    int componentCount(uint32_t typeId) const;
+    uint32_t typeOf(uint32_t id) const;
+    bool isAlu(const SpirvModule::Instruction &inst) const;
+    bool isGlslStd450(const SpirvModule::Instruction &inst) const;
+    QVector<int> floatOperands(const SpirvModule::Instruction &inst) const;
+    int valueOf(uint32_t id) const { return valueIndex.value(id, -1); }
+    Range rangeOfOperand(const SpirvModule::Instruction &inst, int operandIndex) const;
+    Range computeRange(const SpirvModule::Instruction &inst) const;
+    Range constantRange(const SpirvModule::Instruction &inst, int bits) const;
+    void describeSource(Value &value, const SpirvModule::Instruction &inst) const;
+    int builtinOfPointer(uint32_t pointerId, uint32_t *storageClass) const;
+
+    const SpirvModule &module;
+    QVector<SpirvModule::SourceLocation> locations; // 指令下标 -> 源代码位置
+    QHash<uint32_t, int> valueIndex;
+    QVector<Value> values;
+};
+
+HalfPrecisionAnalysis::HalfPrecisionAnalysis(const SpirvModule &module)
+    : module(module)
+    , locations(module.sourceLocations())
+{
+}
+
+int HalfPrecisionAnalysis::floatWidth(uint32_t typeId) const
+{
+    int index = module.definition(typeId);
+    if (index < 0) {
+        return 0;
+    }
+    const SpirvModule::Instruction &inst = module.instruction(index);
+    if (inst.opcode == SpvOpTypeFloat) {
+        return static_cast<int>(module.operand(inst, 1));
+    }
+    if (inst.opcode == SpvOpTypeVector || inst.opcode == SpvOpTypeMatrix) {
+        return floatWidth(module.operand(inst, 1));
+    }
+    return 0;
+}
+
+int HalfPrecisionAnalysis::componentCount(uint32_t typeId) const
+{
+    int index = module.definition(typeId);
+    if (index < 0) {
+        return 1;
+    }
+    const SpirvModule::Instruction &inst = module.instruction(index);
+    if (inst.opcode == SpvOpTypeVector) {
+        return static_cast<int>(module.operand(inst, 2));
+    }
+    return 1;
+}
+
+uint32_t HalfPrecisionAnalysis::typeOf(uint32_t id) const
+{
+    int index = module.definition(id);
+    return index >= 0 ? module.instruction(index).resultType : 0;
+}
+
+bool HalfPrecisionAnalysis::isGlslStd450(const SpirvModule::Instruction &inst) const
+{
+    return inst.opcode == SpvOpExtInst && module.extInstSetName(module.operand(inst, 2)) == "GLSL.std.450";
+}
+
+bool HalfPrecisionAnalysis::isAlu(const SpirvModule::Instruction &inst) const
+{
+    switch (inst.opcode) {
+    case SpvOpFNegate:
+    case SpvOpFAdd:
+    case SpvOpFSub:
+    case SpvOpFMul:
+    case SpvOpFDiv:
+    case SpvOpFRem:
+    case SpvOpFMod:
+    case SpvOpVectorTimesScalar:
+    case SpvOpMatrixTimesScalar:
+    case SpvOpVectorTimesMatrix:
+    case SpvOpMatrixTimesVector:
+    case SpvOpMatrixTimesMatrix:
+    case SpvOpOuterProduct:
+    case SpvOpDot:
+        return true;
+    default:
+        return isGlslStd450(inst);
+    }
+}
+
+// 指令读取的浮点值，内存访问及图像指令是数据流的边界，不返回操作数
+QVector<int> HalfPrecisionAnalysis::floatOperands(const SpirvModule::Instruction &inst) const
+{
+    int first = 2;
+    int last = module.operandCount(inst);
+    int step = 1;
+    switch (inst.opcode) {
+    case SpvOpCompositeExtract:
+        last = qMin(last, 3);
+        break;
+    case SpvOpCompositeInsert:
+    case SpvOpVectorShuffle:
+        last = qMin(last, 4);
+        break;
+    case SpvOpExtInst:
+        first = 4;
+        break;
+    case SpvOpPhi:
+        step = 2;
+        break;
+    case SpvOpLoad:
+    case SpvOpAccessChain:
+    case SpvOpInBoundsAccessChain:
+    case SpvOpFunctionCall:
+    case SpvOpSampledImage:
+        return QVector<int>();
+    default:
+        if (inst.opcode >= SpvOpImageSampleImplicitLod && inst.opcode <= SpvOpImageWrite) {
+            return QVector<int>();
+        }
+        break;
+    }
+
+    QVector<int> operands;
+    for (int i = first; i < last; i += step) {
+        int value = valueOf(module.operand(inst, i));
+        if (value >= 0 && !operands.contains(value)) {
+            operands.append(value);
+        }
+    }
+    return operands;
+}
+
+Range HalfPrecisionAnalysis::constantRange(const SpirvModule::Instruction &inst, int bits) const
+{
+    switch (inst.opcode) {
+    case SpvOpConstant:
+    case SpvOpSpecConstant: {
+        double value = decodeFloat(module.operand(inst, 2), bits);
+        return makeRange(value, value);
+    }
+    case SpvOpConstantNull:
+        return makeRange(0, 0);
+    case SpvOpConstantComposite:
+    case SpvOpSpecConstantComposite: {
+        Range range = makeRange(kInf, -kInf);
+        for (int i = 2; i < module.operandCount(inst); ++i) {
+            int value = valueOf(module.operand(inst, i));
+            range = unite(range, value >= 0 ? values[value].range : Range());
+        }
+        return range;
+    }
+    default:
+        return Range();
+    }
+}
+
+Range HalfPrecisionAnalysis::rangeOfOperand(const SpirvModule::Instruction &inst, int operandIndex) const
+{
+    int value = valueOf(module.operand(inst, operandIndex));
+    return value >= 0 ? values[value].range : Range();
+}
+
+Range HalfPrecisionAnalysis::computeRange(const SpirvModule::Instruction &inst) const
+{
+    auto r = [&](int operandIndex) { return rangeOfOperand(inst, operandIndex); };
+
+    switch (inst.opcode) {
+    case SpvOpFNegate:
+        return negate(r(2));
+    case SpvOpFAdd:
+        return add(r(2), r(3));
+    case SpvOpFSub:
+        return add(r(2), negate(r(3)));
+    case SpvOpFMul:
+    case SpvOpVectorTimesScalar:
+    case SpvOpMatrixTimesScalar:
+    case SpvOpOuterProduct:
+        return multiply(r(2), r(3));
+    case SpvOpFDiv: {
+        Range divisor = r(3);
+        if (!divisor.bounded() || (divisor.lo <= 0 && divisor.hi >= 0)) {
+            return Range();
+        }
+        return multiply(r(2), makeRange(1.0 / divisor.hi, 1.0 / divisor.lo));
+    }
+    case SpvOpFRem:
+    case SpvOpFMod: {
+        Range divisor = r(3);
+        return divisor.bounded() ? makeRange(-divisor.magnitude(), divisor.magnitude()) : Range();
+    }
+    case SpvOpDot:
+        return scale(multiply(r(2), r(3)), componentCount(typeOf(module.operand(inst, 2))));
+    case SpvOpMatrixTimesVector:
+        return scale(multiply(r(2), r(3)), componentCount(typeOf(module.operand(inst, 3))));
+    case SpvOpVectorTimesMatrix:
+        return scale(multiply(r(2), r(3)), componentCount(typeOf(module.operand(inst, 2))));
+    case SpvOpMatrixTimesMatrix:
+        return scale(multiply(r(2), r(3)), 4);
+    case SpvOpCompositeExtract:
+    case SpvOpCopyObject:
+    case SpvOpFConvert:
+    case SpvOpTranspose:
+        return r(2);
+    case SpvOpCompositeInsert:
+    case SpvOpVectorShuffle:
+        return unite(r(2), r(3));
+    case SpvOpSelect:
+        return unite(r(3), r(4));
+    case SpvOpCompositeConstruct:
+    case SpvOpPhi: {
+        // 回边上尚未计算的值暂不参与
+        int step = inst.opcode == SpvOpPhi ? 2 : 1;
+        Range range = makeRange(kInf, -kInf);
+        for (int i = 2; i < module.operandCount(inst); i += step) {
+            int value = valueOf(module.operand(inst, i));
+            if (value < 0) {
+                return Range();
+            }
+            if (values[value].visited) {
+                range = unite(range, values[value].range);
+            }
+        }
+        return range.lo <= range.hi ? range : Range();
+    }
+    default:
+        break;
+    }
+
+    if (!isGlslStd450(inst)) {
+        return Range();
+    }
+
+    Range x = r(4);
+    switch (module.operand(inst, 3)) {
+    case Glsl450Round:
+    case Glsl450RoundEven:
+    case Glsl450Trunc:
+    case Glsl450Floor:
+    case Glsl450Ceil:
+        return x.bounded() ? makeRange(std::floor(x.lo), std::ceil(x.hi)) : Range();
+    case Glsl450FAbs:
+        if (!x.bounded()) {
+            return makeRange(0, kInf);
+        }
+        return makeRange(x.lo <= 0 && x.hi >= 0 ? 0 : qMin(std::fabs(x.lo), std::fabs(x.hi)), x.magnitude());
+    case Glsl450FSign:
+    case Glsl450Sin:
+    case Glsl450Cos:
+    case Glsl450Tanh:
+    case Glsl450Normalize:
+        return makeRange(-1, 1);
+    case Glsl450Fract:
+    case Glsl450Step:
+    case Glsl450SmoothStep:
+        return makeRange(0, 1);
+    case Glsl450Asin:
+    case Glsl450Acos:
+    case Glsl450Atan:
+    case Glsl450Atan2:
+        return makeRange(-kPi, kPi);
+    case Glsl450Radians:
+        return scale(x, kPi / 180.0);
+    case Glsl450Degrees:
+        return scale(x, 180.0 / kPi);
+    case Glsl450Sqrt:
+        return std::isfinite(x.hi) ? makeRange(0, std::sqrt(qMax(x.hi, 0.0))) : makeRange(0, kInf);
+    case Glsl450InverseSqrt:
+        return x.bounded() && x.lo > 0 ? makeRange(1.0 / std::sqrt(x.hi), 1.0 / std::sqrt(x.lo)) : makeRange(0, kInf);
+    case Glsl450Exp:
+        return std::isfinite(x.hi) ? makeRange(0, std::exp(x.hi)) : makeRange(0, kInf);
+    case Glsl450Exp2:
+        return std::isfinite(x.hi) ? makeRange(0, std::exp2(x.hi)) : makeRange(0, kInf);
+    case Glsl450Log:
+        return x.bounded() && x.lo > 0 ? makeRange(std::log(x.lo), std::log(x.hi)) : Range();
+    case Glsl450Log2:
+        return x.bounded() && x.lo > 0 ? makeRange(std::log2(x.lo), std::log2(x.hi)) : Range();
+    case Glsl450Pow: {
+        Range exponent = r(5);
+        return x.bounded() && x.lo >= 0 && x.hi <= 1 && exponent.lo >= 0 ? makeRange(0, 1) : Range();
+    }
+    case Glsl450FMin:
+    case Glsl450NMin: {
+        Range y = r(5);
+        return makeRange(qMin(x.lo, y.lo), qMin(x.hi, y.hi));
+    }
+    case Glsl450FMax:
+    case Glsl450NMax: {
+        Range y = r(5);
+        return makeRange(qMax(x.lo, y.lo), qMax(x.hi, y.hi));
+    }
+    case Glsl450FClamp:
+    case Glsl450NClamp: {
+        Range range = makeRange(qMax(x.lo, r(5).lo), qMin(x.hi, r(6).hi));
+        return range.lo <= range.hi ? range : unite(r(5), r(6));
+    }
+    case Glsl450FMix: {
+        Range y = r(5);
+        Range a = r(6);
+        if (a.bounded() && a.lo >= 0 && a.hi <= 1) {
+            return unite(x, y);
+        }
+        return add(x, multiply(add(y, negate(x)), a));
+    }
+    case Glsl450Fma:
+        return add(multiply(x, r(5)), r(6));
+    case Glsl450Length: {
+        double bound = x.magnitude() * std::sqrt(static_cast<double>(componentCount(typeOf(module.operand(inst, 4)))));
+        return makeRange(0, bound);
+    }
+    case Glsl450Distance: {
+        Range difference = add(x, negate(r(5)));
+        double bound = difference.magnitude() * std::sqrt(static_cast<double>(componentCount(typeOf(module.operand(inst, 4)))));
+        return makeRange(0, bound);
+    }
+    case Glsl450Cross:
+        return scale(multiply(x, r(5)), 2);
+    default:
+        return Range();
+    }
+}
+
+// 指针所指的内置变量（含 gl_PerVertex 等块的成员），不是内置变量返回 -1
+int HalfPrecisionAnalysis::builtinOfPointer(uint32_t pointerId, uint32_t *storageClass) const
+{
+    QVector<uint32_t> indices;
+    uint32_t variable = module.rootVariableOf(pointerId, &indices);
+    int variableIndex = variable ? module.definition(variable) : -1;
+    if (variableIndex < 0) {
+        return -1;
+    }
+
+    const SpirvModule::Instruction &inst = module.instruction(variableIndex);
+    *storageClass = module.operand(inst, 2);
+    uint32_t builtin = 0;
+    if (module.hasDecoration(variable, SpvDecorationBuiltIn, &builtin)) {
+        return static_cast<int>(builtin);
+    }
+
+    int pointerType = module.definition(inst.resultType);
+    uint32_t typeId = pointerType >= 0 ? module.operand(module.instruction(pointerType), 2) : 0;
+    for (uint32_t indexId : indices) {
+        int typeIndex = module.definition(typeId);
+        if (typeIndex < 0) {
+            break;
+        }
+        const SpirvModule::Instruction &type = module.instruction(typeIndex);
+        if (type.opcode == SpvOpTypeStruct) {
+            int constant = module.definition(indexId);
+            if (constant < 0 || module.instruction(constant).opcode != SpvOpConstant) {
+                break;
+            }
+            uint32_t member = module.operand(module.instruction(constant), 2);
+            for (const SpirvModule::Decoration &decoration : module.decorations(typeId)) {
+                if (decoration.member == member && decoration.decoration == SpvDecorationBuiltIn) {
+                    return static_cast<int>(module.operand(module.instruction(decoration.instruction), 3));
+                }
+            }
+            typeId = module.operand(type, 1 + static_cast<int>(member));
+        } else if (type.opcode == SpvOpTypeArray || type.opcode == SpvOpTypeRuntimeArray || type.opcode == SpvOpTypeVector) {
+            typeId = module.operand(type, 1);
+        } else {
+            break;
+        }
+    }
+    return -1;
+}
+
+// 加载及纹理读取的初始区间：FragCoord 等像素位置需要绝对精度，纹理读取假定在 FP16 范围内
+void HalfPrecisionAnalysis::describeSource(Value &value, const SpirvModule::Instruction &inst) const
+{
+    if (inst.opcode == SpvOpLoad) {
+        uint32_t storageClass = 0;
+        int builtin = builtinOfPointer(module.operand(inst, 2), &storageClass);
+        uint32_t variable = module.rootVariableOf(module.operand(inst, 2));
+        if (builtin == SpvBuiltInFragCoord) {
+            value.range = makeRange(0, 16384);
+            value.fullSource = "FragCoord";
+        } else if (builtin == SpvBuiltInPosition) {
+            value.fullSource = "Position";
+        } else if (storageClass == SpvStorageClassInput) {
+            bool relaxed = variable && module.hasDecoration(variable, SpvDecorationRelaxedPrecision);
+            value.range = relaxed ? makeRange(-kHalfMax, kHalfMax) : Range();
+        }
+
+        if (!variable) {
+            return;
+        }
+        switch (storageClass) {
+        case SpvStorageClassInput:
+            value.source = "input " + module.variableName(variable);
+            break;
+        case SpvStorageClassUniform:
+        case SpvStorageClassUniformConstant:
+        case SpvStorageClassPushConstant:
+        case SpvStorageClassStorageBuffer:
+            value.source = "buffer " + module.variableName(variable);
+            break;
+        case SpvStorageClassWorkgroup:
+            value.source = "groupshared " + module.variableName(variable);
+            break;
+        default:
+            break;
+        }
+        return;
+    }
+
+    if (inst.opcode < SpvOpImageSampleImplicitLod || inst.opcode > SpvOpImageRead) {
+        return;
+    }
+
+    uint32_t variable = module.rootVariableOf(module.operand(inst, 2));
+    value.source = "texture " + (variable ? module.variableName(variable) : QString("%%1").arg(module.operand(inst, 2)));
+    value.range = makeRange(-kHalfMax, kHalfMax);
+
+    // 图像类型：采样图像取其图像类型
+    int typeIndex = module.definition(typeOf(module.operand(inst, 2)));
+    if (typeIndex >= 0 && module.instruction(typeIndex).opcode == SpvOpTypeSampledImage) {
+        typeIndex = module.definition(module.operand(module.instruction(typeIndex), 1));
+    }
+    if (typeIndex < 0 || module.instruction(typeIndex).opcode != SpvOpTypeImage) {
+        return;
+    }
+    const SpirvModule::Instruction &imageType = module.instruction(typeIndex);
+    uint32_t format = module.operand(imageType, 7);
+    if (module.operand(imageType, 3) == 1) {
+        value.range = makeRange(0, 1);
+        value.fullSource = "depth texture";
+    } else if (format == SpvImageFormatRgba32f || format == SpvImageFormatRg32f || format == SpvImageFormatR32f) {
+        value.range = Range();
+    }
+}
+
+void HalfPrecisionAnalysis::collectValues()
+{
+    for (uint32_t id : module.constantIds()) {
+        int index = module.definition(id);
+        if (index < 0) {
+            continue;
+        }
+        const SpirvModule::Instruction &inst = module.instruction(index);
+        int bits = floatWidth(inst.resultType);
+        if (bits != 16 && bits != 32) {
+            continue;
+        }
+        Value value;
+        value.id = id;
+        value.instruction = index;
+        value.bits = bits;
+        value.visited = true;
+        value.range = constantRange(inst, bits);
+        valueIndex.insert(id, values.size());
+        values.append(value);
+    }
+
+    const QVector<SpirvModule::Function> &functions = module.functions();
+    for (int f = 0; f < functions.size(); ++f) {
+        for (int i = functions[f].firstInstruction; i < functions[f].firstInstruction + functions[f].instructionCount; ++i) {
+            const SpirvModule::Instruction &inst = module.instruction(i);
+            if (inst.resultId == 0 || inst.resultType == 0 || inst.opcode == SpvOpFunction || inst.opcode == SpvOpVariable) {
+                continue;
+            }
+            int bits = floatWidth(inst.resultType);
+            if (bits != 16 && bits != 32) {
+                continue;
+            }
+            Value value;
+            value.id = inst.resultId;
+            value.instruction = i;
+            value.function = f;
+            value.bits = bits;
+            value.alu = isAlu(inst);
+            value.relaxed = module.hasDecoration(inst.resultId, SpvDecorationRelaxedPrecision);
+            describeSource(value, inst);
+            valueIndex.insert(inst.resultId, values.size());
+            values.append(value);
+        }
+    }
+}
+
+// 块按支配顺序排列，除 OpPhi 外操作数都已先计算；OpPhi 反复迭代，扩大时放宽到无穷
+void HalfPrecisionAnalysis::propagateRanges()
+{
+    // 范围缩小的运算不传递绝对精度的要求
+    QSet<uint32_t> rangeReducing = { Glsl450Fract, Glsl450Sin, Glsl450Cos, Glsl450Tanh, Glsl450Normalize,
+                                      Glsl450Step, Glsl450SmoothStep, Glsl450FSign };
+
+    bool changed = true;
+    for (int pass = 0; changed && pass < 8; ++pass) {
+        changed = false;
+        for (Value &value : values) {
+            if (value.function < 0) {
+                continue;
+            }
+            const SpirvModule::Instruction &inst = module.instruction(value.instruction);
+            if (inst.opcode == SpvOpLoad || (inst.opcode >= SpvOpImageSampleImplicitLod && inst.opcode <= SpvOpImageRead)) {
+                value.visited = true;
+                continue;
+            }
+
+            Range range = computeRange(inst);
+            if (inst.opcode == SpvOpPhi && pass >= 2 && value.visited) {
+                range.lo = range.lo < value.range.lo ? -kInf : range.lo;
+                range.hi = range.hi > value.range.hi ? kInf : range.hi;
+            }
+
+            QString fullSource;
+            if (!(isGlslStd450(inst) && rangeReducing.contains(module.operand(inst, 3)))) {
+                for (int operand : floatOperands(inst)) {
+                    if (!values[operand].fullSource.isEmpty()) {
+                        fullSource = values[operand].fullSource;
+                        break;
+                    }
+                }
+            }
+
+            if (!value.visited || range != value.range || fullSource != value.fullSource) {
+                changed = true;
+            }
+            value.range = range;
+            value.fullSource = fullSource;
+            value.visited = true;
+        }
+    }
+}
+
+// 从需要 32 位精度的使用点反向标记其依赖的值
+void HalfPrecisionAnalysis::markBackward(const QVector<int> &seeds, const QString &reason)
+{
+    QVector<int> worklist = seeds;
+    while (!worklist.isEmpty()) {
+        int index = worklist.takeLast();
+        Value &value = values[index];
+        if (value.function < 0 || !value.risk.isEmpty()) {
+            continue;
+        }
+        value.risk = reason;
+        for (int operand : floatOperands(module.instruction(value.instruction))) {
+            worklist.append(operand);
+        }
+    }
+}
+
+void HalfPrecisionAnalysis::markSinks()
+{
+    QVector<int> outputs;
+    QVector<int> coordinates;
+    QVector<int> depthCompares;
+    QVector<int> conversions;
+    QVector<int> rangeReductions;
+
+    for (const SpirvModule::Function &function : module.functions()) {
+        for (int i = function.firstInstruction; i < function.firstInstruction + function.instructionCount; ++i) {
+            const SpirvModule::Instruction &inst = module.instruction(i);
+            auto addOperand = [&](QVector<int> &seeds, int operandIndex) {
+                int value = valueOf(module.operand(inst, operandIndex));
+                if (value >= 0) {
+                    seeds.append(value);
+                }
+            };
+            // sin/cos/tan/fract/mod 的参数范围未知或超过 kHalfRangeReductionLimit 时需要 32 位
+            auto addLargeOperand = [&](int operandIndex) {
+                int value = valueOf(module.operand(inst, operandIndex));
+                if (value >= 0 && (!values[value].range.bounded() || values[value].range.magnitude() > kHalfRangeReductionLimit)) {
+                    rangeReductions.append(value);
+                }
+            };
+
+            switch (inst.opcode) {
+            case SpvOpStore: {
+                uint32_t storageClass = 0;
+                int builtin = builtinOfPointer(module.operand(inst, 0), &storageClass);
+                if (storageClass == SpvStorageClassOutput
+                    && (builtin == SpvBuiltInPosition || builtin == SpvBuiltInFragDepth || builtin == SpvBuiltInPointSize
+                        || builtin == SpvBuiltInClipDistance || builtin == SpvBuiltInCullDistance)) {
+                    addOperand(outputs, 1);
+                }
+                break;
+            }
+            case SpvOpImageSampleImplicitLod:
+            case SpvOpImageSampleExplicitLod:
+            case SpvOpImageSampleProjImplicitLod:
+            case SpvOpImageSampleProjExplicitLod:
+            case SpvOpImageGather:
+            case SpvOpImageQueryLod:
+                addOperand(coordinates, 3);
+                break;
+            case SpvOpImageSampleDrefImplicitLod:
+            case SpvOpImageSampleDrefExplicitLod:
+            case SpvOpImageSampleProjDrefImplicitLod:
+            case SpvOpImageSampleProjDrefExplicitLod:
+            case SpvOpImageDrefGather:
+                addOperand(coordinates, 3);
+                addOperand(depthCompares, 4);
+                break;
+            case SpvOpConvertFToU:
+            case SpvOpConvertFToS:
+                addOperand(conversions, 2);
+                break;
+            case SpvOpFMod:
+            case SpvOpFRem:
+                addLargeOperand(2);
+                break;
+            case SpvOpExtInst:
+                if (isGlslStd450(inst)) {
+                    uint32_t extOpcode = module.operand(inst, 3);
+                    if (extOpcode == Glsl450Sin || extOpcode == Glsl450Cos || extOpcode == Glsl450Tan || extOpcode == Glsl450Fract) {
+                        addLargeOperand(4);
+                    }
+                }
+                break;
+            default:
+                break;
+            }
+        }
+    }
+
+    markBackward(outputs, QString("position/depth output"));
+    markBackward(depthCompares, QString("depth compare"));
+    markBackward(coordinates, QString("texture coordinate"));
+    markBackward(conversions, QString("float-to-int conversion (indexing)"));
+    markBackward(rangeReductions, QString("large sin/cos/fract/mod argument"));
+}
+
+// 循环中经回边累加的值：OpPhi 与其回边输入之间的加法链
+void HalfPrecisionAnalysis::markLoopAccumulators()
+{
+    QVector<QVector<int>> users(values.size());
+    for (int v = 0; v < values.size(); ++v) {
+        if (values[v].function < 0) {
+            continue;
+        }
+        for (int operand : floatOperands(module.instruction(values[v].instruction))) {
+            users[operand].append(v);
+        }
+    }
+
+    auto accumulates = [](uint32_t opcode) {
+        switch (opcode) {
+        case SpvOpFAdd:
+        case SpvOpFSub:
+        case SpvOpFMul:
+        case SpvOpVectorTimesScalar:
+        case SpvOpExtInst:
+        case SpvOpCompositeConstruct:
+        case SpvOpCompositeExtract:
+        case SpvOpCompositeInsert:
+        case SpvOpVectorShuffle:
+        case SpvOpSelect:
+        case SpvOpPhi:
+            return true;
+        default:
+            return false;
+        }
+    };
+
+    // 每个函数只建立一次标签 -> 块下标表
+    const QVector<SpirvModule::Function> &functions = module.functions();
+    QVector<QHash<uint32_t, int>> blockOfLabels(functions.size());
+    for (int f = 0; f < functions.size(); ++f) {
+        blockOfLabels[f] = SpirvModule::blockIndexOfLabel(functions[f]);
+    }
+
+    for (int phi = 0; phi < values.size(); ++phi) {
+        if (values[phi].function < 0) {
+            continue;
+        }
+        const SpirvModule::Instruction &inst = module.instruction(values[phi].instruction);
+        if (inst.opcode != SpvOpPhi) {
+            continue;
+        }
+
+        // 块按指令顺序排列，二分查找 OpPhi 所在的块
+        const SpirvModule::Function &function = functions[values[phi].function];
+        const QHash<uint32_t, int> &blockOfLabel = blockOfLabels[values[phi].function];
+        auto it = std::upper_bound(function.blocks.begin(), function.blocks.end(), values[phi].instruction,
+            [](int value, const SpirvModule::BasicBlock &block) { return value < block.firstInstruction; });
+        int phiBlock = static_cast<int>(it - function.blocks.begin()) - 1;
+
+        for (int operand = 2; operand + 1 < module.operandCount(inst); operand += 2) {
+            int incoming = valueOf(module.operand(inst, operand));
+            if (incoming < 0 || values[incoming].function < 0 || blockOfLabel.value(module.operand(inst, operand + 1), -1) < phiBlock) {
+                continue;
+            }
+
+            // 回边：从 OpPhi 正向可达且反向可达回边输入的值构成累加链
+            QSet<int> forward;
+            QVector<int> worklist = { phi };
+            while (!worklist.isEmpty()) {
+                int v = worklist.takeLast();
+                if (forward.contains(v)) {
+                    continue;
+                }
+                forward.insert(v);
+                for (int user : users[v]) {
+                    if (accumulates(module.instruction(values[user].instruction).opcode)) {
+                        worklist.append(user);
+                    }
+                }
+            }
+
+            QVector<int> chain;
+            bool hasAdd = false;
+            QSet<int> backward;
+            worklist = { incoming };
+            while (!worklist.isEmpty()) {
+                int v = worklist.takeLast();
+                if (backward.contains(v) || !forward.contains(v)) {
+                    continue;
+                }
+                backward.insert(v);
+                chain.append(v);
+                uint32_t opcode = module.instruction(values[v].instruction).opcode;
+                hasAdd = hasAdd || opcode == SpvOpFAdd || opcode == SpvOpFSub;
+                for (int operandValue : floatOperands(module.instruction(values[v].instruction))) {
+                    worklist.append(operandValue);
+                }
+            }
+
+            if (hasAdd) {
+                chain.append(phi);
+                for (int v : chain) {
+                    if (values[v].risk.isEmpty()) {
+                        values[v].risk = QString("loop accumulation");
+                    }
+                }
+            }
+        }
+    }
+}
+
+void HalfPrecisionAnalysis::markForwardRisks()
+{
+    for (Value &value : values) {
+        if (value.function < 0 || !value.risk.isEmpty()) {
+            continue;
+        }
+
+        const SpirvModule::Instruction &inst = module.instruction(value.instruction);
+        uint32_t extOpcode = isGlslStd450(inst) ? module.operand(inst, 3) : 0;
+        bool mayOverflow = extOpcode == Glsl450Exp || extOpcode == Glsl450Exp2 || extOpcode == Glsl450Pow
+            || extOpcode == Glsl450Sinh || extOpcode == Glsl450Cosh || extOpcode == Glsl450Ldexp;
+
+        if (!value.fullSource.isEmpty()) {
+            value.risk = QString("derived from %1").arg(value.fullSource);
+        } else if (value.range.bounded() && value.range.magnitude() > kHalfMax) {
+            value.risk = QString("exceeds FP16 range");
+        } else if (mayOverflow && !value.range.bounded()) {
+            value.risk = QString("exp/pow may overflow FP16");
+        }
+    }
+}
+
+HalfPrecisionReport HalfPrecisionAnalysis::run(int maxChains)
+{
+    collectValues();
+    propagateRanges();
+    markSinks();
+    markLoopAccumulators();
+    markForwardRisks();
+
+    HalfPrecisionReport report;
+
+    // 并查集：可改为 16 位的 32 位值按数据依赖合并为链
+    QVector<int> parent(values.size());
+    for (int v = 0; v < values.size(); ++v) {
+        parent[v] = v;
+    }
+    auto find = [&](int v) {
+        while (parent[v] != v) {
+            parent[v] = parent[parent[v]];
+            v = parent[v];
+        }
+        return v;
+    };
+    auto isCandidate = [&](const Value &value) { return value.function >= 0 && value.bits == 32 && value.risk.isEmpty(); };
+
+    for (int v = 0; v < values.size(); ++v) {
+        if (!isCandidate(values[v])) {
+            continue;
+        }
+        for (int operand : floatOperands(module.instruction(values[v].instruction))) {
+            if (isCandidate(values[operand])) {
+                parent[find(operand)] = find(v);
+            }
+        }
+    }
+
+    QHash<int, int> chainOfRoot;
+    QVector<HalfPrecisionChain> chains;
+    QVector<QSet<QString>> chainLocations;
+    for (int v = 0; v < values.size(); ++v) {
+        const Value &value = values[v];
+        if (value.function < 0) {
+            continue;
+        }
+        if (value.alu) {
+            if (value.bits == 16) {
+                ++report.halfAluOps;
+                continue;
+            }
+            ++report.fp32AluOps;
+            if (value.relaxed) {
+                ++report.relaxedAluOps;
+                continue;
+            }
+            if (!value.risk.isEmpty()) {
+                report.riskyOps[value.risk] += 1;
+                continue;
+            }
+            ++report.candidateOps;
+            bool proven = value.range.bounded() && value.range.magnitude() <= kHalfMax;
+            if (proven) {
+                ++report.provenOps;
+            }
+        }
+        if (!isCandidate(value)) {
+            continue;
+        }
+
+        int root = find(v);
+        if (!chainOfRoot.contains(root)) {
+            chainOfRoot.insert(root, chains.size());
+            HalfPrecisionChain chain;
+            chain.function = module.name(module.functions()[value.function].id);
+            chain.rangeProven = true;
+            chains.append(chain);
+            chainLocations.append(QSet<QString>());
+        }
+        int chainIndex = chainOfRoot.value(root);
+        HalfPrecisionChain &chain = chains[chainIndex];
+        if (!value.source.isEmpty() && !chain.sources.contains(value.source)) {
+            chain.sources.append(value.source);
+        }
+        if (!value.alu || value.relaxed) {
+            continue;
+        }
+
+        ++chain.aluOps;
+        chain.rangeProven = chain.rangeProven && value.range.bounded() && value.range.magnitude() <= kHalfMax;
+        const SpirvModule::Instruction &inst = module.instruction(value.instruction);
+        QString opcode = inst.opcode == SpvOpExtInst ? QString("ExtInst#%1").arg(module.operand(inst, 3)) : SpirvModule::opcodeName(inst.opcode);
+        chain.opcodes[opcode] += 1;
+        QString location = locations[value.instruction].text();
+        if (!location.isEmpty() && !chainLocations[chainIndex].contains(location)) {
+            chainLocations[chainIndex].insert(location);
+            chain.locations.append(location);
+        }
+    }
+
+    for (const HalfPrecisionChain &chain : chains) {
+        if (chain.aluOps > 0) {
+            report.chains.append(chain);
+        }
+    }
+    std::stable_sort(report.chains.begin(), report.chains.end(), [](const HalfPrecisionChain &a, const HalfPrecisionChain &b) {
+        return a.aluOps > b.aluOps;
+    });
+    report.chains.resize(qMin(report.chains.size(), maxChains));
+    return report;
+}
+
+} // namespace
+
+double HalfPrecisionReport::candidateShare() const
+{
+    int total = fp32AluOps + halfAluOps;
+    return total > 0 ? static_cast<double>(candidateOps) / total : 0;
+}
+
+HalfPrecisionReport SpirvHalfPrecision::analyze(const SpirvModule &module, int maxChains)
+{
+    HalfPrecisionAnalysis analysis(module);
+    return analysis.run(maxChains);
+}
+
+QString SpirvHalfPrecision::reportText(const HalfPrecisionReport &report)
+{
+    QString text;
+    text += QString("FP32 ALU operations: %1 (%2 already 16-bit, %3 already RelaxedPrecision)\n")
+        .arg(report.fp32AluOps).arg(report.halfAluOps).arg(report.relaxedAluOps);
+    text += QString("Could move to FP16: %1 (%2% of float ALU), %3 with proven range\n")
+        .arg(report.candidateOps).arg(report.candidateShare() * 100.0, 0, 'f', 1).arg(report.provenOps);
+
+    // 假定 FP16 运算吞吐为 FP32 的两倍
+    double current = (report.fp32AluOps - report.relaxedAluOps) + report.relaxedAluOps + report.halfAluOps * 0.5;
+    double converted = (report.fp32AluOps - report.candidateOps) + (report.halfAluOps + report.candidateOps) * 0.5;
+    if (current > 0) {
+        text += QString("Estimated float ALU time at 2x FP16 rate: %1% of current\n").arg(converted / current * 100.0, 0, 'f', 1);
+    }
+
+    if (!report.riskyOps.isEmpty()) {
+        text += "\nMust stay FP32:\n";
+        for (auto it = report.riskyOps.constBegin(); it != report.riskyOps.constEnd(); ++it) {
+            text += QString("  %1: %2\n").arg(it.key(), -40).arg(it.value());
+        }
+    }
+
+    if (!report.chains.isEmpty()) {
+        text += "\nCandidate chains:\n";
+        for (int i = 0; i < report.chains.size(); ++i) {
+            const HalfPrecisionChain &chain = report.chains[i];
+            text += QString("#%1 %2: %3 ops, %4\n").arg(i + 1).arg(chain.function.isEmpty() ? QString("<unnamed>") : chain.function)
+                .arg(chain.aluOps).arg(chain.rangeProven ? QString("range proven") : QString("range unknown"));
+            if (!chain.locations.isEmpty()) {
+                QStringList shown = chain.locations.mid(0, 8);
+                text += "    at " + shown.join(", ") + (chain.locations.size() > shown.size() ? QString(", ...") : QString()) + "\n";
+            }
+            if (!chain.sources.isEmpty()) {
+                text += "    from " + chain.sources.join(", ") + "\n";
+            }
+            QStringList opcodes;
+            for (auto it = chain.opcodes.constBegin(); it != chain.opcodes.constEnd(); ++it) {
+                opcodes << QString("%1 x%2").arg(it.key()).arg(it.value());
+            }
+            text += "    ops " + opcodes.join(", ") + "\n";
+        }
+    }
+
+    text += "\nUse min16float / float16_t (HLSL, -enable-16bit-types), mediump / float16_t (GLSL) or RelaxedPrecision (SPIR-V).\n";
+    text += "Texture reads are assumed to fit FP16 unless the image format is 32-bit float; buffer and varying inputs have unknown range.\n";
+    return text;
+}
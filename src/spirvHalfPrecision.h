@@ -0,0 +1,48 @@
+#ifndef SPIRVHALFPRECISION_H
+#define SPIRVHALFPRECISION_H
+
+#include <QMap>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+class SpirvModule;
+
+// 一组相互依赖、可整体改为 16 位的浮点运算
+struct HalfPrecisionChain
+{
+    QString function;
+    int aluOps = 0;
+    bool rangeProven = false; // 链上所有值的取值范围都已确定在 FP16 范围内
+    QStringList locations; // 涉及的源代码位置，如 "shader.hlsl:12"
+    QStringList sources; // 链的输入，如 "texture albedoMap"、"input vNormal"
+    QMap<QString, int> opcodes; // 运算指令名 -> 数量
+};
+
+// 模块的半精度分析结果
+struct HalfPrecisionReport
+{
+    int fp32AluOps = 0; // 32 位浮点运算指令数
+    int halfAluOps = 0; // 已是 16 位类型的浮点运算指令数
+    int relaxedAluOps = 0; // 已有 RelaxedPrecision 修饰的 32 位运算指令数
+    int candidateOps = 0; // 可改为 16 位的 32 位运算指令数（不含已 RelaxedPrecision 的）
+    int provenOps = 0; // 其中取值范围已确定的
+    QMap<QString, int> riskyOps; // 需要保留 32 位的原因 -> 运算指令数
+    QVector<HalfPrecisionChain> chains; // 按运算数降序
+
+    // 可改为 16 位的运算占全部浮点运算的比例
+    double candidateShare() const;
+};
+
+// SpirvHalfPrecision 从输入、纹理及常量出发做区间传播，并从位置/深度输出、纹理坐标、
+// 整数转换、大范围的 sin/cos/fract/mod 参数及循环累加反向标记需要 32 位精度的值，其余 32 位浮点运算按数据依赖分组，
+// 作为 min16float / float16_t / mediump（RelaxedPrecision）的候选。
+class SpirvHalfPrecision
+{
+public:
+    static HalfPrecisionReport analyze(const SpirvModule &module, int maxChains = 15);
+
+    static QString reportText(const HalfPrecisionReport &report);
+};
+
+#endif // SPIRVHALFPRECISION_H
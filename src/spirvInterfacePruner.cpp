@@ -0,0 +1,405 @@
+#include "SPIRV-Reflect/include/spirv/unified1/spirv.h"
+#include "spirvInterfacePruner.h"
+#include "spirvModule.h"
+#include "spirvPassPipeline.h"
+#include <QMap>
+#include <QHash>
+
+namespace {
+
+// 输入/输出带外层逐顶点数组的执行模型
+bool isArrayedInput(uint32_t executionModel)
+{
+    return executionModel == SpvExecutionModelTessellationControl || executionModel == SpvExecutionModelTessellationEvaluation
+        || executionModel == SpvExecutionModelGeometry;
+}
+
+bool isArrayedOutput(uint32_t executionModel)
+{
+    return executionModel == SpvExecutionModelTessellationControl || executionModel == SpvExecutionModelMeshNV
+        || executionModel == SpvExecutionModelMeshEXT;
+}
+
+// 类型占用的 location 数量
+int locationCount(const SpirvModule &module, uint32_t typeId)
+{
+    int index = module.definition(typeId);
+    if (index < 0) {
+        return 1;
+    }
+
+    const SpirvModule::Instruction &inst = module.instruction(index);
+    switch (inst.opcode) {
+    case SpvOpTypeArray:
+        return static_cast<int>(module.constantValue(module.operand(inst, 2), 1)) * locationCount(module, module.operand(inst, 1));
+    case SpvOpTypeMatrix:
+        return static_cast<int>(module.operand(inst, 2)) * locationCount(module, module.operand(inst, 1));
+    case SpvOpTypeStruct: {
+        int count = 0;
+        for (int i = 1; i < module.operandCount(inst); ++i) {
+            count += locationCount(module, module.operand(inst, i));
+        }
+        return qMax(count, 1);
+    }
+    case SpvOpTypeVector: {
+        // 64 位三、四分量向量占两个 location
+        int componentIndex = module.definition(module.operand(inst, 1));
+        bool is64Bit = componentIndex >= 0 && module.operand(module.instruction(componentIndex), 1) == 64;
+        return is64Bit && module.operand(inst, 2) > 2 ? 2 : 1;
+    }
+    default:
+        return 1;
+    }
+}
+
+// 去掉逐顶点外层数组
+uint32_t elementType(const SpirvModule &module, uint32_t typeId)
+{
+    int index = module.definition(typeId);
+    if (index >= 0 && (module.instruction(index).opcode == SpvOpTypeArray || module.instruction(index).opcode == SpvOpTypeRuntimeArray)) {
+        return module.operand(module.instruction(index), 1);
+    }
+    return typeId;
+}
+
+bool hasBuiltInMember(const SpirvModule &module, uint32_t typeId)
+{
+    for (const SpirvModule::Decoration &decoration : module.decorations(typeId)) {
+        if (decoration.decoration == SpvDecorationBuiltIn) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// 函数体内引用的所有 ID（按字扫描，字面量可能误判为引用，只会让变量保留）
+QSet<uint32_t> referencedIds(const SpirvModule &module)
+{
+    QSet<uint32_t> ids;
+    for (const SpirvModule::Function &function : module.functions()) {
+        for (int i = function.firstInstruction; i < function.firstInstruction + function.instructionCount; ++i) {
+            const SpirvModule::Instruction &inst = module.instruction(i);
+            const uint32_t *words = module.words(inst);
+            for (int w = 1; w < inst.wordCount; ++w) {
+                if (words[w] != inst.resultId) {
+                    ids.insert(words[w]);
+                }
+            }
+        }
+    }
+    return ids;
+}
+
+int functionInstructionCount(const SpirvModule &module)
+{
+    int count = 0;
+    for (const SpirvModule::Function &function : module.functions()) {
+        count += function.instructionCount;
+    }
+    return count;
+}
+
+bool optimize(const QByteArray &binary, const QStringList &passes, QByteArray &optimized, QString &error)
+{
+    if (passes.isEmpty()) {
+        optimized = binary;
+        return true;
+    }
+
+    QVector<SpirvPassResult> results = SpirvPassPipeline::run(binary, passes, &optimized);
+    for (const SpirvPassResult &result : results) {
+        if (!result.success) {
+            error = QString("%1: %2").arg(result.pass).arg(result.error.trimmed());
+            return false;
+        }
+    }
+    return true;
+}
+
+bool overlaps(const SpirvInterfaceVariable &a, const SpirvInterfaceVariable &b)
+{
+    return a.location < b.location + b.locationCount && b.location < a.location + a.locationCount;
+}
+
+QString variableText(const SpirvInterfaceVariable &variable)
+{
+    QString name = variable.name.isEmpty() ? QString("%%1").arg(variable.id) : variable.name;
+    return QString("%1 (location %2)").arg(name).arg(variable.location);
+}
+
+} // namespace
+
+QVector<SpirvInterfaceVariable> SpirvInterfacePruner::interfaceVariables(const SpirvModule &module, uint32_t storageClass)
+{
+    QVector<SpirvInterfaceVariable> variables;
+    if (module.entryPoints().isEmpty()) {
+        return variables;
+    }
+
+    const SpirvModule::EntryPoint &entryPoint = module.entryPoints().first();
+    bool arrayed = storageClass == SpvStorageClassInput ? isArrayedInput(entryPoint.executionModel) : isArrayedOutput(entryPoint.executionModel);
+    QSet<uint32_t> referenced = referencedIds(module);
+
+    for (uint32_t id : entryPoint.interfaceIds) {
+        int index = module.definition(id);
+        if (index < 0) {
+            continue;
+        }
+        const SpirvModule::Instruction &inst = module.instruction(index);
+        if (inst.opcode != SpvOpVariable || module.operand(inst, 2) != storageClass) {
+            continue;
+        }
+
+        // 指针类型 -> 变量类型，逐顶点/逐图元数组取元素类型
+        int pointerIndex = module.definition(inst.resultType);
+        uint32_t typeId = pointerIndex >= 0 ? module.operand(module.instruction(pointerIndex), 2) : 0;
+        if (arrayed || module.hasDecoration(id, SpvDecorationPerPrimitiveEXT)) {
+            typeId = elementType(module, typeId);
+        }
+
+        SpirvInterfaceVariable variable;
+        variable.id = id;
+        variable.name = module.name(id);
+        variable.builtIn = module.hasDecoration(id, SpvDecorationBuiltIn) || hasBuiltInMember(module, typeId);
+        uint32_t location = 0;
+        if (module.hasDecoration(id, SpvDecorationLocation, &location)) {
+            variable.location = static_cast<int>(location);
+        }
+        variable.locationCount = locationCount(module, typeId);
+        variable.live = referenced.contains(id);
+        if (!variable.builtIn) {
+            variables.append(variable);
+        }
+    }
+    return variables;
+}
+
+QByteArray SpirvInterfacePruner::demoteToPrivate(const SpirvModule &module, const QSet<uint32_t> &variableIds)
+{
+    if (module.instructionCount() == 0) {
+        return QByteArray();
+    }
+
+    // 由变量派生的指针（访问链、拷贝）
+    QSet<uint32_t> derivedIds = variableIds;
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (const SpirvModule::Function &function : module.functions()) {
+            for (int i = function.firstInstruction; i < function.firstInstruction + function.instructionCount; ++i) {
+                const SpirvModule::Instruction &inst = module.instruction(i);
+                bool isPointerOp = inst.opcode == SpvOpAccessChain || inst.opcode == SpvOpInBoundsAccessChain
+                    || inst.opcode == SpvOpPtrAccessChain || inst.opcode == SpvOpInBoundsPtrAccessChain || inst.opcode == SpvOpCopyObject;
+                if (isPointerOp && !derivedIds.contains(inst.resultId) && derivedIds.contains(module.operand(inst, 2))) {
+                    derivedIds.insert(inst.resultId);
+                    changed = true;
+                }
+            }
+        }
+    }
+
+    // 每个用到的 Input/Output 指针类型对应一个新的 Private 指针类型
+    uint32_t bound = module.bound();
+    QHash<uint32_t, uint32_t> privatePointerTypes;
+    for (int i = 0; i < module.instructionCount(); ++i) {
+        const SpirvModule::Instruction &inst = module.instruction(i);
+        if (inst.resultId != 0 && derivedIds.contains(inst.resultId) && !privatePointerTypes.contains(inst.resultType)) {
+            privatePointerTypes.insert(inst.resultType, bound++);
+        }
+    }
+
+    QVector<uint32_t> words = module.headerWords();
+    words.reserve(static_cast<int>(module.wordCount()) + privatePointerTypes.size() * 4);
+    words[3] = bound;
+
+    bool keepInInterface = module.version() >= 0x00010400;
+    for (int i = 0; i < module.instructionCount(); ++i) {
+        const SpirvModule::Instruction &inst = module.instruction(i);
+        const uint32_t *instWords = module.words(inst);
+
+        switch (inst.opcode) {
+        case SpvOpDecorate:
+        case SpvOpDecorateId:
+        case SpvOpDecorateString:
+            if (variableIds.contains(instWords[1])) {
+                continue;
+            }
+            break;
+        case SpvOpEntryPoint:
+            if (!keepInInterface) {
+                int nameWords = 0;
+                module.literalString(inst, 2, &nameWords);
+                int interfaceStart = 3 + nameWords;
+                int start = words.size();
+                for (int w = 0; w < inst.wordCount; ++w) {
+                    if (w < interfaceStart || !variableIds.contains(instWords[w])) {
+                        words.append(instWords[w]);
+                    }
+                }
+                words[start] = (static_cast<uint32_t>(words.size() - start) << SpvWordCountShift) | SpvOpEntryPoint;
+                continue;
+            }
+            break;
+        default:
+            break;
+        }
+
+        int start = words.size();
+        for (int w = 0; w < inst.wordCount; ++w) {
+            words.append(instWords[w]);
+        }
+
+        if (inst.opcode == SpvOpTypePointer && privatePointerTypes.contains(inst.resultId)) {
+            words.append((4u << SpvWordCountShift) | SpvOpTypePointer);
+            words.append(privatePointerTypes.value(inst.resultId));
+            words.append(SpvStorageClassPrivate);
+            words.append(instWords[3]);
+        } else if (inst.resultId != 0 && derivedIds.contains(inst.resultId)) {
+            words[start + 1] = privatePointerTypes.value(inst.resultType);
+            if (inst.opcode == SpvOpVariable) {
+                words[start + 3] = SpvStorageClassPrivate;
+            }
+        }
+    }
+
+    return QByteArray(reinterpret_cast<const char *>(words.constData()), words.size() * static_cast<int>(sizeof(uint32_t)));
+}
+
+bool SpirvInterfacePruner::prune(const QByteArray &producer, const QByteArray &consumer, const QStringList &optimizePasses,
+                                 SpirvStagePruneResult &producerResult, SpirvStagePruneResult &consumerResult,
+                                 QStringList &warnings, QString &error)
+{
+    SpirvModule producerModule;
+    SpirvModule consumerModule;
+    if (!producerModule.parse(producer, &error) || !consumerModule.parse(consumer, &error)) {
+        return false;
+    }
+    if (producerModule.entryPoints().isEmpty() || consumerModule.entryPoints().isEmpty()) {
+        error = "Both stages need an entry point.";
+        return false;
+    }
+
+    producerResult = SpirvStagePruneResult();
+    consumerResult = SpirvStagePruneResult();
+    producerResult.stage = SpirvModule::stageName(producerModule.entryPoints().first().executionModel);
+    consumerResult.stage = SpirvModule::stageName(consumerModule.entryPoints().first().executionModel);
+
+    QVector<SpirvInterfaceVariable> outputs = interfaceVariables(producerModule, SpvStorageClassOutput);
+    QVector<SpirvInterfaceVariable> inputs = interfaceVariables(consumerModule, SpvStorageClassInput);
+
+    // 未优化的模块中入口包装函数把每个输入都复制到局部变量，按引用判断时所有输入都存活，
+    // 因此先优化消费者（未指定优化参数时用 -O），再按优化后仍被引用的输入判断存活；spirv-opt 不改变保留下来的 ID
+    QByteArray optimizedConsumer;
+    SpirvModule optimizedConsumerModule;
+    if (!optimize(consumer, optimizePasses.isEmpty() ? QStringList{ "-O" } : optimizePasses, optimizedConsumer, error)) {
+        error = QString("%1: %2").arg(consumerResult.stage).arg(error);
+        return false;
+    }
+    if (!optimizedConsumerModule.parse(optimizedConsumer, &error)) {
+        return false;
+    }
+    QSet<uint32_t> liveInputIds;
+    for (const SpirvInterfaceVariable &input : interfaceVariables(optimizedConsumerModule, SpvStorageClassInput)) {
+        if (input.live) {
+            liveInputIds.insert(input.id);
+        }
+    }
+    for (SpirvInterfaceVariable &input : inputs) {
+        input.live = liveInputIds.contains(input.id);
+    }
+
+    // 消费者未读取的输入
+    QSet<uint32_t> deadInputs;
+    QVector<SpirvInterfaceVariable> liveInputs;
+    for (const SpirvInterfaceVariable &input : inputs) {
+        if (input.location >= 0 && !input.live) {
+            deadInputs.insert(input.id);
+            consumerResult.removedVaryings << variableText(input);
+        } else {
+            liveInputs.append(input);
+        }
+    }
+
+    // 生产者输出中没有任何存活输入与之 location 重叠的
+    QSet<uint32_t> deadOutputs;
+    for (const SpirvInterfaceVariable &output : outputs) {
+        if (output.location < 0) {
+            continue;
+        }
+        bool consumed = false;
+        for (const SpirvInterfaceVariable &input : liveInputs) {
+            consumed = consumed || input.location < 0 || overlaps(output, input);
+        }
+        if (!consumed) {
+            deadOutputs.insert(output.id);
+            producerResult.removedVaryings << variableText(output);
+        }
+    }
+
+    for (const SpirvInterfaceVariable &input : liveInputs) {
+        bool written = input.location < 0;
+        for (const SpirvInterfaceVariable &output : outputs) {
+            written = written || output.location < 0 || overlaps(output, input);
+        }
+        if (!written) {
+            warnings << QString("%1 reads %2, which %3 does not write").arg(consumerResult.stage).arg(variableText(input)).arg(producerResult.stage);
+        }
+    }
+
+    // 未裁剪及裁剪后的模块都经过相同优化，指令数才可比较
+    struct StageJob { const QByteArray *original; const SpirvModule *module; const QSet<uint32_t> *deadIds; SpirvStagePruneResult *result; uint32_t storageClass; };
+    StageJob jobs[] = {
+        { &producer, &producerModule, &deadOutputs, &producerResult, SpvStorageClassOutput },
+        { &consumer, &consumerModule, &deadInputs, &consumerResult, SpvStorageClassInput }
+    };
+    for (const StageJob &job : jobs) {
+        QByteArray baseline;
+        QByteArray pruned;
+        if (!optimize(*job.original, optimizePasses, baseline, error)
+            || !optimize(job.deadIds->isEmpty() ? *job.original : demoteToPrivate(*job.module, *job.deadIds), optimizePasses, pruned, error)) {
+            error = QString("%1: %2").arg(job.result->stage).arg(error);
+            return false;
+        }
+
+        SpirvModule baselineModule;
+        SpirvModule prunedModule;
+        if (!baselineModule.parse(baseline, &error) || !prunedModule.parse(pruned, &error)) {
+            return false;
+        }
+        job.result->varyingsBefore = interfaceVariables(baselineModule, job.storageClass).size();
+        job.result->varyingsAfter = interfaceVariables(prunedModule, job.storageClass).size();
+        job.result->instructionsBefore = functionInstructionCount(baselineModule);
+        job.result->instructionsAfter = functionInstructionCount(prunedModule);
+        job.result->prunedBinary = pruned;
+    }
+    return true;
+}
+
+QString SpirvInterfacePruner::reportText(const SpirvStagePruneResult &producer, const SpirvStagePruneResult &consumer, const QStringList &warnings)
+{
+    QString text;
+    for (const SpirvStagePruneResult *result : { &producer, &consumer }) {
+        text += QString("; %1 %2\n").arg(result->stage).arg(result == &producer ? "outputs" : "inputs");
+        text += QString("Varyings:     %1 -> %2 (%3)\n").arg(result->varyingsBefore).arg(result->varyingsAfter)
+            .arg(result->varyingsAfter - result->varyingsBefore);
+        text += QString("Instructions: %1 -> %2 (%3)\n").arg(result->instructionsBefore).arg(result->instructionsAfter)
+            .arg(result->instructionsAfter - result->instructionsBefore);
+        if (result->removedVaryings.isEmpty()) {
+            text += "Removed:      none\n";
+        } else {
+            text += "Removed:\n";
+            for (const QString &varying : result->removedVaryings) {
+                text += "  " + varying + "\n";
+            }
+        }
+        text += "\n";
+    }
+
+    if (!warnings.isEmpty()) {
+        text += "Warnings:\n";
+        for (const QString &warning : warnings) {
+            text += "  " + warning + "\n";
+        }
+    }
+    return text;
+}
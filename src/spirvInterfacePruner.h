@@ -0,0 +1,57 @@
+#ifndef SPIRVINTERFACEPRUNER_H
+#define SPIRVINTERFACEPRUNER_H
+
+#include <QString>
+#include <QStringList>
+#include <QByteArray>
+#include <QVector>
+#include <QSet>
+#include <cstdint>
+
+class SpirvModule;
+
+// 入口函数的输入/输出变量
+struct SpirvInterfaceVariable
+{
+    uint32_t id = 0;
+    QString name;
+    int location = -1; // Location 修饰，没有时为 -1（如 Block 成员各自带 Location）
+    int locationCount = 1; // 占用的 location 数量，逐顶点数组按单个元素计算
+    bool builtIn = false;
+    bool live = false; // 是否被函数体引用
+};
+
+// 单个阶段的裁剪结果，指令数均为 spirv-opt 优化后的函数体指令数
+struct SpirvStagePruneResult
+{
+    QString stage;
+    int varyingsBefore = 0;
+    int varyingsAfter = 0;
+    int instructionsBefore = 0;
+    int instructionsAfter = 0;
+    QStringList removedVaryings; // 被移除的变量，"名称 (location N)"
+    QByteArray prunedBinary; // 裁剪并优化后的 SPIR-V
+};
+
+// SpirvInterfacePruner 对分开编译的生产者/消费者阶段（VS/PS、Mesh/PS 等）做跨阶段接口裁剪：
+// 消费者不读取的输入及生产者输出中消费者用不到的 location 降级为 Private 变量并移出入口接口，
+// 再由 spirv-opt 删除相关的死存储及计算。
+class SpirvInterfacePruner
+{
+public:
+    // 裁剪并重新优化两个阶段，optimizePasses 为 spirv-opt 参数（如 -O）；消费者输入的存活性按优化后的模块判断
+    static bool prune(const QByteArray &producer, const QByteArray &consumer, const QStringList &optimizePasses,
+                      SpirvStagePruneResult &producerResult, SpirvStagePruneResult &consumerResult,
+                      QStringList &warnings, QString &error);
+
+    // 模块第一个入口函数指定存储类（Input/Output）的非内置变量
+    static QVector<SpirvInterfaceVariable> interfaceVariables(const SpirvModule &module, uint32_t storageClass);
+
+    // 将变量降级为 Private：改写变量及由其派生的指针类型，删除变量的修饰，SPIR-V 1.4 以下同时移出入口接口
+    static QByteArray demoteToPrivate(const SpirvModule &module, const QSet<uint32_t> &variableIds);
+
+    // 裁剪结果报告
+    static QString reportText(const SpirvStagePruneResult &producer, const SpirvStagePruneResult &consumer, const QStringList &warnings);
+};
+
+#endif // SPIRVINTERFACEPRUNER_H
@@ -0,0 +1,905 @@
+#define SPV_ENABLE_UTILITY_CODE
+#include "SPIRV-Reflect/include/spirv/unified1/spirv.h"
+#include "spirvModule.h"
+#include <QFileInfo>
+#include <QSet>
+#include <algorithm>
+
+// NonSemantic.Shader.DebugInfo.100 中 DebugSource 为 35，DebugLine 为 103，DebugNoLine 为 104
+static const uint32_t kDebugSource = 35;
+static const uint32_t kDebugLine = 103;
+static const uint32_t kDebugNoLine = 104;
+
+// 核心指令名称表，按操作码下标，空位为 nullptr
+static const char *const kCoreOpcodeNames[] = {
+    "Nop", "Undef", "SourceContinued", "Source", "SourceExtension", "Name", "MemberName", "String", "Line", nullptr,
+    "Extension", "ExtInstImport", "ExtInst", nullptr, "MemoryModel", "EntryPoint", "ExecutionMode", "Capability",
+    nullptr, "TypeVoid", "TypeBool", "TypeInt", "TypeFloat", "TypeVector", "TypeMatrix", "TypeImage", "TypeSampler",
+    "TypeSampledImage", "TypeArray", "TypeRuntimeArray", "TypeStruct", "TypeOpaque", "TypePointer", "TypeFunction",
+    "TypeEvent", "TypeDeviceEvent", "TypeReserveId", "TypeQueue", "TypePipe", "TypeForwardPointer", nullptr,
+    "ConstantTrue", "ConstantFalse", "Constant", "ConstantComposite", "ConstantSampler", "ConstantNull", nullptr,
+    "SpecConstantTrue", "SpecConstantFalse", "SpecConstant", "SpecConstantComposite", "SpecConstantOp", nullptr,
+    "Function", "FunctionParameter", "FunctionEnd", "FunctionCall", nullptr, "Variable", "ImageTexelPointer", "Load",
+    "Store", "CopyMemory", "CopyMemorySized", "AccessChain", "InBoundsAccessChain", "PtrAccessChain", "ArrayLength",
+    "GenericPtrMemSemantics", "InBoundsPtrAccessChain", "Decorate", "MemberDecorate", "DecorationGroup",
+    "GroupDecorate", "GroupMemberDecorate", nullptr, "VectorExtractDynamic", "VectorInsertDynamic", "VectorShuffle",
+    "CompositeConstruct", "CompositeExtract", "CompositeInsert", "CopyObject", "Transpose", nullptr, "SampledImage",
+    "ImageSampleImplicitLod", "ImageSampleExplicitLod", "ImageSampleDrefImplicitLod", "ImageSampleDrefExplicitLod",
+    "ImageSampleProjImplicitLod", "ImageSampleProjExplicitLod", "ImageSampleProjDrefImplicitLod",
+    "ImageSampleProjDrefExplicitLod", "ImageFetch", "ImageGather", "ImageDrefGather", "ImageRead", "ImageWrite",
+    "Image", "ImageQueryFormat", "ImageQueryOrder", "ImageQuerySizeLod", "ImageQuerySize", "ImageQueryLod",
+    "ImageQueryLevels", "ImageQuerySamples", nullptr, "ConvertFToU", "ConvertFToS", "ConvertSToF", "ConvertUToF",
+    "UConvert", "SConvert", "FConvert", "QuantizeToF16", "ConvertPtrToU", "SatConvertSToU", "SatConvertUToS",
+    "ConvertUToPtr", "PtrCastToGeneric", "GenericCastToPtr", "GenericCastToPtrExplicit", "Bitcast", nullptr, "SNegate",
+    "FNegate", "IAdd", "FAdd", "ISub", "FSub", "IMul", "FMul", "UDiv", "SDiv", "FDiv", "UMod", "SRem", "SMod", "FRem",
+    "FMod", "VectorTimesScalar", "MatrixTimesScalar", "VectorTimesMatrix", "MatrixTimesVector", "MatrixTimesMatrix",
+    "OuterProduct", "Dot", "IAddCarry", "ISubBorrow", "UMulExtended", "SMulExtended", nullptr, "Any", "All", "IsNan",
+    "IsInf", "IsFinite", "IsNormal", "SignBitSet", "LessOrGreater", "Ordered", "Unordered", "LogicalEqual",
+    "LogicalNotEqual", "LogicalOr", "LogicalAnd", "LogicalNot", "Select", "IEqual", "INotEqual", "UGreaterThan",
+    "SGreaterThan", "UGreaterThanEqual", "SGreaterThanEqual", "ULessThan", "SLessThan", "ULessThanEqual",
+    "SLessThanEqual", "FOrdEqual", "FUnordEqual", "FOrdNotEqual", "FUnordNotEqual", "FOrdLessThan", "FUnordLessThan",
+    "FOrdGreaterThan", "FUnordGreaterThan", "FOrdLessThanEqual", "FUnordLessThanEqual", "FOrdGreaterThanEqual",
+    "FUnordGreaterThanEqual", nullptr, nullptr, "ShiftRightLogical", "ShiftRightArithmetic", "ShiftLeftLogical",
+    "BitwiseOr", "BitwiseXor", "BitwiseAnd", "Not", "BitFieldInsert", "BitFieldSExtract", "BitFieldUExtract",
+    "BitReverse", "BitCount", nullptr, "DPdx", "DPdy", "Fwidth", "DPdxFine", "DPdyFine", "FwidthFine", "DPdxCoarse",
+    "DPdyCoarse", "FwidthCoarse", nullptr, nullptr, "EmitVertex", "EndPrimitive", "EmitStreamVertex",
+    "EndStreamPrimitive", nullptr, nullptr, "ControlBarrier", "MemoryBarrier", nullptr, "AtomicLoad", "AtomicStore",
+    "AtomicExchange", "AtomicCompareExchange", "AtomicCompareExchangeWeak", "AtomicIIncrement", "AtomicIDecrement",
+    "AtomicIAdd", "AtomicISub", "AtomicSMin", "AtomicUMin", "AtomicSMax", "AtomicUMax", "AtomicAnd", "AtomicOr",
+    "AtomicXor", nullptr, nullptr, "Phi", "LoopMerge", "SelectionMerge", "Label", "Branch", "BranchConditional",
+    "Switch", "Kill", "Return", "ReturnValue", "Unreachable", "LifetimeStart", "LifetimeStop", nullptr,
+    "GroupAsyncCopy", "GroupWaitEvents", "GroupAll", "GroupAny", "GroupBroadcast", "GroupIAdd", "GroupFAdd",
+    "GroupFMin", "GroupUMin", "GroupSMin", "GroupFMax", "GroupUMax", "GroupSMax", nullptr, nullptr, "ReadPipe",
+    "WritePipe", "ReservedReadPipe", "ReservedWritePipe", "ReserveReadPipePackets", "ReserveWritePipePackets",
+    "CommitReadPipe", "CommitWritePipe", "IsValidReserveId", "GetNumPipePackets", "GetMaxPipePackets",
+    "GroupReserveReadPipePackets", "GroupReserveWritePipePackets", "GroupCommitReadPipe", "GroupCommitWritePipe",
+    nullptr, nullptr, "EnqueueMarker", "EnqueueKernel", "GetKernelNDrangeSubGroupCount",
+    "GetKernelNDrangeMaxSubGroupSize", "GetKernelWorkGroupSize", "GetKernelPreferredWorkGroupSizeMultiple",
+    "RetainEvent", "ReleaseEvent", "CreateUserEvent", "IsValidEvent", "SetUserEventStatus", "CaptureEventProfilingInfo",
+    "GetDefaultQueue", "BuildNDRange", "ImageSparseSampleImplicitLod", "ImageSparseSampleExplicitLod",
+    "ImageSparseSampleDrefImplicitLod", "ImageSparseSampleDrefExplicitLod", "ImageSparseSampleProjImplicitLod",
+    "ImageSparseSampleProjExplicitLod", "ImageSparseSampleProjDrefImplicitLod", "ImageSparseSampleProjDrefExplicitLod",
+    "ImageSparseFetch", "ImageSparseGather", "ImageSparseDrefGather", "ImageSparseTexelsResident", "NoLine",
+    "AtomicFlagTestAndSet", "AtomicFlagClear", "ImageSparseRead", "SizeOf", "TypePipeStorage", "ConstantPipeStorage",
+    "CreatePipeFromPipeStorage", "GetKernelLocalSizeForSubgroupCount", "GetKernelMaxNumSubgroups", "TypeNamedBarrier",
+    "NamedBarrierInitialize", "MemoryNamedBarrier", "ModuleProcessed", "ExecutionModeId", "DecorateId",
+    "GroupNonUniformElect", "GroupNonUniformAll", "GroupNonUniformAny", "GroupNonUniformAllEqual",
+    "GroupNonUniformBroadcast", "GroupNonUniformBroadcastFirst", "GroupNonUniformBallot",
+    "GroupNonUniformInverseBallot", "GroupNonUniformBallotBitExtract", "GroupNonUniformBallotBitCount",
+    "GroupNonUniformBallotFindLSB", "GroupNonUniformBallotFindMSB", "GroupNonUniformShuffle",
+    "GroupNonUniformShuffleXor", "GroupNonUniformShuffleUp", "GroupNonUniformShuffleDown", "GroupNonUniformIAdd",
+    "GroupNonUniformFAdd", "GroupNonUniformIMul", "GroupNonUniformFMul", "GroupNonUniformSMin", "GroupNonUniformUMin",
+    "GroupNonUniformFMin", "GroupNonUniformSMax", "GroupNonUniformUMax", "GroupNonUniformFMax",
+    "GroupNonUniformBitwiseAnd", "GroupNonUniformBitwiseOr", "GroupNonUniformBitwiseXor", "GroupNonUniformLogicalAnd",
+    "GroupNonUniformLogicalOr", "GroupNonUniformLogicalXor", "GroupNonUniformQuadBroadcast", "GroupNonUniformQuadSwap",
+};
+
+SpirvModule::SpirvModule()
+    : moduleWords(nullptr)
+    , moduleWordCount(0)
+    , headerVersion(0)
+    , headerGenerator(0)
+    , headerBound(0) {}
+
+void SpirvModule::clear()
+{
+    ownedBinary.clear();
+    moduleWords = nullptr;
+    moduleWordCount = 0;
+    headerVersion = 0;
+    headerGenerator = 0;
+    headerBound = 0;
+
+    instructions.clear();
+    definitionIndex.clear();
+    nameIndex.clear();
+    memberNameIndex.clear();
+    decorationList.clear();
+    decorationIndex.clear();
+    functionList.clear();
+    typeIdList.clear();
+    constantIdList.clear();
+    entryPointList.clear();
+    extInstSetNames.clear();
+    histogram.clear();
+}
+
+bool SpirvModule::parse(const QByteArray &binary, QString *error)
+{
+    // QByteArray 的数据按堆分配对齐，可直接作为 uint32_t 字序列使用
+    QByteArray data = binary;
+    bool success = parse(reinterpret_cast<const uint32_t *>(data.constData()), data.size() / sizeof(uint32_t), error);
+    if (success) {
+        ownedBinary = data;
+    }
+    return success;
+}
+
+static bool isTypeOpcode(uint32_t opcode)
+{
+    return (opcode >= SpvOpTypeVoid && opcode <= SpvOpTypeForwardPointer) ||
+           opcode == SpvOpTypeRayQueryKHR ||
+           opcode == SpvOpTypeAccelerationStructureKHR;
+}
+
+static bool isConstantOpcode(uint32_t opcode)
+{
+    return opcode >= SpvOpConstantTrue && opcode <= SpvOpSpecConstantOp;
+}
+
+bool SpirvModule::parse(const uint32_t *words, size_t wordCount, QString *error)
+{
+    clear();
+
+    auto fail = [this, error](const QString &message) {
+        clear();
+        if (error) {
+            *error = message;
+        }
+        return false;
+    };
+
+    if (words == nullptr || wordCount < 5 || words[0] != SpvMagicNumber) {
+        return fail("Invalid SPIR-V header.");
+    }
+
+    moduleWords = words;
+    moduleWordCount = wordCount;
+    headerVersion = words[1];
+    headerGenerator = words[2];
+    headerBound = words[3];
+
+    // 按 ID 下标的表，bound 为最大 ID + 1
+    definitionIndex.fill(-1, static_cast<int>(headerBound));
+    nameIndex.fill(-1, static_cast<int>(headerBound));
+    instructions.reserve(static_cast<int>(wordCount / 4));
+
+    Function *currentFunction = nullptr;
+    BasicBlock *currentBlock = nullptr;
+
+    size_t offset = 5;
+    while (offset < wordCount) {
+        uint32_t firstWord = words[offset];
+        uint16_t opcode = static_cast<uint16_t>(firstWord & SpvOpCodeMask);
+        uint16_t instWordCount = static_cast<uint16_t>(firstWord >> SpvWordCountShift);
+        if (instWordCount == 0 || offset + instWordCount > wordCount) {
+            return fail(QString("Invalid instruction at word %1.").arg(offset));
+        }
+
+        Instruction inst;
+        inst.offset = static_cast<uint32_t>(offset);
+        inst.opcode = opcode;
+        inst.wordCount = instWordCount;
+
+        bool hasResult = false;
+        bool hasResultType = false;
+        SpvHasResultAndType(static_cast<SpvOp>(opcode), &hasResult, &hasResultType);
+        int resultOperand = hasResultType ? 2 : 1;
+        if (hasResultType && instWordCount > 1) {
+            inst.resultType = words[offset + 1];
+        }
+        if (hasResult && instWordCount > resultOperand) {
+            inst.resultId = words[offset + resultOperand];
+        }
+
+        int index = instructions.size();
+        instructions.append(inst);
+        histogram[opcode]++;
+
+        if (inst.resultId != 0 && inst.resultId < headerBound) {
+            definitionIndex[static_cast<int>(inst.resultId)] = index;
+        }
+
+        const uint32_t *operands = words + offset + 1;
+        int operandCount = instWordCount - 1;
+
+        switch (opcode)
+        {
+            case SpvOpName:
+                if (operandCount >= 1 && operands[0] < headerBound) {
+                    nameIndex[static_cast<int>(operands[0])] = index;
+                }
+                break;
+            case SpvOpMemberName:
+                if (operandCount >= 2) {
+                    memberNameIndex.insert(operands[0], index);
+                }
+                break;
+            case SpvOpDecorate:
+            case SpvOpDecorateId:
+            case SpvOpDecorateString:
+                if (operandCount >= 2) {
+                    Decoration decoration;
+                    decoration.target = operands[0];
+                    decoration.decoration = operands[1];
+                    decoration.instruction = index;
+                    decorationIndex.insert(decoration.target, decorationList.size());
+                    decorationList.append(decoration);
+                }
+                break;
+            case SpvOpMemberDecorate:
+            case SpvOpMemberDecorateString:
+                if (operandCount >= 3) {
+                    Decoration decoration;
+                    decoration.target = operands[0];
+                    decoration.member = operands[1];
+                    decoration.decoration = operands[2];
+                    decoration.instruction = index;
+                    decorationIndex.insert(decoration.target, decorationList.size());
+                    decorationList.append(decoration);
+                }
+                break;
+            case SpvOpExtInstImport:
+                extInstSetNames.insert(inst.resultId, literalString(inst, 1));
+                break;
+            case SpvOpEntryPoint:
+                if (operandCount >= 3) {
+                    EntryPoint entryPoint;
+                    entryPoint.executionModel = operands[0];
+                    entryPoint.functionId = operands[1];
+                    int nameWords = 0;
+                    entryPoint.name = literalString(inst, 2, &nameWords);
+                    for (int i = 2 + nameWords; i < operandCount; ++i) {
+                        entryPoint.interfaceIds.append(operands[i]);
+                    }
+                    entryPointList.append(entryPoint);
+                }
+                break;
+            case SpvOpExecutionMode:
+                if (operandCount >= 5 && operands[1] == SpvExecutionModeLocalSize) {
+                    for (EntryPoint &entryPoint : entryPointList) {
+                        if (entryPoint.functionId == operands[0]) {
+                            entryPoint.localSize[0] = operands[2];
+                            entryPoint.localSize[1] = operands[3];
+                            entryPoint.localSize[2] = operands[4];
+                        }
+                    }
+                }
+                break;
+            case SpvOpFunction:
+                functionList.append(Function());
+                currentFunction = &functionList.last();
+                currentFunction->id = inst.resultId;
+                currentFunction->resultType = inst.resultType;
+                currentFunction->functionType = operandCount >= 4 ? operands[3] : 0;
+                currentFunction->firstInstruction = index;
+                currentBlock = nullptr;
+                break;
+            case SpvOpLabel:
+                if (currentFunction) {
+                    if (currentBlock) {
+                        currentBlock->instructionCount = index - currentBlock->firstInstruction;
+                    }
+                    currentFunction->blocks.append(BasicBlock());
+                    currentBlock = &currentFunction->blocks.last();
+                    currentBlock->labelId = inst.resultId;
+                    currentBlock->firstInstruction = index;
+                }
+                break;
+            case SpvOpFunctionEnd:
+                if (currentFunction) {
+                    if (currentBlock) {
+                        currentBlock->instructionCount = index - currentBlock->firstInstruction;
+                    }
+                    currentFunction->instructionCount = index + 1 - currentFunction->firstInstruction;
+                }
+                currentFunction = nullptr;
+                currentBlock = nullptr;
+                break;
+            default:
+                if (currentFunction == nullptr) {
+                    if (isTypeOpcode(opcode)) {
+                        typeIdList.append(inst.resultId);
+                    } else if (isConstantOpcode(opcode)) {
+                        constantIdList.append(inst.resultId);
+                    }
+                }
+                break;
+        }
+
+        offset += instWordCount;
+    }
+
+    if (currentFunction) {
+        return fail("Missing OpFunctionEnd.");
+    }
+
+    return true;
+}
+
+QVector<uint32_t> SpirvModule::headerWords() const
+{
+    QVector<uint32_t> header;
+    if (moduleWords != nullptr && moduleWordCount >= 5) {
+        for (int w = 0; w < 5; ++w) {
+            header.append(moduleWords[w]);
+        }
+    }
+    return header;
+}
+
+uint32_t SpirvModule::operand(const Instruction &inst, int operandIndex) const
+{
+    if (operandIndex < 0 || operandIndex >= inst.wordCount - 1) {
+        return 0;
+    }
+    return moduleWords[inst.offset + 1 + operandIndex];
+}
+
+QString SpirvModule::literalString(const Instruction &inst, int operandIndex, int *operandWords) const
+{
+    // 字符串按小端序打包在字中，以 0 结尾
+    QByteArray bytes;
+    int count = 0;
+    for (int i = operandIndex; i < inst.wordCount - 1; ++i) {
+        uint32_t word = moduleWords[inst.offset + 1 + i];
+        ++count;
+        bool terminated = false;
+        for (int byte = 0; byte < 4; ++byte) {
+            char c = static_cast<char>((word >> (byte * 8)) & 0xff);
+            if (c == 0) {
+                terminated = true;
+                break;
+            }
+            bytes.append(c);
+        }
+        if (terminated) {
+            break;
+        }
+    }
+
+    if (operandWords) {
+        *operandWords = count;
+    }
+    return QString::fromUtf8(bytes);
+}
+
+int SpirvModule::definition(uint32_t id) const
+{
+    if (id >= static_cast<uint32_t>(definitionIndex.size())) {
+        return -1;
+    }
+    return definitionIndex[static_cast<int>(id)];
+}
+
+uint32_t SpirvModule::constantValue(uint32_t id, uint32_t defaultValue, bool *isSpecConstant) const
+{
+    int index = definition(id);
+    if (index < 0) {
+        return defaultValue;
+    }
+    const Instruction &inst = instructions[index];
+    if (inst.opcode != SpvOpConstant && inst.opcode != SpvOpSpecConstant) {
+        return defaultValue;
+    }
+    if (isSpecConstant && inst.opcode == SpvOpSpecConstant) {
+        *isSpecConstant = true;
+    }
+    return operand(inst, 2);
+}
+
+uint32_t SpirvModule::storageClassOf(uint32_t pointerId) const
+{
+    int index = definition(pointerId);
+    int pointerType = index >= 0 ? definition(instructions[index].resultType) : -1;
+    if (pointerType < 0 || instructions[pointerType].opcode != SpvOpTypePointer) {
+        return UINT32_MAX;
+    }
+    return operand(instructions[pointerType], 1);
+}
+
+uint32_t SpirvModule::rootVariableOf(uint32_t id, QVector<uint32_t> *indices, uint32_t *samplerVariable) const
+{
+    for (int depth = 0; depth < 16; ++depth) {
+        int index = definition(id);
+        if (index < 0) {
+            return 0;
+        }
+        const Instruction &inst = instructions[index];
+        switch (inst.opcode) {
+        case SpvOpVariable:
+            return inst.resultId;
+        case SpvOpAccessChain:
+        case SpvOpInBoundsAccessChain:
+        case SpvOpPtrAccessChain:
+            if (indices) {
+                // OpPtrAccessChain 的 Element 操作数不是类型内的下标
+                indices->clear();
+                for (int i = inst.opcode == SpvOpPtrAccessChain ? 4 : 3; i < operandCount(inst); ++i) {
+                    indices->append(operand(inst, i));
+                }
+            }
+            id = operand(inst, 2);
+            break;
+        case SpvOpLoad:
+            // 加载得到的指针（缓冲区引用、变量指针）不指向被加载的变量
+            if (storageClassOf(inst.resultId) != UINT32_MAX) {
+                return 0;
+            }
+            id = operand(inst, 2);
+            break;
+        case SpvOpSampledImage:
+            if (samplerVariable) {
+                *samplerVariable = rootVariableOf(operand(inst, 3));
+            }
+            id = operand(inst, 2);
+            break;
+        case SpvOpImage:
+        case SpvOpCopyObject:
+            id = operand(inst, 2);
+            break;
+        default:
+            return 0;
+        }
+    }
+    return 0;
+}
+
+QString SpirvModule::variableName(uint32_t variableId) const
+{
+    QString variable = name(variableId);
+    if (!variable.isEmpty()) {
+        return variable;
+    }
+
+    // 匿名的块变量取块类型的名称
+    int index = definition(variableId);
+    int pointerType = index >= 0 ? definition(instructions[index].resultType) : -1;
+    if (pointerType >= 0) {
+        variable = name(operand(instructions[pointerType], 2));
+    }
+    return variable.isEmpty() ? QString("%%1").arg(variableId) : variable;
+}
+
+QString SpirvModule::SourceLocation::text() const
+{
+    return isValid() ? QString("%1:%2").arg(QFileInfo(file).fileName()).arg(line) : QString();
+}
+
+QString SpirvModule::stringOf(uint32_t id) const
+{
+    int index = definition(id);
+    if (index < 0 || instructions[index].opcode != SpvOpString) {
+        return QString();
+    }
+    return literalString(instructions[index], 1);
+}
+
+QString SpirvModule::mainSourceFile() const
+{
+    QString debugSourceFile;
+    for (const Instruction &inst : instructions) {
+        if (inst.opcode == SpvOpFunction) {
+            break;
+        }
+        if (inst.opcode == SpvOpSource && operandCount(inst) > 2) {
+            return stringOf(operand(inst, 2));
+        }
+        if (inst.opcode == SpvOpExtInst && operand(inst, 3) == kDebugSource && debugSourceFile.isEmpty()) {
+            int setIndex = definition(operand(inst, 2));
+            if (setIndex >= 0 && literalString(instructions[setIndex], 1) == "NonSemantic.Shader.DebugInfo.100") {
+                debugSourceFile = stringOf(operand(inst, 4));
+            }
+        }
+    }
+    return debugSourceFile;
+}
+
+QVector<SpirvModule::SourceLocation> SpirvModule::sourceLocations() const
+{
+    QVector<SourceLocation> locations(instructions.size());
+
+    QSet<uint32_t> debugInfoSets; // NonSemantic.Shader.DebugInfo.100 的 OpExtInstImport 结果 ID
+    QHash<uint32_t, QString> debugSourceFiles; // DebugSource 结果 ID -> 文件名
+    for (const Instruction &inst : instructions) {
+        if (inst.opcode == SpvOpFunction) {
+            break;
+        }
+        if (inst.opcode == SpvOpExtInstImport && extInstSetName(inst.resultId) == "NonSemantic.Shader.DebugInfo.100") {
+            debugInfoSets.insert(inst.resultId);
+        } else if (inst.opcode == SpvOpExtInst && operand(inst, 3) == kDebugSource && debugInfoSets.contains(operand(inst, 2))) {
+            debugSourceFiles.insert(inst.resultId, stringOf(operand(inst, 4)));
+        }
+    }
+
+    for (const Function &function : functionList) {
+        SourceLocation location;
+        for (int i = function.firstInstruction; i < function.firstInstruction + function.instructionCount; ++i) {
+            const Instruction &inst = instructions[i];
+            if (inst.opcode == SpvOpLabel || inst.opcode == SpvOpNoLine) {
+                location = SourceLocation();
+            } else if (inst.opcode == SpvOpLine) {
+                location.file = stringOf(operand(inst, 0));
+                location.line = static_cast<int>(operand(inst, 1));
+            } else if (inst.opcode == SpvOpExtInst && debugInfoSets.contains(operand(inst, 2))) {
+                if (operand(inst, 3) == kDebugLine) {
+                    location.file = debugSourceFiles.value(operand(inst, 4));
+                    location.line = static_cast<int>(constantValue(operand(inst, 5)));
+                } else if (operand(inst, 3) == kDebugNoLine) {
+                    location = SourceLocation();
+                }
+            }
+            locations[i] = location;
+        }
+    }
+    return locations;
+}
+
+QString SpirvModule::name(uint32_t id) const
+{
+    if (id >= static_cast<uint32_t>(nameIndex.size()) || nameIndex[static_cast<int>(id)] < 0) {
+        return QString();
+    }
+    return literalString(instructions[nameIndex[static_cast<int>(id)]], 1);
+}
+
+QString SpirvModule::memberName(uint32_t typeId, uint32_t member) const
+{
+    for (auto it = memberNameIndex.find(typeId); it != memberNameIndex.end() && it.key() == typeId; ++it) {
+        const Instruction &inst = instructions[it.value()];
+        if (operand(inst, 1) == member) {
+            return literalString(inst, 2);
+        }
+    }
+    return QString();
+}
+
+QVector<SpirvModule::Decoration> SpirvModule::decorations(uint32_t id) const
+{
+    QVector<Decoration> result;
+    for (auto it = decorationIndex.find(id); it != decorationIndex.end() && it.key() == id; ++it) {
+        result.append(decorationList[it.value()]);
+    }
+    return result;
+}
+
+bool SpirvModule::hasDecoration(uint32_t id, uint32_t decoration, uint32_t *value) const
+{
+    for (auto it = decorationIndex.find(id); it != decorationIndex.end() && it.key() == id; ++it) {
+        const Decoration &item = decorationList[it.value()];
+        if (item.member == UINT32_MAX && item.decoration == decoration) {
+            if (value) {
+                *value = operand(instructions[item.instruction], 2);
+            }
+            return true;
+        }
+    }
+    return false;
+}
+
+int SpirvModule::functionIndex(uint32_t functionId) const
+{
+    int index = definition(functionId);
+    if (index < 0) {
+        return -1;
+    }
+    return functionIndexOfInstruction(index);
+}
+
+int SpirvModule::functionIndexOfInstruction(int instructionIndex) const
+{
+    // 函数按指令顺序排列，二分查找
+    auto it = std::upper_bound(functionList.begin(), functionList.end(), instructionIndex,
+        [](int value, const Function &function) { return value < function.firstInstruction; });
+    if (it == functionList.begin()) {
+        return -1;
+    }
+    --it;
+    if (instructionIndex >= it->firstInstruction + it->instructionCount) {
+        return -1;
+    }
+    return static_cast<int>(it - functionList.begin());
+}
+
+QHash<uint32_t, int> SpirvModule::blockIndexOfLabel(const Function &function)
+{
+    QHash<uint32_t, int> result;
+    for (int b = 0; b < function.blocks.size(); ++b) {
+        result.insert(function.blocks[b].labelId, b);
+    }
+    return result;
+}
+
+QVector<QVector<int>> SpirvModule::blockSuccessors(const Function &function) const
+{
+    QHash<uint32_t, int> blockOfLabel = blockIndexOfLabel(function);
+    QVector<QVector<int>> result(function.blocks.size());
+    for (int b = 0; b < function.blocks.size(); ++b) {
+        const BasicBlock &block = function.blocks[b];
+        if (block.instructionCount <= 0) {
+            continue;
+        }
+
+        const Instruction &terminator = instructions[block.firstInstruction + block.instructionCount - 1];
+        QVector<int> &successors = result[b];
+        auto addLabel = [&](uint32_t label) {
+            int target = blockOfLabel.value(label, -1);
+            if (target >= 0 && !successors.contains(target)) {
+                successors.append(target);
+            }
+        };
+
+        switch (terminator.opcode) {
+        case SpvOpBranch:
+            addLabel(operand(terminator, 0));
+            break;
+        case SpvOpBranchConditional:
+            addLabel(operand(terminator, 1));
+            addLabel(operand(terminator, 2));
+            break;
+        case SpvOpSwitch: {
+            // 64 位选择子的字面量占两个字
+            int literalWords = 1;
+            int selectorDefinition = definition(operand(terminator, 0));
+            if (selectorDefinition >= 0) {
+                int typeDefinition = definition(instructions[selectorDefinition].resultType);
+                if (typeDefinition >= 0 && operand(instructions[typeDefinition], 1) == 64) {
+                    literalWords = 2;
+                }
+            }
+            addLabel(operand(terminator, 1));
+            for (int i = 2 + literalWords; i < operandCount(terminator); i += literalWords + 1) {
+                addLabel(operand(terminator, i));
+            }
+            break;
+        }
+        default:
+            break;
+        }
+    }
+    return result;
+}
+
+QVector<SpirvModule::Loop> SpirvModule::loops(const Function &function, const QVector<QVector<int>> &successors) const
+{
+    const int blockCount = function.blocks.size();
+    QHash<uint32_t, int> blockOfLabel = blockIndexOfLabel(function);
+    QVector<QVector<int>> predecessors(blockCount);
+    for (int b = 0; b < blockCount; ++b) {
+        for (int successor : successors.value(b)) {
+            predecessors[successor].append(b);
+        }
+    }
+
+    QVector<Loop> result;
+    for (int header = 0; header < blockCount; ++header) {
+        const BasicBlock &block = function.blocks[header];
+        if (block.instructionCount < 2) {
+            continue;
+        }
+        const Instruction &merge = instructions[block.firstInstruction + block.instructionCount - 2];
+        if (merge.opcode != SpvOpLoopMerge) {
+            continue;
+        }
+
+        // 自然循环：结构化 SPIR-V 中回边的源块排在循环头之后，从回边源块沿前驱回溯到循环头
+        Loop loop;
+        loop.header = header;
+        loop.mergeBlock = blockOfLabel.value(operand(merge, 0), -1);
+        loop.blocks.fill(false, blockCount);
+        loop.blocks[header] = true;
+        QVector<int> worklist;
+        for (int predecessor : predecessors[header]) {
+            if (predecessor >= header) {
+                loop.backEdgeSources.append(predecessor);
+                if (!loop.blocks[predecessor]) {
+                    loop.blocks[predecessor] = true;
+                    worklist.append(predecessor);
+                }
+            }
+        }
+        while (!worklist.isEmpty()) {
+            int b = worklist.takeLast();
+            for (int predecessor : predecessors[b]) {
+                if (!loop.blocks[predecessor]) {
+                    loop.blocks[predecessor] = true;
+                    worklist.append(predecessor);
+                }
+            }
+        }
+        result.append(loop);
+    }
+    return result;
+}
+
+QVector<uint32_t> SpirvModule::idOperands(const Instruction &inst) const
+{
+    int first = (inst.resultType != 0 ? 1 : 0) + (inst.resultId != 0 ? 1 : 0);
+    int last = operandCount(inst);
+    switch (inst.opcode) {
+    case SpvOpCompositeExtract:
+    case SpvOpLoad:
+    case SpvOpSwitch:
+    case SpvOpBranchConditional:
+        last = std::min(last, first + 1);
+        break;
+    case SpvOpCompositeInsert:
+    case SpvOpVectorShuffle:
+    case SpvOpStore:
+        last = std::min(last, first + 2);
+        break;
+    case SpvOpExtInst:
+        first += 2; // 指令集及指令编号
+        break;
+    case SpvOpBranch:
+    case SpvOpSelectionMerge:
+    case SpvOpLoopMerge:
+        last = first;
+        break;
+    default:
+        break;
+    }
+
+    QVector<uint32_t> ids;
+    for (int i = first; i < last; ++i) {
+        ids.append(operand(inst, i));
+    }
+    return ids;
+}
+
+QHash<uint32_t, int> SpirvModule::opcodeHistogram(int firstInstruction, int instructionCount) const
+{
+    QHash<uint32_t, int> result;
+    int last = std::min(firstInstruction + instructionCount, instructions.size());
+    for (int i = std::max(firstInstruction, 0); i < last; ++i) {
+        result[instructions[i].opcode]++;
+    }
+    return result;
+}
+
+bool SpirvModule::isImageReadOpcode(uint32_t opcode, bool *sparse)
+{
+    bool isSparse = false;
+    switch (opcode) {
+    case SpvOpImageSampleImplicitLod:
+    case SpvOpImageSampleExplicitLod:
+    case SpvOpImageSampleDrefImplicitLod:
+    case SpvOpImageSampleDrefExplicitLod:
+    case SpvOpImageSampleProjImplicitLod:
+    case SpvOpImageSampleProjExplicitLod:
+    case SpvOpImageSampleProjDrefImplicitLod:
+    case SpvOpImageSampleProjDrefExplicitLod:
+    case SpvOpImageFetch:
+    case SpvOpImageGather:
+    case SpvOpImageDrefGather:
+    case SpvOpImageRead:
+        break;
+    // 操作码 316~319（ImageSparseTexelsResident、NoLine、AtomicFlag*）夹在 Sparse 读取指令之间，不能按范围判断
+    case SpvOpImageSparseSampleImplicitLod:
+    case SpvOpImageSparseSampleExplicitLod:
+    case SpvOpImageSparseSampleDrefImplicitLod:
+    case SpvOpImageSparseSampleDrefExplicitLod:
+    case SpvOpImageSparseSampleProjImplicitLod:
+    case SpvOpImageSparseSampleProjExplicitLod:
+    case SpvOpImageSparseSampleProjDrefImplicitLod:
+    case SpvOpImageSparseSampleProjDrefExplicitLod:
+    case SpvOpImageSparseFetch:
+    case SpvOpImageSparseGather:
+    case SpvOpImageSparseDrefGather:
+    case SpvOpImageSparseRead:
+        isSparse = true;
+        break;
+    default:
+        return false;
+    }
+    if (sparse) {
+        *sparse = isSparse;
+    }
+    return true;
+}
+
+QString SpirvModule::opcodeName(uint32_t opcode)
+{
+    const size_t tableSize = sizeof(kCoreOpcodeNames) / sizeof(kCoreOpcodeNames[0]);
+    if (opcode < tableSize && kCoreOpcodeNames[opcode]) {
+        return QString(kCoreOpcodeNames[opcode]);
+    }
+    return QString("Op#%1").arg(opcode);
+}
+
+QString SpirvModule::stageName(uint32_t executionModel)
+{
+    switch (executionModel) {
+    case SpvExecutionModelVertex: return "Vertex";
+    case SpvExecutionModelTessellationControl: return "TessControl";
+    case SpvExecutionModelTessellationEvaluation: return "TessEvaluation";
+    case SpvExecutionModelGeometry: return "Geometry";
+    case SpvExecutionModelFragment: return "Pixel";
+    case SpvExecutionModelGLCompute: return "Compute";
+    case SpvExecutionModelTaskNV: case SpvExecutionModelTaskEXT: return "Task";
+    case SpvExecutionModelMeshNV: case SpvExecutionModelMeshEXT: return "Mesh";
+    default: return QString("ExecutionModel#%1").arg(executionModel);
+    }
+}
+
+QStringList SpirvModule::capabilityNames() const
+{
+    QStringList names;
+    for (const Instruction &inst : instructions) {
+        if (inst.opcode == SpvOpCapability) {
+            names << capabilityName(operand(inst, 0));
+        }
+    }
+    return names;
+}
+
+QString SpirvModule::capabilityName(uint32_t capability)
+{
+    switch (capability) {
+    case SpvCapabilityMatrix: return "Matrix";
+    case SpvCapabilityShader: return "Shader";
+    case SpvCapabilityGeometry: return "Geometry";
+    case SpvCapabilityTessellation: return "Tessellation";
+    case SpvCapabilityFloat16Buffer: return "Float16Buffer";
+    case SpvCapabilityFloat16: return "Float16";
+    case SpvCapabilityFloat64: return "Float64";
+    case SpvCapabilityInt64: return "Int64";
+    case SpvCapabilityInt64Atomics: return "Int64Atomics";
+    case SpvCapabilityInt16: return "Int16";
+    case SpvCapabilityInt8: return "Int8";
+    case SpvCapabilityImageGatherExtended: return "ImageGatherExtended";
+    case SpvCapabilityStorageImageMultisample: return "StorageImageMultisample";
+    case SpvCapabilityClipDistance: return "ClipDistance";
+    case SpvCapabilityCullDistance: return "CullDistance";
+    case SpvCapabilityImageCubeArray: return "ImageCubeArray";
+    case SpvCapabilitySampleRateShading: return "SampleRateShading";
+    case SpvCapabilityInputAttachment: return "InputAttachment";
+    case SpvCapabilitySparseResidency: return "SparseResidency";
+    case SpvCapabilityMinLod: return "MinLod";
+    case SpvCapabilitySampled1D: return "Sampled1D";
+    case SpvCapabilityImage1D: return "Image1D";
+    case SpvCapabilitySampledCubeArray: return "SampledCubeArray";
+    case SpvCapabilitySampledBuffer: return "SampledBuffer";
+    case SpvCapabilityImageBuffer: return "ImageBuffer";
+    case SpvCapabilityImageMSArray: return "ImageMSArray";
+    case SpvCapabilityStorageImageExtendedFormats: return "StorageImageExtendedFormats";
+    case SpvCapabilityImageQuery: return "ImageQuery";
+    case SpvCapabilityDerivativeControl: return "DerivativeControl";
+    case SpvCapabilityInterpolationFunction: return "InterpolationFunction";
+    case SpvCapabilityTransformFeedback: return "TransformFeedback";
+    case SpvCapabilityGeometryStreams: return "GeometryStreams";
+    case SpvCapabilityStorageImageReadWithoutFormat: return "StorageImageReadWithoutFormat";
+    case SpvCapabilityStorageImageWriteWithoutFormat: return "StorageImageWriteWithoutFormat";
+    case SpvCapabilityMultiViewport: return "MultiViewport";
+    case SpvCapabilityGroupNonUniform: return "GroupNonUniform";
+    case SpvCapabilityGroupNonUniformVote: return "GroupNonUniformVote";
+    case SpvCapabilityGroupNonUniformArithmetic: return "GroupNonUniformArithmetic";
+    case SpvCapabilityGroupNonUniformBallot: return "GroupNonUniformBallot";
+    case SpvCapabilityGroupNonUniformShuffle: return "GroupNonUniformShuffle";
+    case SpvCapabilityGroupNonUniformShuffleRelative: return "GroupNonUniformShuffleRelative";
+    case SpvCapabilityGroupNonUniformClustered: return "GroupNonUniformClustered";
+    case SpvCapabilityGroupNonUniformQuad: return "GroupNonUniformQuad";
+    case SpvCapabilityShaderLayer: return "ShaderLayer";
+    case SpvCapabilityShaderViewportIndex: return "ShaderViewportIndex";
+    case SpvCapabilityDrawParameters: return "DrawParameters";
+    case SpvCapabilityStorageBuffer16BitAccess: return "StorageBuffer16BitAccess";
+    case SpvCapabilityUniformAndStorageBuffer16BitAccess: return "UniformAndStorageBuffer16BitAccess";
+    case SpvCapabilityStoragePushConstant16: return "StoragePushConstant16";
+    case SpvCapabilityStorageInputOutput16: return "StorageInputOutput16";
+    case SpvCapabilityMultiView: return "MultiView";
+    case SpvCapabilityVariablePointersStorageBuffer: return "VariablePointersStorageBuffer";
+    case SpvCapabilityVariablePointers: return "VariablePointers";
+    case SpvCapabilityStorageBuffer8BitAccess: return "StorageBuffer8BitAccess";
+    case SpvCapabilityUniformAndStorageBuffer8BitAccess: return "UniformAndStorageBuffer8BitAccess";
+    case SpvCapabilityDenormPreserve: return "DenormPreserve";
+    case SpvCapabilityDenormFlushToZero: return "DenormFlushToZero";
+    case SpvCapabilitySignedZeroInfNanPreserve: return "SignedZeroInfNanPreserve";
+    case SpvCapabilityShaderNonUniform: return "ShaderNonUniform";
+    case SpvCapabilityRuntimeDescriptorArray: return "RuntimeDescriptorArray";
+    case SpvCapabilitySampledImageArrayNonUniformIndexing: return "SampledImageArrayNonUniformIndexing";
+    case SpvCapabilityStorageBufferArrayNonUniformIndexing: return "StorageBufferArrayNonUniformIndexing";
+    case SpvCapabilityStorageImageArrayNonUniformIndexing: return "StorageImageArrayNonUniformIndexing";
+    case SpvCapabilityVulkanMemoryModel: return "VulkanMemoryModel";
+    case SpvCapabilityPhysicalStorageBufferAddresses: return "PhysicalStorageBufferAddresses";
+    case SpvCapabilityDemoteToHelperInvocation: return "DemoteToHelperInvocation";
+    case SpvCapabilityDotProduct: return "DotProduct";
+    case SpvCapabilityRayTracingKHR: return "RayTracingKHR";
+    case SpvCapabilityRayQueryKHR: return "RayQueryKHR";
+    case SpvCapabilityMeshShadingEXT: return "MeshShadingEXT";
+    case SpvCapabilityFragmentShadingRateKHR: return "FragmentShadingRateKHR";
+    case SpvCapabilityFragmentShaderPixelInterlockEXT: return "FragmentShaderPixelInterlockEXT";
+    case SpvCapabilityAtomicFloat32AddEXT: return "AtomicFloat32AddEXT";
+    case SpvCapabilityInt64ImageEXT: return "Int64ImageEXT";
+    default: return QString("Capability#%1").arg(capability);
+    }
+}
@@ -0,0 +1,207 @@
+#ifndef SPIRVMODULE_H
+#define SPIRVMODULE_H
+
+#include <QString>
+#include <QStringList>
+#include <QByteArray>
+#include <QVector>
+#include <QHash>
+#include <QMultiHash>
+#include <cstdint>
+#include <cstddef>
+
+// SpirvModule 一次遍历 SPIR-V 字流建立索引：ID -> 定义指令、函数 -> 基本块范围、类型/常量表、
+// 修饰表及操作码统计，供分析视图随机访问，不经过 spirv-dis 文本。
+class SpirvModule
+{
+public:
+    // 指令在字流中的位置
+    struct Instruction
+    {
+        uint32_t offset = 0; // 指令首字在模块中的下标
+        uint16_t opcode = 0; // 操作码
+        uint16_t wordCount = 0; // 指令字数（含首字）
+        uint32_t resultId = 0; // 结果 ID，无结果为 0
+        uint32_t resultType = 0; // 结果类型 ID，无结果类型为 0
+    };
+
+    // 基本块，[firstInstruction, firstInstruction + instructionCount) 包含 OpLabel 本身
+    struct BasicBlock
+    {
+        uint32_t labelId = 0;
+        int firstInstruction = 0;
+        int instructionCount = 0;
+    };
+
+    // 函数，指令范围从 OpFunction 到 OpFunctionEnd（含）
+    struct Function
+    {
+        uint32_t id = 0;
+        uint32_t resultType = 0;
+        uint32_t functionType = 0;
+        int firstInstruction = 0;
+        int instructionCount = 0;
+        QVector<BasicBlock> blocks;
+    };
+
+    // 结构化循环，块下标按函数中的布局顺序
+    struct Loop
+    {
+        int header = -1; // 含 OpLoopMerge 的循环头
+        int mergeBlock = -1; // 合并块，未找到时为 -1
+        QVector<int> backEdgeSources; // 跳回循环头的块
+        QVector<bool> blocks; // 自然循环包含的块，按块下标
+    };
+
+    // OpDecorate/OpMemberDecorate 等修饰
+    struct Decoration
+    {
+        uint32_t target = 0; // 目标 ID
+        uint32_t member = UINT32_MAX; // 结构体成员下标，非成员修饰为 UINT32_MAX
+        uint32_t decoration = 0; // SpvDecoration
+        int instruction = 0; // 修饰指令下标，可用于读取附加参数
+    };
+
+    // OpEntryPoint 及其执行模式
+    struct EntryPoint
+    {
+        uint32_t executionModel = 0; // SpvExecutionModel
+        uint32_t functionId = 0;
+        QString name;
+        QVector<uint32_t> interfaceIds;
+        uint32_t localSize[3] = { 0, 0, 0 };
+    };
+
+    // 指令对应的源代码位置，line 为 0 表示没有行信息
+    struct SourceLocation
+    {
+        QString file;
+        int line = 0;
+
+        bool isValid() const { return line > 0; }
+        QString text() const; // "文件名:行号"，文件名不含目录，没有行信息时为空
+    };
+
+    SpirvModule();
+
+    // 解析内存中的字流，不复制；words 在模块使用期间必须保持有效
+    bool parse(const uint32_t *words, size_t wordCount, QString *error = nullptr);
+
+    // 解析 QByteArray，模块持有其浅拷贝（隐式共享，不复制数据）
+    bool parse(const QByteArray &binary, QString *error = nullptr);
+
+    // 清空索引，保留容器容量以便复用
+    void clear();
+
+    bool isValid() const { return moduleWords != nullptr; }
+
+    // 模块头
+    uint32_t version() const { return headerVersion; }
+    uint32_t generator() const { return headerGenerator; }
+    uint32_t bound() const { return headerBound; }
+    size_t wordCount() const { return moduleWordCount; }
+    QVector<uint32_t> headerWords() const; // 模块头的 5 个字（魔数、版本、生成器、ID 上界、保留字），未解析时为空
+
+    // 指令访问
+    int instructionCount() const { return instructions.size(); }
+    const Instruction &instruction(int index) const { return instructions[index]; }
+    const uint32_t *words(const Instruction &inst) const { return moduleWords + inst.offset; }
+    uint32_t operand(const Instruction &inst, int operandIndex) const; // 操作数（不含首字），越界返回 0
+    int operandCount(const Instruction &inst) const { return inst.wordCount - 1; }
+    QString literalString(const Instruction &inst, int operandIndex, int *operandWords = nullptr) const;
+
+    // ID -> 定义指令下标，未定义返回 -1
+    int definition(uint32_t id) const;
+
+    // OpConstant/OpSpecConstant（取默认值）的第一个字，不是标量常量时返回 defaultValue；
+    // 遇到特化常量时将 isSpecConstant 置为 true
+    uint32_t constantValue(uint32_t id, uint32_t defaultValue = 0, bool *isSpecConstant = nullptr) const;
+
+    // 指针所指的存储类别（SpvStorageClass），不是指针时返回 UINT32_MAX
+    uint32_t storageClassOf(uint32_t pointerId) const;
+
+    // 沿访问链、图像及采样图像的加载追溯到 OpVariable，无法追溯（如函数参数或加载得到的指针）时返回 0；
+    // indices 返回最后经过的访问链下标，samplerVariable 返回 OpSampledImage 的采样器变量
+    uint32_t rootVariableOf(uint32_t id, QVector<uint32_t> *indices = nullptr, uint32_t *samplerVariable = nullptr) const;
+
+    // 变量名称，匿名的块变量取块类型的名称，都没有时为 %ID
+    QString variableName(uint32_t variableId) const;
+
+    // OpString 的字符串，id 不是 OpString 时返回空
+    QString stringOf(uint32_t id) const;
+
+    // 主源文件：OpSource 的 File 操作数，没有时取第一个 DebugSource 的文件
+    QString mainSourceFile() const;
+
+    // 每条指令的源代码位置（按指令下标），来自 OpLine 及 NonSemantic.Shader.DebugInfo.100 的 DebugLine，
+    // 行信息的作用域不跨越基本块
+    QVector<SourceLocation> sourceLocations() const;
+
+    // OpName/OpMemberName
+    QString name(uint32_t id) const;
+    QString memberName(uint32_t typeId, uint32_t member) const;
+
+    // 修饰表
+    QVector<Decoration> decorations(uint32_t id) const;
+    bool hasDecoration(uint32_t id, uint32_t decoration, uint32_t *value = nullptr) const;
+
+    // 函数与基本块
+    const QVector<Function> &functions() const { return functionList; }
+    int functionIndex(uint32_t functionId) const; // 未找到返回 -1
+    int functionIndexOfInstruction(int instructionIndex) const; // 不在函数内返回 -1
+    static QHash<uint32_t, int> blockIndexOfLabel(const Function &function); // OpLabel 结果 ID -> 块下标
+    QVector<QVector<int>> blockSuccessors(const Function &function) const; // 各块终结指令的目标块下标，不重复
+    QVector<Loop> loops(const Function &function, const QVector<QVector<int>> &successors) const; // successors 为 blockSuccessors 的结果
+
+    // 指令读取的 ID（不含结果类型及结果），跳过常见指令中的字面量操作数，避免字面量被误认为值
+    QVector<uint32_t> idOperands(const Instruction &inst) const;
+
+    // 类型及常量声明的结果 ID，按模块中出现的顺序
+    const QVector<uint32_t> &typeIds() const { return typeIdList; }
+    const QVector<uint32_t> &constantIds() const { return constantIdList; }
+
+    const QVector<EntryPoint> &entryPoints() const { return entryPointList; }
+
+    // OpExtInstImport 结果 ID 对应的扩展指令集名称，如 GLSL.std.450，未导入时为空
+    QString extInstSetName(uint32_t setId) const { return extInstSetNames.value(setId); }
+
+    // 整个模块或指定指令范围的操作码统计
+    const QHash<uint32_t, int> &opcodeHistogram() const { return histogram; }
+    QHash<uint32_t, int> opcodeHistogram(int firstInstruction, int instructionCount) const;
+
+    // 操作码名称（不含 Op 前缀的核心指令名，扩展指令返回 Op#N）
+    static QString opcodeName(uint32_t opcode);
+
+    // 读取图像的指令（采样、Gather、Fetch、Read 及其 Sparse 版本），sparse 返回是否为 Sparse 版本
+    static bool isImageReadOpcode(uint32_t opcode, bool *sparse = nullptr);
+
+    // 执行模型对应的着色器阶段名称，如 Vertex、Pixel、Compute
+    static QString stageName(uint32_t executionModel);
+
+    // 模块声明的 OpCapability 名称
+    QStringList capabilityNames() const;
+    static QString capabilityName(uint32_t capability);
+
+private:
+    QByteArray ownedBinary; // parse(QByteArray) 时持有的数据
+    const uint32_t *moduleWords;
+    size_t moduleWordCount;
+    uint32_t headerVersion;
+    uint32_t headerGenerator;
+    uint32_t headerBound;
+
+    QVector<Instruction> instructions;
+    QVector<int> definitionIndex; // 按 ID 下标，-1 表示未定义
+    QVector<int> nameIndex; // 按 ID 下标，OpName 指令下标
+    QMultiHash<uint32_t, int> memberNameIndex; // 类型 ID -> OpMemberName 指令下标
+    QVector<Decoration> decorationList;
+    QMultiHash<uint32_t, int> decorationIndex; // 目标 ID -> decorationList 下标
+    QVector<Function> functionList;
+    QVector<uint32_t> typeIdList;
+    QVector<uint32_t> constantIdList;
+    QVector<EntryPoint> entryPointList;
+    QHash<uint32_t, QString> extInstSetNames; // OpExtInstImport 结果 ID -> 指令集名称
+    QHash<uint32_t, int> histogram;
+};
+
+#endif // SPIRVMODULE_H
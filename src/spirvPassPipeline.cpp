@@ -0,0 +1,159 @@
+#include "spirvPassPipeline.h"
+#include "spirvModule.h"
+#include "shaderIntermediateCache.h"
+#include <QProcess>
+#include <QDir>
+#include <QFile>
+#include <QElapsedTimer>
+
+namespace {
+
+// 执行一次 spirv-opt，返回墙钟时间（秒），失败时返回 -1
+double runSpirvOpt(const QString &options, const QString &inputPath, const QString &outputPath, QString &error)
+{
+    QFile::remove(outputPath);
+
+    QElapsedTimer timer;
+    timer.start();
+    QProcess process;
+    process.start(QString("spirv-opt %1 \"%2\" -o \"%3\"").arg(options).arg(inputPath).arg(outputPath));
+    process.waitForFinished(-1);
+    double seconds = timer.nsecsElapsed() / 1e9;
+
+    error = process.readAllStandardError();
+    if (process.exitCode() != 0 || !QFile::exists(outputPath)) {
+        if (error.isEmpty()) {
+            error = "spirv-opt failed with no output.";
+        }
+        return -1;
+    }
+    return seconds;
+}
+
+} // namespace
+
+QStringList SpirvPassPipeline::availablePasses()
+{
+    return QStringList()
+        << "--ccp" << "--cfg-cleanup" << "--combine-access-chains" << "--compact-ids" << "--convert-local-access-chains"
+        << "--copy-propagate-arrays" << "--eliminate-dead-branches" << "--eliminate-dead-code-aggressive"
+        << "--eliminate-dead-const" << "--eliminate-dead-functions" << "--eliminate-dead-inserts"
+        << "--eliminate-dead-variables" << "--eliminate-local-multi-store" << "--eliminate-local-single-block"
+        << "--eliminate-local-single-store" << "--fold-spec-const-op-composite" << "--if-conversion"
+        << "--inline-entry-points-exhaustive" << "--licm" << "--local-redundancy-elimination" << "--loop-fission"
+        << "--loop-fusion" << "--loop-invariant-code-motion" << "--loop-peeling" << "--loop-unroll"
+        << "--loop-unroll-partial=2" << "--loop-unswitch" << "--merge-blocks" << "--merge-return"
+        << "--private-to-local" << "--reduce-load-size" << "--redundancy-elimination" << "--relax-float-ops"
+        << "--remove-duplicates" << "--replace-invalid-opcode" << "--scalar-replacement=100" << "--simplify-instructions"
+        << "--ssa-rewrite" << "--strength-reduction" << "--strip-debug" << "--strip-nonsemantic" << "--unify-const"
+        << "--vector-dce" << "--wrap-opkill";
+}
+
+QStringList SpirvPassPipeline::performancePasses()
+{
+    return QStringList()
+        << "--wrap-opkill" << "--eliminate-dead-branches" << "--merge-return" << "--inline-entry-points-exhaustive"
+        << "--eliminate-dead-functions" << "--eliminate-dead-code-aggressive" << "--private-to-local"
+        << "--eliminate-local-single-block" << "--eliminate-local-single-store" << "--eliminate-dead-code-aggressive"
+        << "--scalar-replacement=100" << "--convert-local-access-chains" << "--eliminate-local-single-block"
+        << "--eliminate-local-single-store" << "--eliminate-dead-code-aggressive" << "--ssa-rewrite"
+        << "--eliminate-dead-code-aggressive" << "--ccp" << "--eliminate-dead-code-aggressive" << "--loop-unroll"
+        << "--eliminate-dead-branches" << "--redundancy-elimination" << "--combine-access-chains"
+        << "--simplify-instructions" << "--scalar-replacement=100" << "--convert-local-access-chains"
+        << "--eliminate-local-single-block" << "--eliminate-local-single-store" << "--eliminate-dead-code-aggressive"
+        << "--ssa-rewrite" << "--eliminate-dead-code-aggressive" << "--vector-dce" << "--eliminate-dead-inserts"
+        << "--eliminate-dead-branches" << "--simplify-instructions" << "--if-conversion" << "--copy-propagate-arrays"
+        << "--reduce-load-size" << "--eliminate-dead-code-aggressive" << "--merge-blocks" << "--redundancy-elimination"
+        << "--eliminate-dead-branches" << "--merge-blocks" << "--simplify-instructions";
+}
+
+QVector<SpirvPassResult> SpirvPassPipeline::run(const QByteArray &module, const QStringList &passes, QByteArray *optimizedModule)
+{
+    QVector<SpirvPassResult> results;
+    QString inputPath = QDir::temp().filePath("pass_pipeline_input.spv");
+    QString outputPath = QDir::temp().filePath("pass_pipeline_output.spv");
+
+    QByteArray current = module;
+    SpirvModule currentModule;
+    currentModule.parse(current);
+
+    // 不带 pass 执行一次 spirv-opt，测得进程启动、校验及读写模块的固定开销
+    double overhead = 0;
+    QString error;
+    if (ShaderIntermediateCache::writeBlob(inputPath, current)) {
+        overhead = qMax(0.0, runSpirvOpt(QString(), inputPath, outputPath, error));
+    }
+
+    for (const QString &pass : passes) {
+        SpirvPassResult result;
+        result.pass = pass;
+        result.instructionsBefore = currentModule.instructionCount();
+        result.wordsBefore = currentModule.wordCount();
+
+        double seconds = -1;
+        if (ShaderIntermediateCache::writeBlob(inputPath, current)) {
+            seconds = runSpirvOpt(pass, inputPath, outputPath, result.error);
+        } else {
+            result.error = "Failed to write the SPIR-V module.";
+        }
+
+        QByteArray next;
+        SpirvModule nextModule;
+        if (seconds < 0 || !ShaderIntermediateCache::readBlob(outputPath, next) || !nextModule.parse(next, &error)) {
+            if (result.error.isEmpty()) {
+                result.error = error;
+            }
+            results.append(result);
+            break;
+        }
+
+        result.success = true;
+        result.seconds = qMax(0.0, seconds - overhead);
+        result.instructionsAfter = nextModule.instructionCount();
+        result.wordsAfter = nextModule.wordCount();
+        result.changed = next != current;
+        results.append(result);
+
+        current = next;
+        currentModule.parse(current);
+    }
+
+    QFile::remove(inputPath);
+    QFile::remove(outputPath);
+
+    if (optimizedModule) {
+        *optimizedModule = current;
+    }
+    return results;
+}
+
+bool SpirvPassPipeline::optimize(const QByteArray &module, const QString &options, QByteArray &optimizedModule, QString &error,
+                                 double *seconds, const QString &tempFileTag)
+{
+    QString inputPath = QDir::temp().filePath(QString("optimize_input%1.spv").arg(tempFileTag));
+    QString outputPath = QDir::temp().filePath(QString("optimize_output%1.spv").arg(tempFileTag));
+    if (!ShaderIntermediateCache::writeBlob(inputPath, module)) {
+        error = "Failed to write the SPIR-V module.";
+        return false;
+    }
+
+    double elapsed = runSpirvOpt(options, inputPath, outputPath, error);
+    bool success = elapsed >= 0 && ShaderIntermediateCache::readBlob(outputPath, optimizedModule);
+    if (seconds) {
+        *seconds = qMax(0.0, elapsed);
+    }
+
+    QFile::remove(inputPath);
+    QFile::remove(outputPath);
+    return success;
+}
+
+QString SpirvPassPipeline::toSpirvOptOptions(const QStringList &passes)
+{
+    return passes.join(" ");
+}
+
+QString SpirvPassPipeline::toDxcOptimizeConfig(const QStringList &passes)
+{
+    return passes.isEmpty() ? QString() : QString("-Oconfig=%1").arg(passes.join(","));
+}
@@ -0,0 +1,46 @@
+#ifndef SPIRVPASSPIPELINE_H
+#define SPIRVPASSPIPELINE_H
+
+#include <QString>
+#include <QStringList>
+#include <QByteArray>
+#include <QVector>
+
+// 单个 pass 的执行结果
+struct SpirvPassResult
+{
+    QString pass; // spirv-opt 参数，如 --merge-return
+    bool success = false;
+    QString error;
+    double seconds = 0; // 墙钟时间，已扣除 spirv-opt 进程启动及读写模块的开销
+    int instructionsBefore = 0;
+    int instructionsAfter = 0;
+    qint64 wordsBefore = 0;
+    qint64 wordsAfter = 0;
+    bool changed = false; // 模块内容是否变化
+};
+
+// SpirvPassPipeline 按顺序逐个执行 spirv-opt pass，每个 pass 单独启动一次 spirv-opt，
+// 以便得到每个 pass 的耗时及指令数、字数变化。
+class SpirvPassPipeline
+{
+public:
+    // 可选的 spirv-opt pass 列表
+    static QStringList availablePasses();
+
+    // spirv-opt -O 对应的 pass 序列（SPIRV-Tools RegisterPerformancePasses）
+    static QStringList performancePasses();
+
+    // 依次执行 passes，某个 pass 失败时停止；optimizedModule 返回最后一个成功 pass 的结果
+    static QVector<SpirvPassResult> run(const QByteArray &module, const QStringList &passes, QByteArray *optimizedModule = nullptr);
+
+    // 用一组 spirv-opt 参数执行一次优化，seconds 返回墙钟时间；tempFileTag 区分并行调用的临时文件
+    static bool optimize(const QByteArray &module, const QString &options, QByteArray &optimizedModule, QString &error,
+                         double *seconds = nullptr, const QString &tempFileTag = QString());
+
+    // 转换为 spirv-opt 命令行参数（glslang 的 spirv-opt 设置）或 DXC 的 -Oconfig= 选项
+    static QString toSpirvOptOptions(const QStringList &passes);
+    static QString toDxcOptimizeConfig(const QStringList &passes);
+};
+
+#endif // SPIRVPASSPIPELINE_H
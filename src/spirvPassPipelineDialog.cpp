@@ -0,0 +1,219 @@
+#include "spirvPassPipelineDialog.h"
+#include <QtWidgets/QVBoxLayout>
+#include <QtWidgets/QHBoxLayout>
+#include <QtWidgets/QPushButton>
+#include <QtWidgets/QHeaderView>
+#include <QtWidgets/QDialogButtonBox>
+#include <QtWidgets/QApplication>
+#include <QtWidgets/QMessageBox>
+
+namespace {
+
+QString signedNumber(qint64 value)
+{
+    return value > 0 ? QString("+%1").arg(value) : QString::number(value);
+}
+
+} // namespace
+
+// 构造函数，初始化 pass 序列编辑对话框。
+SpirvPassPipelineDialog::SpirvPassPipelineDialog(const QByteArray &module, const QStringList &pipeline, QWidget *parent)
+    : QDialog(parent), module(module)
+{
+    setWindowTitle(tr("spirv-opt Pass Pipeline"));
+    resize(900, 650);
+
+    QVBoxLayout *mainLayout = new QVBoxLayout(this);
+
+    // 可选 pass 列表及 pass 序列，序列项可双击编辑参数
+    QHBoxLayout *editLayout = new QHBoxLayout();
+
+    QVBoxLayout *availableLayout = new QVBoxLayout();
+    availableLayout->addWidget(new QLabel(tr("Available Passes"), this));
+    availableList = new QListWidget(this);
+    availableList->addItems(SpirvPassPipeline::availablePasses());
+    availableLayout->addWidget(availableList);
+    editLayout->addLayout(availableLayout);
+
+    QVBoxLayout *buttonLayout = new QVBoxLayout();
+    QPushButton *addButton = new QPushButton(tr("Add >"), this);
+    QPushButton *removeButton = new QPushButton(tr("Remove"), this);
+    QPushButton *upButton = new QPushButton(tr("Up"), this);
+    QPushButton *downButton = new QPushButton(tr("Down"), this);
+    QPushButton *performanceButton = new QPushButton(tr("Load -O"), this);
+    QPushButton *clearButton = new QPushButton(tr("Clear"), this);
+    buttonLayout->addStretch();
+    buttonLayout->addWidget(addButton);
+    buttonLayout->addWidget(removeButton);
+    buttonLayout->addWidget(upButton);
+    buttonLayout->addWidget(downButton);
+    buttonLayout->addSpacing(12);
+    buttonLayout->addWidget(performanceButton);
+    buttonLayout->addWidget(clearButton);
+    buttonLayout->addStretch();
+    editLayout->addLayout(buttonLayout);
+
+    QVBoxLayout *pipelineLayout = new QVBoxLayout();
+    pipelineLayout->addWidget(new QLabel(tr("Pipeline"), this));
+    pipelineList = new QListWidget(this);
+    pipelineLayout->addWidget(pipelineList);
+    editLayout->addLayout(pipelineLayout);
+
+    mainLayout->addLayout(editLayout, 1);
+
+    QHBoxLayout *runLayout = new QHBoxLayout();
+    summaryLabel = new QLabel(module.isEmpty() ? tr("No SPIR-V module, the pipeline can only be edited.") : QString(), this);
+    QPushButton *runButton = new QPushButton(tr("Run"), this);
+    runButton->setEnabled(!module.isEmpty());
+    runLayout->addWidget(summaryLabel, 1);
+    runLayout->addWidget(runButton);
+    mainLayout->addLayout(runLayout);
+
+    resultTable = new QTableWidget(this);
+    resultTable->setColumnCount(8);
+    resultTable->setHorizontalHeaderLabels(QStringList() << tr("#") << tr("Pass") << tr("Time (ms)") << tr("Instructions")
+        << tr("Instructions +/-") << tr("Words") << tr("Words +/-") << tr("Changed"));
+    resultTable->horizontalHeader()->setSectionResizeMode(QHeaderView::ResizeToContents);
+    resultTable->verticalHeader()->setVisible(false);
+    resultTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    resultTable->setSelectionBehavior(QAbstractItemView::SelectRows);
+    mainLayout->addWidget(resultTable, 1);
+
+    QDialogButtonBox *buttonBox = new QDialogButtonBox(QDialogButtonBox::Close, Qt::Horizontal, this);
+    QPushButton *applyButton = buttonBox->addButton(tr("Use Pipeline"), QDialogButtonBox::AcceptRole);
+    mainLayout->addWidget(buttonBox);
+
+    setPipeline(pipeline);
+
+    connect(availableList, &QListWidget::itemDoubleClicked, this, &SpirvPassPipelineDialog::addPass);
+    connect(addButton, &QPushButton::clicked, this, &SpirvPassPipelineDialog::addPass);
+    connect(removeButton, &QPushButton::clicked, this, &SpirvPassPipelineDialog::removePass);
+    connect(upButton, &QPushButton::clicked, this, &SpirvPassPipelineDialog::movePassUp);
+    connect(downButton, &QPushButton::clicked, this, &SpirvPassPipelineDialog::movePassDown);
+    connect(performanceButton, &QPushButton::clicked, this, &SpirvPassPipelineDialog::loadPerformancePasses);
+    connect(clearButton, &QPushButton::clicked, pipelineList, &QListWidget::clear);
+    connect(runButton, &QPushButton::clicked, this, &SpirvPassPipelineDialog::runPipeline);
+    connect(applyButton, &QPushButton::clicked, this, &QDialog::accept);
+    connect(buttonBox, &QDialogButtonBox::rejected, this, &QDialog::reject);
+}
+
+QStringList SpirvPassPipelineDialog::pipeline() const
+{
+    QStringList passes;
+    for (int i = 0; i < pipelineList->count(); ++i) {
+        QString pass = pipelineList->item(i)->text().trimmed();
+        if (!pass.isEmpty()) {
+            passes << pass;
+        }
+    }
+    return passes;
+}
+
+void SpirvPassPipelineDialog::setPipeline(const QStringList &passes)
+{
+    pipelineList->clear();
+    for (const QString &pass : passes) {
+        QListWidgetItem *item = new QListWidgetItem(pass, pipelineList);
+        item->setFlags(item->flags() | Qt::ItemIsEditable);
+    }
+}
+
+void SpirvPassPipelineDialog::addPass()
+{
+    QListWidgetItem *available = availableList->currentItem();
+    if (!available) {
+        return;
+    }
+
+    // 插入到当前选中项之后，未选中时追加到末尾
+    int row = pipelineList->currentRow() < 0 ? pipelineList->count() : pipelineList->currentRow() + 1;
+    QListWidgetItem *item = new QListWidgetItem(available->text());
+    item->setFlags(item->flags() | Qt::ItemIsEditable);
+    pipelineList->insertItem(row, item);
+    pipelineList->setCurrentRow(row);
+}
+
+void SpirvPassPipelineDialog::removePass()
+{
+    delete pipelineList->takeItem(pipelineList->currentRow());
+}
+
+void SpirvPassPipelineDialog::movePassUp()
+{
+    int row = pipelineList->currentRow();
+    if (row > 0) {
+        pipelineList->insertItem(row - 1, pipelineList->takeItem(row));
+        pipelineList->setCurrentRow(row - 1);
+    }
+}
+
+void SpirvPassPipelineDialog::movePassDown()
+{
+    int row = pipelineList->currentRow();
+    if (row >= 0 && row < pipelineList->count() - 1) {
+        pipelineList->insertItem(row + 1, pipelineList->takeItem(row));
+        pipelineList->setCurrentRow(row + 1);
+    }
+}
+
+void SpirvPassPipelineDialog::loadPerformancePasses()
+{
+    setPipeline(SpirvPassPipeline::performancePasses());
+}
+
+void SpirvPassPipelineDialog::runPipeline()
+{
+    QStringList passes = pipeline();
+    if (passes.isEmpty()) {
+        QMessageBox::information(this, windowTitle(), tr("The pipeline is empty."));
+        return;
+    }
+
+    QApplication::setOverrideCursor(Qt::WaitCursor);
+    QVector<SpirvPassResult> results = SpirvPassPipeline::run(module, passes);
+    QApplication::restoreOverrideCursor();
+
+    resultTable->setRowCount(0);
+    double totalSeconds = 0;
+    int unchangedCount = 0;
+    for (int i = 0; i < results.size(); ++i) {
+        const SpirvPassResult &result = results[i];
+        resultTable->insertRow(i);
+        resultTable->setItem(i, 0, new QTableWidgetItem(QString::number(i + 1)));
+        resultTable->setItem(i, 1, new QTableWidgetItem(result.pass));
+        if (!result.success) {
+            QTableWidgetItem *errorItem = new QTableWidgetItem(tr("Failed: %1").arg(result.error.trimmed()));
+            errorItem->setForeground(Qt::red);
+            errorItem->setToolTip(result.error);
+            resultTable->setItem(i, 2, errorItem);
+            resultTable->setSpan(i, 2, 1, 6);
+            continue;
+        }
+
+        totalSeconds += result.seconds;
+        unchangedCount += result.changed ? 0 : 1;
+        resultTable->setItem(i, 2, new QTableWidgetItem(QString::number(result.seconds * 1000.0, 'f', 1)));
+        resultTable->setItem(i, 3, new QTableWidgetItem(QString::number(result.instructionsAfter)));
+        resultTable->setItem(i, 4, new QTableWidgetItem(signedNumber(result.instructionsAfter - result.instructionsBefore)));
+        resultTable->setItem(i, 5, new QTableWidgetItem(QString::number(result.wordsAfter)));
+        resultTable->setItem(i, 6, new QTableWidgetItem(signedNumber(result.wordsAfter - result.wordsBefore)));
+        QTableWidgetItem *changedItem = new QTableWidgetItem(result.changed ? tr("Yes") : tr("No"));
+        if (!result.changed) {
+            changedItem->setForeground(Qt::gray);
+        }
+        resultTable->setItem(i, 7, changedItem);
+    }
+
+    if (!results.isEmpty()) {
+        const SpirvPassResult &first = results.first();
+        const SpirvPassResult *last = &results.last();
+        if (!last->success && results.size() > 1) {
+            last = &results[results.size() - 2];
+        }
+        summaryLabel->setText(tr("Total %1 ms, instructions %2 -> %3, words %4 -> %5, %6 of %7 passes changed nothing")
+            .arg(totalSeconds * 1000.0, 0, 'f', 1)
+            .arg(first.instructionsBefore).arg(last->success ? last->instructionsAfter : first.instructionsBefore)
+            .arg(first.wordsBefore).arg(last->success ? last->wordsAfter : first.wordsBefore)
+            .arg(unchangedCount).arg(results.size()));
+    }
+}
@@ -0,0 +1,41 @@
+#ifndef SPIRVPASSPIPELINEDIALOG_H
+#define SPIRVPASSPIPELINEDIALOG_H
+
+#include <QtWidgets/QDialog>
+#include <QtWidgets/QListWidget>
+#include <QtWidgets/QTableWidget>
+#include <QtWidgets/QLabel>
+#include "spirvPassPipeline.h"
+
+// SpirvPassPipelineDialog 编辑 spirv-opt pass 序列，对未优化的 SPIR-V 逐个执行并显示每个 pass 的耗时及大小变化。
+class SpirvPassPipelineDialog : public QDialog
+{
+    Q_OBJECT
+
+public:
+    // module 为未优化的 SPIR-V，为空时只能编辑不能执行
+    SpirvPassPipelineDialog(const QByteArray &module, const QStringList &pipeline, QWidget *parent = nullptr);
+
+    // 编辑后的 pass 序列
+    QStringList pipeline() const;
+
+private slots:
+    void addPass();
+    void removePass();
+    void movePassUp();
+    void movePassDown();
+    void loadPerformancePasses();
+    void runPipeline();
+
+private:
+    void setPipeline(const QStringList &passes);
+
+    QByteArray module;
+
+    QListWidget *availableList;
+    QListWidget *pipelineList;
+    QTableWidget *resultTable;
+    QLabel *summaryLabel;
+};
+
+#endif // SPIRVPASSPIPELINEDIALOG_H
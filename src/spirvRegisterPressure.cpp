@@ -0,0 +1,400 @@
+#include "SPIRV-Reflect/include/spirv/unified1/spirv.h"
+#include "spirvRegisterPressure.h"
+#include "spirvModule.h"
+#include <QBitArray>
+#include <QHash>
+#include <QMap>
+#include <algorithm>
+
+namespace {
+
+class PressureAnalysis
+{
+public:
+    explicit PressureAnalysis(const SpirvModule &module);
+
+    SpirvFunctionPressure analyzeFunction(int functionIndex, int topCount);
+
+private:
+    int components(uint32_t typeId) const;
+    QString typeName(uint32_t typeId) const;
+    bool isDebugInstruction(const SpirvModule::Instruction &inst) const;
+
+    const SpirvModule &module;
+    QVector<SpirvModule::SourceLocation> locations; // 每条指令的源代码位置
+};
+
+PressureAnalysis::PressureAnalysis(const SpirvModule &module)
+    : module(module)
+    , locations(module.sourceLocations())
+{
+}
+
+// 类型占用的 32 位分量数，指针（物理存储缓冲区指针除外）、图像、采样器等不计入
+int PressureAnalysis::components(uint32_t typeId) const
+{
+    int index = module.definition(typeId);
+    if (index < 0) {
+        return 0;
+    }
+
+    const SpirvModule::Instruction &inst = module.instruction(index);
+    switch (inst.opcode) {
+    case SpvOpTypeBool:
+        return 1;
+    case SpvOpTypeInt:
+    case SpvOpTypeFloat:
+        return static_cast<int>((module.operand(inst, 1) + 31) / 32);
+    case SpvOpTypeVector:
+    case SpvOpTypeMatrix:
+        return static_cast<int>(module.operand(inst, 2)) * components(module.operand(inst, 1));
+    case SpvOpTypeArray: {
+        int lengthIndex = module.definition(module.operand(inst, 2));
+        int length = lengthIndex >= 0 ? static_cast<int>(module.operand(module.instruction(lengthIndex), 2)) : 1;
+        return length * components(module.operand(inst, 1));
+    }
+    case SpvOpTypeStruct: {
+        int count = 0;
+        for (int member = 1; member < module.operandCount(inst); ++member) {
+            count += components(module.operand(inst, member));
+        }
+        return count;
+    }
+    case SpvOpTypePointer:
+        return module.operand(inst, 1) == SpvStorageClassPhysicalStorageBuffer ? 2 : 0;
+    default:
+        return 0;
+    }
+}
+
+QString PressureAnalysis::typeName(uint32_t typeId) const
+{
+    int index = module.definition(typeId);
+    if (index < 0) {
+        return QString();
+    }
+
+    const SpirvModule::Instruction &inst = module.instruction(index);
+    switch (inst.opcode) {
+    case SpvOpTypeBool:
+        return "bool";
+    case SpvOpTypeInt:
+        return QString("%1%2").arg(module.operand(inst, 2) ? "i" : "u").arg(module.operand(inst, 1));
+    case SpvOpTypeFloat:
+        return QString("f%1").arg(module.operand(inst, 1));
+    case SpvOpTypeVector:
+    case SpvOpTypeMatrix:
+        return QString("%1x%2").arg(typeName(module.operand(inst, 1))).arg(module.operand(inst, 2));
+    case SpvOpTypeArray:
+        return QString("%1[%2]").arg(typeName(module.operand(inst, 1))).arg(module.constantValue(module.operand(inst, 2)));
+    case SpvOpTypeStruct: {
+        QString name = module.name(typeId);
+        return name.isEmpty() ? QString("struct") : name;
+    }
+    case SpvOpTypePointer:
+        return "ptr";
+    default:
+        return SpirvModule::opcodeName(inst.opcode);
+    }
+}
+
+bool PressureAnalysis::isDebugInstruction(const SpirvModule::Instruction &inst) const
+{
+    if (inst.opcode == SpvOpLine || inst.opcode == SpvOpNoLine) {
+        return true;
+    }
+    return inst.opcode == SpvOpExtInst && module.extInstSetName(module.operand(inst, 2)).startsWith("NonSemantic.");
+}
+
+SpirvFunctionPressure PressureAnalysis::analyzeFunction(int functionIndex, int topCount)
+{
+    const SpirvModule::Function &function = module.functions()[functionIndex];
+    SpirvFunctionPressure result;
+    result.name = module.name(function.id);
+    if (result.name.isEmpty()) {
+        result.name = QString("%%1").arg(function.id);
+    }
+    if (function.blocks.isEmpty()) {
+        return result;
+    }
+
+    // 函数内定义的寄存器值：参数及有结果类型的指令（函数内变量、调试指令除外）
+    QHash<uint32_t, int> valueIndex;
+    QVector<SpirvLiveValue> values;
+    QVector<int> weights;
+    QHash<uint32_t, int> blockOfLabel = SpirvModule::blockIndexOfLabel(function);
+
+    for (int i = function.firstInstruction; i < function.firstInstruction + function.instructionCount; ++i) {
+        const SpirvModule::Instruction &inst = module.instruction(i);
+
+        if (inst.resultId == 0 || inst.resultType == 0 || inst.opcode == SpvOpFunction || inst.opcode == SpvOpVariable || isDebugInstruction(inst)) {
+            continue;
+        }
+        int weight = components(inst.resultType);
+        if (weight == 0) {
+            continue;
+        }
+        SpirvLiveValue value;
+        value.id = inst.resultId;
+        value.name = module.name(inst.resultId);
+        value.typeName = typeName(inst.resultType);
+        value.components = weight;
+        value.defLocation = locations[i].text();
+        valueIndex.insert(inst.resultId, values.size());
+        values.append(value);
+        weights.append(weight);
+    }
+
+    const int valueCount = values.size();
+    const int blockCount = function.blocks.size();
+    QVector<QBitArray> uses(blockCount, QBitArray(valueCount));
+    QVector<QBitArray> defs(blockCount, QBitArray(valueCount));
+    QVector<QBitArray> phiDefs(blockCount, QBitArray(valueCount));
+    QVector<QBitArray> phiUsesOut(blockCount, QBitArray(valueCount)); // 后继块的 OpPhi 经由本块的边读取的值
+    QVector<QVector<int>> blockSuccessors = module.blockSuccessors(function);
+
+    for (int b = 0; b < blockCount; ++b) {
+        const SpirvModule::BasicBlock &block = function.blocks[b];
+        for (int i = block.firstInstruction; i < block.firstInstruction + block.instructionCount; ++i) {
+            const SpirvModule::Instruction &inst = module.instruction(i);
+            if (inst.opcode == SpvOpPhi) {
+                for (int operand = 2; operand + 1 < module.operandCount(inst); operand += 2) {
+                    int value = valueIndex.value(module.operand(inst, operand), -1);
+                    int predecessor = blockOfLabel.value(module.operand(inst, operand + 1), -1);
+                    if (value >= 0 && predecessor >= 0) {
+                        phiUsesOut[predecessor].setBit(value);
+                    }
+                }
+                int def = valueIndex.value(inst.resultId, -1);
+                if (def >= 0) {
+                    phiDefs[b].setBit(def);
+                    defs[b].setBit(def);
+                }
+                continue;
+            }
+            if (isDebugInstruction(inst)) {
+                continue;
+            }
+
+            for (uint32_t id : module.idOperands(inst)) {
+                int value = valueIndex.value(id, -1);
+                if (value >= 0 && !defs[b].testBit(value)) {
+                    uses[b].setBit(value);
+                }
+            }
+            int def = valueIndex.value(inst.resultId, -1);
+            if (def >= 0) {
+                defs[b].setBit(def);
+            }
+        }
+    }
+
+    // 函数参数在入口块之前定义，入口块视为其定义位置
+    for (int i = function.firstInstruction; i < function.firstInstruction + function.instructionCount; ++i) {
+        const SpirvModule::Instruction &inst = module.instruction(i);
+        int def = inst.opcode == SpvOpFunctionParameter ? valueIndex.value(inst.resultId, -1) : -1;
+        if (def >= 0) {
+            defs[0].setBit(def);
+        }
+    }
+
+    // 反向数据流迭代至不动点
+    QVector<QBitArray> liveIn(blockCount, QBitArray(valueCount));
+    QVector<QBitArray> liveOut(blockCount, QBitArray(valueCount));
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (int b = blockCount - 1; b >= 0; --b) {
+            QBitArray out = phiUsesOut[b];
+            for (int successor : blockSuccessors[b]) {
+                out |= liveIn[successor] & ~phiDefs[successor];
+            }
+            QBitArray in = uses[b] | (out & ~defs[b]) | phiDefs[b];
+            if (out != liveOut[b] || in != liveIn[b]) {
+                liveOut[b] = out;
+                liveIn[b] = in;
+                changed = true;
+            }
+        }
+    }
+
+    // 逐块反向遍历，统计每条指令处的活跃分量数及每个值的活跃长度
+    QVector<int> enterPoint(valueCount, -1);
+    qint64 totalComponents = 0;
+    int peakInstruction = -1;
+    QBitArray peakLive;
+    for (int b = 0; b < blockCount; ++b) {
+        const SpirvModule::BasicBlock &block = function.blocks[b];
+        int blockEnd = block.firstInstruction + block.instructionCount;
+        QBitArray live = liveOut[b];
+        int liveComponents = 0;
+        for (int v = 0; v < valueCount; ++v) {
+            if (live.testBit(v)) {
+                liveComponents += weights[v];
+                enterPoint[v] = blockEnd;
+            }
+        }
+
+        for (int i = blockEnd - 1; i >= block.firstInstruction; --i) {
+            const SpirvModule::Instruction &inst = module.instruction(i);
+            if (inst.opcode == SpvOpPhi || inst.opcode == SpvOpLabel || isDebugInstruction(inst)) {
+                continue;
+            }
+
+            // 结果即使未被使用也需要占用寄存器
+            int def = valueIndex.value(inst.resultId, -1);
+            int pressure = liveComponents + (def >= 0 && !live.testBit(def) ? weights[def] : 0);
+            ++result.instructionCount;
+            totalComponents += pressure;
+            if (pressure > result.peakComponents || peakInstruction < 0) {
+                result.peakComponents = pressure;
+                peakInstruction = i;
+                peakLive = live;
+                if (def >= 0) {
+                    peakLive.setBit(def);
+                }
+            }
+
+            if (def >= 0 && live.testBit(def)) {
+                live.clearBit(def);
+                liveComponents -= weights[def];
+                values[def].liveLength += enterPoint[def] - i;
+            }
+            for (uint32_t id : module.idOperands(inst)) {
+                int value = valueIndex.value(id, -1);
+                if (value >= 0 && !live.testBit(value)) {
+                    live.setBit(value);
+                    liveComponents += weights[value];
+                    enterPoint[value] = i;
+                }
+            }
+        }
+
+        // 块入口处仍活跃的值（含 OpPhi 结果）
+        for (int v = 0; v < valueCount; ++v) {
+            if (live.testBit(v)) {
+                values[v].liveLength += enterPoint[v] - block.firstInstruction;
+            }
+        }
+    }
+
+    if (result.instructionCount > 0) {
+        result.averageComponents = static_cast<double>(totalComponents) / result.instructionCount;
+    }
+    if (peakInstruction >= 0) {
+        const SpirvModule::Instruction &inst = module.instruction(peakInstruction);
+        result.peakLocation = locations[peakInstruction].text();
+        result.peakInstruction = QString("Op%1").arg(SpirvModule::opcodeName(inst.opcode));
+        if (inst.resultId != 0) {
+            result.peakInstruction += QString(" %%1").arg(inst.resultId);
+        }
+        for (int v = 0; v < valueCount; ++v) {
+            if (peakLive.testBit(v)) {
+                result.liveAtPeak.append(values[v]);
+            }
+        }
+        std::stable_sort(result.liveAtPeak.begin(), result.liveAtPeak.end(), [](const SpirvLiveValue &a, const SpirvLiveValue &b) {
+            return a.components * qMax(a.liveLength, 1) > b.components * qMax(b.liveLength, 1);
+        });
+        result.liveAtPeak.resize(qMin(result.liveAtPeak.size(), topCount));
+    }
+
+    // 按源代码行汇总
+    QMap<QString, SpirvLinePressure> lines;
+    for (const SpirvLiveValue &value : values) {
+        if (value.defLocation.isEmpty()) {
+            continue;
+        }
+        SpirvLinePressure &line = lines[value.defLocation];
+        line.location = value.defLocation;
+        ++line.valueCount;
+        line.componentInstructions += static_cast<qint64>(value.components) * value.liveLength;
+    }
+    result.lines = lines.values().toVector();
+    std::stable_sort(result.lines.begin(), result.lines.end(), [](const SpirvLinePressure &a, const SpirvLinePressure &b) {
+        return a.componentInstructions > b.componentInstructions;
+    });
+    result.lines.resize(qMin(result.lines.size(), topCount));
+
+    result.longestLived = values;
+    std::stable_sort(result.longestLived.begin(), result.longestLived.end(), [](const SpirvLiveValue &a, const SpirvLiveValue &b) {
+        return static_cast<qint64>(a.components) * a.liveLength > static_cast<qint64>(b.components) * b.liveLength;
+    });
+    result.longestLived.resize(qMin(result.longestLived.size(), topCount));
+    return result;
+}
+
+QString valueText(const SpirvLiveValue &value)
+{
+    QString text = QString("%%1").arg(value.id);
+    if (!value.name.isEmpty()) {
+        text += " " + value.name;
+    }
+    text += QString(" (%1, %2 components)").arg(value.typeName).arg(value.components);
+    if (!value.defLocation.isEmpty()) {
+        text += " defined at " + value.defLocation;
+    }
+    return text;
+}
+
+} // namespace
+
+QVector<SpirvFunctionPressure> SpirvRegisterPressure::analyze(const SpirvModule &module, int topCount)
+{
+    PressureAnalysis analysis(module);
+    QVector<SpirvFunctionPressure> entries;
+    QVector<SpirvFunctionPressure> others;
+    for (int f = 0; f < module.functions().size(); ++f) {
+        SpirvFunctionPressure pressure = analysis.analyzeFunction(f, topCount);
+        if (pressure.instructionCount == 0) {
+            continue;
+        }
+
+        for (const SpirvModule::EntryPoint &entryPoint : module.entryPoints()) {
+            if (entryPoint.functionId == module.functions()[f].id) {
+                pressure.stage = SpirvModule::stageName(entryPoint.executionModel);
+                pressure.name = entryPoint.name;
+            }
+        }
+        if (pressure.stage.isEmpty()) {
+            others.append(pressure);
+        } else {
+            entries.append(pressure);
+        }
+    }
+    entries += others;
+    return entries;
+}
+
+QString SpirvRegisterPressure::reportText(const QVector<SpirvFunctionPressure> &functions)
+{
+    QString text;
+    for (const SpirvFunctionPressure &function : functions) {
+        text += function.stage.isEmpty() ? QString("== %1 ==\n").arg(function.name) : QString("== %1 (%2) ==\n").arg(function.name).arg(function.stage);
+        text += QString("Peak live 32-bit components: %1 at %2%3\n").arg(function.peakComponents).arg(function.peakInstruction)
+            .arg(function.peakLocation.isEmpty() ? QString() : " (" + function.peakLocation + ")");
+        text += QString("Average: %1 over %2 instructions\n").arg(function.averageComponents, 0, 'f', 1).arg(function.instructionCount);
+
+        if (!function.liveAtPeak.isEmpty()) {
+            text += "\nLive at peak:\n";
+            for (const SpirvLiveValue &value : function.liveAtPeak) {
+                text += "  " + valueText(value) + "\n";
+            }
+        }
+        if (!function.longestLived.isEmpty()) {
+            text += "\nLongest-lived values:\n";
+            for (const SpirvLiveValue &value : function.longestLived) {
+                text += QString("  %1, live across %2 instructions\n").arg(valueText(value)).arg(value.liveLength);
+            }
+        }
+        if (!function.lines.isEmpty()) {
+            text += "\nSource lines holding long-lived values:\n";
+            for (const SpirvLinePressure &line : function.lines) {
+                text += QString("  %1: %2 component-instructions (%3 values)\n").arg(line.location, -24)
+                    .arg(line.componentInstructions).arg(line.valueCount);
+            }
+        }
+        text += "\n";
+    }
+    return text;
+}
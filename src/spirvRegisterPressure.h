@@ -0,0 +1,56 @@
+#ifndef SPIRVREGISTERPRESSURE_H
+#define SPIRVREGISTERPRESSURE_H
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <cstdint>
+
+class SpirvModule;
+
+// 单个 SSA 值的活跃信息
+struct SpirvLiveValue
+{
+    uint32_t id = 0;
+    QString name; // OpName，没有时为空
+    QString typeName; // 如 f32x4、u32、bool
+    int components = 0; // 32 位分量数
+    QString defLocation; // 定义所在源代码位置，如 "shader.hlsl:12"，无调试信息时为空
+    int liveLength = 0; // 活跃的指令数
+};
+
+// 单个源代码行定义的值的活跃总量
+struct SpirvLinePressure
+{
+    QString location;
+    int valueCount = 0;
+    qint64 componentInstructions = 0; // 分量数 × 活跃指令数之和
+};
+
+// 单个函数的寄存器压力
+struct SpirvFunctionPressure
+{
+    QString name;
+    QString stage; // 入口函数的着色器阶段，非入口函数为空
+    int instructionCount = 0; // 参与统计的指令数
+    int peakComponents = 0; // 同时活跃的 32 位分量峰值
+    double averageComponents = 0;
+    QString peakLocation; // 峰值所在源代码位置
+    QString peakInstruction; // 峰值处的指令，如 "OpFMul %123"
+    QVector<SpirvLiveValue> liveAtPeak; // 峰值处活跃的值，按分量数降序
+    QVector<SpirvLiveValue> longestLived; // 活跃时间最长的值（分量数 × 活跃指令数降序）
+    QVector<SpirvLinePressure> lines; // 按活跃总量降序的源代码行
+};
+
+// SpirvRegisterPressure 在 SPIR-V 的控制流图上做 SSA 活跃变量分析，统计每条指令处同时活跃的
+// 32 位标量分量数，作为与硬件无关的寄存器压力估计；有 OpLine/DebugLine 时定位到源代码行。
+class SpirvRegisterPressure
+{
+public:
+    // 分析模块中的所有函数，入口函数在前；topCount 为各列表保留的条目数
+    static QVector<SpirvFunctionPressure> analyze(const SpirvModule &module, int topCount = 10);
+
+    static QString reportText(const QVector<SpirvFunctionPressure> &functions);
+};
+
+#endif // SPIRVREGISTERPRESSURE_H
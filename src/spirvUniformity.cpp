@@ -0,0 +1,321 @@
+#include "SPIRV-Reflect/include/spirv/unified1/spirv.h"
+#include "spirvUniformity.h"
+#include "spirvModule.h"
+#include <QVector>
+
+namespace {
+
+// 函数的结构化控制流，块下标按模块中的布局顺序
+struct FunctionFlow
+{
+    QVector<QVector<int>> successors;
+    QVector<QVector<int>> predecessors;
+    QVector<int> mergeBlocks; // OpSelectionMerge/OpLoopMerge 的合并块，没有合并指令时为 -1
+    QVector<SpirvModule::Loop> loops;
+    QVector<QSet<uint32_t>> loopValues; // 与 loops 对应的循环内定义的值
+};
+
+class UniformityAnalysis
+{
+public:
+    explicit UniformityAnalysis(const SpirvModule &module);
+
+    QSet<uint32_t> run();
+
+private:
+    bool isThreadPrivate(uint32_t pointerId) const;
+    bool loadsVarying(uint32_t pointerId) const;
+    bool isVarying(const SpirvModule::Instruction &inst) const;
+    bool markValue(uint32_t id);
+    bool markVariable(uint32_t pointerId);
+    bool markPhis(const SpirvModule::Function &function, int block);
+    bool markDivergent(int functionIndex, int block);
+    bool propagateMemory(int functionIndex);
+    bool propagateControl(int functionIndex);
+
+    const SpirvModule &module;
+    QVector<FunctionFlow> flows;
+    QSet<uint32_t> nonUniform;
+    QSet<uint32_t> varyingVariables; // 写入过不一致值的 Function/Private 变量
+    QVector<QVector<bool>> divergentBlocks; // 各函数中可能只有部分线程执行的块
+};
+
+UniformityAnalysis::UniformityAnalysis(const SpirvModule &module)
+    : module(module)
+{
+    const QVector<SpirvModule::Function> &functions = module.functions();
+    flows.resize(functions.size());
+    divergentBlocks.resize(functions.size());
+    for (int f = 0; f < functions.size(); ++f) {
+        const SpirvModule::Function &function = functions[f];
+        const int blockCount = function.blocks.size();
+        FunctionFlow &flow = flows[f];
+        QHash<uint32_t, int> blockOfLabel = SpirvModule::blockIndexOfLabel(function);
+        flow.successors = module.blockSuccessors(function);
+        flow.predecessors.resize(blockCount);
+        flow.mergeBlocks.fill(-1, blockCount);
+        divergentBlocks[f].fill(false, blockCount);
+
+        for (int b = 0; b < blockCount; ++b) {
+            for (int successor : flow.successors[b]) {
+                flow.predecessors[successor].append(b);
+            }
+            const SpirvModule::BasicBlock &block = function.blocks[b];
+            for (int i = block.firstInstruction; i < block.firstInstruction + block.instructionCount; ++i) {
+                const SpirvModule::Instruction &inst = module.instruction(i);
+                if (inst.opcode == SpvOpSelectionMerge || inst.opcode == SpvOpLoopMerge) {
+                    flow.mergeBlocks[b] = blockOfLabel.value(module.operand(inst, 0), -1);
+                }
+            }
+        }
+
+        flow.loops = module.loops(function, flow.successors);
+        for (const SpirvModule::Loop &loop : flow.loops) {
+            const QVector<bool> &inLoop = loop.blocks;
+            QSet<uint32_t> values;
+            for (int b = 0; b < blockCount; ++b) {
+                const SpirvModule::BasicBlock &block = function.blocks[b];
+                for (int i = block.firstInstruction; inLoop[b] && i < block.firstInstruction + block.instructionCount; ++i) {
+                    if (module.instruction(i).resultType != 0) {
+                        values.insert(module.instruction(i).resultId);
+                    }
+                }
+            }
+            flow.loopValues.append(values);
+        }
+    }
+}
+
+bool UniformityAnalysis::isThreadPrivate(uint32_t pointerId) const
+{
+    uint32_t storageClass = module.storageClassOf(pointerId);
+    return storageClass == SpvStorageClassFunction || storageClass == SpvStorageClassPrivate;
+}
+
+// 输入、输出及共享内存各线程不同；Function/Private 变量只有写入过不一致的值时才不一致
+bool UniformityAnalysis::loadsVarying(uint32_t pointerId) const
+{
+    if (nonUniform.contains(pointerId)) {
+        return true;
+    }
+    uint32_t storageClass = module.storageClassOf(pointerId);
+    if (storageClass == SpvStorageClassInput || storageClass == SpvStorageClassOutput || storageClass == SpvStorageClassWorkgroup) {
+        return true;
+    }
+    if (isThreadPrivate(pointerId)) {
+        uint32_t variable = module.rootVariableOf(pointerId);
+        return variable == 0 || varyingVariables.contains(variable);
+    }
+    return false;
+}
+
+bool UniformityAnalysis::isVarying(const SpirvModule::Instruction &inst) const
+{
+    switch (inst.opcode) {
+    case SpvOpVariable:
+        return false;
+    case SpvOpLoad:
+        return loadsVarying(module.operand(inst, 2));
+    case SpvOpFunctionParameter:
+    case SpvOpFunctionCall:
+        return true;
+    default:
+        break;
+    }
+    if (SpirvModule::isImageReadOpcode(inst.opcode) || (inst.opcode >= SpvOpAtomicLoad && inst.opcode <= SpvOpAtomicXor)) {
+        return true;
+    }
+    for (uint32_t id : module.idOperands(inst)) {
+        if (nonUniform.contains(id)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool UniformityAnalysis::markValue(uint32_t id)
+{
+    if (id == 0 || nonUniform.contains(id)) {
+        return false;
+    }
+    nonUniform.insert(id);
+    return true;
+}
+
+bool UniformityAnalysis::markVariable(uint32_t pointerId)
+{
+    if (!isThreadPrivate(pointerId)) {
+        return false;
+    }
+    uint32_t variable = module.rootVariableOf(pointerId);
+    if (variable == 0 || varyingVariables.contains(variable)) {
+        return false;
+    }
+    varyingVariables.insert(variable);
+    return true;
+}
+
+bool UniformityAnalysis::markPhis(const SpirvModule::Function &function, int block)
+{
+    bool changed = false;
+    const SpirvModule::BasicBlock &basicBlock = function.blocks[block];
+    for (int i = basicBlock.firstInstruction; i < basicBlock.firstInstruction + basicBlock.instructionCount; ++i) {
+        const SpirvModule::Instruction &inst = module.instruction(i);
+        if (inst.opcode == SpvOpPhi) {
+            changed = markValue(inst.resultId) || changed;
+        }
+    }
+    return changed;
+}
+
+bool UniformityAnalysis::markDivergent(int functionIndex, int block)
+{
+    if (divergentBlocks[functionIndex][block]) {
+        return false;
+    }
+    divergentBlocks[functionIndex][block] = true;
+    return true;
+}
+
+// 写入 Function/Private 变量：写入不一致的值、经由不一致的地址写入或只有部分线程执行写入时，变量不一致
+bool UniformityAnalysis::propagateMemory(int functionIndex)
+{
+    bool changed = false;
+    const SpirvModule::Function &function = module.functions()[functionIndex];
+    for (int b = 0; b < function.blocks.size(); ++b) {
+        const SpirvModule::BasicBlock &block = function.blocks[b];
+        bool divergent = divergentBlocks[functionIndex][b];
+        for (int i = block.firstInstruction; i < block.firstInstruction + block.instructionCount; ++i) {
+            const SpirvModule::Instruction &inst = module.instruction(i);
+            if (inst.opcode == SpvOpStore) {
+                uint32_t pointer = module.operand(inst, 0);
+                if (divergent || nonUniform.contains(pointer) || nonUniform.contains(module.operand(inst, 1))) {
+                    changed = markVariable(pointer) || changed;
+                }
+            } else if (inst.opcode == SpvOpCopyMemory || inst.opcode == SpvOpCopyMemorySized) {
+                uint32_t target = module.operand(inst, 0);
+                if (divergent || nonUniform.contains(target) || loadsVarying(module.operand(inst, 1))) {
+                    changed = markVariable(target) || changed;
+                }
+            } else if (inst.opcode == SpvOpFunctionCall) {
+                // 被调函数可能经由指针参数写入任意值
+                for (int o = 3; o < module.operandCount(inst); ++o) {
+                    changed = markVariable(module.operand(inst, o)) || changed;
+                }
+            }
+
+            if (inst.resultId != 0 && !nonUniform.contains(inst.resultId) && isVarying(inst)) {
+                nonUniform.insert(inst.resultId);
+                changed = true;
+            }
+        }
+    }
+    return changed;
+}
+
+// 条件不一致的分支：分支与合并块之间的块只有部分线程执行，汇合处的 OpPhi 合并了不同线程的路径；
+// 有条件不一致的出口的循环中各线程迭代次数不同，循环内定义、循环外使用的值也不一致
+bool UniformityAnalysis::propagateControl(int functionIndex)
+{
+    bool changed = false;
+    const SpirvModule::Function &function = module.functions()[functionIndex];
+    const FunctionFlow &flow = flows[functionIndex];
+    const int blockCount = function.blocks.size();
+
+    QVector<bool> divergentBranch(blockCount, false);
+    for (int b = 0; b < blockCount; ++b) {
+        const SpirvModule::BasicBlock &block = function.blocks[b];
+        if (block.instructionCount <= 0) {
+            continue;
+        }
+        const SpirvModule::Instruction &terminator = module.instruction(block.firstInstruction + block.instructionCount - 1);
+        if ((terminator.opcode != SpvOpBranchConditional && terminator.opcode != SpvOpSwitch) || flow.successors[b].size() < 2
+            || !nonUniform.contains(module.operand(terminator, 0))) {
+            continue;
+        }
+        divergentBranch[b] = true;
+
+        int merge = flow.mergeBlocks[b];
+        if (merge < 0) {
+            // 没有合并指令的条件分支只能是 break/continue，汇合点为其目标块
+            for (int successor : flow.successors[b]) {
+                if (flow.predecessors[successor].size() > 1) {
+                    changed = markPhis(function, successor) || changed;
+                }
+            }
+            continue;
+        }
+
+        // 结构化布局中构造内的块位于头块与合并块之间，沿前向边求得，break 等跳出构造的边不计入
+        QVector<int> worklist = flow.successors[b];
+        QVector<bool> visited(blockCount, false);
+        while (!worklist.isEmpty()) {
+            int current = worklist.takeLast();
+            if (current <= b || current >= merge || visited[current]) {
+                continue;
+            }
+            visited[current] = true;
+            changed = markDivergent(functionIndex, current) || changed;
+            worklist += flow.successors[current];
+        }
+        changed = markPhis(function, merge) || changed;
+    }
+
+    for (int l = 0; l < flow.loops.size(); ++l) {
+        const QVector<bool> &inLoop = flow.loops[l].blocks;
+        bool divergentExit = false;
+        for (int b = 0; b < blockCount && !divergentExit; ++b) {
+            if (!inLoop[b] || !divergentBranch[b]) {
+                continue;
+            }
+            for (int successor : flow.successors[b]) {
+                divergentExit = divergentExit || !inLoop[successor];
+            }
+        }
+        if (!divergentExit) {
+            continue;
+        }
+
+        for (int b = 0; b < blockCount; ++b) {
+            if (inLoop[b]) {
+                changed = markDivergent(functionIndex, b) || changed;
+            }
+        }
+        int merge = flow.loops[l].mergeBlock;
+        if (merge >= 0) {
+            changed = markPhis(function, merge) || changed;
+        }
+        for (int b = 0; b < blockCount; ++b) {
+            const SpirvModule::BasicBlock &block = function.blocks[b];
+            for (int i = block.firstInstruction; !inLoop[b] && i < block.firstInstruction + block.instructionCount; ++i) {
+                for (uint32_t id : module.idOperands(module.instruction(i))) {
+                    if (flow.loopValues[l].contains(id)) {
+                        changed = markValue(id) || changed;
+                    }
+                }
+            }
+        }
+    }
+    return changed;
+}
+
+QSet<uint32_t> UniformityAnalysis::run()
+{
+    // 各集合只增不减，迭代到不再变化为止
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (int f = 0; f < module.functions().size(); ++f) {
+            changed = propagateMemory(f) || changed;
+            changed = propagateControl(f) || changed;
+        }
+    }
+    return nonUniform;
+}
+
+} // namespace
+
+QSet<uint32_t> SpirvUniformity::nonUniformValues(const SpirvModule &module)
+{
+    return UniformityAnalysis(module).run();
+}
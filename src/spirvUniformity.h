@@ -0,0 +1,18 @@
+#ifndef SPIRVUNIFORMITY_H
+#define SPIRVUNIFORMITY_H
+
+#include <QSet>
+#include <cstdint>
+
+class SpirvModule;
+
+// SpirvUniformity 按存储类别、数据流及控制依赖判断 SPIR-V 中的值在同一波次内是否各线程一致，
+// 纹理访问报告和控制流图据此标出条件不一致的分支。
+class SpirvUniformity
+{
+public:
+    // 各线程可能不同的值的结果 ID，覆盖模块中的所有函数
+    static QSet<uint32_t> nonUniformValues(const SpirvModule &module);
+};
+
+#endif // SPIRVUNIFORMITY_H
@@ -1,7 +1,14 @@
 #ifndef SPIRVUTILS_H
 #define SPIRVUTILS_H
 #include <QString>
+#include <QByteArray>
 
-bool DumpSpirVReflectionInfo(const QString &spvFilePath, QString &outputReflectionInfo);
+class ShaderReflection;
 
-#endif 
\ No newline at end of file
+// 反射内存中的 SPIR-V 字节码，直接引用 spirvBinary 的数据，不复制
+bool ReflectSpirV(const QByteArray &spirvBinary, ShaderReflection &reflection, QString *error = nullptr);
+
+// 反射 spv 文件并输出文本摘要，reflection 非空时同时填充结构化反射数据
+bool DumpSpirVReflectionInfo(const QString &spvFilePath, QString &outputReflectionInfo, ShaderReflection *reflection = nullptr);
+
+#endif 
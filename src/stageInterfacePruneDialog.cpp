@@ -0,0 +1,103 @@
+#include "stageInterfacePruneDialog.h"
+#include "documentWindow.h"
+#include "shaderIntermediateCache.h"
+#include <QtWidgets/QVBoxLayout>
+#include <QtWidgets/QFormLayout>
+#include <QtWidgets/QDialogButtonBox>
+#include <QtWidgets/QApplication>
+#include <QtWidgets/QFileDialog>
+#include <QtWidgets/QMessageBox>
+#include <QDir>
+
+// 构造函数，初始化跨阶段接口裁剪对话框，默认当前文档为生产者、下一个文档为消费者。
+StageInterfacePruneDialog::StageInterfacePruneDialog(const QList<DocumentWindow *> &documents, int currentIndex, QWidget *parent)
+    : QDialog(parent), documents(documents)
+{
+    setWindowTitle(tr("Prune Stage Interface"));
+    resize(800, 600);
+
+    QVBoxLayout *mainLayout = new QVBoxLayout(this);
+
+    QFormLayout *formLayout = new QFormLayout();
+    producerCombo = new QComboBox(this);
+    consumerCombo = new QComboBox(this);
+    for (DocumentWindow *document : documents) {
+        producerCombo->addItem(document->getDocumentWindowTitle());
+        consumerCombo->addItem(document->getDocumentWindowTitle());
+    }
+    producerCombo->setCurrentIndex(qMax(currentIndex, 0));
+    consumerCombo->setCurrentIndex(documents.size() > 1 ? (qMax(currentIndex, 0) + 1) % documents.size() : 0);
+    optimizeEdit = new QLineEdit("-O", this);
+    formLayout->addRow(tr("Producer (VS/Mesh/...)"), producerCombo);
+    formLayout->addRow(tr("Consumer (PS/...)"), consumerCombo);
+    formLayout->addRow(tr("spirv-opt"), optimizeEdit);
+    mainLayout->addLayout(formLayout);
+
+    reportEdit = new QTextEdit(this);
+    reportEdit->setReadOnly(true);
+    reportEdit->setStyleSheet("QTextEdit { font-family: 'Consolas', monospace; }");
+    mainLayout->addWidget(reportEdit, 1);
+
+    QDialogButtonBox *buttonBox = new QDialogButtonBox(QDialogButtonBox::Close, Qt::Horizontal, this);
+    QPushButton *runButton = buttonBox->addButton(tr("Run"), QDialogButtonBox::ActionRole);
+    saveButton = buttonBox->addButton(tr("Save Pruned SPIR-V..."), QDialogButtonBox::ActionRole);
+    saveButton->setEnabled(false);
+    mainLayout->addWidget(buttonBox);
+
+    connect(runButton, &QPushButton::clicked, this, &StageInterfacePruneDialog::runPrune);
+    connect(saveButton, &QPushButton::clicked, this, &StageInterfacePruneDialog::savePruned);
+    connect(buttonBox, &QDialogButtonBox::rejected, this, &QDialog::reject);
+}
+
+void StageInterfacePruneDialog::runPrune()
+{
+    DocumentWindow *producer = documents.value(producerCombo->currentIndex());
+    DocumentWindow *consumer = documents.value(consumerCombo->currentIndex());
+    if (!producer || !consumer || producer == consumer) {
+        QMessageBox::information(this, windowTitle(), tr("Select two different documents."));
+        return;
+    }
+
+    saveButton->setEnabled(false);
+    QApplication::setOverrideCursor(Qt::WaitCursor);
+
+    QByteArray producerBinary;
+    QByteArray consumerBinary;
+    QString error;
+    QStringList warnings;
+    bool success = producer->compileUnoptimizedSpirv(producerBinary, error);
+    if (!success) {
+        error = tr("%1: %2").arg(producer->getDocumentWindowTitle()).arg(error);
+    } else if (!(success = consumer->compileUnoptimizedSpirv(consumerBinary, error))) {
+        error = tr("%1: %2").arg(consumer->getDocumentWindowTitle()).arg(error);
+    } else {
+        QStringList passes = optimizeEdit->text().split(' ', QString::SkipEmptyParts);
+        success = SpirvInterfacePruner::prune(producerBinary, consumerBinary, passes, producerResult, consumerResult, warnings, error);
+    }
+
+    QApplication::restoreOverrideCursor();
+
+    if (!success) {
+        reportEdit->setPlainText(tr("Prune failed:\n") + (error.isEmpty() ? tr("Compilation failed.") : error));
+        return;
+    }
+
+    reportEdit->setPlainText(SpirvInterfacePruner::reportText(producerResult, consumerResult, warnings));
+    saveButton->setEnabled(true);
+}
+
+void StageInterfacePruneDialog::savePruned()
+{
+    QString directory = QFileDialog::getExistingDirectory(this, tr("Save Pruned SPIR-V"));
+    if (directory.isEmpty()) {
+        return;
+    }
+
+    QDir dir(directory);
+    QString producerPath = dir.filePath(QString("%1_%2.spv").arg(producerCombo->currentText()).arg(producerResult.stage.toLower()));
+    QString consumerPath = dir.filePath(QString("%1_%2.spv").arg(consumerCombo->currentText()).arg(consumerResult.stage.toLower()));
+    if (!ShaderIntermediateCache::writeBlob(producerPath, producerResult.prunedBinary)
+        || !ShaderIntermediateCache::writeBlob(consumerPath, consumerResult.prunedBinary)) {
+        QMessageBox::warning(this, windowTitle(), tr("Failed to write the SPIR-V files."));
+    }
+}
@@ -0,0 +1,38 @@
+#ifndef STAGEINTERFACEPRUNEDIALOG_H
+#define STAGEINTERFACEPRUNEDIALOG_H
+
+#include <QtWidgets/QDialog>
+#include <QtWidgets/QComboBox>
+#include <QtWidgets/QLineEdit>
+#include <QtWidgets/QTextEdit>
+#include <QtWidgets/QPushButton>
+#include "spirvInterfacePruner.h"
+
+class DocumentWindow;
+
+// StageInterfacePruneDialog 选择两个文档作为生产者/消费者阶段（如 VS/PS、Mesh/PS），
+// 裁剪未被消费的接口变量并重新优化，报告每个阶段移除的 varying 及指令数。
+class StageInterfacePruneDialog : public QDialog
+{
+    Q_OBJECT
+
+public:
+    StageInterfacePruneDialog(const QList<DocumentWindow *> &documents, int currentIndex, QWidget *parent = nullptr);
+
+private slots:
+    void runPrune();
+    void savePruned();
+
+private:
+    QList<DocumentWindow *> documents;
+    SpirvStagePruneResult producerResult;
+    SpirvStagePruneResult consumerResult;
+
+    QComboBox *producerCombo;
+    QComboBox *consumerCombo;
+    QLineEdit *optimizeEdit;
+    QTextEdit *reportEdit;
+    QPushButton *saveButton;
+};
+
+#endif // STAGEINTERFACEPRUNEDIALOG_H
@@ -0,0 +1,971 @@
+#include "SPIRV-Reflect/include/spirv/unified1/spirv.h"
+#include "textureAccessAnalyzer.h"
+#include "shaderCostAnalyzer.h"
+#include "shaderReflection.h"
+#include "spirvModule.h"
+#include "spirvUniformity.h"
+#include <QHash>
+#include <QMap>
+#include <QRegularExpression>
+#include <QSet>
+
+namespace {
+
+// 报告中每类明细的最大条数
+const int kMaxFindings = 20;
+
+// 沿前向边（目标块在布局中位于其后）从 starts 可达的块，不经过 stop 块
+QSet<int> forwardReach(const QVector<QVector<int>> &successors, const QVector<int> &starts, int stop)
+{
+    QSet<int> reached;
+    QVector<int> worklist;
+    for (int start : starts) {
+        if (start != stop) {
+            worklist.append(start);
+        }
+    }
+    while (!worklist.isEmpty()) {
+        int block = worklist.takeLast();
+        if (reached.contains(block)) {
+            continue;
+        }
+        reached.insert(block);
+        for (int successor : successors[block]) {
+            if (successor > block && successor != stop) {
+                worklist.append(successor);
+            }
+        }
+    }
+    return reached;
+}
+
+// ---------------- SPIR-V ----------------
+
+class SpirvTextureAnalysis
+{
+public:
+    explicit SpirvTextureAnalysis(const SpirvModule &module);
+
+    TextureAccessReport run();
+
+private:
+    void analyzeFunction(int functionIndex, TextureAccessReport &report);
+    bool isStorageBufferPointer(uint32_t pointerId) const;
+    QString resourceName(uint32_t variable) const;
+    QString bindingText(uint32_t variable) const;
+    QStringList dependencies(uint32_t id);
+
+    const SpirvModule &module;
+    QVector<SpirvModule::SourceLocation> locations; // 指令下标 -> 源代码位置
+    QSet<uint32_t> nonUniform; // 各线程可能不同的值
+    QHash<uint32_t, QStringList> dependencyCache;
+    QSet<uint32_t> dependencyInProgress;
+};
+
+SpirvTextureAnalysis::SpirvTextureAnalysis(const SpirvModule &module)
+    : module(module)
+    , locations(module.sourceLocations())
+{
+}
+
+bool SpirvTextureAnalysis::isStorageBufferPointer(uint32_t pointerId) const
+{
+    uint32_t storageClass = module.storageClassOf(pointerId);
+    if (storageClass == SpvStorageClassStorageBuffer || storageClass == SpvStorageClassPhysicalStorageBuffer) {
+        return true;
+    }
+    if (storageClass != SpvStorageClassUniform) {
+        return false;
+    }
+
+    // 旧式的 BufferBlock 存储缓冲区
+    uint32_t variable = module.rootVariableOf(pointerId);
+    int variableIndex = variable ? module.definition(variable) : -1;
+    int pointerType = variableIndex >= 0 ? module.definition(module.instruction(variableIndex).resultType) : -1;
+    return pointerType >= 0 && module.hasDecoration(module.operand(module.instruction(pointerType), 2), SpvDecorationBufferBlock);
+}
+
+QString SpirvTextureAnalysis::resourceName(uint32_t variable) const
+{
+    return variable == 0 ? QString("buffer reference") : module.variableName(variable);
+}
+
+QString SpirvTextureAnalysis::bindingText(uint32_t variable) const
+{
+    uint32_t set = 0;
+    uint32_t binding = 0;
+    if (variable == 0 || !module.hasDecoration(variable, SpvDecorationBinding, &binding)) {
+        return QString();
+    }
+    module.hasDecoration(variable, SpvDecorationDescriptorSet, &set);
+    return QString("set %1, binding %2").arg(set).arg(binding);
+}
+
+// 值依赖的先前读取：纹理读取及存储缓冲区加载返回其资源名称
+QStringList SpirvTextureAnalysis::dependencies(uint32_t id)
+{
+    if (dependencyCache.contains(id)) {
+        return dependencyCache.value(id);
+    }
+    int index = module.definition(id);
+    if (index < 0 || module.functionIndexOfInstruction(index) < 0 || dependencyInProgress.contains(id)) {
+        return QStringList();
+    }
+
+    const SpirvModule::Instruction &inst = module.instruction(index);
+    QStringList result;
+    if (SpirvModule::isImageReadOpcode(inst.opcode)) {
+        result << resourceName(module.rootVariableOf(module.operand(inst, 2)));
+    } else if (inst.opcode == SpvOpLoad && isStorageBufferPointer(module.operand(inst, 2))) {
+        result << resourceName(module.rootVariableOf(module.operand(inst, 2)));
+    } else {
+        dependencyInProgress.insert(id);
+        for (uint32_t operand : module.idOperands(inst)) {
+            for (const QString &name : dependencies(operand)) {
+                if (!result.contains(name)) {
+                    result << name;
+                }
+            }
+        }
+        dependencyInProgress.remove(id);
+    }
+    dependencyCache.insert(id, result);
+    return result;
+}
+
+void SpirvTextureAnalysis::analyzeFunction(int functionIndex, TextureAccessReport &report)
+{
+    const SpirvModule::Function &function = module.functions()[functionIndex];
+    const int blockCount = function.blocks.size();
+    QString functionName = module.name(function.id);
+    if (functionName.isEmpty()) {
+        functionName = QString("%%1").arg(function.id);
+    }
+
+    QHash<uint32_t, int> blockOfLabel = SpirvModule::blockIndexOfLabel(function);
+    QVector<QVector<int>> blockSuccessors = module.blockSuccessors(function);
+
+    // 结构化控制流：循环体及条件不一致的选择结构
+    QVector<int> loopDepth(blockCount, 0);
+    QVector<bool> divergent(blockCount, false);
+    for (int b = 0; b < blockCount; ++b) {
+        const SpirvModule::BasicBlock &block = function.blocks[b];
+        if (block.instructionCount < 2) {
+            continue;
+        }
+        const SpirvModule::Instruction &merge = module.instruction(block.firstInstruction + block.instructionCount - 2);
+        const SpirvModule::Instruction &terminator = module.instruction(block.firstInstruction + block.instructionCount - 1);
+        int mergeBlock = blockOfLabel.value(module.operand(merge, 0), -1);
+
+        if (merge.opcode == SpvOpLoopMerge) {
+            QSet<int> body = forwardReach(blockSuccessors, blockSuccessors[b], mergeBlock);
+            body.insert(b);
+
+            // 退出条件不一致的循环
+            bool varyingExit = false;
+            for (int member : body) {
+                const SpirvModule::BasicBlock &memberBlock = function.blocks[member];
+                const SpirvModule::Instruction &exit = module.instruction(memberBlock.firstInstruction + memberBlock.instructionCount - 1);
+                if ((exit.opcode == SpvOpBranchConditional || exit.opcode == SpvOpSwitch) && nonUniform.contains(module.operand(exit, 0))
+                    && blockSuccessors[member].contains(mergeBlock)) {
+                    varyingExit = true;
+                }
+            }
+            for (int member : body) {
+                ++loopDepth[member];
+                divergent[member] = divergent[member] || varyingExit;
+            }
+        } else if (merge.opcode == SpvOpSelectionMerge
+                   && (terminator.opcode == SpvOpBranchConditional || terminator.opcode == SpvOpSwitch)
+                   && nonUniform.contains(module.operand(terminator, 0))) {
+            for (int member : forwardReach(blockSuccessors, blockSuccessors[b], mergeBlock)) {
+                divergent[member] = true;
+            }
+        }
+    }
+
+    for (int b = 0; b < blockCount; ++b) {
+        const SpirvModule::BasicBlock &block = function.blocks[b];
+        for (int i = block.firstInstruction; i < block.firstInstruction + block.instructionCount; ++i) {
+            const SpirvModule::Instruction &inst = module.instruction(i);
+            TextureAccess access;
+            uint32_t resourceVariable = 0;
+            uint32_t samplerVariable = 0;
+            uint32_t address = 0; // 坐标或指针
+            int maskOperand = -1;
+            QStringList variants;
+
+            switch (inst.opcode) {
+            case SpvOpImageSampleImplicitLod:
+            case SpvOpImageSampleExplicitLod:
+            case SpvOpImageSampleProjImplicitLod:
+            case SpvOpImageSampleProjExplicitLod:
+            case SpvOpImageSparseSampleImplicitLod:
+            case SpvOpImageSparseSampleExplicitLod:
+            case SpvOpImageSparseSampleProjImplicitLod:
+            case SpvOpImageSparseSampleProjExplicitLod:
+                access.kind = "Sample";
+                maskOperand = 4;
+                break;
+            case SpvOpImageSampleDrefImplicitLod:
+            case SpvOpImageSampleDrefExplicitLod:
+            case SpvOpImageSampleProjDrefImplicitLod:
+            case SpvOpImageSampleProjDrefExplicitLod:
+            case SpvOpImageSparseSampleDrefImplicitLod:
+            case SpvOpImageSparseSampleDrefExplicitLod:
+            case SpvOpImageSparseSampleProjDrefImplicitLod:
+            case SpvOpImageSparseSampleProjDrefExplicitLod:
+                access.kind = "Sample";
+                variants << "Cmp";
+                maskOperand = 5;
+                break;
+            case SpvOpImageGather:
+            case SpvOpImageSparseGather:
+                access.kind = "Gather";
+                maskOperand = 5;
+                break;
+            case SpvOpImageDrefGather:
+            case SpvOpImageSparseDrefGather:
+                access.kind = "Gather";
+                variants << "Cmp";
+                maskOperand = 5;
+                break;
+            case SpvOpImageFetch:
+            case SpvOpImageSparseFetch:
+                access.kind = "Fetch";
+                maskOperand = 4;
+                break;
+            case SpvOpImageRead:
+            case SpvOpImageSparseRead:
+                access.kind = "Read";
+                maskOperand = 4;
+                break;
+            case SpvOpImageWrite:
+                access.kind = "Write";
+                resourceVariable = module.rootVariableOf(module.operand(inst, 0));
+                address = module.operand(inst, 1);
+                maskOperand = 3;
+                break;
+            case SpvOpLoad:
+                if (isStorageBufferPointer(module.operand(inst, 2))) {
+                    access.kind = "Load";
+                    address = module.operand(inst, 2);
+                    resourceVariable = module.rootVariableOf(address);
+                }
+                break;
+            case SpvOpStore:
+                if (isStorageBufferPointer(module.operand(inst, 0))) {
+                    access.kind = "Store";
+                    address = module.operand(inst, 0);
+                    resourceVariable = module.rootVariableOf(address);
+                }
+                break;
+            default:
+                if ((inst.opcode >= SpvOpAtomicLoad && inst.opcode <= SpvOpAtomicXor) || inst.opcode == SpvOpAtomicFAddEXT) {
+                    address = module.operand(inst, inst.opcode == SpvOpAtomicStore ? 0 : 2);
+                    if (isStorageBufferPointer(address) || module.storageClassOf(address) == SpvStorageClassImage) {
+                        access.kind = "Atomic";
+                        resourceVariable = module.rootVariableOf(address);
+                    }
+                }
+                break;
+            }
+            if (access.kind.isEmpty()) {
+                continue;
+            }
+
+            bool isImageRead = access.kind == "Sample" || access.kind == "Gather" || access.kind == "Fetch" || access.kind == "Read";
+            if (isImageRead) {
+                resourceVariable = module.rootVariableOf(module.operand(inst, 2), nullptr, &samplerVariable);
+                address = module.operand(inst, 3);
+            }
+
+            bool isSparse = false;
+            SpirvModule::isImageReadOpcode(inst.opcode, &isSparse);
+            bool isProj = (inst.opcode >= SpvOpImageSampleProjImplicitLod && inst.opcode <= SpvOpImageSampleProjDrefExplicitLod)
+                || (inst.opcode >= SpvOpImageSparseSampleProjImplicitLod && inst.opcode <= SpvOpImageSparseSampleProjDrefExplicitLod);
+            bool isImplicit = inst.opcode == SpvOpImageSampleImplicitLod || inst.opcode == SpvOpImageSampleDrefImplicitLod
+                || inst.opcode == SpvOpImageSampleProjImplicitLod || inst.opcode == SpvOpImageSampleProjDrefImplicitLod
+                || inst.opcode == SpvOpImageSparseSampleImplicitLod || inst.opcode == SpvOpImageSparseSampleDrefImplicitLod
+                || inst.opcode == SpvOpImageSparseSampleProjImplicitLod || inst.opcode == SpvOpImageSparseSampleProjDrefImplicitLod;
+            uint32_t mask = maskOperand >= 0 && maskOperand < module.operandCount(inst) ? module.operand(inst, maskOperand) : 0;
+            if (isImplicit && !(mask & SpvImageOperandsBiasMask)) {
+                variants.prepend("Implicit LOD");
+            }
+            if (mask & SpvImageOperandsBiasMask) {
+                variants << "Bias";
+            }
+            if ((mask & SpvImageOperandsLodMask) && access.kind != "Fetch" && access.kind != "Read") {
+                variants << "Level";
+            }
+            if (mask & SpvImageOperandsGradMask) {
+                variants << "Grad";
+            }
+            if (mask & (SpvImageOperandsConstOffsetMask | SpvImageOperandsOffsetMask | SpvImageOperandsConstOffsetsMask)) {
+                variants << "Offset";
+            }
+            if (mask & SpvImageOperandsMinLodMask) {
+                variants << "MinLod";
+            }
+            if (isProj) {
+                variants << "Proj";
+            }
+            if (isSparse) {
+                variants << "Sparse";
+            }
+
+            access.function = functionName;
+            access.resource = resourceName(resourceVariable);
+            access.resourceBinding = bindingText(resourceVariable);
+            if (samplerVariable) {
+                access.sampler = resourceName(samplerVariable);
+                access.samplerBinding = bindingText(samplerVariable);
+            }
+            access.variant = variants.join(" + ");
+            access.implicitLod = isImplicit;
+            access.location = locations[i].text();
+            access.loopDepth = loopDepth[b];
+            access.divergent = divergent[b];
+            access.dependsOn = dependencies(address);
+            report.accesses.append(access);
+        }
+    }
+}
+
+TextureAccessReport SpirvTextureAnalysis::run()
+{
+    TextureAccessReport report;
+    report.binaryType = "SPIR-V";
+    if (!module.entryPoints().isEmpty()) {
+        report.stage = SpirvModule::stageName(module.entryPoints().first().executionModel);
+    }
+
+    nonUniform = SpirvUniformity::nonUniformValues(module);
+    for (int f = 0; f < module.functions().size(); ++f) {
+        analyzeFunction(f, report);
+    }
+    return report;
+}
+
+// ---------------- DXIL ----------------
+
+// dx.op 类别 -> 访问类型及变体
+bool classifyDxOp(const QString &opClass, TextureAccess &access)
+{
+    static const QHash<QString, QStringList> kOps = {
+        { "sample", { "Sample", "Implicit LOD", "1" } },
+        { "sampleBias", { "Sample", "Bias", "1" } },
+        { "sampleLevel", { "Sample", "Level", "0" } },
+        { "sampleGrad", { "Sample", "Grad", "0" } },
+        { "sampleCmp", { "Sample", "Implicit LOD + Cmp", "1" } },
+        { "sampleCmpBias", { "Sample", "Cmp + Bias", "1" } },
+        { "sampleCmpLevel", { "Sample", "Cmp + Level", "0" } },
+        { "sampleCmpLevelZero", { "Sample", "Cmp + Level", "0" } },
+        { "sampleCmpGrad", { "Sample", "Cmp + Grad", "0" } },
+        { "textureGather", { "Gather", "", "0" } },
+        { "textureGatherCmp", { "Gather", "Cmp", "0" } },
+        { "textureGatherRaw", { "Gather", "Raw", "0" } },
+        { "textureLoad", { "Fetch", "", "0" } },
+        { "textureStore", { "Write", "", "0" } },
+        { "bufferLoad", { "Load", "", "0" } },
+        { "rawBufferLoad", { "Load", "", "0" } },
+        { "bufferStore", { "Store", "", "0" } },
+        { "rawBufferStore", { "Store", "", "0" } },
+        { "atomicBinOp", { "Atomic", "", "0" } },
+        { "atomicCompareExchange", { "Atomic", "", "0" } }
+    };
+
+    auto it = kOps.constFind(opClass);
+    if (it == kOps.constEnd()) {
+        return false;
+    }
+    access.kind = it.value()[0];
+    access.variant = it.value()[1];
+    access.implicitLod = it.value()[2] == "1";
+    return true;
+}
+
+// 坐标/地址参数的范围 [first, last)，参数下标从句柄开始
+void addressArguments(const QString &opClass, int &first, int &last)
+{
+    if (opClass.startsWith("sample") || opClass.startsWith("textureGather")) {
+        first = 2; // 纹理句柄、采样器句柄之后
+        last = 6;
+    } else if (opClass == "textureLoad") {
+        first = 1; // mip 级别及坐标
+        last = 5;
+    } else if (opClass == "atomicBinOp") {
+        first = 2;
+        last = 5;
+    } else if (opClass == "textureStore" || opClass == "atomicCompareExchange") {
+        first = 1;
+        last = 4;
+    } else {
+        first = 1;
+        last = 3;
+    }
+}
+
+QString valueOfArgument(const QString &argument)
+{
+    return argument.trimmed().split(' ').last();
+}
+
+class DxilTextureAnalysis
+{
+public:
+    explicit DxilTextureAnalysis(const QString &disassembly);
+
+    TextureAccessReport run();
+
+private:
+    struct Resource
+    {
+        QString name;
+        QString binding; // HLSL 绑定，如 t0、s1,space2
+    };
+
+    struct Block
+    {
+        QString label;
+        QStringList targets;
+        QString condition; // 条件分支或 switch 的条件值，无条件为空
+    };
+
+    void parseResourceTable();
+    void analyzeFunction(const QStringList &body, const QString &functionName, TextureAccessReport &report);
+    QStringList valueRefs(const QString &text) const;
+    QStringList dependencies(const QString &value);
+
+    QStringList lines;
+    QHash<int, int> locationLines;
+    QHash<QString, Resource> resourcesById; // "类别:范围 ID" -> 资源
+    QHash<QString, Resource> resourcesByBinding; // "t0,space0" -> 资源
+
+    // 当前函数
+    QHash<QString, QString> definitions; // 值 -> 定义行
+    QHash<QString, Resource> handles; // 句柄值 -> 资源
+    QHash<QString, QStringList> dependencyCache;
+    QSet<QString> dependencyInProgress;
+};
+
+DxilTextureAnalysis::DxilTextureAnalysis(const QString &disassembly)
+    : lines(disassembly.split('\n'))
+{
+    locationLines = ShaderCostAnalyzer::dxilDebugLocationLines(lines);
+}
+
+// dxc -dumpbin 注释中的资源绑定表：Name Type Format Dim ID HLSL-Bind Count
+void DxilTextureAnalysis::parseResourceTable()
+{
+    static const QRegularExpression rowRe(R"(^;\s*(\S+)\s+(sampler|texture|UAV|cbuffer)\s+\S+\s+\S+\s+([A-Z]+)(\d+)\s+(\S+)\s+\d+\s*$)");
+    static const QHash<QString, QString> kClassOfId = { { "T", "0" }, { "U", "1" }, { "CB", "2" }, { "S", "3" } };
+
+    bool inTable = false;
+    for (const QString &line : lines) {
+        if (line.startsWith("; Resource Bindings:")) {
+            inTable = true;
+            continue;
+        }
+        if (!inTable) {
+            continue;
+        }
+        if (!line.startsWith(';')) {
+            break;
+        }
+        QRegularExpressionMatch match = rowRe.match(line);
+        if (!match.hasMatch()) {
+            continue;
+        }
+
+        Resource resource;
+        resource.name = match.captured(1);
+        resource.binding = match.captured(5);
+        resourcesById.insert(kClassOfId.value(match.captured(3)) + ":" + match.captured(4), resource);
+        QString key = resource.binding.contains(",space") ? resource.binding : resource.binding + ",space0";
+        resourcesByBinding.insert(key, resource);
+    }
+}
+
+QStringList DxilTextureAnalysis::valueRefs(const QString &text) const
+{
+    static const QRegularExpression refRe(R"(%[\w.]+)");
+    QStringList refs;
+    QRegularExpressionMatchIterator it = refRe.globalMatch(text);
+    while (it.hasNext()) {
+        QString ref = it.next().captured(0);
+        if (!ref.startsWith("%dx.") && !ref.startsWith("%struct.") && !ref.startsWith("%class.") && !refs.contains(ref)) {
+            refs << ref;
+        }
+    }
+    return refs;
+}
+
+// 值依赖的先前读取：纹理/缓冲区读取的 dx.op 返回其资源名称
+QStringList DxilTextureAnalysis::dependencies(const QString &value)
+{
+    static const QRegularExpression dxOpRe(R"(@dx\.op\.(\w+)(?:\.[\w.]+)?\(i32\s+\d+,\s*%dx\.types\.Handle\s+(%[\w.]+))");
+
+    if (dependencyCache.contains(value)) {
+        return dependencyCache.value(value);
+    }
+    if (!definitions.contains(value) || dependencyInProgress.contains(value)) {
+        return QStringList();
+    }
+
+    const QString definition = definitions.value(value);
+    QStringList result;
+    QRegularExpressionMatch match = dxOpRe.match(definition);
+    TextureAccess access;
+    if (match.hasMatch() && classifyDxOp(match.captured(1), access) && access.kind != "Write" && access.kind != "Store") {
+        result << handles.value(match.captured(2)).name;
+    } else {
+        dependencyInProgress.insert(value);
+        for (const QString &ref : valueRefs(definition)) {
+            for (const QString &name : dependencies(ref)) {
+                if (!result.contains(name)) {
+                    result << name;
+                }
+            }
+        }
+        dependencyInProgress.remove(value);
+    }
+    dependencyCache.insert(value, result);
+    return result;
+}
+
+void DxilTextureAnalysis::analyzeFunction(const QStringList &body, const QString &functionName, TextureAccessReport &report)
+{
+    static const QRegularExpression definitionRe(R"(^\s*(%[\w.]+)\s*=\s*(.*)$)");
+    static const QRegularExpression labelRe(R"(^(?:; <label>:(\d+)|([\w.]+):)(?:\s|$))");
+    static const QRegularExpression createHandleRe(R"(@dx\.op\.createHandle\(i32 \d+, i8 (\d+), i32 (\d+))");
+    static const QRegularExpression handleFromBindingRe(R"(@dx\.op\.createHandleFromBinding\(i32 \d+, %dx\.types\.ResBind \{ i32 (-?\d+), i32 -?\d+, i32 (\d+), i8 (\d+) \})");
+    static const QRegularExpression annotateHandleRe(R"(@dx\.op\.annotateHandle\(i32 \d+, %dx\.types\.Handle (%[\w.]+))");
+    static const QRegularExpression handleForLibRe(R"(@dx\.op\.createHandleForLib[\w.]*\(i32 \d+, [^%]*(%[\w.]+))");
+    static const QRegularExpression globalLoadRe(R"re(load [^@]*@"?\\01\?(\w+)@@)re");
+    static const QRegularExpression dxOpRe(R"(@dx\.op\.(\w+)(?:\.[\w.]+)?\(i32\s+\d+,\s*(.*)\)(?:,\s*!dbg.*)?\s*$)");
+    static const QRegularExpression conditionalBranchRe(R"(^\s*br i1 ([%\w.]+), label (%[\w.]+), label (%[\w.]+))");
+    static const QRegularExpression branchRe(R"(^\s*br label (%[\w.]+))");
+    static const QRegularExpression switchRe(R"(^\s*switch \w+ (%[\w.]+), label (%[\w.]+))");
+    static const QRegularExpression labelRefRe(R"(label (%[\w.]+))");
+    static const QRegularExpression debugLocationRe(R"(!dbg !(\d+))");
+    static const QStringList kVaryingOps = {
+        "loadInput", "threadId", "threadIdInGroup", "flattenedThreadIdInGroup", "primitiveID", "sampleIndex", "coverage",
+        "innerCoverage", "waveGetLaneIndex", "domainLocation", "outputControlPointID", "gsInstanceID", "evalSnapped",
+        "evalSampleIndex", "evalCentroid", "attributeAtVertex"
+    };
+    static const QString kHandleClassLetters[4] = { "t", "u", "cb", "s" };
+
+    definitions.clear();
+    handles.clear();
+    dependencyCache.clear();
+    QHash<QString, QString> globalNames; // 加载全局资源的值 -> 资源名称
+
+    // 基本块：入口块没有标签
+    QVector<Block> blocks(1);
+    QVector<int> blockOfLine(body.size(), 0);
+    bool inSwitch = false;
+    for (int l = 0; l < body.size(); ++l) {
+        const QString &line = body[l];
+        QRegularExpressionMatch labelMatch = labelRe.match(line);
+        if (labelMatch.hasMatch()) {
+            Block block;
+            block.label = "%" + (labelMatch.captured(1).isEmpty() ? labelMatch.captured(2) : labelMatch.captured(1));
+            blocks.append(block);
+        }
+        blockOfLine[l] = blocks.size() - 1;
+        Block &current = blocks.last();
+
+        QRegularExpressionMatch match;
+        if (inSwitch) {
+            QRegularExpressionMatchIterator it = labelRefRe.globalMatch(line);
+            while (it.hasNext()) {
+                current.targets << it.next().captured(1);
+            }
+            inSwitch = !line.contains(']');
+        } else if ((match = conditionalBranchRe.match(line)).hasMatch()) {
+            current.condition = match.captured(1);
+            current.targets << match.captured(2) << match.captured(3);
+        } else if ((match = branchRe.match(line)).hasMatch()) {
+            current.targets << match.captured(1);
+        } else if ((match = switchRe.match(line)).hasMatch()) {
+            current.condition = match.captured(1);
+            current.targets << match.captured(2);
+            QRegularExpressionMatchIterator it = labelRefRe.globalMatch(line.mid(match.capturedEnd(0)));
+            while (it.hasNext()) {
+                current.targets << it.next().captured(1);
+            }
+            inSwitch = line.contains('[') && !line.contains(']');
+        }
+
+        match = definitionRe.match(line);
+        if (!match.hasMatch()) {
+            continue;
+        }
+        QString value = match.captured(1);
+        QString definition = match.captured(2);
+        definitions.insert(value, definition);
+
+        QRegularExpressionMatch handleMatch;
+        if ((handleMatch = createHandleRe.match(definition)).hasMatch()) {
+            handles.insert(value, resourcesById.value(handleMatch.captured(1) + ":" + handleMatch.captured(2)));
+        } else if ((handleMatch = handleFromBindingRe.match(definition)).hasMatch()) {
+            int handleClass = qBound(0, handleMatch.captured(3).toInt(), 3);
+            QString key = QString("%1%2,space%3").arg(kHandleClassLetters[handleClass]).arg(handleMatch.captured(1)).arg(handleMatch.captured(2));
+            Resource resource = resourcesByBinding.value(key);
+            if (resource.binding.isEmpty()) {
+                resource.binding = key.endsWith(",space0") ? key.left(key.size() - 7) : key;
+            }
+            handles.insert(value, resource);
+        } else if ((handleMatch = annotateHandleRe.match(definition)).hasMatch()) {
+            handles.insert(value, handles.value(handleMatch.captured(1)));
+        } else if ((handleMatch = globalLoadRe.match(definition)).hasMatch()) {
+            globalNames.insert(value, handleMatch.captured(1));
+        } else if ((handleMatch = handleForLibRe.match(definition)).hasMatch()) {
+            Resource resource;
+            resource.name = globalNames.value(handleMatch.captured(1));
+            handles.insert(value, resource);
+        }
+    }
+
+    QHash<QString, int> blockOfLabel;
+    for (int b = 0; b < blocks.size(); ++b) {
+        blockOfLabel.insert(blocks[b].label, b);
+    }
+    QVector<QVector<int>> blockSuccessors(blocks.size());
+    for (int b = 0; b < blocks.size(); ++b) {
+        for (const QString &target : blocks[b].targets) {
+            int successor = blockOfLabel.value(target, -1);
+            if (successor >= 0 && !blockSuccessors[b].contains(successor)) {
+                blockSuccessors[b].append(successor);
+            }
+        }
+    }
+
+    // 一致性：逐线程输入、线程 ID 及资源读取的结果视为不一致
+    QSet<QString> nonUniform;
+    static const QRegularExpression opClassRe(R"(@dx\.op\.(\w+))");
+    bool changed = true;
+    for (int pass = 0; changed && pass < 4; ++pass) {
+        changed = false;
+        for (auto it = definitions.constBegin(); it != definitions.constEnd(); ++it) {
+            if (nonUniform.contains(it.key())) {
+                continue;
+            }
+            QRegularExpressionMatch opMatch = opClassRe.match(it.value());
+            TextureAccess access;
+            bool varying = it.value().contains("addrspace(3)")
+                || (opMatch.hasMatch() && (kVaryingOps.contains(opMatch.captured(1)) || classifyDxOp(opMatch.captured(1), access)));
+            for (const QString &ref : valueRefs(it.value())) {
+                varying = varying || nonUniform.contains(ref);
+            }
+            if (varying) {
+                nonUniform.insert(it.key());
+                changed = true;
+            }
+        }
+    }
+
+    // 回边 [目标, 源] 之间的块视为循环体；条件不一致的分支只经一侧可达的块视为不一致区域
+    QVector<int> loopDepth(blocks.size(), 0);
+    QVector<bool> divergent(blocks.size(), false);
+    for (int b = 0; b < blocks.size(); ++b) {
+        for (int successor : blockSuccessors[b]) {
+            if (successor > b) {
+                continue;
+            }
+            bool varyingExit = false;
+            for (int member = successor; member <= b; ++member) {
+                ++loopDepth[member];
+                if (nonUniform.contains(blocks[member].condition)) {
+                    for (int target : blockSuccessors[member]) {
+                        varyingExit = varyingExit || target > b || target < successor;
+                    }
+                }
+            }
+            for (int member = successor; member <= b && varyingExit; ++member) {
+                divergent[member] = true;
+            }
+        }
+
+        if (blocks[b].condition.isEmpty() || !nonUniform.contains(blocks[b].condition) || blockSuccessors[b].size() < 2) {
+            continue;
+        }
+        QSet<int> reachedByAny;
+        QSet<int> reachedByAll;
+        for (int s = 0; s < blockSuccessors[b].size(); ++s) {
+            int successor = blockSuccessors[b][s];
+            QSet<int> reached = successor > b ? forwardReach(blockSuccessors, { successor }, -1) : QSet<int>();
+            reachedByAny.unite(reached);
+            if (s == 0) {
+                reachedByAll = reached;
+            } else {
+                reachedByAll.intersect(reached);
+            }
+        }
+        for (int member : reachedByAny) {
+            divergent[member] = divergent[member] || !reachedByAll.contains(member);
+        }
+    }
+
+    for (int l = 0; l < body.size(); ++l) {
+        const QString &line = body[l];
+        QRegularExpressionMatch match = dxOpRe.match(line);
+        TextureAccess access;
+        if (!match.hasMatch() || !classifyDxOp(match.captured(1), access)) {
+            continue;
+        }
+
+        QString opClass = match.captured(1);
+        QStringList arguments = match.captured(2).split(", ");
+        Resource resource = handles.value(valueOfArgument(arguments.value(0)));
+        access.function = functionName;
+        access.resource = resource.name.isEmpty() ? valueOfArgument(arguments.value(0)) : resource.name;
+        access.resourceBinding = resource.binding;
+        if (access.kind == "Sample" || access.kind == "Gather") {
+            Resource sampler = handles.value(valueOfArgument(arguments.value(1)));
+            access.sampler = sampler.name.isEmpty() ? valueOfArgument(arguments.value(1)) : sampler.name;
+            access.samplerBinding = sampler.binding;
+        }
+
+        int first = 0;
+        int last = 0;
+        addressArguments(opClass, first, last);
+        for (int a = first; a < qMin(last, arguments.size()); ++a) {
+            for (const QString &name : dependencies(valueOfArgument(arguments[a]))) {
+                if (!access.dependsOn.contains(name)) {
+                    access.dependsOn << name;
+                }
+            }
+        }
+
+        QRegularExpressionMatch debugMatch = debugLocationRe.match(line);
+        int sourceLine = debugMatch.hasMatch() ? locationLines.value(debugMatch.captured(1).toInt(), 0) : 0;
+        if (sourceLine > 0) {
+            access.location = QString("line %1").arg(sourceLine);
+        }
+        access.loopDepth = loopDepth[blockOfLine[l]];
+        access.divergent = divergent[blockOfLine[l]];
+        report.accesses.append(access);
+    }
+}
+
+TextureAccessReport DxilTextureAnalysis::run()
+{
+    static const QRegularExpression defineRe(R"(^define\s+[^@]*@([\w.$]+)\()");
+    static const QRegularExpression shaderModelRe(R"re(!\{!"(\w+)", i32 \d+, i32 \d+\})re");
+    static const QHash<QString, QString> kStages = {
+        { "vs", "Vertex" }, { "ps", "Pixel" }, { "cs", "Compute" }, { "gs", "Geometry" },
+        { "hs", "Hull" }, { "ds", "Domain" }, { "ms", "Mesh" }, { "as", "Task" }
+    };
+
+    TextureAccessReport report;
+    report.binaryType = "DXIL";
+    for (const QString &line : lines) {
+        QRegularExpressionMatch match = shaderModelRe.match(line);
+        if (match.hasMatch()) {
+            report.stage = kStages.value(match.captured(1));
+            break;
+        }
+    }
+
+    parseResourceTable();
+
+    QString functionName;
+    QStringList body;
+    bool inFunction = false;
+    for (const QString &line : lines) {
+        if (!inFunction) {
+            QRegularExpressionMatch match = defineRe.match(line);
+            if (match.hasMatch()) {
+                inFunction = true;
+                functionName = match.captured(1);
+                body.clear();
+            }
+            continue;
+        }
+        if (line.startsWith('}')) {
+            analyzeFunction(body, functionName, report);
+            inFunction = false;
+            continue;
+        }
+        body << line;
+    }
+    return report;
+}
+
+// 按资源汇总
+struct ResourceUsage
+{
+    QString name;
+    QString binding;
+    QStringList samplers;
+    QMap<QString, int> kinds; // 访问类型 -> 次数
+    QMap<QString, int> variants;
+    int inLoops = 0;
+    int divergent = 0;
+    int dependent = 0;
+};
+
+QString accessText(const TextureAccess &access)
+{
+    QString text = QString("%1 (%2%3)").arg(access.resource).arg(access.kind)
+        .arg(access.variant.isEmpty() ? QString() : " " + access.variant);
+    if (!access.location.isEmpty()) {
+        text += " at " + access.location;
+    }
+    return text;
+}
+
+} // namespace
+
+TextureAccessReport TextureAccessAnalyzer::analyzeSpirv(const SpirvModule &module)
+{
+    SpirvTextureAnalysis analysis(module);
+    return analysis.run();
+}
+
+TextureAccessReport TextureAccessAnalyzer::analyzeDxilDisassembly(const QString &disassembly)
+{
+    DxilTextureAnalysis analysis(disassembly);
+    return analysis.run();
+}
+
+void TextureAccessAnalyzer::applyReflection(TextureAccessReport &report, const ShaderReflection &reflection)
+{
+    static const QHash<QString, QString> kRegisterLetters = { { "CBV", "cb" }, { "SRV", "t" }, { "UAV", "u" }, { "Sampler", "s" } };
+
+    QHash<QString, QString> names; // 绑定 -> 名称
+    for (const ShaderReflectionBinding &binding : reflection.descriptorBindings) {
+        if (binding.name.isEmpty()) {
+            continue;
+        }
+        if (reflection.binaryType == "DXIL") {
+            QString key = kRegisterLetters.value(binding.descriptorType) + QString::number(binding.binding);
+            names.insert(binding.set ? QString("%1,space%2").arg(key).arg(binding.set) : key, binding.name);
+        } else {
+            names.insert(QString("set %1, binding %2").arg(binding.set).arg(binding.binding), binding.name);
+        }
+    }
+
+    for (TextureAccess &access : report.accesses) {
+        if ((access.resource.isEmpty() || access.resource.startsWith('%')) && names.contains(access.resourceBinding)) {
+            access.resource = names.value(access.resourceBinding);
+        }
+        if ((access.sampler.isEmpty() || access.sampler.startsWith('%')) && names.contains(access.samplerBinding)) {
+            access.sampler = names.value(access.samplerBinding);
+        }
+    }
+}
+
+QString TextureAccessAnalyzer::reportText(const QVector<TextureAccessReport> &reports)
+{
+    static const QStringList kKinds = { "Sample", "Gather", "Fetch", "Read", "Write", "Load", "Store", "Atomic" };
+
+    QString text;
+    for (const TextureAccessReport &report : reports) {
+        text += QString("== %1 (%2) ==\n").arg(report.stage.isEmpty() ? QString("Shader") : report.stage).arg(report.binaryType);
+        if (report.isEmpty()) {
+            text += "No texture or storage buffer accesses.\n\n";
+            continue;
+        }
+
+        QVector<ResourceUsage> usages;
+        QMap<QString, int> totals;
+        for (const TextureAccess &access : report.accesses) {
+            QString key = access.resourceBinding.isEmpty() ? access.resource : access.resourceBinding;
+            int index = -1;
+            for (int i = 0; i < usages.size(); ++i) {
+                if ((usages[i].binding.isEmpty() ? usages[i].name : usages[i].binding) == key) {
+                    index = i;
+                    break;
+                }
+            }
+            if (index < 0) {
+                ResourceUsage usage;
+                usage.name = access.resource;
+                usage.binding = access.resourceBinding;
+                usages.append(usage);
+                index = usages.size() - 1;
+            }
+
+            ResourceUsage &usage = usages[index];
+            if (!access.sampler.isEmpty() && !usage.samplers.contains(access.sampler)) {
+                usage.samplers << access.sampler;
+            }
+            usage.kinds[access.kind] += 1;
+            totals[access.kind] += 1;
+            if (!access.variant.isEmpty()) {
+                usage.variants[access.variant] += 1;
+            }
+            usage.inLoops += access.loopDepth > 0 ? 1 : 0;
+            usage.divergent += access.divergent ? 1 : 0;
+            usage.dependent += access.dependsOn.isEmpty() ? 0 : 1;
+        }
+
+        QStringList totalTexts;
+        for (const QString &kind : kKinds) {
+            if (totals.value(kind) > 0) {
+                totalTexts << QString("%1 %2").arg(totals.value(kind)).arg(kind);
+            }
+        }
+        text += totalTexts.join(", ") + "\n\n";
+
+        text += QString("  %1 %2").arg("Resource", -24).arg("Binding", -20);
+        for (const QString &kind : kKinds) {
+            if (totals.value(kind) > 0) {
+                text += QString(" %1").arg(kind, 6);
+            }
+        }
+        text += "   Loop  Diverg  Depend  Samplers / Variants\n";
+        for (const ResourceUsage &usage : usages) {
+            text += QString("  %1 %2").arg(usage.name, -24).arg(usage.binding, -20);
+            for (const QString &kind : kKinds) {
+                if (totals.value(kind) > 0) {
+                    text += QString(" %1").arg(usage.kinds.value(kind), 6);
+                }
+            }
+            QStringList notes;
+            if (!usage.samplers.isEmpty()) {
+                notes << usage.samplers.join(", ");
+            }
+            for (auto it = usage.variants.constBegin(); it != usage.variants.constEnd(); ++it) {
+                notes << QString("%1 x%2").arg(it.key()).arg(it.value());
+            }
+            text += QString(" %1 %2 %3  %4\n").arg(usage.inLoops, 6).arg(usage.divergent, 7).arg(usage.dependent, 7).arg(notes.join("; "));
+        }
+
+        QStringList dependent;
+        QStringList inLoops;
+        QStringList divergent;
+        for (const TextureAccess &access : report.accesses) {
+            if (!access.dependsOn.isEmpty()) {
+                dependent << QString("%1, address from %2").arg(accessText(access)).arg(access.dependsOn.join(", "));
+            }
+            if (access.loopDepth > 0) {
+                inLoops << QString("%1, loop depth %2").arg(accessText(access)).arg(access.loopDepth);
+            }
+            if (access.divergent) {
+                divergent << accessText(access) + (access.implicitLod ? QString(", implicit LOD: derivatives undefined") : QString());
+            }
+        }
+
+        auto appendFindings = [&](const QString &title, const QStringList &findings) {
+            if (findings.isEmpty()) {
+                return;
+            }
+            text += QString("\n%1 (%2):\n").arg(title).arg(findings.size());
+            for (int i = 0; i < qMin(findings.size(), kMaxFindings); ++i) {
+                text += "  " + findings[i] + "\n";
+            }
+            if (findings.size() > kMaxFindings) {
+                text += QString("  ... %1 more\n").arg(findings.size() - kMaxFindings);
+            }
+        };
+        appendFindings("Dependent reads", dependent);
+        appendFindings("Accesses in loops", inLoops);
+        appendFindings("Accesses in divergent control flow", divergent);
+        text += "\n";
+    }
+    return text;
+}
@@ -0,0 +1,54 @@
+#ifndef TEXTUREACCESSANALYZER_H
+#define TEXTUREACCESSANALYZER_H
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+class SpirvModule;
+class ShaderReflection;
+
+// 单次纹理或存储缓冲区访问
+struct TextureAccess
+{
+    QString function;
+    QString resource; // 纹理/缓冲区名称
+    QString resourceBinding; // 如 "set 0, binding 2"、"t0"、"t1,space2"
+    QString sampler; // 采样器名称，非采样操作为空
+    QString samplerBinding;
+    QString kind; // Sample、Gather、Fetch、Read、Write、Load、Store、Atomic
+    QString variant; // Implicit LOD、Bias、Level、Grad、Cmp、Proj、Offset、Sparse 等，以 " + " 连接
+    QString location; // 源代码位置，无调试信息时为空
+    int loopDepth = 0; // 所在循环的嵌套深度
+    bool divergent = false; // 位于条件不一致（依赖逐线程数据）的分支或循环内
+    bool implicitLod = false; // 隐式 LOD 采样，需要导数
+    QStringList dependsOn; // 坐标/地址依赖的先前读取的资源，非空为依赖读取
+};
+
+// 一次编译结果的访问报告
+struct TextureAccessReport
+{
+    QString binaryType; // SPIR-V 或 DXIL
+    QString stage;
+    QVector<TextureAccess> accesses;
+
+    bool isEmpty() const { return accesses.isEmpty(); }
+};
+
+// TextureAccessAnalyzer 统计纹理采样、读取、gather 及存储缓冲区读写，按资源绑定分组，
+// 并标出依赖读取（坐标来自先前的纹理/缓冲区读取）、循环内及分支不一致区域内的访问。
+class TextureAccessAnalyzer
+{
+public:
+    static TextureAccessReport analyzeSpirv(const SpirvModule &module);
+
+    // 分析 dxc -dumpbin 输出的 DXIL 反汇编，资源名称取自其 Resource Bindings 表
+    static TextureAccessReport analyzeDxilDisassembly(const QString &disassembly);
+
+    // 用反射的绑定表补全资源名称（SPIR-V 去除 OpName 后只有 ID）
+    static void applyReflection(TextureAccessReport &report, const ShaderReflection &reflection);
+
+    static QString reportText(const QVector<TextureAccessReport> &reports);
+};
+
+#endif // TEXTUREACCESSANALYZER_H